@@ -0,0 +1,213 @@
+///
+/// @file AlphaBetaTracker.cpp
+///
+/// @brief AlphaBetaTracker class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "AlphaBetaTracker.h"
+
+namespace CNEGR
+{
+  /// @brief Multiplies two Q16.16 values
+  ///
+  static inline Q16 Q16Mul(Q16 a, Q16 b)
+  {
+    return (Q16)(((int64_t)a * b) >> 16);
+  }
+
+  /// @brief Saturates a value to the Q16.16 range
+  ///
+  static inline Q16 Q16Saturate(int64_t value)
+  {
+    if (value > INT32_MAX)
+      return INT32_MAX;
+
+    if (value < INT32_MIN)
+      return INT32_MIN;
+
+    return (Q16)value;
+  }
+
+  /// @brief Constructor.
+  AlphaBetaTracker::AlphaBetaTracker()
+    :_tracking(false),
+     _predictedSamples(0),
+     _lastTimeMs(0),
+     _position(0),
+     _velocity(0)
+  {
+    _config.alpha               = Q16_ONE;
+    _config.beta                = 0;
+    _config.maxPredictedSamples = 0;
+  }
+
+  /// @brief Destructor.
+  AlphaBetaTracker::~AlphaBetaTracker()
+  {
+  }
+
+  /// @brief Initialization function.
+  ///
+  /// @param configuration      The configuration data.
+  ///
+  /// @retval RESULT_OK         The tracker was successfully configured.
+  /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+  ///
+  Result AlphaBetaTracker::Init(const Config& configuration)
+  {
+    // The filter is stable only for 0 < alpha <= 1 and 0 < beta < 2
+    if ((configuration.alpha <= 0) || (configuration.alpha > Q16_ONE))
+      return RESULT_BAD_PARAM;
+
+    if ((configuration.beta < 0) || (configuration.beta >= 2 * Q16_ONE))
+      return RESULT_BAD_PARAM;
+
+    _config = configuration;
+    Reset();
+
+    return RESULT_OK;
+  }
+
+  /// @brief Drops the current track. The next measurement will start a new track.
+  ///
+  void AlphaBetaTracker::Reset()
+  {
+    _tracking         = false;
+    _predictedSamples = 0;
+    _position         = 0;
+    _velocity         = 0;
+  }
+
+  /// @brief Updates the track with a new measurement
+  ///
+  /// @param timeMs             The time of the measurement in milliseconds
+  /// @param distanceMm         The measured distance in millimeters
+  ///
+  void AlphaBetaTracker::Update(uint32_t timeMs, uint32_t distanceMm)
+  {
+    // Anything that doesn't fit in the Q16.16 format can't be a valid reading
+    if (distanceMm > INT16_MAX)
+    {
+      Predict(timeMs);
+      return;
+    }
+
+    Q16 measurement = Q16_FROM_INT(distanceMm);
+
+    if (!_tracking)
+    {
+      // Start a new track from the first measurement
+      _tracking         = true;
+      _predictedSamples = 0;
+      _lastTimeMs       = timeMs;
+      _position         = measurement;
+      _velocity         = 0;
+      return;
+    }
+
+    uint32_t deltaT = Advance(timeMs);
+
+    // Correct the prediction using the residual
+    Q16 residual = measurement - _position;
+
+    _position += Q16Mul(_config.alpha, residual);
+
+    // A jump of the reading over a few milliseconds is a velocity beyond the Q16.16
+    // range, beta * residual alone can exceed it since beta is up to 2
+    int64_t correction = ((((int64_t)_config.beta * residual) >> 16) * 1000) / (int32_t)deltaT;
+    _velocity = Q16Saturate((int64_t)_velocity + correction);
+
+    if (_position < 0)
+      _position = 0;
+
+    _predictedSamples = 0;
+  }
+
+  /// @brief Updates the track when the measurement is missing by predicting the
+  /// position from the velocity estimate
+  ///
+  /// @param timeMs             The time of the missed measurement in milliseconds
+  ///
+  void AlphaBetaTracker::Predict(uint32_t timeMs)
+  {
+    if (!_tracking)
+      return;
+
+    if (_predictedSamples >= _config.maxPredictedSamples)
+    {
+      // Too many samples missed in a row, the subject is gone
+      Reset();
+      return;
+    }
+
+    Advance(timeMs);
+    _predictedSamples++;
+
+    if (_position < 0)
+      _position = 0;
+  }
+
+  /// @brief Get whether a subject is currently tracked
+  ///
+  /// @return boolean true if the tracker has a valid position estimate
+  ///
+  bool AlphaBetaTracker::IsTracking() const
+  {
+    return _tracking;
+  }
+
+  /// @brief Gets the estimated distance
+  ///
+  /// @retval The estimated distance in millimeters or UINT32_MAX if the
+  /// subject is not tracked
+  ///
+  uint32_t AlphaBetaTracker::GetDistance() const
+  {
+    if (!_tracking)
+      return UINT32_MAX;
+
+    // Round to the nearest millimeter
+    return (uint32_t)(((int64_t)_position + (Q16_ONE / 2)) >> 16);
+  }
+
+  /// @brief Gets the estimated velocity
+  ///
+  /// @retval The estimated velocity in millimeters per second. A positive value means
+  /// that the subject is moving away from the sensor. Zero if the subject is not tracked.
+  ///
+  int32_t AlphaBetaTracker::GetVelocity() const
+  {
+    if (!_tracking)
+      return 0;
+
+    return _velocity / Q16_ONE;
+  }
+
+  /// @brief Advances the position estimate by the elapsed time
+  ///
+  /// @param timeMs The current time in milliseconds
+  ///
+  /// @retval The elapsed time since the previous sample in milliseconds
+  ///
+  uint32_t AlphaBetaTracker::Advance(uint32_t timeMs)
+  {
+    uint32_t deltaT = timeMs - _lastTimeMs;
+    _lastTimeMs = timeMs;
+
+    // Two samples with the same timestamp are treated as being 1 ms apart
+    // so the velocity correction never divides by zero
+    if (deltaT == 0)
+      deltaT = 1;
+
+    // Guard against the velocity term overflowing after a long pause
+    if (deltaT > INT16_MAX)
+      deltaT = INT16_MAX;
+
+    _position = Q16Saturate((int64_t)_position + ((int64_t)_velocity * (int32_t)deltaT) / 1000);
+
+    return deltaT;
+  }
+}
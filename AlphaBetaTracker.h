@@ -0,0 +1,122 @@
+///
+/// @file AlphaBetaTracker.h
+///
+/// @brief AlphaBetaTracker class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_ALPHABETATRACKER_H_)
+#define _ALPHABETATRACKER_H_
+
+#include <stdint.h>
+#include "Result.h"
+
+namespace CNEGR
+{
+  /// @brief Q16.16 fixed-point type
+  ///
+  typedef int32_t Q16;
+
+  #define Q16_ONE             ((int32_t)1 << 16)
+  #define Q16_FROM_INT(x)     ((int32_t)(x) << 16)
+  #define Q16_FROM_RATIO(n,d) ((int32_t)(((int32_t)(n) << 16) / (d)))
+
+  /// @brief Fixed-point alpha-beta tracker estimating the subject position and velocity
+  ///
+  /// The tracker smooths the raw distance readings and derives the subject velocity
+  /// without using floating point arithmetic. All the internal values are kept in the
+  /// Q16.16 format, so positions up to ~32 m and velocities up to ~32 m/s can be tracked.
+  /// The estimates saturate at these limits instead of wrapping around.
+  ///
+  /// When a measurement is missing (i.e. the sensor timed out) the tracker predicts the
+  /// position from the last velocity estimate for up to maxPredictedSamples consecutive
+  /// samples, after which the track is considered lost.
+  ///
+  class AlphaBetaTracker
+  {
+  public:
+    struct Config
+    {
+      Q16     alpha;                  ///< The position correction gain in Q16.16 format, (0, 1]
+      Q16     beta;                   ///< The velocity correction gain in Q16.16 format, (0, 2)
+      uint8_t maxPredictedSamples;    ///< The maximum number of consecutive samples that can be
+                                      ///< predicted before the track is considered lost
+    };
+
+  public:
+    /// @brief Constructor.
+    AlphaBetaTracker();
+
+    /// @brief Destructor.
+    ~AlphaBetaTracker();
+
+  public:
+    /// @brief Initialization function.
+    ///
+    /// @param configuration      The configuration data.
+    ///
+    /// @retval RESULT_OK         The tracker was successfully configured.
+    /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+    ///
+    Result Init(const Config& configuration);
+
+    /// @brief Drops the current track. The next measurement will start a new track.
+    ///
+    void Reset();
+
+    /// @brief Updates the track with a new measurement
+    ///
+    /// @param timeMs             The time of the measurement in milliseconds
+    /// @param distanceMm         The measured distance in millimeters
+    ///
+    void Update(uint32_t timeMs, uint32_t distanceMm);
+
+    /// @brief Updates the track when the measurement is missing by predicting the
+    /// position from the velocity estimate
+    ///
+    /// @param timeMs             The time of the missed measurement in milliseconds
+    ///
+    void Predict(uint32_t timeMs);
+
+    /// @brief Get whether a subject is currently tracked
+    ///
+    /// @return boolean true if the tracker has a valid position estimate
+    ///
+    bool IsTracking() const;
+
+    /// @brief Gets the estimated distance
+    ///
+    /// @retval The estimated distance in millimeters or UINT32_MAX if the
+    /// subject is not tracked
+    ///
+    uint32_t GetDistance() const;
+
+    /// @brief Gets the estimated velocity
+    ///
+    /// @retval The estimated velocity in millimeters per second. A positive value means
+    /// that the subject is moving away from the sensor. Zero if the subject is not tracked.
+    ///
+    int32_t GetVelocity() const;
+
+  private:
+    /// @brief Advances the position estimate by the elapsed time
+    ///
+    /// @param timeMs The current time in milliseconds
+    ///
+    /// @retval The elapsed time since the previous sample in milliseconds
+    ///
+    uint32_t Advance(uint32_t timeMs);
+
+  private:
+    Config    _config;                ///< The tracker configuration
+    bool      _tracking;              ///< A flag to indicate whether a subject is tracked
+    uint8_t   _predictedSamples;      ///< The number of consecutive predicted samples
+    uint32_t  _lastTimeMs;            ///< The time of the previous sample in milliseconds
+    Q16       _position;              ///< The estimated position in millimeters (Q16.16)
+    Q16       _velocity;              ///< The estimated velocity in millimeters per second (Q16.16)
+  };
+}
+#endif // _ALPHABETATRACKER_H_
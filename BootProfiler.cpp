@@ -0,0 +1,113 @@
+///
+/// @file BootProfiler.cpp
+///
+/// @brief BootProfiler class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "BootProfiler.h"
+#include "DebugUtils.h"
+
+namespace CNEGR
+{
+  /// @brief Constructor.
+  BootProfiler::BootProfiler()
+    :_marked(0)
+  {
+    memset(_timesUs, 0, sizeof(_timesUs));
+  }
+
+  /// @brief Destructor.
+  BootProfiler::~BootProfiler()
+  {
+  }
+
+  /// @brief Records the time of a milestone, only the first call for each milestone counts
+  ///
+  /// @param milestone          The milestone reached
+  ///
+  void BootProfiler::Mark(Milestone milestone)
+  {
+    if ((milestone >= MilestoneCount) || IsMarked(milestone))
+      return;
+
+    _timesUs[milestone] = micros();
+    _marked |= (uint8_t)(1 << milestone);
+  }
+
+  /// @brief Get whether a milestone was reached
+  ///
+  /// @param milestone          The milestone
+  ///
+  /// @return boolean true if the milestone was reached
+  ///
+  bool BootProfiler::IsMarked(Milestone milestone) const
+  {
+    return (milestone < MilestoneCount) && ((_marked & (1 << milestone)) != 0);
+  }
+
+  /// @brief Gets the time of a milestone
+  ///
+  /// @param milestone          The milestone
+  /// @param timeUs             Contains the time since the reset in microseconds
+  ///
+  /// @retval RESULT_OK         The time was retrieved.
+  /// @retval RESULT_NO_DATA    The milestone was not reached yet.
+  /// @retval RESULT_BAD_PARAM  The milestone is invalid.
+  ///
+  Result BootProfiler::GetTime(Milestone milestone, uint32_t& timeUs) const
+  {
+    if (milestone >= MilestoneCount)
+      return RESULT_BAD_PARAM;
+
+    if (!IsMarked(milestone))
+      return RESULT_NO_DATA;
+
+    timeUs = _timesUs[milestone];
+    return RESULT_OK;
+  }
+
+  /// @brief Prints the milestones reached, one "name=time" line per milestone
+  ///
+  /// @param output             Where the milestones are printed
+  ///
+  void BootProfiler::Print(::Print& output) const
+  {
+    for (uint8_t milestone = 0; milestone < MilestoneCount; milestone++)
+    {
+      if (!IsMarked((Milestone)milestone))
+        continue;
+
+      output.print(ToString((Milestone)milestone));
+      output.print(F("="));
+      output.println(_timesUs[milestone]);
+    }
+  }
+
+  /// @brief Logs the milestones reached as a single line
+  ///
+  /// @note The milestones not reached yet are logged as 0.
+  ///
+  void BootProfiler::Log() const
+  {
+    Logger::Info(F("Boot times (us): serial=%lu config=%lu components=%lu setup=%lu measurement=%lu lights=%lu"),
+                 _timesUs[SerialReady], _timesUs[ConfigLoaded], _timesUs[ComponentsReady],
+                 _timesUs[SetupDone], _timesUs[FirstMeasurement], _timesUs[LightsTested]);
+  }
+
+  const __FlashStringHelper *BootProfiler::ToString(Milestone milestone)
+  {
+    switch (milestone)
+    {
+      case SerialReady:       return F("serial");
+      case ConfigLoaded:      return F("config");
+      case ComponentsReady:   return F("components");
+      case SetupDone:         return F("setup");
+      case FirstMeasurement:  return F("measurement");
+      case LightsTested:      return F("lights");
+      default:                return F("unknown");
+    }
+  }
+}
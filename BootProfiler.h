@@ -0,0 +1,94 @@
+///
+/// @file BootProfiler.h
+///
+/// @brief BootProfiler class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_BOOTPROFILER_H_)
+#define _BOOTPROFILER_H_
+
+#include <Arduino.h>
+#include "Result.h"
+
+namespace CNEGR
+{
+  /// @brief BootProfiler class definition
+  ///
+  /// Records the time of the boot milestones, from the reset to the first measurement.
+  /// The times are taken with micros(), which starts counting when the Arduino core is
+  /// initialized, right before setup(), so the time spent in the bootloader is not
+  /// included. Recording a milestone only stores a timestamp, the report is printed
+  /// later when the serial port is not needed by the boot anymore.
+  ///
+  class BootProfiler
+  {
+  public:
+    enum Milestone
+    {
+      SerialReady,                    ///< The serial port is initialized
+      ConfigLoaded,                   ///< The configuration is loaded from the EEPROM
+      ComponentsReady,                ///< The sensor, lights and state machine are initialized
+      SetupDone,                      ///< setup() returned
+      FirstMeasurement,               ///< The first state machine update completed, the lights show the distance
+      LightsTested,                   ///< The lights test completed
+      MilestoneCount
+    };
+
+  public:
+    /// @brief Constructor.
+    BootProfiler();
+
+    /// @brief Destructor.
+    ~BootProfiler();
+
+  public:
+    /// @brief Records the time of a milestone, only the first call for each milestone counts
+    ///
+    /// @param milestone          The milestone reached
+    ///
+    void Mark(Milestone milestone);
+
+    /// @brief Get whether a milestone was reached
+    ///
+    /// @param milestone          The milestone
+    ///
+    /// @return boolean true if the milestone was reached
+    ///
+    bool IsMarked(Milestone milestone) const;
+
+    /// @brief Gets the time of a milestone
+    ///
+    /// @param milestone          The milestone
+    /// @param timeUs             Contains the time since the reset in microseconds
+    ///
+    /// @retval RESULT_OK         The time was retrieved.
+    /// @retval RESULT_NO_DATA    The milestone was not reached yet.
+    /// @retval RESULT_BAD_PARAM  The milestone is invalid.
+    ///
+    Result GetTime(Milestone milestone, uint32_t& timeUs) const;
+
+    /// @brief Prints the milestones reached, one "name=time" line per milestone
+    ///
+    /// @param output             Where the milestones are printed
+    ///
+    void Print(::Print& output) const;
+
+    /// @brief Logs the milestones reached as a single line
+    ///
+    /// @note The milestones not reached yet are logged as 0.
+    ///
+    void Log() const;
+
+  private:
+    static const __FlashStringHelper *ToString(Milestone milestone);
+
+  private:
+    uint32_t  _timesUs[MilestoneCount];           ///< The time of every milestone in microseconds
+    uint8_t   _marked;                            ///< One bit per milestone reached
+  };
+}
+#endif // _BOOTPROFILER_H_
@@ -0,0 +1,102 @@
+///
+/// @file Cobs.cpp
+///
+/// @brief Consistent Overhead Byte Stuffing (COBS) functions
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "Cobs.h"
+
+namespace CNEGR
+{
+  /// @brief Encodes a buffer so that it doesn't contain any zero byte
+  ///
+  /// @note The delimiter is not added to the encoded data
+  ///
+  /// @param data           The data to encode
+  /// @param length         The data length in bytes
+  /// @param encoded        The buffer receiving the encoded data,
+  ///                       at least COBS_MAX_ENCODED_LENGTH(length) bytes long
+  ///
+  /// @retval The encoded length in bytes
+  ///
+  size_t CobsEncode(const uint8_t *data, size_t length, uint8_t *encoded)
+  {
+    // Each block starts with a code byte holding the distance to the next zero
+    size_t  codeIndex = 0;
+    size_t  out       = 1;
+    uint8_t code      = 1;
+
+    for (size_t i = 0; i < length; i++)
+    {
+      if (data[i] == 0)
+      {
+        encoded[codeIndex] = code;
+        codeIndex = out++;
+        code = 1;
+      }
+      else
+      {
+        encoded[out++] = data[i];
+        code++;
+
+        // A block holds at most 254 data bytes
+        if ((code == 0xFF) && (i + 1 < length))
+        {
+          encoded[codeIndex] = code;
+          codeIndex = out++;
+          code = 1;
+        }
+      }
+    }
+
+    encoded[codeIndex] = code;
+
+    return out;
+  }
+
+  /// @brief Decodes a COBS encoded buffer
+  ///
+  /// @note The buffer must not include the delimiter. The data can be
+  /// decoded in place, i.e. decoded may be the same as encoded.
+  ///
+  /// @param encoded          The encoded data
+  /// @param length           The encoded data length in bytes
+  /// @param decoded          The buffer receiving the decoded data, at least length bytes long
+  /// @param decodedLength    Contains the decoded length in bytes if successful
+  ///
+  /// @retval RESULT_OK         The data was successfully decoded.
+  /// @retval RESULT_PARSE_ERROR The data is not a valid COBS encoding.
+  ///
+  Result CobsDecode(const uint8_t *encoded, size_t length, uint8_t *decoded, size_t& decodedLength)
+  {
+    size_t in  = 0;
+    size_t out = 0;
+
+    while (in < length)
+    {
+      uint8_t code = encoded[in++];
+
+      if ((code == 0) || (in + code - 1 > length))
+        return RESULT_PARSE_ERROR;
+
+      for (uint8_t i = 1; i < code; i++)
+      {
+        if (encoded[in] == 0)
+          return RESULT_PARSE_ERROR;
+
+        decoded[out++] = encoded[in++];
+      }
+
+      // A full block is not followed by an implicit zero, neither is the last block
+      if ((code != 0xFF) && (in < length))
+        decoded[out++] = 0;
+    }
+
+    decodedLength = out;
+
+    return RESULT_OK;
+  }
+}
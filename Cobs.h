@@ -0,0 +1,54 @@
+///
+/// @file Cobs.h
+///
+/// @brief Consistent Overhead Byte Stuffing (COBS) functions
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_COBS_H_)
+#define _COBS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Result.h"
+
+namespace CNEGR
+{
+  /// The byte used to delimit the encoded frames, it never appears inside an encoded frame
+  #define COBS_DELIMITER 0x00
+
+  /// The maximum encoded length of a buffer of the given length, without the delimiter
+  #define COBS_MAX_ENCODED_LENGTH(length) ((length) + ((length) / 254) + 1)
+
+  /// @brief Encodes a buffer so that it doesn't contain any zero byte
+  ///
+  /// @note The delimiter is not added to the encoded data
+  ///
+  /// @param data           The data to encode
+  /// @param length         The data length in bytes
+  /// @param encoded        The buffer receiving the encoded data,
+  ///                       at least COBS_MAX_ENCODED_LENGTH(length) bytes long
+  ///
+  /// @retval The encoded length in bytes
+  ///
+  size_t CobsEncode(const uint8_t *data, size_t length, uint8_t *encoded);
+
+  /// @brief Decodes a COBS encoded buffer
+  ///
+  /// @note The buffer must not include the delimiter. The data can be
+  /// decoded in place, i.e. decoded may be the same as encoded.
+  ///
+  /// @param encoded          The encoded data
+  /// @param length           The encoded data length in bytes
+  /// @param decoded          The buffer receiving the decoded data, at least length bytes long
+  /// @param decodedLength    Contains the decoded length in bytes if successful
+  ///
+  /// @retval RESULT_OK         The data was successfully decoded.
+  /// @retval RESULT_PARSE_ERROR The data is not a valid COBS encoding.
+  ///
+  Result CobsDecode(const uint8_t *encoded, size_t length, uint8_t *decoded, size_t& decodedLength);
+}
+#endif // _COBS_H_
@@ -12,10 +12,28 @@
 #if !defined(_COMMONDEFINES_H_)
 #define _COMMONDEFINES_H_
 
+#include <stdint.h>
+
 namespace CNEGR
 {
   #define MAX_COMPONENT_NAME_LENGTH 32
 
+  /// @brief A millisecond clock, millis() or a simulated clock
+  ///
+  typedef uint32_t (*ClockProc)();
+
+  /// @brief Reads the ambient conditions, from a temperature and humidity sensor
+  ///
+  /// @note It is called before every measurement, it must return quickly, e.g. the
+  /// last reading of a sensor polled elsewhere.
+  ///
+  /// @param ambientTemperature Contains the ambient temperature in deci-degrees celsius
+  /// @param relativeHumidity   Contains the relative humidity in percent
+  ///
+  /// @retval true if the values are valid, false to use the defaults
+  ///
+  typedef bool (*AmbientProc)(int32_t& ambientTemperature, uint32_t& relativeHumidity);
+
   enum SignalPolarity
   {
     ActiveHigh,
@@ -0,0 +1,229 @@
+///
+/// @file ConfigStore.cpp
+///
+/// @brief ConfigStore class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include <EEPROM.h>
+#include "ConfigStore.h"
+#include "CommonDefines.h"
+#include "Crc16.h"
+
+namespace CNEGR
+{
+  /// @brief Constructor.
+  ConfigStore::ConfigStore(uint16_t baseAddress,   ///< The EEPROM address of the first slot
+                           uint8_t  slotCount      ///< The number of slots, at least 2
+                          )
+    :_baseAddress(baseAddress),
+     _slotCount(slotCount),
+     _currentSlot(-1),
+     _currentSequence(0),
+     _loadDurationUs(0)
+  {
+  }
+
+  /// @brief Destructor.
+  ConfigStore::~ConfigStore()
+  {
+  }
+
+  /// @brief Loads the most recently saved configuration
+  ///
+  /// @note The execution time is bounded, every slot is read exactly once
+  ///
+  /// @param config             Contains the configuration if it was successfully loaded.
+  ///
+  /// @retval RESULT_OK         The configuration was successfully loaded.
+  /// @retval RESULT_NO_DATA    No configuration was ever saved.
+  /// @retval RESULT_CRC_ERROR  All the saved configurations are corrupted.
+  /// @retval RESULT_NOT_VALID  The saved configuration has a different schema version.
+  /// @retval RESULT_NO_MEM     The slots don't fit in the EEPROM.
+  ///
+  Result ConfigStore::Load(PersistentConfig& config)
+  {
+    uint32_t startTime = micros();
+
+    if ((uint32_t)GetSlotAddress(_slotCount) > EEPROM.length())
+      return RESULT_NO_MEM;
+
+    // Report the "most serious" problem found if no slot is valid
+    Result result = RESULT_NO_DATA;
+
+    _currentSlot = -1;
+    _currentSequence = 0;
+
+    for (uint8_t slot = 0; slot < _slotCount; slot++)
+    {
+      SlotHeader header;
+      PersistentConfig candidate;
+
+      Result slotResult = ReadSlot(slot, header, candidate);
+
+      if (slotResult == RESULT_OK)
+      {
+        // Keep the most recent slot, the sequence number may wrap around
+        if ((_currentSlot < 0) || ((int16_t)(header.sequence - _currentSequence) > 0))
+        {
+          _currentSlot = slot;
+          _currentSequence = header.sequence;
+          config = candidate;
+        }
+      }
+      else if ((slotResult == RESULT_NOT_VALID) || ((slotResult == RESULT_CRC_ERROR) && (result == RESULT_NO_DATA)))
+      {
+        result = slotResult;
+      }
+    }
+
+    if (_currentSlot >= 0)
+      result = RESULT_OK;
+
+    _loadDurationUs = micros() - startTime;
+
+    return result;
+  }
+
+  /// @brief Saves the configuration in the next slot
+  ///
+  /// @note Load() should be called first, otherwise the most recent
+  /// configuration may be overwritten.
+  ///
+  /// @param config             The configuration to save.
+  ///
+  /// @retval RESULT_OK         The configuration was successfully saved.
+  /// @retval RESULT_BAD_PARAM  The configuration failed validation.
+  /// @retval RESULT_NO_MEM     The slots don't fit in the EEPROM.
+  /// @retval RESULT_HW_FAILURE The configuration read back doesn't match.
+  ///
+  Result ConfigStore::Save(const PersistentConfig& config)
+  {
+    if (Validate(config) != RESULT_OK)
+      return RESULT_BAD_PARAM;
+
+    if ((uint32_t)GetSlotAddress(_slotCount) > EEPROM.length())
+      return RESULT_NO_MEM;
+
+    // Never overwrite the most recent slot
+    uint8_t slot = (_currentSlot < 0) ? 0 : (uint8_t)((_currentSlot + 1) % _slotCount);
+
+    SlotHeader header;
+    header.version  = PERSISTENT_CONFIG_VERSION;
+    header.size     = sizeof(PersistentConfig);
+    header.sequence = _currentSequence + 1;
+    header.crc      = CalculateCrc(header, config);
+
+    uint16_t address = GetSlotAddress(slot);
+
+    // Write the data first and the header last, update() only writes
+    // the bytes that changed which saves EEPROM write cycles
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(&config);
+    for (uint8_t i = 0; i < sizeof(PersistentConfig); i++)
+      EEPROM.update(address + sizeof(SlotHeader) + i, data[i]);
+
+    const uint8_t *headerData = reinterpret_cast<const uint8_t *>(&header);
+    for (uint8_t i = 0; i < sizeof(SlotHeader); i++)
+      EEPROM.update(address + i, headerData[i]);
+
+    // Read back the slot to make sure it was written correctly
+    SlotHeader readHeader;
+    PersistentConfig readConfig;
+    if ((ReadSlot(slot, readHeader, readConfig) != RESULT_OK) || (readHeader.sequence != header.sequence))
+      return RESULT_HW_FAILURE;
+
+    _currentSlot = slot;
+    _currentSequence = header.sequence;
+
+    return RESULT_OK;
+  }
+
+  /// @brief Gets the duration of the last Load()
+  ///
+  /// @retval The duration in microseconds
+  ///
+  uint32_t ConfigStore::GetLoadDurationUs() const
+  {
+    return _loadDurationUs;
+  }
+
+  /// @brief Checks the configuration values
+  ///
+  /// @param config             The configuration to check.
+  ///
+  /// @retval RESULT_OK         The configuration is valid.
+  /// @retval RESULT_NOT_VALID  The thresholds are not ordered or a filter configuration is invalid.
+  ///
+  Result ConfigStore::Validate(const PersistentConfig& config)
+  {
+    if ((config.nearThresholdMm >= config.farThresholdMm) || (config.farThresholdMm >= config.maxDistanceThresholdMm))
+      return RESULT_NOT_VALID;
+
+    if ((config.lightsPolarity != SignalPolarity::ActiveHigh) && (config.lightsPolarity != SignalPolarity::ActiveLow))
+      return RESULT_NOT_VALID;
+
+    // Let the components validate their own configuration
+    HampelFilter outlierFilter;
+    if (outlierFilter.Init(config.outlierFilter) != RESULT_OK)
+      return RESULT_NOT_VALID;
+
+    TargetClassifier classifier;
+    if (classifier.Init(config.classifier) != RESULT_OK)
+      return RESULT_NOT_VALID;
+
+    AlphaBetaTracker tracker;
+    if (tracker.Init(config.tracker) != RESULT_OK)
+      return RESULT_NOT_VALID;
+
+    return RESULT_OK;
+  }
+
+  /// @brief Gets the EEPROM address of a slot
+  ///
+  uint16_t ConfigStore::GetSlotAddress(uint8_t slot) const
+  {
+    return _baseAddress + (uint16_t)slot * (sizeof(SlotHeader) + sizeof(PersistentConfig));
+  }
+
+  /// @brief Reads a slot header and checks the slot CRC
+  ///
+  /// @retval RESULT_OK         The slot is valid.
+  /// @retval RESULT_NO_DATA    The slot was never written.
+  /// @retval RESULT_CRC_ERROR  The slot is corrupted.
+  /// @retval RESULT_NOT_VALID  The slot has a different schema version.
+  ///
+  Result ConfigStore::ReadSlot(uint8_t slot, SlotHeader& header, PersistentConfig& config) const
+  {
+    uint16_t address = GetSlotAddress(slot);
+
+    uint8_t *headerData = reinterpret_cast<uint8_t *>(&header);
+    for (uint8_t i = 0; i < sizeof(SlotHeader); i++)
+      headerData[i] = EEPROM.read(address + i);
+
+    // An erased EEPROM reads as all ones
+    if ((header.version == 0xFF) && (header.size == 0xFF))
+      return RESULT_NO_DATA;
+
+    if ((header.version != PERSISTENT_CONFIG_VERSION) || (header.size != sizeof(PersistentConfig)))
+      return RESULT_NOT_VALID;
+
+    uint8_t *data = reinterpret_cast<uint8_t *>(&config);
+    for (uint8_t i = 0; i < sizeof(PersistentConfig); i++)
+      data[i] = EEPROM.read(address + sizeof(SlotHeader) + i);
+
+    if (CalculateCrc(header, config) != header.crc)
+      return RESULT_CRC_ERROR;
+
+    return RESULT_OK;
+  }
+
+  /// @brief Calculates the CRC of a slot header (except the CRC field) and data
+  ///
+  uint16_t ConfigStore::CalculateCrc(const SlotHeader& header, const PersistentConfig& config)
+  {
+    uint16_t crc = Crc16(&header, offsetof(SlotHeader, crc));
+    return Crc16(&config, sizeof(PersistentConfig), crc);
+  }
+}
@@ -0,0 +1,153 @@
+///
+/// @file ConfigStore.h
+///
+/// @brief ConfigStore class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_CONFIGSTORE_H_)
+#define _CONFIGSTORE_H_
+
+#include <Arduino.h>
+#include "Result.h"
+#include "HampelFilter.h"
+#include "TargetClassifier.h"
+#include "AlphaBetaTracker.h"
+
+namespace CNEGR
+{
+  /// The configuration schema version. Must be incremented every time
+  /// the PersistentConfig structure changes.
+  #define PERSISTENT_CONFIG_VERSION 1
+
+  /// @brief The application configuration saved in the EEPROM
+  ///
+  struct PersistentConfig
+  {
+    uint8_t   triggerPin;                             ///< The distance sensor trigger GPIO pin number
+    uint8_t   echoPin;                                ///< The distance sensor echo GPIO pin number
+    uint8_t   redLightPin;                            ///< The GPIO pin number to control the Red light
+    uint8_t   yellowLightPin;                         ///< The GPIO pin number to control the Yellow light
+    uint8_t   greenLightPin;                          ///< The GPIO pin number to control the Green light
+    uint8_t   lightsPolarity;                         ///< The polarity of the lights GPIO pins (SignalPolarity)
+    uint32_t  maxDistanceThresholdMm;                 ///< See StateMachine::Config
+    uint32_t  farThresholdMm;                         ///< See StateMachine::Config
+    uint32_t  nearThresholdMm;                        ///< See StateMachine::Config
+    uint32_t  movingDistanceDetectionThresholdMm;     ///< See StateMachine::Config
+    uint32_t  movingTimeThresholdMs;                  ///< See StateMachine::Config
+    uint32_t  holdingTimeThresholdMs;                 ///< See StateMachine::Config
+    HampelFilter::Config      outlierFilter;          ///< See StateMachine::Config
+    TargetClassifier::Config  classifier;             ///< See StateMachine::Config
+    AlphaBetaTracker::Config  tracker;                ///< See StateMachine::Config
+  };
+
+  /// @brief ConfigStore class definition
+  ///
+  /// Saves the PersistentConfig in the EEPROM. The EEPROM area is divided into slots and
+  /// each save goes to the slot following the most recent one, which spreads the wear
+  /// over all the slots. Every slot has a header with the schema version, a sequence
+  /// number and a CRC covering the header and the data.
+  ///
+  /// The data is written before the header, so a save interrupted by a power loss leaves
+  /// a slot with a bad CRC and the previous slot is loaded instead. At least two slots
+  /// are needed for this to work.
+  ///
+  class ConfigStore
+  {
+  public:
+    /// @brief Constructor.
+    ConfigStore(uint16_t baseAddress,   ///< The EEPROM address of the first slot
+                uint8_t  slotCount      ///< The number of slots, at least 2
+               );
+
+    /// @brief Destructor.
+    ~ConfigStore();
+
+  public:
+    /// @brief Loads the most recently saved configuration
+    ///
+    /// @note The execution time is bounded, every slot is read exactly once
+    ///
+    /// @param config             Contains the configuration if it was successfully loaded.
+    ///
+    /// @retval RESULT_OK         The configuration was successfully loaded.
+    /// @retval RESULT_NO_DATA    No configuration was ever saved.
+    /// @retval RESULT_CRC_ERROR  All the saved configurations are corrupted.
+    /// @retval RESULT_NOT_VALID  The saved configuration has a different schema version.
+    /// @retval RESULT_NO_MEM     The slots don't fit in the EEPROM.
+    ///
+    Result Load(PersistentConfig& config);
+
+    /// @brief Saves the configuration in the next slot
+    ///
+    /// @note Load() should be called first, otherwise the most recent
+    /// configuration may be overwritten.
+    ///
+    /// @param config             The configuration to save.
+    ///
+    /// @retval RESULT_OK         The configuration was successfully saved.
+    /// @retval RESULT_BAD_PARAM  The configuration failed validation.
+    /// @retval RESULT_NO_MEM     The slots don't fit in the EEPROM.
+    /// @retval RESULT_HW_FAILURE The configuration read back doesn't match.
+    ///
+    Result Save(const PersistentConfig& config);
+
+    /// @brief Gets the duration of the last Load()
+    ///
+    /// @retval The duration in microseconds
+    ///
+    uint32_t GetLoadDurationUs() const;
+
+    /// @brief Checks the configuration values
+    ///
+    /// @param config             The configuration to check.
+    ///
+    /// @retval RESULT_OK         The configuration is valid.
+    /// @retval RESULT_NOT_VALID  The thresholds are not ordered or a filter configuration is invalid.
+    ///
+    static Result Validate(const PersistentConfig& config);
+
+  private:
+    /// @brief The slot header
+    ///
+    struct SlotHeader
+    {
+      uint8_t   version;                ///< The schema version
+      uint8_t   size;                   ///< The size of the data following the header
+      uint16_t  sequence;               ///< Incremented on each save, identifies the most recent slot
+      uint16_t  crc;                    ///< The CRC of the version, size, sequence and data
+    };
+
+    /// @brief Gets the EEPROM address of a slot
+    ///
+    uint16_t GetSlotAddress(uint8_t slot) const;
+
+    /// @brief Reads a slot header and checks the slot CRC
+    ///
+    /// @retval RESULT_OK         The slot is valid.
+    /// @retval RESULT_NO_DATA    The slot was never written.
+    /// @retval RESULT_CRC_ERROR  The slot is corrupted.
+    /// @retval RESULT_NOT_VALID  The slot has a different schema version.
+    ///
+    Result ReadSlot(uint8_t slot, SlotHeader& header, PersistentConfig& config) const;
+
+    /// @brief Calculates the CRC of a slot header (except the CRC field) and data
+    ///
+    static uint16_t CalculateCrc(const SlotHeader& header, const PersistentConfig& config);
+
+  private:
+    /// @brief Default Constructor.
+    ConfigStore();
+
+  private:
+    uint16_t  _baseAddress;             ///< The EEPROM address of the first slot
+    uint8_t   _slotCount;               ///< The number of slots
+    int16_t   _currentSlot;             ///< The most recent valid slot, -1 if none
+    uint16_t  _currentSequence;         ///< The sequence number of the most recent valid slot
+    uint32_t  _loadDurationUs;          ///< The duration of the last Load()
+  };
+}
+#endif // _CONFIGSTORE_H_
@@ -0,0 +1,173 @@
+///
+/// @file Console.cpp
+///
+/// @brief Console class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "Console.h"
+
+namespace CNEGR
+{
+  /// @brief Constructor.
+  Console::Console()
+    :_stream(nullptr),
+     _commands(nullptr),
+     _commandCount(0),
+     _length(0),
+     _overflow(false),
+     _pending(false)
+  {
+    _line[0] = '\0';
+  }
+
+  /// @brief Destructor.
+  Console::~Console()
+  {
+  }
+
+  /// @brief Initialization function.
+  ///
+  /// @param stream             The stream used to read the commands and print the output
+  /// @param commands           The command table, must remain valid while the console is used
+  /// @param commandCount       The number of commands in the table
+  ///
+  /// @retval RESULT_OK         The console was successfully initialized.
+  /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+  ///
+  Result Console::Init(Stream *stream, const Command *commands, uint8_t commandCount)
+  {
+    if ((stream == nullptr) || (commands == nullptr) || (commandCount == 0))
+      return RESULT_BAD_PARAM;
+
+    _stream       = stream;
+    _commands     = commands;
+    _commandCount = commandCount;
+    _length       = 0;
+    _overflow     = false;
+    _pending      = false;
+
+    return RESULT_OK;
+  }
+
+  /// @brief Reads the available characters without blocking
+  ///
+  /// @note Nothing is read while a command is pending, the characters
+  /// are left in the stream buffer until the command is executed
+  ///
+  void Console::Poll()
+  {
+    if (_stream == nullptr)
+      return;
+
+    while (!_pending && (_stream->available() > 0))
+    {
+      int c = _stream->read();
+
+      if ((c == '\r') || (c == '\n'))
+      {
+        // Ignore empty lines, this also takes care of "\r\n" line endings
+        if ((_length != 0) || _overflow)
+        {
+          _line[_length] = '\0';
+          _pending = true;
+        }
+      }
+      else if (_length < (CONSOLE_LINE_LENGTH - 1))
+      {
+        _line[_length++] = (char)c;
+      }
+      else
+      {
+        // Keep consuming the line but remember that it didn't fit
+        _overflow = true;
+      }
+    }
+  }
+
+  /// @brief Get whether a complete command line was received
+  ///
+  /// @return boolean true if a command is waiting to be executed
+  ///
+  bool Console::IsCommandPending() const
+  {
+    return _pending;
+  }
+
+  /// @brief Executes the pending command, if any, and prints the result
+  ///
+  /// @retval RESULT_OK         The command was successful.
+  /// @retval RESULT_NO_DATA    There was no pending command.
+  /// @retval RESULT_NOT_SUP    The command is unknown.
+  /// @retval RESULT_OVERFLOW   The command line was too long or had too many arguments.
+  /// @retval Any error returned by the command handler
+  ///
+  Result Console::Execute()
+  {
+    if (!_pending)
+      return RESULT_NO_DATA;
+
+    Result result = RESULT_OK;
+
+    // Split the line into space separated arguments
+    char *argv[CONSOLE_MAX_ARGS];
+    uint8_t argc = 0;
+
+    char *p = _line;
+    while ((*p != '\0') && (result == RESULT_OK))
+    {
+      while (*p == ' ')
+        *p++ = '\0';
+
+      if (*p == '\0')
+        break;
+
+      if (argc == CONSOLE_MAX_ARGS)
+      {
+        result = RESULT_OVERFLOW;
+        break;
+      }
+
+      argv[argc++] = p;
+
+      while ((*p != ' ') && (*p != '\0'))
+        p++;
+    }
+
+    if (_overflow)
+      result = RESULT_OVERFLOW;
+
+    if ((result == RESULT_OK) && (argc != 0))
+    {
+      result = RESULT_NOT_SUP;
+
+      for (uint8_t i = 0; i < _commandCount; i++)
+      {
+        if (strcmp(argv[0], _commands[i].name) == 0)
+        {
+          result = _commands[i].proc(*_stream, argc, argv);
+          break;
+        }
+      }
+    }
+
+    if (result == RESULT_OK)
+    {
+      _stream->println(F("OK"));
+    }
+    else
+    {
+      _stream->print(F("ERR "));
+      _stream->println(ResultToStr(result));
+    }
+
+    // Get ready for the next line
+    _length   = 0;
+    _overflow = false;
+    _pending  = false;
+
+    return result;
+  }
+}
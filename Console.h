@@ -0,0 +1,100 @@
+///
+/// @file Console.h
+///
+/// @brief Console class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_CONSOLE_H_)
+#define _CONSOLE_H_
+
+#include <Arduino.h>
+#include "Result.h"
+
+namespace CNEGR
+{
+  #define CONSOLE_LINE_LENGTH   48    ///< The maximum command line length including the terminator
+  #define CONSOLE_MAX_ARGS      4     ///< The maximum number of arguments including the command name
+
+  /// @brief Console class definition
+  ///
+  /// A line oriented command console. The characters are read from the stream without
+  /// blocking, as they become available, and a command is executed only when Execute() is
+  /// called. This lets the application decide when the command runs so that it doesn't
+  /// interfere with the measurements.
+  ///
+  class Console
+  {
+  public:
+    /// @brief Command handler function
+    ///
+    /// @param output   The stream where the command output should be printed
+    /// @param argc     The number of arguments, including the command name
+    /// @param argv     The arguments, argv[0] is the command name
+    ///
+    /// @retval RESULT_OK when the command was successful or an error code otherwise
+    ///
+    typedef Result (*CommandProc)(Print& output, uint8_t argc, char *argv[]);
+
+    struct Command
+    {
+      const char  *name;              ///< The command name
+      CommandProc proc;               ///< The command handler
+    };
+
+  public:
+    /// @brief Constructor.
+    Console();
+
+    /// @brief Destructor.
+    ~Console();
+
+  public:
+    /// @brief Initialization function.
+    ///
+    /// @param stream             The stream used to read the commands and print the output
+    /// @param commands           The command table, must remain valid while the console is used
+    /// @param commandCount       The number of commands in the table
+    ///
+    /// @retval RESULT_OK         The console was successfully initialized.
+    /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+    ///
+    Result Init(Stream *stream, const Command *commands, uint8_t commandCount);
+
+    /// @brief Reads the available characters without blocking
+    ///
+    /// @note Nothing is read while a command is pending, the characters
+    /// are left in the stream buffer until the command is executed
+    ///
+    void Poll();
+
+    /// @brief Get whether a complete command line was received
+    ///
+    /// @return boolean true if a command is waiting to be executed
+    ///
+    bool IsCommandPending() const;
+
+    /// @brief Executes the pending command, if any, and prints the result
+    ///
+    /// @retval RESULT_OK         The command was successful.
+    /// @retval RESULT_NO_DATA    There was no pending command.
+    /// @retval RESULT_NOT_SUP    The command is unknown.
+    /// @retval RESULT_OVERFLOW   The command line was too long or had too many arguments.
+    /// @retval Any error returned by the command handler
+    ///
+    Result Execute();
+
+  private:
+    Stream        *_stream;                       ///< The console stream
+    const Command *_commands;                     ///< The command table
+    uint8_t       _commandCount;                  ///< The number of commands in the table
+    char          _line[CONSOLE_LINE_LENGTH];     ///< The command line buffer
+    uint8_t       _length;                        ///< The number of characters in the buffer
+    bool          _overflow;                      ///< A flag to indicate that the line didn't fit in the buffer
+    bool          _pending;                       ///< A flag to indicate that a complete line was received
+  };
+}
+#endif // _CONSOLE_H_
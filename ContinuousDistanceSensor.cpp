@@ -0,0 +1,322 @@
+///
+/// @file ContinuousDistanceSensor.cpp
+///
+/// @brief ContinuousDistanceSensor class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "ContinuousDistanceSensor.h"
+#include "DebugUtils.h"
+#include "SpeedOfSound.h"
+
+namespace CNEGR
+{
+  /// @brief Constructor.
+  ContinuousDistanceSensor::ContinuousDistanceSensor(IDistanceSensor  *sensor,                  ///< The sensor pinged continuously
+                                                     uint32_t         cycleTimeMs,              ///< The minimum time between two pings in milliseconds
+                                                     uint32_t         ghostShiftMs,             ///< The time added to every other cycle in milliseconds
+                                                     uint32_t         ghostToleranceMm,         ///< The largest difference between a reading and its confirmation
+                                                     ClockProc        clock                     ///< The clock pacing the pings, nullptr for millis()
+                                                    )
+    :_initDone(false),
+     _sensor(sensor),
+     _cycleTimeMs(cycleTimeMs),
+     _ghostShiftMs(ghostShiftMs),
+     _ghostToleranceMm(ghostToleranceMm),
+     _clock(clock),
+     _lastPingTimeMs(0),
+     _shiftedCycle(false),
+     _pingResult(RESULT_OK),
+     _pingDistance(0),
+     _tracking(false),
+     _candidate(false),
+     _candidateDistance(0),
+     _sampleReady(false),
+     _sampleResult(RESULT_OK),
+     _sampleDistance(0)
+  {
+    _name[0] = '\0';
+    memset(&_statistics, 0, sizeof(_statistics));
+    PT_INIT(&_pinging);
+  }
+
+  /// @brief Destructor.
+  ContinuousDistanceSensor::~ContinuousDistanceSensor()
+  {
+    Deinit();
+  }
+
+  /// @brief Initialization function.
+  ///
+  /// @note The sensor must be initialized before calling this method
+  ///
+  /// @param configuration      The configuration data. Only the name is used.
+  ///
+  /// @retval RESULT_OK         The device was successfully configured.
+  /// @retval RESULT_BUSY       The  device was already configured.
+  ///                           Deinit() must be called before calling Init() again.
+  /// @retval RESULT_DEV_ERR    The sensor is not initialized.
+  /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+  ///
+  Result ContinuousDistanceSensor::Init(const Config& configuration)
+  {
+    if (IsInitialized())
+    {
+      // Already initialized
+      return RESULT_BUSY;
+    }
+
+    if ((configuration.name == NULL) || (_sensor == nullptr) || (_cycleTimeMs == 0))
+    {
+      // Invalid name, sensor or cycle
+      return RESULT_BAD_PARAM;
+    }
+
+    if (!_sensor->IsInitialized())
+    {
+      return RESULT_DEV_ERR;
+    }
+
+    // Copy the name
+    strncpy((char *)(&_name[0]), configuration.name, sizeof(_name)-1);
+
+    // The first ping starts right away
+    _lastPingTimeMs = GetTime() - _cycleTimeMs - _ghostShiftMs;
+    _shiftedCycle   = false;
+    _tracking       = false;
+    _candidate      = false;
+    _sampleReady    = false;
+    memset(&_statistics, 0, sizeof(_statistics));
+    PT_INIT(&_pinging);
+
+    // Set the init done flag
+    _initDone = true;
+    return RESULT_OK;
+  }
+
+  /// @brief Get whether the sensor device was initialized
+  ///
+  /// @return boolean true if it is initialized
+  /// and available for use
+  bool ContinuousDistanceSensor::IsInitialized() const
+  {
+    return _initDone;
+  }
+
+  /// @brief Deinitialization function for the device.
+  ///
+  /// @note The sensor is not deinitialized
+  ///
+  void ContinuousDistanceSensor::Deinit()
+  {
+    // Clear the name
+    _name[0] = '\0';
+
+    // And reset the init done flag
+    _initDone = false;
+  }
+
+  /// @brief Measures the distance.
+  ///
+  /// @note Waits for the next sample.
+  ///
+  /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+  ///                           of error state.
+  Result ContinuousDistanceSensor::MeasureDistance(uint32_t& distance)
+  {
+    const uint32_t ambientTemperature = 20 * 10;
+    return MeasureDistance(ambientTemperature, distance);
+  }
+
+  /// @brief Measures the distance and adjusts the result for the ambient temperature.
+  ///
+  /// @note Waits for the next sample.
+  ///
+  /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+  /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+  ///                           of error state.
+  Result ContinuousDistanceSensor::MeasureDistance(uint32_t ambientTemperature, uint32_t& distance)
+  {
+    return MeasureDistance(ambientTemperature, DEFAULT_RELATIVE_HUMIDITY, distance);
+  }
+
+  /// @brief Measures the distance and adjusts the result for the ambient temperature and relative humidity.
+  ///
+  /// @note Waits for the next sample. Temperatures below zero are passed as the two's
+  /// complement of the value.
+  ///
+  /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+  /// @param relativeHumidity   The relative humidity in percent
+  /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+  ///                           of error state.
+  Result ContinuousDistanceSensor::MeasureDistance(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance)
+  {
+    Result result = RESULT_BUSY;
+
+    while (result == RESULT_BUSY)
+      result = MeasureDistanceAsync(ambientTemperature, relativeHumidity, distance);
+
+    return result;
+  }
+
+  /// @brief Gets the latest sample without blocking.
+  ///
+  /// @note Every call advances the pings, the method must be called continuously.
+  /// The temperature and humidity are used from the next ping on. A sample that is
+  /// not retrieved before the next one completes is lost.
+  ///
+  /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+  /// @param relativeHumidity   The relative humidity in percent
+  /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_BUSY       No new sample is available yet.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+  ///                           of error state.
+  Result ContinuousDistanceSensor::MeasureDistanceAsync(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    if (Ping(ambientTemperature, relativeHumidity) == RESULT_OK)
+      ProcessPing();
+
+    if (!_sampleReady)
+      return RESULT_BUSY;
+
+    _sampleReady = false;
+    distance = _sampleDistance;
+    return _sampleResult;
+  }
+
+  /// @brief Limits the range of the measurements
+  ///
+  /// @note The limit is applied to the sensor pinged continuously.
+  ///
+  /// @param rangeLimitMm       The range limit in millimeters, 0 to use the full range
+  ///
+  /// @retval RESULT_OK         The range limit was changed.
+  /// @retval RESULT_NOT_READY  The sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_BAD_PARAM  The range limit is below the minimum distance the sensor can detect.
+  ///
+  Result ContinuousDistanceSensor::SetRangeLimit(uint32_t rangeLimitMm)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    return _sensor->SetRangeLimit(rangeLimitMm);
+  }
+
+  /// @brief Gets the counters collected since Init()
+  ///
+  /// @param statistics         Contains the counters
+  ///
+  void ContinuousDistanceSensor::GetStatistics(Statistics& statistics) const
+  {
+    statistics = _statistics;
+  }
+
+  /// @brief Pings the sensor once the cycle has elapsed
+  ///
+  /// @retval RESULT_OK         A ping completed.
+  /// @retval RESULT_BUSY       The ping is in progress or the cycle has not elapsed yet.
+  ///
+  Result ContinuousDistanceSensor::Ping(uint32_t ambientTemperature, uint32_t relativeHumidity)
+  {
+    PT_BEGIN(&_pinging);
+
+    // Every other cycle is longer so that the ghosts move from one ping to the next
+    PT_WAIT_UNTIL(&_pinging, GetTime() - _lastPingTimeMs >= _cycleTimeMs + (_shiftedCycle ? _ghostShiftMs : 0));
+
+    _lastPingTimeMs = GetTime();
+    _shiftedCycle   = !_shiftedCycle;
+    _statistics.pings++;
+
+    PT_WAIT_UNTIL(&_pinging, (_pingResult = _sensor->MeasureDistanceAsync(ambientTemperature, relativeHumidity, _pingDistance)) != RESULT_BUSY);
+
+    PT_END(&_pinging);
+  }
+
+  /// @brief Checks the result of the completed ping and makes it available
+  ///
+  void ContinuousDistanceSensor::ProcessPing()
+  {
+    if (_pingResult != RESULT_OK)
+    {
+      // A reading followed by a ping without echo was not confirmed
+      if (_candidate)
+        _statistics.ghosts++;
+
+      _tracking  = false;
+      _candidate = false;
+      SetSample(_pingResult, 0);
+      return;
+    }
+
+    // The previous reading was real, so this ping can't receive a ghost
+    if (_tracking)
+    {
+      SetSample(RESULT_OK, _pingDistance);
+      return;
+    }
+
+    if (_candidate)
+    {
+      uint32_t difference = (_pingDistance > _candidateDistance) ?
+                                _pingDistance - _candidateDistance :
+                                _candidateDistance - _pingDistance;
+
+      if (difference <= _ghostToleranceMm)
+      {
+        _tracking  = true;
+        _candidate = false;
+        SetSample(RESULT_OK, _pingDistance);
+        return;
+      }
+
+      // The reading moved with the cycle time, it was a ghost and the ping
+      // that received it didn't see any target
+      Logger::Debug(F("Ghost echo at %lu mm discarded"), _candidateDistance);
+      _statistics.ghosts++;
+      SetSample(RESULT_TIMEOUT, 0);
+    }
+
+    // The first reading after a ping without echo waits for the next ping
+    _candidate         = true;
+    _candidateDistance = _pingDistance;
+  }
+
+  /// @brief Makes a sample available
+  ///
+  void ContinuousDistanceSensor::SetSample(Result result, uint32_t distance)
+  {
+    _sampleResult   = result;
+    _sampleDistance = distance;
+    _sampleReady    = true;
+    _statistics.samples++;
+  }
+
+  uint32_t ContinuousDistanceSensor::GetTime() const
+  {
+    return (_clock != nullptr) ? _clock() : millis();
+  }
+}
@@ -0,0 +1,214 @@
+///
+/// @file ContinuousDistanceSensor.h
+///
+/// @brief ContinuousDistanceSensor class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_CONTINUOUSDISTANCESENSOR_H_)
+#define _CONTINUOUSDISTANCESENSOR_H_
+
+#include "IDistanceSensor.h"
+#include "CommonDefines.h"
+#include "Protothread.h"
+
+namespace CNEGR
+{
+  /// @brief ContinuousDistanceSensor class definition
+  ///
+  /// Pings another sensor back to back, as soon as the ping cycle recommended by the
+  /// sensor's datasheet has elapsed since the previous ping, instead of once per
+  /// application period. MeasureDistanceAsync() returns the latest completed sample and
+  /// returns RESULT_BUSY until a new one is available, so the application processes a
+  /// sample while the echo of the next ping dies out. The pings only progress while
+  /// MeasureDistanceAsync() is called, the application has to call it continuously.
+  ///
+  /// A ghost echo is a late echo of the previous ping received by the current one, it
+  /// looks like a close target. Ghosts can only appear when the previous ping didn't
+  /// receive its own echo, so the first reading after a ping without echo is held back
+  /// until the next ping confirms it. The pings alternate between two cycle times: the
+  /// distance of a ghost changes by the difference (about 171 mm per millisecond) from
+  /// one ping to the next while a real target doesn't, so a ghost is never confirmed
+  /// and the ping that received it is returned as a timeout, one ping late.
+  /// The steady readings of a target are returned without this extra ping.
+  ///
+  class ContinuousDistanceSensor: public IDistanceSensor
+  {
+  public:
+    /// @brief The counters since Init()
+    ///
+    struct Statistics
+    {
+      uint32_t  pings;                        ///< The number of pings
+      uint32_t  samples;                      ///< The number of samples made available, timeouts included
+      uint32_t  ghosts;                       ///< The number of readings discarded because they were not confirmed
+    };
+
+  public:
+    /// @brief Constructor.
+    ContinuousDistanceSensor(IDistanceSensor  *sensor,                  ///< The sensor pinged continuously
+                             uint32_t         cycleTimeMs,              ///< The minimum time between two pings in milliseconds
+                             uint32_t         ghostShiftMs,             ///< The time added to every other cycle in milliseconds
+                             uint32_t         ghostToleranceMm,         ///< The largest difference between a reading and its confirmation,
+                                                                        ///< must be smaller than the ghost shift (171 mm per millisecond)
+                             ClockProc        clock                     ///< The clock pacing the pings, nullptr for millis()
+                            );
+
+    /// @brief Destructor.
+    virtual ~ContinuousDistanceSensor();
+
+  public:
+    /// @brief Initialization function.
+    ///
+    /// @note The sensor must be initialized before calling this method
+    ///
+    /// @param configuration      The configuration data. Only the name is used.
+    ///
+    /// @retval RESULT_OK         The device was successfully configured.
+    /// @retval RESULT_BUSY       The  device was already configured.
+    ///                           Deinit() must be called before calling Init() again.
+    /// @retval RESULT_DEV_ERR    The sensor is not initialized.
+    /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+    ///
+    virtual Result Init(const Config& configuration);
+
+    /// @brief Get whether the sensor device was initialized
+    ///
+    /// @return boolean true if it is initialized
+    /// and available for use
+    virtual bool IsInitialized() const;
+
+    /// @brief Deinitialization function for the device.
+    ///
+    /// @note The sensor is not deinitialized
+    ///
+    virtual void Deinit();
+
+    /// @brief Measures the distance.
+    ///
+    /// @note Waits for the next sample.
+    ///
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+    ///                           of error state.
+    virtual Result MeasureDistance(uint32_t& distance);
+
+    /// @brief Measures the distance and adjusts the result for the ambient temperature.
+    ///
+    /// @note Waits for the next sample.
+    ///
+    /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+    ///                           of error state.
+    virtual Result MeasureDistance(uint32_t ambientTemperature, uint32_t& distance);
+
+    /// @brief Measures the distance and adjusts the result for the ambient temperature and relative humidity.
+    ///
+    /// @note Waits for the next sample. Temperatures below zero are passed as the two's
+    /// complement of the value.
+    ///
+    /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+    /// @param relativeHumidity   The relative humidity in percent
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+    ///                           of error state.
+    virtual Result MeasureDistance(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance);
+
+    /// @brief Gets the latest sample without blocking.
+    ///
+    /// @note Every call advances the pings, the method must be called continuously.
+    /// The temperature and humidity are used from the next ping on. A sample that is
+    /// not retrieved before the next one completes is lost.
+    ///
+    /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+    /// @param relativeHumidity   The relative humidity in percent
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_BUSY       No new sample is available yet.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+    ///                           of error state.
+    virtual Result MeasureDistanceAsync(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance);
+
+    /// @brief Limits the range of the measurements
+    ///
+    /// @note The limit is applied to the sensor pinged continuously.
+    ///
+    /// @param rangeLimitMm       The range limit in millimeters, 0 to use the full range
+    ///
+    /// @retval RESULT_OK         The range limit was changed.
+    /// @retval RESULT_NOT_READY  The sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_BAD_PARAM  The range limit is below the minimum distance the sensor can detect.
+    ///
+    virtual Result SetRangeLimit(uint32_t rangeLimitMm);
+
+  public:
+    /// @brief Gets the counters collected since Init()
+    ///
+    /// @param statistics         Contains the counters
+    ///
+    void GetStatistics(Statistics& statistics) const;
+
+  private:
+    /// @brief Pings the sensor once the cycle has elapsed
+    ///
+    /// @retval RESULT_OK         A ping completed.
+    /// @retval RESULT_BUSY       The ping is in progress or the cycle has not elapsed yet.
+    ///
+    Result Ping(uint32_t ambientTemperature, uint32_t relativeHumidity);
+
+    /// @brief Checks the result of the completed ping and makes it available
+    ///
+    void ProcessPing();
+
+    /// @brief Makes a sample available
+    ///
+    void SetSample(Result result, uint32_t distance);
+
+    uint32_t GetTime() const;
+
+  private:
+    /// @brief Default Constructor.
+    ContinuousDistanceSensor();
+
+  private:
+    bool            _initDone;                        ///< A flag to indicate whether the sensor was initialized
+    char            _name[MAX_COMPONENT_NAME_LENGTH]; ///< A symbolic name for this sensor
+    IDistanceSensor *_sensor;                         ///< The sensor pinged continuously
+    uint32_t        _cycleTimeMs;                     ///< The minimum time between two pings in milliseconds
+    uint32_t        _ghostShiftMs;                    ///< The time added to every other cycle in milliseconds
+    uint32_t        _ghostToleranceMm;                ///< The largest difference between a reading and its confirmation
+    ClockProc       _clock;                           ///< The clock pacing the pings, nullptr for millis()
+    Protothread     _pinging;                         ///< The ping in progress
+    uint32_t        _lastPingTimeMs;                  ///< The time of the previous ping in milliseconds
+    bool            _shiftedCycle;                    ///< A flag to indicate whether the next cycle is the shifted one
+    Result          _pingResult;                      ///< The result of the ping in progress
+    uint32_t        _pingDistance;                    ///< The distance of the ping in progress
+    bool            _tracking;                        ///< A flag to indicate whether the previous reading was returned
+    bool            _candidate;                       ///< A flag to indicate whether a reading waits for its confirmation
+    uint32_t        _candidateDistance;               ///< The reading waiting for its confirmation
+    bool            _sampleReady;                     ///< A flag to indicate whether a sample was not retrieved yet
+    Result          _sampleResult;                    ///< The result of the latest sample
+    uint32_t        _sampleDistance;                  ///< The distance of the latest sample
+    Statistics      _statistics;                      ///< The counters since Init()
+  };
+}
+#endif // _CONTINUOUSDISTANCESENSOR_H_
@@ -0,0 +1,47 @@
+///
+/// @file Crc16.cpp
+///
+/// @brief CRC-16 calculation functions
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "Crc16.h"
+
+namespace CNEGR
+{
+  /// @brief Updates a CRC-16/CCITT-FALSE (polynomial 0x1021) with one byte
+  ///
+  /// @param crc    The current CRC value, CRC16_INITIAL_VALUE for the first byte
+  /// @param data   The data byte
+  ///
+  /// @retval The updated CRC value
+  ///
+  uint16_t Crc16Update(uint16_t crc, uint8_t data)
+  {
+    // Table-less byte-wise update, trades a few cycles for 512 bytes of flash
+    uint8_t x = (uint8_t)((crc >> 8) ^ data);
+    x ^= x >> 4;
+
+    return (uint16_t)((crc << 8) ^ ((uint16_t)x << 12) ^ ((uint16_t)x << 5) ^ (uint16_t)x);
+  }
+
+  /// @brief Calculates the CRC-16/CCITT-FALSE (polynomial 0x1021) of a buffer
+  ///
+  /// @param data   Pointer to the data
+  /// @param length The data length in bytes
+  /// @param crc    The initial CRC value, allows calculating the CRC in several steps
+  ///
+  /// @retval The CRC value
+  ///
+  uint16_t Crc16(const void *data, size_t length, uint16_t crc)
+  {
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+
+    for (size_t i = 0; i < length; i++)
+      crc = Crc16Update(crc, bytes[i]);
+
+    return crc;
+  }
+}
@@ -0,0 +1,40 @@
+///
+/// @file Crc16.h
+///
+/// @brief CRC-16 calculation functions
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_CRC16_H_)
+#define _CRC16_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace CNEGR
+{
+  #define CRC16_INITIAL_VALUE 0xFFFF
+
+  /// @brief Updates a CRC-16/CCITT-FALSE (polynomial 0x1021) with one byte
+  ///
+  /// @param crc    The current CRC value, CRC16_INITIAL_VALUE for the first byte
+  /// @param data   The data byte
+  ///
+  /// @retval The updated CRC value
+  ///
+  uint16_t Crc16Update(uint16_t crc, uint8_t data);
+
+  /// @brief Calculates the CRC-16/CCITT-FALSE (polynomial 0x1021) of a buffer
+  ///
+  /// @param data   Pointer to the data
+  /// @param length The data length in bytes
+  /// @param crc    The initial CRC value, allows calculating the CRC in several steps
+  ///
+  /// @retval The CRC value
+  ///
+  uint16_t Crc16(const void *data, size_t length, uint16_t crc = CRC16_INITIAL_VALUE);
+}
+#endif // _CRC16_H_
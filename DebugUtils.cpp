@@ -13,7 +13,11 @@
 /// @brief Resets the board
 void Reset()
 {
+#if defined(__AVR__)
   asm volatile ("jmp 0");
+#else
+  abort();
+#endif
 }
 
 const uint32_t LOG_BUFFER_SIZE = 128;
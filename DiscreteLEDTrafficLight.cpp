@@ -19,6 +19,7 @@ namespace CNEGR
     _pinsPolarity(SignalPolarity::ActiveHigh)
   {
     _name[0] = '\0';
+    PT_INIT(&_lightsTest);
   }
 
   /// @brief Destructor.
@@ -66,6 +67,9 @@ namespace CNEGR
     // Make sure that all the lights are off
     SetAllLightsOff();
 
+    // No lights test is in progress
+    PT_INIT(&_lightsTest);
+
     // Set the init done flag
     _initDone = true;
     return RESULT_OK;
@@ -238,31 +242,59 @@ namespace CNEGR
   /// @retval RESULT_DEV_ERR    The device is not present or is in some kind of error state.
   ///
   Result DiscreteLEDTrafficLight::PerformLightsTest()
+  {
+    Result result = RESULT_OK;
+
+    // Run the sequence to completion
+    PT_INIT(&_lightsTest);
+    while ((result = PerformLightsTestAsync()) == RESULT_BUSY)
+    {
+    }
+
+    return result;
+  }
+
+  /// @brief Performs a test of the lights without blocking.
+  ///
+  /// @note The test takes about 1.5 seconds, the method must be called repeatedly
+  /// until it returns something else than RESULT_BUSY.
+  ///
+  /// @retval RESULT_OK         The test completed successfully.
+  /// @retval RESULT_BUSY       The test is in progress.
+  /// @retval RESULT_NOT_READY  The execution failed because the device was not initialized (Init() method wasn't called).
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind of error state.
+  ///
+  Result DiscreteLEDTrafficLight::PerformLightsTestAsync()
   {
     if (!IsInitialized())
       return RESULT_NOT_READY;
 
-    Result result = TurnOn(LightSelector::RedLight);
+    Result result = RESULT_OK;
 
-    if(result == RESULT_OK)
-    {
-      delay(500);
-      result = TurnOn(LightSelector::YellowLight);
-    }
+    PT_BEGIN(&_lightsTest);
 
-    if(result == RESULT_OK)
-    {
-      delay(500);
-      result = TurnOn(LightSelector::GreenLight);
-    }
+    result = TurnOn(LightSelector::RedLight);
+    if (result != RESULT_OK)
+      PT_EXIT(&_lightsTest, result);
 
-    if(result == RESULT_OK)
-    {
-      delay(500);
-      result = SetAllLightsOff();
-    }
+    PT_WAIT_MS(&_lightsTest, 500);
 
-    return result;
+    result = TurnOn(LightSelector::YellowLight);
+    if (result != RESULT_OK)
+      PT_EXIT(&_lightsTest, result);
+
+    PT_WAIT_MS(&_lightsTest, 500);
+
+    result = TurnOn(LightSelector::GreenLight);
+    if (result != RESULT_OK)
+      PT_EXIT(&_lightsTest, result);
+
+    PT_WAIT_MS(&_lightsTest, 500);
+
+    result = SetAllLightsOff();
+    PT_EXIT(&_lightsTest, result);
+
+    PT_END(&_lightsTest);
   }
 
   /// @brief Sets the state of  the specified pin.
@@ -12,6 +12,7 @@
 #define _DISCRETELEDTRAFFICLIGHT_H_
 
 #include "ITrafficLight.h"
+#include "Protothread.h"
 
 namespace CNEGR
 {
@@ -109,6 +110,18 @@ namespace CNEGR
     ///
     virtual Result PerformLightsTest();
 
+    /// @brief Performs a test of the lights without blocking.
+    ///
+    /// @note The test takes about 1.5 seconds, the method must be called repeatedly
+    /// until it returns something else than RESULT_BUSY.
+    ///
+    /// @retval RESULT_OK         The test completed successfully.
+    /// @retval RESULT_BUSY       The test is in progress.
+    /// @retval RESULT_NOT_READY  The execution failed because the device was not initialized (Init() method wasn't called).
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind of error state.
+    ///
+    virtual Result PerformLightsTestAsync();
+
   private:
     /// @brief Sets the state of the specified pin.
     ///
@@ -133,6 +146,7 @@ namespace CNEGR
     uint8_t         _yellowLightPin;                ///< The GPIO pin number (output) to control the Yellow light
     uint8_t         _greenLightPin;                 ///< The GPIO pin number (output) to control the Green light
     SignalPolarity  _pinsPolarity;                  ///< The polarity for the GPIO pins
+    Protothread     _lightsTest;                    ///< The lights test sequence state
   };
 }
 
@@ -1,6 +1,7 @@
 #include <Arduino.h>
 #define __ASSERT_USE_STDERR
 #include <assert.h>
+#include <errno.h>
 
 #include "DebugUtils.h"
 #include "StateMachine.h"
@@ -8,26 +9,935 @@
 #include "MockDistanceSensor.h"
 #include "MockTrafficLight.h"
 #include "HCSR04.h"
+#include "DualDistanceSensor.h"
+#include "ContinuousDistanceSensor.h"
+#include "JitteredDistanceSensor.h"
+#include "SlottedDistanceSensor.h"
+#include "SlotScheduler.h"
 #include "DiscreteLEDTrafficLight.h"
+#include "InstrumentedTrafficLight.h"
+#include "ConfigStore.h"
+#include "Console.h"
+#include "Telemetry.h"
+#include "TeachIn.h"
+#include "PushButton.h"
+#include "EventBus.h"
+#include "MockButton.h"
+#include "BootProfiler.h"
+#include "EchoEdgeRecorder.h"
+#include "LatencyHistogram.h"
+#include "UpdateProfiler.h"
 
 const uint8_t triggerPin      = 3;
 const uint8_t echoPin         = 2;
 
+// Second sensor, used only when two sensors are mounted side by side
+const bool     useDualSensors            = false;
+const uint8_t  rightTriggerPin           = 7;
+const uint8_t  rightEchoPin              = 8;
+const uint32_t sensorsBaselineMm         = 1200;
+const uint32_t sensorsCrosstalkGuardMs   = 30;
+const uint32_t sensorsMaxPairIntervalMs  = 150;   // One measurement period and the loop jitter
+
+// Continuous pinging: the sensor is pinged as fast as its datasheet allows instead of
+// once every waitTimeBetweenMeasurementsMs. The state machine compares consecutive
+// samples, so its moving time threshold is limited to half the ping cycle in this mode.
+const bool     continuousPinging         = false;
+const uint32_t pingCycleTimeMs           = 60;    // The HC-SR04 measurement cycle
+const uint32_t ghostShiftMs              = 4;     // Every other cycle is longer by this time
+const uint32_t ghostToleranceMm          = 100;
+
+// Interference from the sensors of the neighbouring bays: every ping is delayed by a
+// random time and the readings that don't match any of the last ones are rejected
+const bool     rejectInterference        = false;
+const uint32_t pingJitterMaxMs           = 20;
+const uint32_t consistencyToleranceMm    = 150;
+
+// Time slots shared with the boards of the neighbouring bays: the boards are connected by
+// a sync wire pulled up and only driven low, every board pings in its own slot of the
+// frame. Every board needs a different slot and the ping window must leave enough time
+// for the longest echo (17.4 ms at 3 m) before the next slot. The pulses are polled by
+// the main loop, they must last longer than a loop iteration.
+const bool     useTimeSlots              = false;
+const uint8_t  syncPin                   = 10;
+const uint8_t  slotCount                 = 4;
+const uint8_t  ownSlot                   = 0;
+const uint32_t slotTimeMs                = 25;
+const uint32_t slotPingWindowMs          = 5;
+const uint8_t  syncTimeoutFrames         = 3;
+const uint32_t syncPulseWidthMs          = 2;
+
 const uint8_t redLightPin     = 4;
 const uint8_t yellowLightPin  = 5;
 const uint8_t greenLightPin   = 6;
 
+// The button starts the teach-in, a long press aborts it
+const uint8_t  buttonPin                 = 9;
+const uint16_t buttonDebounceTimeMs      = 30;
+const uint16_t buttonLongPressTimeMs     = 1500;
+
 const uint32_t maxDistanceThresholdMm        = 3000;
 const uint32_t farThresholdMm                = 1500;
 const uint32_t nearThresholdMm               = 250;
 const uint32_t movingDistanceThresholdMm     = 50;
 const uint32_t movingTimeThresholdMs         = 100;
 const uint32_t holdingTimeThresholdMs        = 2000;
-const uint32_t waitTimeBetweenMeasurementsMs = 100;
+const uint32_t waitTimeBetweenMeasurementsMs = 100;   // The time between the start of two measurements
+const uint32_t telemetryStatisticsPeriodMs   = 1000;
+const uint16_t outlierThresholdX16           = 71;
+const uint16_t outlierMinDeviationMm         = 40;
+const uint8_t  classifierPersistenceSamples  = 5;
+const uint16_t classifierMaxStepMm           = 150;   // Per measurement, 1.5 m/s at the 100 ms period
+const uint8_t  classifierMaxMissedSamples    = 2;
+const CNEGR::Q16 trackerAlpha                = Q16_FROM_RATIO(1, 2);
+const CNEGR::Q16 trackerBeta                 = Q16_FROM_RATIO(1, 8);
+const uint8_t  trackerMaxPredictedSamples    = 5;
+
+// Teach-in: about 3 seconds of readings, the thresholds keep the default zone sizes
+const uint8_t  teachInSampleCount            = 32;
+const uint8_t  teachInMaxMissedSamples       = 8;
+const uint16_t teachInMaxSpreadMm            = 60;
+const uint16_t teachInStopToleranceMm        = 100;
+const uint16_t teachInYellowZoneMm           = farThresholdMm - nearThresholdMm;
+const uint16_t teachInGreenZoneMm            = maxDistanceThresholdMm - farThresholdMm;
+const uint32_t teachInMaxRangeMm             = 4000;  // The HC-SR04 range
+
+// Fast start: the lights show the distance right after a reset, the lights test,
+// the INFO logs and the first save of the default configuration are deferred
+// until after the first measurement
+const bool     fastStart                     = true;
+
+// The configuration is saved at the beginning of the EEPROM
+const uint16_t configStoreAddress            = 0;
+const uint8_t  configStoreSlotCount          = 4;
 
 CNEGR::IDistanceSensor *distanceSensor;
+CNEGR::DistanceSensor  *echoSensor;        ///< The first sensor, its echo edges can be recorded
+CNEGR::ContinuousDistanceSensor *continuousSensor = nullptr;   ///< The continuous pinging, nullptr if not used
+CNEGR::JitteredDistanceSensor   *jitteredSensor   = nullptr;   ///< The interference rejection, nullptr if not used
+CNEGR::SlottedDistanceSensor    *slottedSensor    = nullptr;   ///< The pings in the time slot, nullptr if not used
 CNEGR::ITrafficLight   *trafficLight;
 CNEGR::StateMachine    *stateMachine;
+CNEGR::IButton         *button;
+
+CNEGR::ConfigStore      configStore(configStoreAddress, configStoreSlotCount);
+CNEGR::PersistentConfig config;
+CNEGR::Console          console;
+CNEGR::Telemetry        telemetry;
+CNEGR::TeachIn          teachIn;
+CNEGR::BootProfiler     bootProfiler;
+CNEGR::EchoEdgeRecorder edgeRecorder;
+CNEGR::SlotScheduler    slotScheduler;
+CNEGR::LatencyHistogram latencyHistogram;   ///< The latency from the capture of a sample to the light it causes
+CNEGR::UpdateProfiler   updateProfiler;     ///< The cycles of the state machine updates, started by the 'wcet' command
+uint32_t                lastStatisticsTimeMs = 0;
+bool                    configSavePending     = false;   ///< The default configuration must be saved after the boot
+Logger::Level           telemetryLogLevel     = Logger::Level::INFO; ///< The log level restored when the telemetry stops
+
+bool                    updatePending         = false;   ///< The state machine update is in progress
+uint32_t                lastUpdateTimeMs      = 0;       ///< The start time of the last state machine update
+uint32_t                idleTimeMs            = 0;       ///< The time spent by the loop with nothing to do
+uint16_t                idleTimeRemainderUs   = 0;       ///< The part of the idle time below one millisecond
+
+bool                    syncLineLow           = false;   ///< The level of the sync line at the previous poll
+bool                    syncPulseSending      = false;   ///< This board drives the sync line low
+uint32_t                syncPulseStartTimeMs  = 0;       ///< The start time of the pulse sent by this board
+
+/// @brief Fills the configuration with the default values
+///
+/// @param configuration The configuration to fill
+///
+void GetDefaultConfig(CNEGR::PersistentConfig& configuration)
+{
+  memset(&configuration, 0, sizeof(configuration));
+
+  configuration.triggerPin                          = triggerPin;
+  configuration.echoPin                             = echoPin;
+  configuration.redLightPin                         = redLightPin;
+  configuration.yellowLightPin                      = yellowLightPin;
+  configuration.greenLightPin                       = greenLightPin;
+  configuration.lightsPolarity                      = CNEGR::SignalPolarity::ActiveHigh;
+  configuration.maxDistanceThresholdMm              = maxDistanceThresholdMm;
+  configuration.farThresholdMm                      = farThresholdMm;
+  configuration.nearThresholdMm                     = nearThresholdMm;
+  configuration.movingDistanceDetectionThresholdMm  = movingDistanceThresholdMm;
+  configuration.movingTimeThresholdMs               = movingTimeThresholdMs;
+  configuration.holdingTimeThresholdMs              = holdingTimeThresholdMs;
+  configuration.outlierFilter.thresholdX16          = outlierThresholdX16;
+  configuration.outlierFilter.minDeviationMm        = outlierMinDeviationMm;
+  configuration.classifier.persistenceSamples       = classifierPersistenceSamples;
+  configuration.classifier.maxStepMm                = classifierMaxStepMm;
+  configuration.classifier.maxMissedSamples         = classifierMaxMissedSamples;
+  configuration.tracker.alpha                       = trackerAlpha;
+  configuration.tracker.beta                        = trackerBeta;
+  configuration.tracker.maxPredictedSamples         = trackerMaxPredictedSamples;
+}
+
+/// @brief Saves the default configuration loaded at boot
+///
+void SaveDefaultConfig()
+{
+  configSavePending = false;
+
+  Result result = configStore.Save(config);
+  if (result != RESULT_OK)
+  {
+    // Not fatal, the defaults are used until the next boot
+    Logger::Error(F("Config save failed: %s"), ResultToStr(result));
+  }
+}
+
+/// @brief Loads the configuration from the EEPROM. The default configuration
+/// is used and saved if there is no valid configuration in the EEPROM.
+///
+void LoadConfig()
+{
+  Result result = configStore.Load(config);
+  if (result == RESULT_OK)
+    result = CNEGR::ConfigStore::Validate(config);
+
+  Logger::Info(F("Config load returned %s in %lu us"), ResultToStr(result), configStore.GetLoadDurationUs());
+
+  if (result != RESULT_OK)
+  {
+    GetDefaultConfig(config);
+
+    // Writing the EEPROM takes a few milliseconds per byte
+    if (fastStart)
+      configSavePending = true;
+    else
+      SaveDefaultConfig();
+  }
+}
+
+/// @brief Records the boot milestones reached by the last state machine update
+/// and runs the work deferred by the fast start after the first measurement
+///
+/// @param updateCompleted    true if the last update completed
+///
+void UpdateBootProfile(bool updateCompleted)
+{
+  if (!bootProfiler.IsMarked(CNEGR::BootProfiler::LightsTested) &&
+      (stateMachine->GetLightsTestResult() != RESULT_NOT_EXECUTED))
+  {
+    bootProfiler.Mark(CNEGR::BootProfiler::LightsTested);
+  }
+
+  if (!updateCompleted || bootProfiler.IsMarked(CNEGR::BootProfiler::FirstMeasurement))
+    return;
+
+  bootProfiler.Mark(CNEGR::BootProfiler::FirstMeasurement);
+
+  // The logs stay off if the telemetry was started during the boot
+  if (fastStart && telemetry.IsEnabled())
+    telemetryLogLevel = Logger::Level::INFO;
+  else if (fastStart)
+    Logger::SetLogLevel(Logger::Level::INFO);
+
+  bootProfiler.Log();
+
+  if (configSavePending)
+    SaveDefaultConfig();
+}
+
+/// @brief Fills the state machine configuration from the application configuration
+///
+/// @param configuration      The application configuration
+/// @param stateMachineConfig The state machine configuration to fill
+///
+void GetStateMachineConfig(const CNEGR::PersistentConfig& configuration, CNEGR::StateMachine::Config& stateMachineConfig)
+{
+  stateMachineConfig.distanceSensor                     = distanceSensor;
+  stateMachineConfig.trafficLight                       = trafficLight;
+  stateMachineConfig.clock                              = nullptr;
+  stateMachineConfig.ambient                            = nullptr;  // No temperature and humidity sensor fitted
+  stateMachineConfig.deferLightsTest                    = fastStart;
+  stateMachineConfig.maxDistanceThresholdMm             = configuration.maxDistanceThresholdMm;
+  stateMachineConfig.farThresholdMm                     = configuration.farThresholdMm;
+  stateMachineConfig.nearThresholdMm                    = configuration.nearThresholdMm;
+  stateMachineConfig.movingDistanceDetectionThresholdMm = configuration.movingDistanceDetectionThresholdMm;
+  stateMachineConfig.movingTimeThresholdMs              = configuration.movingTimeThresholdMs;
+  stateMachineConfig.holdingTimeThresholdMs             = configuration.holdingTimeThresholdMs;
+  stateMachineConfig.outlierFilter                      = configuration.outlierFilter;
+  stateMachineConfig.classifier                         = configuration.classifier;
+  stateMachineConfig.tracker                            = configuration.tracker;
+
+  // The samples come one ping cycle apart, give or take the loop and echo times. With a
+  // longer threshold the state machine would never see the subject moving.
+  if (continuousPinging && (stateMachineConfig.movingTimeThresholdMs > pingCycleTimeMs / 2))
+  {
+    Logger::Warning(F("Moving time threshold limited to %lu ms by the continuous pinging"), pingCycleTimeMs / 2);
+    stateMachineConfig.movingTimeThresholdMs = pingCycleTimeMs / 2;
+  }
+}
+
+/// @brief A configuration value that can be accessed from the console
+///
+struct ConfigField
+{
+  const char  *name;        ///< The name used in the console commands
+  uint8_t     offset;       ///< The offset of the value in PersistentConfig
+  uint8_t     size;         ///< The size of the value in bytes
+  bool        isSigned;     ///< A flag to indicate whether the value can be negative
+};
+
+#define CONFIG_FIELD(name, field) { name, offsetof(CNEGR::PersistentConfig, field), sizeof(((CNEGR::PersistentConfig *)0)->field), \
+                                    ((decltype(((CNEGR::PersistentConfig *)0)->field))-1 < 0) }
+
+/// The values that can be changed at runtime. The pins are not listed
+/// since changing them requires reinitializing the components.
+const ConfigField configFields[] =
+{
+  CONFIG_FIELD("max",       maxDistanceThresholdMm),
+  CONFIG_FIELD("far",       farThresholdMm),
+  CONFIG_FIELD("near",      nearThresholdMm),
+  CONFIG_FIELD("movdist",   movingDistanceDetectionThresholdMm),
+  CONFIG_FIELD("movtime",   movingTimeThresholdMs),
+  CONFIG_FIELD("hold",      holdingTimeThresholdMs),
+  CONFIG_FIELD("outlier",   outlierFilter.thresholdX16),
+  CONFIG_FIELD("outmin",    outlierFilter.minDeviationMm),
+  CONFIG_FIELD("persist",   classifier.persistenceSamples),
+  CONFIG_FIELD("maxstep",   classifier.maxStepMm),
+  CONFIG_FIELD("maxmiss",   classifier.maxMissedSamples),
+  CONFIG_FIELD("alpha",     tracker.alpha),
+  CONFIG_FIELD("beta",      tracker.beta),
+  CONFIG_FIELD("maxpred",   tracker.maxPredictedSamples),
+};
+
+const uint8_t configFieldCount = sizeof(configFields) / sizeof(configFields[0]);
+
+/// @brief Finds a configuration value by name
+///
+/// @param name The value name
+///
+/// @retval Pointer to the value description or nullptr if not found
+///
+const ConfigField *FindConfigField(const char *name)
+{
+  for (uint8_t i = 0; i < configFieldCount; i++)
+  {
+    if (strcmp(name, configFields[i].name) == 0)
+      return &configFields[i];
+  }
+
+  return nullptr;
+}
+
+/// @brief Reads a configuration value
+///
+int32_t GetConfigValue(const CNEGR::PersistentConfig& configuration, const ConfigField& field)
+{
+  const uint8_t *p = reinterpret_cast<const uint8_t *>(&configuration) + field.offset;
+
+  switch(field.size)
+  {
+    case sizeof(uint8_t):   return *p;
+    case sizeof(uint16_t):  return *reinterpret_cast<const uint16_t *>(p);
+    default:                return *reinterpret_cast<const int32_t *>(p);
+  }
+}
+
+/// @brief Writes a configuration value
+///
+void SetConfigValue(CNEGR::PersistentConfig& configuration, const ConfigField& field, int32_t value)
+{
+  uint8_t *p = reinterpret_cast<uint8_t *>(&configuration) + field.offset;
+
+  switch(field.size)
+  {
+    case sizeof(uint8_t):   *p = (uint8_t)value; break;
+    case sizeof(uint16_t):  *reinterpret_cast<uint16_t *>(p) = (uint16_t)value; break;
+    default:                *reinterpret_cast<int32_t *>(p) = value; break;
+  }
+}
+
+/// @brief Get whether a value can be written to a configuration value without being truncated
+///
+bool IsConfigValueInRange(const ConfigField& field, int32_t value)
+{
+  if (field.size >= sizeof(int32_t))
+    return field.isSigned || (value >= 0);
+
+  int32_t range = (int32_t)1 << (8 * field.size);
+
+  if (field.isSigned)
+    return (value >= -(range / 2)) && (value < range / 2);
+
+  return (value >= 0) && (value < range);
+}
+
+/// @brief Validates a new configuration and applies it to the state machine
+///
+/// @param candidate          The new configuration, the pins are not applied
+///
+/// @retval RESULT_OK         The configuration was applied and is now the current one.
+/// @retval RESULT_NOT_VALID  The configuration is invalid, nothing was changed.
+///
+Result ApplyConfig(const CNEGR::PersistentConfig& candidate)
+{
+  if (CNEGR::ConfigStore::Validate(candidate) != RESULT_OK)
+    return RESULT_NOT_VALID;
+
+  CNEGR::StateMachine::Config stateMachineConfig;
+  GetStateMachineConfig(candidate, stateMachineConfig);
+
+  Result result = stateMachine->Reconfigure(stateMachineConfig);
+  if (result == RESULT_OK)
+    config = candidate;
+
+  return result;
+}
+
+/// @brief Console command: help
+///
+Result HelpCommand(Print& output, uint8_t argc, char *argv[]);
+
+/// @brief Console command: get [name]
+///
+/// Prints the named configuration value or all of them
+///
+Result GetCommand(Print& output, uint8_t argc, char *argv[])
+{
+  for (uint8_t i = 0; i < configFieldCount; i++)
+  {
+    if ((argc < 2) || (strcmp(argv[1], configFields[i].name) == 0))
+    {
+      output.print(configFields[i].name);
+      output.print(F("="));
+      output.println((long)GetConfigValue(config, configFields[i]));
+
+      if (argc >= 2)
+        return RESULT_OK;
+    }
+  }
+
+  return (argc < 2) ? RESULT_OK : RESULT_BAD_PARAM;
+}
+
+/// @brief Console command: set <name> <value>
+///
+/// Changes a configuration value, the change takes effect immediately
+/// but it is lost on reset unless it is saved
+///
+Result SetCommand(Print& output, uint8_t argc, char *argv[])
+{
+  (void)output;
+
+  if (argc != 3)
+    return RESULT_BAD_PARAM;
+
+  const ConfigField *field = FindConfigField(argv[1]);
+  if (field == nullptr)
+    return RESULT_BAD_PARAM;
+
+  char *end = nullptr;
+  errno = 0;
+  int32_t value = strtol(argv[2], &end, 0);
+  if ((end == argv[2]) || (*end != '\0'))
+    return RESULT_PARSE_ERROR;
+
+  // A truncated value could still pass the validation, e.g. 70000 stored as 4464 in 16 bits
+  if ((errno == ERANGE) || !IsConfigValueInRange(*field, value))
+    return RESULT_BAD_PARAM;
+
+  CNEGR::PersistentConfig candidate = config;
+  SetConfigValue(candidate, *field, value);
+
+  return ApplyConfig(candidate);
+}
+
+/// @brief Console command: save
+///
+/// Saves the current configuration in the EEPROM
+///
+Result SaveCommand(Print& output, uint8_t argc, char *argv[])
+{
+  (void)output;
+  (void)argc;
+  (void)argv;
+
+  return configStore.Save(config);
+}
+
+/// @brief Console command: stats
+///
+/// Prints the state machine statistics
+///
+Result StatsCommand(Print& output, uint8_t argc, char *argv[])
+{
+  (void)argc;
+  (void)argv;
+
+  CNEGR::StateMachine::Statistics statistics;
+  stateMachine->GetStatistics(statistics);
+
+  output.print(F("uptime="));           output.println(millis());
+  output.print(F("updates="));          output.println(statistics.updates);
+  output.print(F("timeouts="));         output.println(statistics.timeouts);
+  output.print(F("transitions="));      output.println(statistics.transitions);
+  output.print(F("outliers="));         output.println(statistics.outliers);
+  output.print(F("rejectedTargets="));  output.println(statistics.rejectedTargets);
+  output.print(F("sensorFaults="));     output.println(statistics.sensorFaults);
+  output.print(F("reconnects="));       output.println(echoSensor->GetReconnectAttempts());
+  output.print(F("idle="));             output.println(idleTimeMs);
+
+  if (continuousSensor != nullptr)
+  {
+    CNEGR::ContinuousDistanceSensor::Statistics sensorStatistics;
+    continuousSensor->GetStatistics(sensorStatistics);
+
+    output.print(F("pings="));          output.println(sensorStatistics.pings);
+    output.print(F("ghosts="));         output.println(sensorStatistics.ghosts);
+    output.print(F("samplesPerS="));    output.println((uint32_t)((uint64_t)sensorStatistics.samples * 1000UL / millis()));
+  }
+
+  if (jitteredSensor != nullptr)
+  {
+    CNEGR::JitteredDistanceSensor::Statistics sensorStatistics;
+    jitteredSensor->GetStatistics(sensorStatistics);
+
+    output.print(F("readings="));       output.println(sensorStatistics.readings);
+    output.print(F("inconsistent="));   output.println(sensorStatistics.rejected);
+  }
+
+  if (slotScheduler.IsInitialized())
+  {
+    CNEGR::SlotScheduler::Statistics schedulerStatistics;
+    slotScheduler.GetStatistics(schedulerStatistics);
+
+    output.print(F("syncSending="));    output.println(slotScheduler.IsSending() ? 1 : 0);
+    output.print(F("syncsSent="));      output.println(schedulerStatistics.syncsSent);
+    output.print(F("syncsReceived="));  output.println(schedulerStatistics.syncsReceived);
+    output.print(F("syncTakeovers="));  output.println(schedulerStatistics.takeovers);
+  }
+
+  return RESULT_OK;
+}
+
+/// @brief Console command: log <level>
+///
+/// Changes the log output level, 0 (DEBUG) to 5 (OFF)
+///
+Result LogCommand(Print& output, uint8_t argc, char *argv[])
+{
+  (void)output;
+
+  if (argc != 2)
+    return RESULT_BAD_PARAM;
+
+  char *end = nullptr;
+  long level = strtol(argv[1], &end, 10);
+  if ((end == argv[1]) || (*end != '\0'))
+    return RESULT_PARSE_ERROR;
+
+  if ((level < Logger::Level::DEBUG) || (level > Logger::Level::OFF))
+    return RESULT_BAD_PARAM;
+
+  Logger::SetLogLevel((Logger::Level)level);
+  return RESULT_OK;
+}
+
+/// @brief Console command: tlm <0|1>
+///
+/// Stops or starts the binary telemetry. The logs are turned off while
+/// the telemetry is running since both use the serial port, their level
+/// is restored when it stops.
+///
+Result TelemetryCommand(Print& output, uint8_t argc, char *argv[])
+{
+  (void)output;
+
+  if ((argc != 2) || (argv[1][1] != '\0') || ((argv[1][0] != '0') && (argv[1][0] != '1')))
+    return RESULT_BAD_PARAM;
+
+  bool enabled = (argv[1][0] == '1');
+  if (enabled == telemetry.IsEnabled())
+    return RESULT_OK;
+
+  if (enabled)
+  {
+    telemetryLogLevel = Logger::GetLogLevel();
+    Logger::SetLogLevel(Logger::Level::OFF);
+  }
+  else
+  {
+    Logger::SetLogLevel(telemetryLogLevel);
+  }
+
+  telemetry.SetEnabled(enabled);
+  return RESULT_OK;
+}
+
+/// @brief Handles the button events
+///
+void ProcessButtonEvents()
+{
+  CNEGR::IButton::Event event;
+
+  while (button->GetEvent(event) == RESULT_OK)
+  {
+    switch(event)
+    {
+      case CNEGR::IButton::Event::Press:
+        Logger::Info(F("Button pressed, teach-in start returned %s"), ResultToStr(teachIn.Start()));
+        break;
+
+      case CNEGR::IButton::Event::LongPress:
+        Logger::Info(F("Button long press, teach-in aborted"));
+        teachIn.Abort();
+        break;
+    }
+  }
+}
+
+/// @brief Sends the state machine statistics to the telemetry
+///
+void SendStatistics()
+{
+  CNEGR::StateMachine::Statistics statistics;
+  stateMachine->GetStatistics(statistics);
+
+  CNEGR::TelemetryStatistics message;
+  message.timeMs          = millis();
+  message.updates         = statistics.updates;
+  message.timeouts        = statistics.timeouts;
+  message.transitions     = statistics.transitions;
+  message.outliers        = statistics.outliers;
+  message.rejectedTargets = statistics.rejectedTargets;
+  telemetry.Send(message);
+}
+
+/// @brief Converts a distance to the telemetry representation
+///
+uint16_t ToTelemetryDistance(uint32_t distance)
+{
+  return (distance < TELEMETRY_NO_DISTANCE) ? (uint16_t)distance : TELEMETRY_NO_DISTANCE;
+}
+
+/// @brief Sends the samples and the state changes to the telemetry
+///
+struct TelemetrySubscriber: public CNEGR::EventSubscriber
+{
+  using CNEGR::EventSubscriber::OnEvent;
+
+  static void OnEvent(const CNEGR::SampleEvent& event)
+  {
+    if (!telemetry.IsEnabled())
+      return;
+
+    int32_t velocity = event.velocityMmPerS;
+    if (velocity > INT16_MAX)
+      velocity = INT16_MAX;
+    else if (velocity < INT16_MIN)
+      velocity = INT16_MIN;
+
+    CNEGR::TelemetrySample message;
+    message.timeMs            = event.timeMs;
+    message.rawDistanceMm     = ToTelemetryDistance(event.rawDistanceMm);
+    message.trackedDistanceMm = ToTelemetryDistance(event.trackedDistanceMm);
+    message.velocityMmPerS    = (int16_t)velocity;
+    message.state             = event.state;
+    telemetry.Send(message);
+  }
+
+  static void OnEvent(const CNEGR::StateChangedEvent& event)
+  {
+    if (!telemetry.IsEnabled())
+      return;
+
+    CNEGR::TelemetryTransition message;
+    message.timeMs    = event.timeMs;
+    message.fromState = event.fromState;
+    message.toState   = event.toState;
+    telemetry.Send(message);
+  }
+};
+
+/// The event subscribers, in the order in which they receive the events
+typedef CNEGR::EventBus<TelemetrySubscriber> AppEventBus;
+
+void CNEGR::Publish(const CNEGR::SampleEvent& event)
+{
+  AppEventBus::Publish(event);
+}
+
+void CNEGR::Publish(const CNEGR::StateChangedEvent& event)
+{
+  AppEventBus::Publish(event);
+}
+
+void CNEGR::Publish(const CNEGR::FaultEvent& event)
+{
+  AppEventBus::Publish(event);
+}
+
+/// @brief Console command: boot
+///
+/// Prints the time of the boot milestones in microseconds since the reset
+///
+Result BootCommand(Print& output, uint8_t argc, char *argv[])
+{
+  (void)argc;
+  (void)argv;
+
+  bootProfiler.Print(output);
+  return RESULT_OK;
+}
+
+/// @brief Gets the time of the last capture of the first sensor
+///
+/// @retval The time in microseconds
+///
+uint32_t GetCaptureTime()
+{
+  return echoSensor->GetLastCaptureTime();
+}
+
+/// @brief Console command: latency [clear]
+///
+/// Prints the latency from the capture of a sample to the light it causes, or
+/// clears the recorded latencies. The percentiles are the upper bounds of their
+/// buckets, in microseconds.
+///
+Result LatencyCommand(Print& output, uint8_t argc, char *argv[])
+{
+  if (argc == 2)
+  {
+    if (strcmp(argv[1], "clear") != 0)
+      return RESULT_BAD_PARAM;
+
+    latencyHistogram.Clear();
+    return RESULT_OK;
+  }
+
+  if (argc != 1)
+    return RESULT_BAD_PARAM;
+
+  latencyHistogram.Print(output);
+  return RESULT_OK;
+}
+
+/// @brief Console command: wcet [0|1]
+///
+/// Starts or stops counting the CPU cycles of the state machine updates, or
+/// prints the largest count of every path taken since the start as
+/// "logLevel state nextState result count maxCycles" lines. The paths are
+/// released when it stops.
+///
+Result WcetCommand(Print& output, uint8_t argc, char *argv[])
+{
+  if (argc == 2)
+  {
+    if ((argv[1][1] != '\0') || ((argv[1][0] != '0') && (argv[1][0] != '1')))
+      return RESULT_BAD_PARAM;
+
+    if (argv[1][0] == '0')
+    {
+      updateProfiler.Stop();
+      return RESULT_OK;
+    }
+
+    return updateProfiler.Start();
+  }
+
+  if (argc != 1)
+    return RESULT_BAD_PARAM;
+
+  if (!updateProfiler.IsRunning())
+    return RESULT_NOT_READY;
+
+  updateProfiler.Print(output);
+  return RESULT_OK;
+}
+
+/// @brief Sends the recorded echo edges to the telemetry
+///
+Result SendEchoEdges()
+{
+  CNEGR::TelemetryEchoEdges message;
+  message.totalCount = edgeRecorder.GetEdgeCount();
+  message.lostCount  = edgeRecorder.GetLostEdgeCount();
+
+  uint8_t index = 0;
+  do
+  {
+    message.firstIndex = index;
+    message.count      = 0;
+
+    while ((message.count < TELEMETRY_MAX_ECHO_EDGES) &&
+           (edgeRecorder.GetEdge(index, message.edges[message.count]) == RESULT_OK))
+    {
+      message.count++;
+      index++;
+    }
+
+    Result result = telemetry.Send(message);
+    if (result != RESULT_OK)
+      return result;
+  }
+  while (index < message.totalCount);
+
+  return RESULT_OK;
+}
+
+/// @brief Console command: edges [pings]
+///
+/// Starts recording every echo edge of the next pings, or prints the recorded
+/// edges as "ping level time" lines, the time is in microseconds since the
+/// trigger. The edges are sent as telemetry frames while the telemetry is running.
+///
+Result EdgesCommand(Print& output, uint8_t argc, char *argv[])
+{
+  if (argc == 2)
+  {
+    char *end = nullptr;
+    long pings = strtol(argv[1], &end, 10);
+    if ((end == argv[1]) || (*end != '\0'))
+      return RESULT_PARSE_ERROR;
+
+    if ((pings < 1) || (pings > UINT8_MAX))
+      return RESULT_BAD_PARAM;
+
+    return edgeRecorder.Start((uint8_t)pings);
+  }
+
+  if (argc != 1)
+    return RESULT_BAD_PARAM;
+
+  if (edgeRecorder.IsActive())
+    return RESULT_BUSY;
+
+  if (telemetry.IsEnabled())
+    return SendEchoEdges();
+
+  CNEGR::EchoEdge edge;
+  for (uint8_t i = 0; edgeRecorder.GetEdge(i, edge) == RESULT_OK; i++)
+  {
+    output.print(edge.ping);
+    output.print(F(" "));
+    output.print(edge.level);
+    output.print(F(" "));
+    output.println(edge.timeUs);
+  }
+
+  output.print(F("lost="));
+  output.println(edgeRecorder.GetLostEdgeCount());
+
+  return RESULT_OK;
+}
+
+/// @brief Console command: cal
+///
+/// Starts the teach-in of the stop position, the car must be parked
+/// at the desired stop position
+///
+Result CalibrateCommand(Print& output, uint8_t argc, char *argv[])
+{
+  (void)output;
+  (void)argc;
+  (void)argv;
+
+  return teachIn.Start();
+}
+
+/// @brief Exchanges the sync pulses of the time slots with the other boards
+///
+void UpdateTimeSlots()
+{
+  if (!slotScheduler.IsInitialized())
+    return;
+
+  if (syncPulseSending)
+  {
+    if (millis() - syncPulseStartTimeMs < syncPulseWidthMs)
+      return;
+
+    // Release the line, the pull-up brings it back high. Its own
+    // pulse is not a received pulse, wait for the line to be high.
+    pinMode(syncPin, INPUT_PULLUP);
+    syncPulseSending = false;
+    syncLineLow      = true;
+  }
+
+  // A received pulse starts on the falling edge
+  bool lineLow = (digitalRead(syncPin) == LOW);
+  if (lineLow && !syncLineLow)
+    slotScheduler.OnSync(millis());
+
+  syncLineLow = lineLow;
+
+  if (slotScheduler.Update())
+  {
+    // Only drive the line low, the other boards may send too
+    digitalWrite(syncPin, LOW);
+    pinMode(syncPin, OUTPUT);
+    syncPulseSending     = true;
+    syncPulseStartTimeMs = millis();
+  }
+}
+
+/// @brief Feeds the running teach-in and applies and saves the new
+/// thresholds once the capture is complete
+///
+void UpdateTeachIn()
+{
+  if (!teachIn.IsActive())
+    return;
+
+  Result result = teachIn.AddSample(stateMachine->GetFilteredDistance());
+  if (result == RESULT_NO_DATA)
+    return;
+
+  if (result == RESULT_OK)
+  {
+    // The stop position can be too far for a green zone within the range of the sensor
+    CNEGR::TeachIn::Thresholds thresholds;
+    result = teachIn.GetThresholds(thresholds);
+    if (result == RESULT_OK)
+    {
+      CNEGR::PersistentConfig candidate = config;
+      candidate.nearThresholdMm        = thresholds.nearThresholdMm;
+      candidate.farThresholdMm         = thresholds.farThresholdMm;
+      candidate.maxDistanceThresholdMm = thresholds.maxDistanceThresholdMm;
+
+      result = ApplyConfig(candidate);
+    }
+
+    if (result == RESULT_OK)
+      result = configStore.Save(config);
+  }
+
+  Logger::Info(F("Teach-in returned %s, stop distance is %lu mm"), ResultToStr(result), teachIn.GetStopDistance());
+}
+
+const CNEGR::Console::Command consoleCommands[] =
+{
+  { "help",   HelpCommand },
+  { "get",    GetCommand },
+  { "set",    SetCommand },
+  { "save",   SaveCommand },
+  { "stats",  StatsCommand },
+  { "log",    LogCommand },
+  { "tlm",    TelemetryCommand },
+  { "cal",    CalibrateCommand },
+  { "boot",   BootCommand },
+  { "edges",  EdgesCommand },
+  { "latency", LatencyCommand },
+  { "wcet",   WcetCommand },
+};
+
+const uint8_t consoleCommandCount = sizeof(consoleCommands) / sizeof(consoleCommands[0]);
+
+Result HelpCommand(Print& output, uint8_t argc, char *argv[])
+{
+  (void)argc;
+  (void)argv;
+
+  for (uint8_t i = 0; i < consoleCommandCount; i++)
+    output.println(consoleCommands[i].name);
+
+  return RESULT_OK;
+}
 
 /// @brief The main app setup function
 ///
@@ -36,10 +946,20 @@ void setup()
   // Initialize serial communication at 19200 bits per second.
   Serial.begin(19200);
 
-  Logger::SetLogLevel(Logger::Level::INFO);
+  bootProfiler.Mark(CNEGR::BootProfiler::SerialReady);
+
+  // Every log line blocks for tens of milliseconds at this baud rate, only
+  // the problems are logged until the first measurement
+  Logger::SetLogLevel(fastStart ? Logger::Level::WARNING : Logger::Level::INFO);
+
+  // Load the configuration before setting up the components
+  LoadConfig();
+
+  bootProfiler.Mark(CNEGR::BootProfiler::ConfigLoaded);
 
   // Create the distance sensor object
-  distanceSensor = new CNEGR::HCSR04();
+  echoSensor     = new CNEGR::HCSR04();
+  distanceSensor = echoSensor;
   //distanceSensor = new CNEGR::MockDistanceSensor();
   // Assert if the the distanceSensor object can't be created
   assert(distanceSensor != nullptr);
@@ -48,8 +968,8 @@ void setup()
   CNEGR::IDistanceSensor::Config distanceSensorConfig;
 
   distanceSensorConfig.name       = "DistanceSensor1";
-  distanceSensorConfig.triggerPin = triggerPin;
-  distanceSensorConfig.echoPin    = echoPin;
+  distanceSensorConfig.triggerPin = config.triggerPin;
+  distanceSensorConfig.echoPin    = config.echoPin;
 
   Result result = distanceSensor->Init(distanceSensorConfig);
   if (result != RESULT_OK)
@@ -58,6 +978,95 @@ void setup()
     assert(result == RESULT_OK);
   }
 
+  // The echo edges can only be recorded when the echo pin has an external interrupt
+  if (echoSensor->SetEdgeRecorder(&edgeRecorder) != RESULT_OK)
+    Logger::Warning(F("The echo edges of %s can't be recorded"), distanceSensorConfig.name);
+
+  if (useDualSensors)
+  {
+    // The first sensor is the left one, create and setup the right one
+    CNEGR::IDistanceSensor *rightDistanceSensor = new CNEGR::HCSR04();
+    assert(rightDistanceSensor != nullptr);
+
+    distanceSensorConfig.name       = "DistanceSensor2";
+    distanceSensorConfig.triggerPin = rightTriggerPin;
+    distanceSensorConfig.echoPin    = rightEchoPin;
+
+    result = rightDistanceSensor->Init(distanceSensorConfig);
+    assert(result == RESULT_OK);
+
+    // And fuse the two sensors into a single one
+    CNEGR::IDistanceSensor *dualDistanceSensor = new CNEGR::DualDistanceSensor(distanceSensor, rightDistanceSensor,
+                                                                               sensorsBaselineMm, sensorsCrosstalkGuardMs,
+                                                                               sensorsMaxPairIntervalMs);
+    assert(dualDistanceSensor != nullptr);
+
+    distanceSensorConfig.name = "DualDistanceSensor";
+    result = dualDistanceSensor->Init(distanceSensorConfig);
+    assert(result == RESULT_OK);
+
+    distanceSensor = dualDistanceSensor;
+  }
+
+  if (useTimeSlots)
+  {
+    pinMode(syncPin, INPUT_PULLUP);
+
+    CNEGR::SlotScheduler::Config schedulerConfig;
+    schedulerConfig.slotCount         = slotCount;
+    schedulerConfig.slot              = ownSlot;
+    schedulerConfig.slotTimeMs        = slotTimeMs;
+    schedulerConfig.pingWindowMs      = slotPingWindowMs;
+    schedulerConfig.syncTimeoutFrames = syncTimeoutFrames;
+    schedulerConfig.clock             = nullptr;
+
+    result = slotScheduler.Init(schedulerConfig);
+    assert(result == RESULT_OK);
+
+    // Every ping waits for the slot of this board
+    slottedSensor = new CNEGR::SlottedDistanceSensor(distanceSensor, &slotScheduler);
+    assert(slottedSensor != nullptr);
+
+    distanceSensorConfig.name = "SlottedDistanceSensor";
+    result = slottedSensor->Init(distanceSensorConfig);
+    assert(result == RESULT_OK);
+
+    distanceSensor = slottedSensor;
+  }
+
+  if (rejectInterference)
+  {
+    // The low bits of the floating analog input are noise, the seed
+    // must be different on the boards of the neighbouring bays
+    uint32_t seed = 0;
+    for (uint8_t i = 0; i < 32; i++)
+      seed = (seed << 1) ^ (uint32_t)analogRead(0);
+
+    jitteredSensor = new CNEGR::JitteredDistanceSensor(distanceSensor, pingJitterMaxMs, consistencyToleranceMm,
+                                                       seed, nullptr);
+    assert(jitteredSensor != nullptr);
+
+    distanceSensorConfig.name = "JitteredDistanceSensor";
+    result = jitteredSensor->Init(distanceSensorConfig);
+    assert(result == RESULT_OK);
+
+    distanceSensor = jitteredSensor;
+  }
+
+  if (continuousPinging)
+  {
+    // Ping back to back, the state machine gets every sample as soon as it is ready
+    continuousSensor = new CNEGR::ContinuousDistanceSensor(distanceSensor, pingCycleTimeMs, ghostShiftMs,
+                                                           ghostToleranceMm, nullptr);
+    assert(continuousSensor != nullptr);
+
+    distanceSensorConfig.name = "ContinuousDistanceSensor";
+    result = continuousSensor->Init(distanceSensorConfig);
+    assert(result == RESULT_OK);
+
+    distanceSensor = continuousSensor;
+  }
+
   // Create the traffic light object
   //trafficLight   = new CNEGR::MockTrafficLight();
   trafficLight   = new CNEGR::DiscreteLEDTrafficLight();
@@ -68,10 +1077,10 @@ void setup()
   CNEGR::ITrafficLight::Config trafficLightConfig;
 
   trafficLightConfig.name           = "TrafficLight1";
-  trafficLightConfig.redLightPin    = redLightPin;
-  trafficLightConfig.yellowLightPin = yellowLightPin;
-  trafficLightConfig.greenLightPin  = greenLightPin;
-  trafficLightConfig.pinsPolarity   = CNEGR::SignalPolarity::ActiveHigh;
+  trafficLightConfig.redLightPin    = config.redLightPin;
+  trafficLightConfig.yellowLightPin = config.yellowLightPin;
+  trafficLightConfig.greenLightPin  = config.greenLightPin;
+  trafficLightConfig.pinsPolarity   = (CNEGR::SignalPolarity)config.lightsPolarity;
 
   result = trafficLight->Init(trafficLightConfig);
   if (result != RESULT_OK)
@@ -80,6 +1089,16 @@ void setup()
     assert(result == RESULT_OK);
   }
 
+  // Measure the latency of every light written by the state machine
+  CNEGR::ITrafficLight *instrumentedLight = new CNEGR::InstrumentedTrafficLight(trafficLight, GetCaptureTime,
+                                                                                &latencyHistogram, nullptr);
+  assert(instrumentedLight != nullptr);
+
+  result = instrumentedLight->Init(trafficLightConfig);
+  assert(result == RESULT_OK);
+
+  trafficLight = instrumentedLight;
+
   // Create the state machine object
   stateMachine = new CNEGR::StateMachine();
   // Assert if the the stateMachine object can't be created
@@ -87,25 +1106,117 @@ void setup()
 
   // Setup the state machine component
   CNEGR::StateMachine::Config stateMachineConfig;
-  stateMachineConfig.distanceSensor                     = distanceSensor;
-  stateMachineConfig.trafficLight                       = trafficLight;
-  stateMachineConfig.maxDistanceThresholdMm             = maxDistanceThresholdMm;
-  stateMachineConfig.farThresholdMm                     = farThresholdMm;
-  stateMachineConfig.nearThresholdMm                    = nearThresholdMm;
-  stateMachineConfig.movingDistanceDetectionThresholdMm = movingDistanceThresholdMm;
-  stateMachineConfig.movingTimeThresholdMs              = movingTimeThresholdMs;
-  stateMachineConfig.holdingTimeThresholdMs             = holdingTimeThresholdMs;
+  GetStateMachineConfig(config, stateMachineConfig);
 
   stateMachine->Init(stateMachineConfig);
 
+  bootProfiler.Mark(CNEGR::BootProfiler::ComponentsReady);
+
+  // Create the button object
+  button = new CNEGR::PushButton();
+  //button = new CNEGR::MockButton();
+  // Assert if the the button object can't be created
+  assert(button != nullptr);
+
+  // Setup the button component
+  CNEGR::IButton::Config buttonConfig;
+
+  buttonConfig.name            = "Button1";
+  buttonConfig.pin             = buttonPin;
+  buttonConfig.polarity        = CNEGR::SignalPolarity::ActiveLow;
+  buttonConfig.debounceTimeMs  = buttonDebounceTimeMs;
+  buttonConfig.longPressTimeMs = buttonLongPressTimeMs;
+
+  result = button->Init(buttonConfig);
+  assert(result == RESULT_OK);
+
+  // Setup the teach-in, it is started from the button or the console
+  CNEGR::TeachIn::Config teachInConfig;
+  teachInConfig.sampleCount       = teachInSampleCount;
+  teachInConfig.maxMissedSamples  = teachInMaxMissedSamples;
+  teachInConfig.maxSpreadMm       = teachInMaxSpreadMm;
+  teachInConfig.stopToleranceMm   = teachInStopToleranceMm;
+  teachInConfig.yellowZoneMm      = teachInYellowZoneMm;
+  teachInConfig.greenZoneMm       = teachInGreenZoneMm;
+  teachInConfig.maxRangeMm        = teachInMaxRangeMm;
+
+  result = teachIn.Init(teachInConfig);
+  assert(result == RESULT_OK);
+
+  // Setup the telemetry, it is started from the console
+  result = telemetry.Init(&Serial);
+  assert(result == RESULT_OK);
+
+  // Setup the console on the serial port
+  result = console.Init(&Serial, consoleCommands, consoleCommandCount);
+  assert(result == RESULT_OK);
+
+  // Start the first update right away instead of waiting for a full period
+  lastUpdateTimeMs = millis() - waitTimeBetweenMeasurementsMs;
+
   // Everything is now setup up abd ready to go
+  bootProfiler.Mark(CNEGR::BootProfiler::SetupDone);
 }
 
 /// @brief The main app loop
 ///
 void loop()
 {
-  stateMachine->Update();
+  uint32_t iterationStartTimeUs = micros();
+  bool     idle                 = true;
+
+  // Collect the console input without blocking
+  console.Poll();
+
+  ProcessButtonEvents();
+
+  UpdateTimeSlots();
+
+  // Start a state machine update every waitTimeBetweenMeasurementsMs. The update
+  // returns RESULT_BUSY while the lights test or the measurement is in progress,
+  // the loop keeps running in the meantime and resumes it on the next iteration.
+  // With the continuous pinging the sensor sets the pace, the update runs all the
+  // time and completes whenever a sample is ready. With the time slots the
+  // measurement waits for the slot, the update runs all the time too.
+  if (continuousPinging || useTimeSlots || updatePending || (millis() - lastUpdateTimeMs >= waitTimeBetweenMeasurementsMs))
+  {
+    if (!updatePending)
+      lastUpdateTimeMs = millis();
+
+    updateProfiler.Begin(stateMachine->GetState());
+    Result result = stateMachine->Update();
+    updateProfiler.End(stateMachine->GetState(), result);
 
-  delay(waitTimeBetweenMeasurementsMs);
+    updatePending = (result == RESULT_BUSY);
+
+    UpdateBootProfile(!updatePending);
+
+    if (!updatePending)
+    {
+      idle = false;
+
+      // The teach-in takes one reading per update so that it never stalls the loop
+      UpdateTeachIn();
+    }
+  }
+
+  // Run the pending console command, if any, after the measurement
+  // so that it never delays it
+  if (console.Execute() != RESULT_NO_DATA)
+    idle = false;
+
+  if (telemetry.IsEnabled() && (millis() - lastStatisticsTimeMs >= telemetryStatisticsPeriodMs))
+  {
+    lastStatisticsTimeMs = millis();
+    SendStatistics();
+  }
+
+  // Account the iterations that only waited, this is the CPU time
+  // available to other tasks
+  if (idle)
+  {
+    uint32_t idleTimeUs = idleTimeRemainderUs + (micros() - iterationStartTimeUs);
+    idleTimeMs         += idleTimeUs / 1000;
+    idleTimeRemainderUs = (uint16_t)(idleTimeUs % 1000);
+  }
 }
@@ -9,9 +9,12 @@
 
 #include "DistanceSensor.h"
 #include "DebugUtils.h"
+#include "SpeedOfSound.h"
 
 namespace CNEGR
 {
+  DistanceSensor * volatile DistanceSensor::_interruptInstances[DISTANCESENSOR_MAX_INTERRUPT_INSTANCES] = { nullptr };
+
   /// @brief Constructor.
   DistanceSensor::DistanceSensor(uint32_t       minTriggerPulseDurationUs,  ///< The minimum trigger pulse duration in microseconds
                                  uint32_t       minDistanceMm,              ///< The minimum distance the sensor can detect in millimeters
@@ -25,10 +28,24 @@ namespace CNEGR
     _minTriggerPulseDurationUs(minTriggerPulseDurationUs),
     _minDistanceMm(minDistanceMm),
     _maxDistanceMm(maxDistanceMm),
+    _rangeLimitMm(maxDistanceMm),
     _triggerPolarity(triggerPolarity),
-    _echoPolarity(echoPolarity)
+    _echoPolarity(echoPolarity),
+    _interruptSlot(-1),
+    _speedOfSound(0),
+    _maxWaitDurationUs(0),
+    _triggerTimeUs(0),
+    _echoArmed(false),
+    _echoEdges(0),
+    _echoStartTimeUs(0),
+    _echoEndTimeUs(0),
+    _edgeRecorder(nullptr),
+    _missingResponses(0),
+    _reconnectAttempts(0),
+    _captureTimeUs(0)
   {
     _name[0] = '\0';
+    PT_INIT(&_measurement);
   }
 
   /// @brief Default destructor.
@@ -74,6 +91,16 @@ namespace CNEGR
     // Configure the echo pin as an intput.
     pinMode(_echoPin, INPUT);
 
+    // The full range until the application limits it
+    _rangeLimitMm = _maxDistanceMm;
+
+    _missingResponses  = 0;
+    _reconnectAttempts = 0;
+
+    // Capture the echo with interrupts if the pin supports them
+    PT_INIT(&_measurement);
+    AttachEchoInterrupt();
+
     // Set the init done flag
     _initDone = true;
     return RESULT_OK;
@@ -92,6 +119,11 @@ namespace CNEGR
   ///
   void DistanceSensor::Deinit()
   {
+    if (_initDone)
+      DetachEchoInterrupt();
+
+    _edgeRecorder = nullptr;
+
     // Clear the name
     _name[0] = '\0';
 
@@ -130,37 +162,300 @@ namespace CNEGR
   /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
   ///                           of error state.
   Result DistanceSensor::MeasureDistance(uint32_t ambientTemperature, uint32_t& distance)
+  {
+    return MeasureDistance(ambientTemperature, DEFAULT_RELATIVE_HUMIDITY, distance);
+  }
+
+  /// @brief Measures the distance and adjusts the result for the ambient temperature and relative humidity.
+  ///
+  /// @note Temperatures below zero are passed as the two's complement of the value.
+  ///
+  /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+  /// @param relativeHumidity   The relative humidity in percent
+  /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+  ///                           of error state.
+  Result DistanceSensor::MeasureDistance(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance)
   {
     if (!IsInitialized())
       return RESULT_NOT_READY;
 
+    uint16_t speedOfSound = GetSpeedOfSound((int32_t)ambientTemperature, relativeHumidity);
+
     // Trigger the distance measurement
     TriggerMeasurement();
 
     // Read the distance from the sensor
     distance = 0;
-    Result result = ReadDistance(ambientTemperature, distance);
+    Result result = ReadDistance(speedOfSound, distance);
 
     return result;
   }
 
-  /// @brief Gets the speed of sound at the specified ambient temperature
+  /// @brief Measures the distance without blocking.
+  ///
+  /// @note The first call starts the measurement and the method must then be called
+  /// repeatedly until it returns something else than RESULT_BUSY. The temperature
+  /// and humidity passed to the first call are used for the whole measurement.
   ///
   /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+  /// @param relativeHumidity   The relative humidity in percent
+  /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_BUSY       The measurement is in progress.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+  ///                           of error state.
+  Result DistanceSensor::MeasureDistanceAsync(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    // Without the interrupt the echo can only be measured by polling
+    if (_interruptSlot < 0)
+      return MeasureDistance(ambientTemperature, relativeHumidity, distance);
+
+    PT_BEGIN(&_measurement);
+
+    _speedOfSound      = GetSpeedOfSound((int32_t)ambientTemperature, relativeHumidity);
+    _maxWaitDurationUs = DistanceToEchoTime(_speedOfSound, _rangeLimitMm);
+
+    // Arm the capture, the trigger pulse is short enough to be generated in place
+    _echoEdges = 0;
+    _echoArmed = true;
+
+    if (_edgeRecorder != nullptr)
+    {
+      // The interrupt handler must not see a half updated trigger time
+      noInterrupts();
+      _edgeRecorder->OnTrigger(micros());
+      interrupts();
+    }
+
+    TriggerMeasurement();
+    _triggerTimeUs = micros();
+
+    // Wait for the raising edge of the echo pulse
+    PT_WAIT_UNTIL(&_measurement, (_echoEdges != 0) || (micros() - _triggerTimeUs >= _maxWaitDurationUs));
+
+    if (_echoEdges == 0)
+    {
+      _echoArmed     = false;
+      _captureTimeUs = micros();
+      Logger::Debug(F("Timeout waiting for the echo pulse raising edge!"));
+      PT_EXIT(&_measurement, OnMissingResponse());
+    }
+
+    _missingResponses = 0;
+
+    // Wait for the falling edge of the echo pulse, the start time
+    // doesn't change anymore so it can be read safely
+    PT_WAIT_UNTIL(&_measurement, (_echoEdges == 2) || (micros() - _echoStartTimeUs >= _maxWaitDurationUs));
+
+    _echoArmed = false;
+
+    if (_echoEdges != 2)
+    {
+      _captureTimeUs = micros();
+      Logger::Debug(F("Timeout waiting for the echo pulse falling edge!"));
+      PT_EXIT(&_measurement, RESULT_TIMEOUT);
+    }
+
+    _captureTimeUs = _echoEndTimeUs;
+    distance = Time2Distance(_speedOfSound, _echoEndTimeUs - _echoStartTimeUs);
+
+    PT_END(&_measurement);
+  }
+
+  /// @brief Limits the range of the measurements
+  ///
+  /// @note The echo timeout is computed from the range limit, so a shorter range makes
+  /// the measurements without target shorter. A target beyond the limit is reported as
+  /// a timeout. The limit is clipped to the maximum distance the sensor can detect.
+  ///
+  /// @param rangeLimitMm       The range limit in millimeters, 0 to use the full range
+  ///
+  /// @retval RESULT_OK         The range limit was changed.
+  /// @retval RESULT_NOT_READY  The sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_BAD_PARAM  The range limit is below the minimum distance the sensor can detect.
+  ///
+  Result DistanceSensor::SetRangeLimit(uint32_t rangeLimitMm)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    if (rangeLimitMm == 0)
+      rangeLimitMm = _maxDistanceMm;
+
+    if (rangeLimitMm < _minDistanceMm)
+      return RESULT_BAD_PARAM;
+
+    // Takes effect with the next measurement, the one in progress keeps its timeout
+    _rangeLimitMm = (rangeLimitMm < _maxDistanceMm) ? rangeLimitMm : _maxDistanceMm;
+    return RESULT_OK;
+  }
+
+  /// @brief Sets the recorder receiving every edge of the echo signal
+  ///
+  /// @note Only the asynchronous measurements record the edges, the recorder
+  /// decides when the capture starts and stops.
+  ///
+  /// @param recorder           The recorder, nullptr to remove it
   ///
-  float SpeedOfSound(uint32_t ambientTemperature)
+  /// @retval RESULT_OK         The recorder was set.
+  /// @retval RESULT_NOT_READY  The sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_NOT_SUP    The echo pin doesn't support interrupts, the echo is polled.
+  ///
+  Result DistanceSensor::SetEdgeRecorder(EchoEdgeRecorder *recorder)
   {
-    return 331.4f + (0.6f * (float)ambientTemperature / 10.0f);
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    if (_interruptSlot < 0)
+      return RESULT_NOT_SUP;
+
+    _edgeRecorder = recorder;
+    return RESULT_OK;
   }
 
-  uint32_t DistanceSensor::Time2Distance(uint32_t ambientTemperature, uint32_t timeUs)
+  /// @brief Gets the number of times the pins were configured again because the device didn't answer
+  ///
+  /// @retval The number of reconfigurations since Init()
+  ///
+  uint32_t DistanceSensor::GetReconnectAttempts() const
   {
-    // The distance in meters is calculated as:
-    //   distance = timeInSeconds / speedOfSound / 2;
+    return _reconnectAttempts;
+  }
 
-    // Calculate the distance in millimeters
-    uint32_t distanceMm = ((float)timeUs/1000.0f/1000.0f * (SpeedOfSound(ambientTemperature) / 2)) * 1000.0f;
-    return distanceMm;
+  /// @brief Gets the time when the last measurement ended
+  ///
+  /// @note This is the time of the echo falling edge, or the time the timeout was
+  /// detected, so the delay until the result is acted upon can be measured.
+  ///
+  /// @retval The time in microseconds, 0 before the first measurement
+  ///
+  uint32_t DistanceSensor::GetLastCaptureTime() const
+  {
+    return _captureTimeUs;
+  }
+
+  /// @brief Accounts a ping without echo pulse
+  ///
+  /// @retval RESULT_TIMEOUT    The device didn't answer, a single missing pulse can be a glitch.
+  /// @retval RESULT_DEV_ERR    The device didn't answer the last pings, the pins were configured again.
+  ///
+  Result DistanceSensor::OnMissingResponse()
+  {
+    if (_missingResponses < DISTANCESENSOR_MAX_MISSING_RESPONSES)
+      _missingResponses++;
+
+    if (_missingResponses < DISTANCESENSOR_MAX_MISSING_RESPONSES)
+      return RESULT_TIMEOUT;
+
+    // Configure the pins again, as Init() does, for a sensor plugged back in
+    DetachEchoInterrupt();
+    pinMode(_triggerPin, OUTPUT);
+    pinMode(_echoPin, INPUT);
+    AttachEchoInterrupt();
+
+    _reconnectAttempts++;
+    return RESULT_DEV_ERR;
+  }
+
+  /// @brief Attaches the echo interrupt handler if the echo pin supports it
+  ///
+  void DistanceSensor::AttachEchoInterrupt()
+  {
+    static void (* const handlers[DISTANCESENSOR_MAX_INTERRUPT_INSTANCES])() = { OnEchoChange0, OnEchoChange1 };
+
+    _interruptSlot = -1;
+
+    int interrupt = digitalPinToInterrupt(_echoPin);
+    if (interrupt == NOT_AN_INTERRUPT)
+      return;
+
+    for (uint8_t slot = 0; slot < DISTANCESENSOR_MAX_INTERRUPT_INSTANCES; slot++)
+    {
+      if (_interruptInstances[slot] == nullptr)
+      {
+        _echoArmed = false;
+        _interruptInstances[slot] = this;
+        _interruptSlot = (int8_t)slot;
+        attachInterrupt(interrupt, handlers[slot], CHANGE);
+        return;
+      }
+    }
+  }
+
+  /// @brief Detaches the echo interrupt handler
+  ///
+  void DistanceSensor::DetachEchoInterrupt()
+  {
+    if (_interruptSlot < 0)
+      return;
+
+    detachInterrupt(digitalPinToInterrupt(_echoPin));
+    _interruptInstances[_interruptSlot] = nullptr;
+    _interruptSlot = -1;
+  }
+
+  /// @brief Timestamps the echo edges
+  ///
+  /// @note Called from the interrupt handler only
+  ///
+  void DistanceSensor::OnEchoChange()
+  {
+    uint32_t now   = micros();
+    bool     level = GetEchoPinState();
+
+    // The recorder gets the timestamp taken above, it doesn't delay the measurement
+    EchoEdgeRecorder *recorder = _edgeRecorder;
+    if (recorder != nullptr)
+      recorder->OnEdge(now, level);
+
+    if (!_echoArmed)
+      return;
+
+    if (level)
+    {
+      if (_echoEdges == 0)
+      {
+        _echoStartTimeUs = now;
+        _echoEdges = 1;
+      }
+    }
+    else if (_echoEdges == 1)
+    {
+      _echoEndTimeUs = now;
+      _echoEdges = 2;
+    }
+  }
+
+  void DistanceSensor::OnEchoChange0()
+  {
+    DistanceSensor *sensor = _interruptInstances[0];
+    if (sensor != nullptr)
+      sensor->OnEchoChange();
+  }
+
+  void DistanceSensor::OnEchoChange1()
+  {
+    DistanceSensor *sensor = _interruptInstances[1];
+    if (sensor != nullptr)
+      sensor->OnEchoChange();
+  }
+
+  uint32_t DistanceSensor::Time2Distance(uint16_t speedOfSound, uint32_t timeUs)
+  {
+    // The distance is calculated as:
+    //   distance = time * speedOfSound / 2;
+    return EchoTimeToDistance(speedOfSound, timeUs);
   }
 
   void DistanceSensor::SetTriggerPintState(bool active)
@@ -193,16 +488,6 @@ namespace CNEGR
     delayMicroseconds(_minTriggerPulseDurationUs/5);
   }
 
-  static uint32_t Distance2Time(uint32_t ambientTemperature, uint32_t distanceMm)
-  {
-    // The time in seconds is calculated as:
-    //    timeInSeconds = distance * 2 / speedOfSound;
-
-    // Calculate the distance in millimeters
-    uint32_t timeUs = ((float)distanceMm/1000.0f / (SpeedOfSound(ambientTemperature) / 2)) * 1000.0f * 1000.0f;
-    return timeUs;
-  }
-
   bool DistanceSensor::GetEchoPinState()
   {
     bool rawPinState = (digitalRead(_echoPin) != 0 ? true : false);
@@ -210,10 +495,10 @@ namespace CNEGR
     return ((_echoPolarity == SignalPolarity::ActiveHigh) ? rawPinState : !rawPinState);
   }
 
-  Result DistanceSensor::ReadDistance(uint32_t ambientTemperature, uint32_t& distance)
+  Result DistanceSensor::ReadDistance(uint16_t speedOfSound, uint32_t& distance)
   {
     // Calculate the maximum wait duration for the echo pulse
-    uint32_t maxWaitDurationUs = Distance2Time(ambientTemperature, _maxDistanceMm);
+    uint32_t maxWaitDurationUs = DistanceToEchoTime(speedOfSound, _rangeLimitMm);
     Logger::Debug(F("maxWaitDurationUs is %u us"), maxWaitDurationUs);
 
     bool echoPinState = false;
@@ -231,20 +516,18 @@ namespace CNEGR
       time = micros();
     };
 
-    // Did not see the raising edge of the echo pulse
-    // Possible reasons:
-    //  (1) The sensor is not working correctly, or
-    //  (2) The sensor is not connected to the board or
-    //  (3) There are no objects in the detection range
-    //
-    // Since we can't differentiate between these reasons
-    // we simply return a timeout error
+    // Did not see the raising edge of the echo pulse. The sensor raises the
+    // echo pin even when there are no objects in the detection range, so
+    // either it is not working correctly or it is not connected to the board
     if (echoPinState == false)
     {
+      _captureTimeUs = time;
       Logger::Debug(F("Timeout waiting for the echo pulse raising edge!"));
-      return RESULT_TIMEOUT;
+      return OnMissingResponse();
     }
 
+    _missingResponses = 0;
+
     // The echo pulse started so record the time when this happen
     uint32_t echoPulseStartTimeUs = micros();
 
@@ -268,6 +551,8 @@ namespace CNEGR
     //
     // Since we can't differentiate between these reasons
     // we simply return a timeout error
+    _captureTimeUs = time;
+
     if (echoPinState == true)
     {
       Logger::Debug(F("Timeout waiting for the echo pulse falling edge!"));
@@ -279,7 +564,7 @@ namespace CNEGR
 
     Logger::Debug(F("echoPulseDurationUs is %u us"), echoPulseDurationUs);
 
-    distance = Time2Distance(ambientTemperature, echoPulseDurationUs);
+    distance = Time2Distance(speedOfSound, echoPulseDurationUs);
     return RESULT_OK;
   }
 }
@@ -13,13 +13,33 @@
 
 #include "IDistanceSensor.h"
 #include "CommonDefines.h"
+#include "Protothread.h"
+#include "EchoEdgeRecorder.h"
 
 namespace CNEGR
 {
   #define MAX_SENSOR_NAME_LENGTH MAX_COMPONENT_NAME_LENGTH
 
+  /// The maximum number of sensors capturing the echo with interrupts
+  #define DISTANCESENSOR_MAX_INTERRUPT_INSTANCES 2
+
+  /// The number of consecutive pings without echo pulse after which the sensor is considered disconnected
+  #define DISTANCESENSOR_MAX_MISSING_RESPONSES 5
+
   /// @brief DistanceSensor class definition
   ///
+  /// MeasureDistance() polls the echo pin. MeasureDistanceAsync() timestamps the echo
+  /// edges in an interrupt handler when the echo pin supports external interrupts, so
+  /// the main loop is free while the echo travels. Otherwise it falls back to polling.
+  ///
+  /// The sensor answers every trigger with an echo pulse, even when there is nothing in
+  /// range: the pulse then ends when the sensor gives up or it is cut short by the range
+  /// limit, which is reported as a timeout. A ping without echo pulse at all means that
+  /// nothing answered, after DISTANCESENSOR_MAX_MISSING_RESPONSES of them in a row the
+  /// sensor is considered disconnected: the pins are configured again so that a sensor
+  /// plugged back in answers the next ping, and the pings return RESULT_DEV_ERR until
+  /// it does.
+  ///
   class DistanceSensor: public IDistanceSensor
   {
   public:
@@ -81,18 +101,117 @@ namespace CNEGR
     ///                           of error state.
     virtual Result MeasureDistance(uint32_t ambientTemperature, uint32_t& distance);
 
+    /// @brief Measures the distance and adjusts the result for the ambient temperature and relative humidity.
+    ///
+    /// @note Temperatures below zero are passed as the two's complement of the value.
+    ///
+    /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+    /// @param relativeHumidity   The relative humidity in percent
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+    ///                           of error state.
+    virtual Result MeasureDistance(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance);
+
+    /// @brief Measures the distance without blocking.
+    ///
+    /// @note The first call starts the measurement and the method must then be called
+    /// repeatedly until it returns something else than RESULT_BUSY. The temperature
+    /// and humidity passed to the first call are used for the whole measurement.
+    ///
+    /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+    /// @param relativeHumidity   The relative humidity in percent
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_BUSY       The measurement is in progress.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+    ///                           of error state.
+    virtual Result MeasureDistanceAsync(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance);
+
+    /// @brief Limits the range of the measurements
+    ///
+    /// @note The echo timeout is computed from the range limit, so a shorter range makes
+    /// the measurements without target shorter. A target beyond the limit is reported as
+    /// a timeout. The limit is clipped to the maximum distance the sensor can detect.
+    ///
+    /// @param rangeLimitMm       The range limit in millimeters, 0 to use the full range
+    ///
+    /// @retval RESULT_OK         The range limit was changed.
+    /// @retval RESULT_NOT_READY  The sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_BAD_PARAM  The range limit is below the minimum distance the sensor can detect.
+    ///
+    virtual Result SetRangeLimit(uint32_t rangeLimitMm);
+
+    /// @brief Sets the recorder receiving every edge of the echo signal
+    ///
+    /// @note Only the asynchronous measurements record the edges, the recorder
+    /// decides when the capture starts and stops.
+    ///
+    /// @param recorder           The recorder, nullptr to remove it
+    ///
+    /// @retval RESULT_OK         The recorder was set.
+    /// @retval RESULT_NOT_READY  The sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_NOT_SUP    The echo pin doesn't support interrupts, the echo is polled.
+    ///
+    Result SetEdgeRecorder(EchoEdgeRecorder *recorder);
+
+    /// @brief Gets the number of times the pins were configured again because the device didn't answer
+    ///
+    /// @retval The number of reconfigurations since Init()
+    ///
+    uint32_t GetReconnectAttempts() const;
+
+    /// @brief Gets the time when the last measurement ended
+    ///
+    /// @note This is the time of the echo falling edge, or the time the timeout was
+    /// detected, so the delay until the result is acted upon can be measured.
+    ///
+    /// @retval The time in microseconds, 0 before the first measurement
+    ///
+    uint32_t GetLastCaptureTime() const;
+
   protected:
     /// @brief Converts duration to a distance
     ///
-    /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+    /// @param speedOfSound       The speed of sound in centimeters per second
     /// @param timeUs             The duration in microseconds
     ///
     /// @retval The measured distance
-    uint32_t Time2Distance(uint32_t ambientTemperature, uint32_t timeUs);
+    uint32_t Time2Distance(uint16_t speedOfSound, uint32_t timeUs);
 
   private:
+    /// @brief Attaches the echo interrupt handler if the echo pin supports it
+    ///
+    void AttachEchoInterrupt();
+
+    /// @brief Detaches the echo interrupt handler
+    ///
+    void DetachEchoInterrupt();
+
+    /// @brief Timestamps the echo edges
+    ///
+    /// @note Called from the interrupt handler only
+    ///
+    void OnEchoChange();
+
+    static void OnEchoChange0();
+    static void OnEchoChange1();
+
+    /// @brief Accounts a ping without echo pulse
+    ///
+    /// @retval RESULT_TIMEOUT    The device didn't answer, a single missing pulse can be a glitch.
+    /// @retval RESULT_DEV_ERR    The device didn't answer the last pings, the pins were configured again.
+    ///
+    Result OnMissingResponse();
+
     void TriggerMeasurement();
-    Result ReadDistance(uint32_t ambientTemperature, uint32_t& distance);
+    Result ReadDistance(uint16_t speedOfSound, uint32_t& distance);
     void SetTriggerPintState(bool active);
     bool GetEchoPinState();
 
@@ -108,8 +227,27 @@ namespace CNEGR
     uint32_t        _minTriggerPulseDurationUs;       ///< The minimum trigger pulse duration in microseconds
     uint32_t        _minDistanceMm;                   ///< The minimum distance the sensor can detect in millimeters
     uint32_t        _maxDistanceMm;                   ///< The maximum distance the sensor can detect in millimeters
+    uint32_t        _rangeLimitMm;                    ///< The distance beyond which the echo is not waited for in millimeters
     SignalPolarity  _triggerPolarity;                 ///< The trigger signal polarity
     SignalPolarity  _echoPolarity;                    ///< The echo signal polarity
+
+  private:
+    static DistanceSensor * volatile _interruptInstances[DISTANCESENSOR_MAX_INTERRUPT_INSTANCES];  ///< The sensors using interrupts
+
+  private:
+    int8_t            _interruptSlot;                 ///< The index in _interruptInstances, -1 if the echo is polled
+    Protothread       _measurement;                   ///< The asynchronous measurement state
+    uint16_t          _speedOfSound;                  ///< The speed of sound used by the asynchronous measurement
+    uint32_t          _maxWaitDurationUs;             ///< The echo timeout of the asynchronous measurement
+    uint32_t          _triggerTimeUs;                 ///< The time when the asynchronous measurement was triggered
+    volatile bool     _echoArmed;                     ///< A flag to indicate whether the echo edges are captured
+    volatile uint8_t  _echoEdges;                     ///< The number of echo edges captured, 0 to 2
+    volatile uint32_t _echoStartTimeUs;               ///< The time of the echo rising edge
+    volatile uint32_t _echoEndTimeUs;                 ///< The time of the echo falling edge
+    EchoEdgeRecorder * volatile _edgeRecorder;        ///< The recorder of the echo edges, nullptr if none
+    uint8_t           _missingResponses;              ///< The number of consecutive pings without echo pulse
+    uint32_t          _reconnectAttempts;             ///< The number of times the pins were configured again
+    uint32_t          _captureTimeUs;                 ///< The time when the last measurement ended
   };
 }
 #endif // _DISTANCESENSOR_H_
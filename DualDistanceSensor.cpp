@@ -0,0 +1,415 @@
+///
+/// @file DualDistanceSensor.cpp
+///
+/// @brief DualDistanceSensor class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "DualDistanceSensor.h"
+#include "DebugUtils.h"
+#include "SpeedOfSound.h"
+
+namespace CNEGR
+{
+  const uint8_t LEFT_SENSOR  = 0;
+  const uint8_t RIGHT_SENSOR = 1;
+
+  /// @brief Divides and rounds half away from zero
+  ///
+  static inline int32_t RoundedDivide(int32_t value, int32_t divisor)
+  {
+    return (value + ((value < 0) ? -(divisor / 2) : (divisor / 2))) / divisor;
+  }
+
+  /// @brief Constructor.
+  DualDistanceSensor::DualDistanceSensor(IDistanceSensor  *leftSensor,              ///< The sensor mounted on the left side
+                                         IDistanceSensor  *rightSensor,             ///< The sensor mounted on the right side
+                                         uint32_t         baselineMm,               ///< The distance between the two sensors in millimeters
+                                         uint32_t         crosstalkGuardTimeMs,     ///< The minimum time between two pings in milliseconds
+                                         uint32_t         maxPairIntervalMs         ///< The maximum time between the pings of a fused pair in milliseconds
+                                        )
+    :_initDone(false),
+     _baselineMm(baselineMm),
+     _crosstalkGuardTimeMs(crosstalkGuardTimeMs),
+     _maxPairIntervalMs(maxPairIntervalMs),
+     _nextSensor(LEFT_SENSOR),
+     _lastPingTimeMs(0),
+     _lateralOffsetMm(0),
+     _yawMrad(0),
+     _pendingSensor(LEFT_SENSOR),
+     _sensorResult(RESULT_OK),
+     _sensorDistance(0)
+  {
+    _name[0] = '\0';
+    _sensors[LEFT_SENSOR]    = leftSensor;
+    _sensors[RIGHT_SENSOR]   = rightSensor;
+    _distances[LEFT_SENSOR]  = UINT32_MAX;
+    _distances[RIGHT_SENSOR] = UINT32_MAX;
+    _pingTimesMs[LEFT_SENSOR]  = 0;
+    _pingTimesMs[RIGHT_SENSOR] = 0;
+    _valid[LEFT_SENSOR]      = false;
+    _valid[RIGHT_SENSOR]     = false;
+    _lost[LEFT_SENSOR]       = false;
+    _lost[RIGHT_SENSOR]      = false;
+    PT_INIT(&_measurement);
+  }
+
+  /// @brief Destructor.
+  DualDistanceSensor::~DualDistanceSensor()
+  {
+    Deinit();
+  }
+
+  /// @brief Initialization function.
+  ///
+  /// @note Both sensors must be initialized before calling this method
+  ///
+  /// @param configuration      The configuration data. Only the name is used.
+  ///
+  /// @retval RESULT_OK         The device was successfully configured.
+  /// @retval RESULT_BUSY       The  device was already configured.
+  ///                           Deinit() must be called before calling Init() again.
+  /// @retval RESULT_DEV_ERR    One of the sensors is not initialized.
+  /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+  ///
+  Result DualDistanceSensor::Init(const Config& configuration)
+  {
+    if (IsInitialized())
+    {
+      // Already initialized
+      return RESULT_BUSY;
+    }
+
+    if ((configuration.name == NULL) || (_sensors[LEFT_SENSOR] == nullptr) || (_sensors[RIGHT_SENSOR] == nullptr) ||
+        (_baselineMm == 0) || (_maxPairIntervalMs < _crosstalkGuardTimeMs))
+    {
+      // Invalid name, sensors, geometry or timing
+      return RESULT_BAD_PARAM;
+    }
+
+    if (!_sensors[LEFT_SENSOR]->IsInitialized() || !_sensors[RIGHT_SENSOR]->IsInitialized())
+    {
+      return RESULT_DEV_ERR;
+    }
+
+    // Copy the name
+    strncpy((char *)(&_name[0]), configuration.name, sizeof(_name)-1);
+
+    _nextSensor              = LEFT_SENSOR;
+    _lastPingTimeMs          = millis() - _crosstalkGuardTimeMs;
+    _distances[LEFT_SENSOR]  = UINT32_MAX;
+    _distances[RIGHT_SENSOR] = UINT32_MAX;
+    _valid[LEFT_SENSOR]      = false;
+    _valid[RIGHT_SENSOR]     = false;
+    _lost[LEFT_SENSOR]       = false;
+    _lost[RIGHT_SENSOR]      = false;
+    _lateralOffsetMm         = 0;
+    _yawMrad                 = 0;
+    PT_INIT(&_measurement);
+
+    // Set the init done flag
+    _initDone = true;
+    return RESULT_OK;
+  }
+
+  /// @brief Get whether the sensor device was initialized
+  ///
+  /// @return boolean true if it is initialized
+  /// and available for use
+  bool DualDistanceSensor::IsInitialized() const
+  {
+    return _initDone;
+  }
+
+  /// @brief Deinitialization function for the device.
+  ///
+  /// @note The two sensors are not deinitialized
+  ///
+  void DualDistanceSensor::Deinit()
+  {
+    // Clear the name
+    _name[0] = '\0';
+
+    // And reset the init done flag
+    _initDone = false;
+  }
+
+  /// @brief Measures the distance.
+  ///
+  /// @param distance           Contains the fused distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_TIMEOUT    Neither of the sensors sees the subject.
+  /// @retval RESULT_DEV_ERR    Both sensors are not present or are in some kind
+  ///                           of error state.
+  Result DualDistanceSensor::MeasureDistance(uint32_t& distance)
+  {
+    const uint32_t ambientTemperature = 20 * 10;
+    return MeasureDistance(ambientTemperature, distance);
+  }
+
+  /// @brief Measures the distance and adjusts the result for the ambient temperature.
+  ///
+  /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+  /// @param distance           Contains the fused distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_TIMEOUT    Neither of the sensors sees the subject.
+  /// @retval RESULT_DEV_ERR    Both sensors are not present or are in some kind
+  ///                           of error state.
+  Result DualDistanceSensor::MeasureDistance(uint32_t ambientTemperature, uint32_t& distance)
+  {
+    return MeasureDistance(ambientTemperature, DEFAULT_RELATIVE_HUMIDITY, distance);
+  }
+
+  /// @brief Measures the distance and adjusts the result for the ambient temperature and relative humidity.
+  ///
+  /// @note Temperatures below zero are passed as the two's complement of the value.
+  ///
+  /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+  /// @param relativeHumidity   The relative humidity in percent
+  /// @param distance           Contains the fused distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_TIMEOUT    Neither of the sensors sees the subject.
+  /// @retval RESULT_DEV_ERR    Both sensors are not present or are in some kind
+  ///                           of error state.
+  Result DualDistanceSensor::MeasureDistance(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    // Make sure that the echo of the previous ping has died out before
+    // pinging the other sensor. This is usually already the case since the
+    // application waits between measurements.
+    uint32_t elapsedMs = millis() - _lastPingTimeMs;
+    if (elapsedMs < _crosstalkGuardTimeMs)
+      delay(_crosstalkGuardTimeMs - elapsedMs);
+
+    uint8_t which = _nextSensor;
+    _nextSensor = (which == LEFT_SENSOR) ? RIGHT_SENSOR : LEFT_SENSOR;
+
+    _lastPingTimeMs = millis();
+
+    uint32_t sensorDistance = 0;
+    Result result = _sensors[which]->MeasureDistance(ambientTemperature, relativeHumidity, sensorDistance);
+
+    return Update(which, result, sensorDistance, distance);
+  }
+
+  /// @brief Measures the distance without blocking.
+  ///
+  /// @note The first call starts the measurement and the method must then be called
+  /// repeatedly until it returns something else than RESULT_BUSY. The temperature
+  /// and humidity passed to the first call are used for the whole measurement.
+  ///
+  /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+  /// @param relativeHumidity   The relative humidity in percent
+  /// @param distance           Contains the fused distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_BUSY       The measurement is in progress.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_TIMEOUT    Neither of the sensors sees the subject.
+  /// @retval RESULT_DEV_ERR    Both sensors are not present or are in some kind
+  ///                           of error state.
+  Result DualDistanceSensor::MeasureDistanceAsync(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    PT_BEGIN(&_measurement);
+
+    // Let the echo of the previous ping die out, without blocking
+    PT_WAIT_UNTIL(&_measurement, millis() - _lastPingTimeMs >= _crosstalkGuardTimeMs);
+
+    _pendingSensor = _nextSensor;
+    _nextSensor = (_pendingSensor == LEFT_SENSOR) ? RIGHT_SENSOR : LEFT_SENSOR;
+
+    _lastPingTimeMs = millis();
+
+    PT_WAIT_UNTIL(&_measurement, (_sensorResult = _sensors[_pendingSensor]->MeasureDistanceAsync(ambientTemperature, relativeHumidity, _sensorDistance)) != RESULT_BUSY);
+
+    PT_EXIT(&_measurement, Update(_pendingSensor, _sensorResult, _sensorDistance, distance));
+
+    PT_END(&_measurement);
+  }
+
+  /// @brief Limits the range of the measurements
+  ///
+  /// @note The limit is applied to both sensors.
+  ///
+  /// @param rangeLimitMm       The range limit in millimeters, 0 to use the full range
+  ///
+  /// @retval RESULT_OK         The range limit was changed.
+  /// @retval RESULT_NOT_READY  The sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_BAD_PARAM  The range limit is below the minimum distance the sensors can detect.
+  ///
+  Result DualDistanceSensor::SetRangeLimit(uint32_t rangeLimitMm)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    Result result = _sensors[LEFT_SENSOR]->SetRangeLimit(rangeLimitMm);
+    if (result != RESULT_OK)
+      return result;
+
+    return _sensors[RIGHT_SENSOR]->SetRangeLimit(rangeLimitMm);
+  }
+
+  /// @brief Stores the result of a sensor measurement and fuses the readings
+  ///
+  /// @param which              The sensor that measured the distance
+  /// @param result             The measurement result
+  /// @param sensorDistance     The distance measured by the sensor
+  /// @param distance           Contains the fused distance in millimeters if successful.
+  ///
+  /// @retval RESULT_OK         At least one sensor sees the subject.
+  /// @retval RESULT_TIMEOUT    Neither of the sensors sees the subject.
+  /// @retval RESULT_DEV_ERR    Both sensors don't answer.
+  /// @retval Any other error returned by the sensor
+  ///
+  Result DualDistanceSensor::Update(uint8_t which, Result result, uint32_t sensorDistance, uint32_t& distance)
+  {
+    uint8_t other = (which == LEFT_SENSOR) ? RIGHT_SENSOR : LEFT_SENSOR;
+
+    switch(result)
+    {
+      case RESULT_OK:
+        _distances[which] = sensorDistance;
+        break;
+
+      case RESULT_TIMEOUT:
+        _distances[which] = UINT32_MAX;
+        break;
+
+      case RESULT_DEV_ERR:
+        // One sensor not answering is a missing reading, the other one still sees the
+        // subject. The fault is reported only once both sensors are lost.
+        _valid[which] = false;
+        _lost[which]  = true;
+
+        if (_lost[other])
+          return RESULT_DEV_ERR;
+
+        if (!_valid[other] || (_lastPingTimeMs - _pingTimesMs[other] > _maxPairIntervalMs))
+        {
+          _lateralOffsetMm = 0;
+          _yawMrad         = 0;
+          return RESULT_TIMEOUT;
+        }
+
+        // The latest reading of the other sensor, unpaired
+        distance = 0;
+        return Fuse(other, distance);
+
+      default:
+        // The reading of this sensor is unknown, it can't be paired any more
+        _valid[which] = false;
+        return result;
+    }
+
+    _pingTimesMs[which] = _lastPingTimeMs;
+    _valid[which]       = true;
+    _lost[which]        = false;
+
+    distance = 0;
+    return Fuse(which, distance);
+  }
+
+  /// @brief Gets the estimated lateral offset of the subject
+  ///
+  /// @retval The lateral offset in millimeters. A positive value means that the subject
+  /// is offset towards the right sensor, zero means that it is centered.
+  ///
+  int32_t DualDistanceSensor::GetLateralOffset() const
+  {
+    return _lateralOffsetMm;
+  }
+
+  /// @brief Gets the estimated yaw angle of the subject
+  ///
+  /// @retval The yaw angle in milliradians. A positive value means that the subject's
+  /// right side is further away than its left side. Zero if the angle can't be estimated.
+  ///
+  int32_t DualDistanceSensor::GetYaw() const
+  {
+    return _yawMrad;
+  }
+
+  /// @brief Fuses the latest readings of the two sensors
+  ///
+  /// @param which              The sensor that measured last
+  /// @param distance           Contains the fused distance in millimeters if successful.
+  ///
+  /// @retval RESULT_OK         At least one sensor sees the subject.
+  /// @retval RESULT_TIMEOUT    Neither of the sensors sees the subject.
+  ///
+  Result DualDistanceSensor::Fuse(uint8_t which, uint32_t& distance)
+  {
+    uint32_t left  = _distances[LEFT_SENSOR];
+    uint32_t right = _distances[RIGHT_SENSOR];
+    uint8_t  other = (which == LEFT_SENSOR) ? RIGHT_SENSOR : LEFT_SENSOR;
+
+    _yawMrad = 0;
+
+    // The other reading is too old to be paired, e.g. after a pause of the
+    // measurements or a failure of the other sensor
+    if (!_valid[other] || (_pingTimesMs[which] - _pingTimesMs[other] > _maxPairIntervalMs))
+    {
+      _lateralOffsetMm = 0;
+
+      if (_distances[which] == UINT32_MAX)
+        return RESULT_TIMEOUT;
+
+      distance = _distances[which];
+      Logger::Debug(F("Unpaired distance is %lu mm"), distance);
+      return RESULT_OK;
+    }
+
+    if ((left == UINT32_MAX) && (right == UINT32_MAX))
+    {
+      _lateralOffsetMm = 0;
+      return RESULT_TIMEOUT;
+    }
+
+    if (left == UINT32_MAX)
+    {
+      _lateralOffsetMm = (int32_t)(_baselineMm / 2);
+      distance = right;
+    }
+    else if (right == UINT32_MAX)
+    {
+      _lateralOffsetMm = -(int32_t)(_baselineMm / 2);
+      distance = left;
+    }
+    else
+    {
+      _lateralOffsetMm = 0;
+      distance = (left < right) ? left : right;
+
+      // yaw = atan((right - left) / baseline), using the approximation
+      // atan(x) ~= pi/4 * x + x * (1 - |x|) * (0.2447 + 0.0663 * |x|) which is within
+      // 1.5 mrad for |x| <= 1, and within 3 mrad with the rounding of x to 1/1000
+      int32_t ratio = RoundedDivide(((int32_t)right - (int32_t)left) * 1000L, (int32_t)_baselineMm);
+      if (ratio > 1000)
+        ratio = 1000;
+      else if (ratio < -1000)
+        ratio = -1000;
+
+      int32_t magnitude = (ratio < 0) ? -ratio : ratio;
+
+      _yawMrad = RoundedDivide(ratio * 7854L, 10000L) +
+                 RoundedDivide(ratio * (1000L - magnitude) * (2447L + (663L * magnitude) / 1000L), 10000000L);
+    }
+
+    Logger::Debug(F("Fused distance is %lu mm, offset is %ld mm, yaw is %ld mrad"), distance, _lateralOffsetMm, _yawMrad);
+
+    return RESULT_OK;
+  }
+}
@@ -0,0 +1,217 @@
+///
+/// @file DualDistanceSensor.h
+///
+/// @brief DualDistanceSensor class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_DUALDISTANCESENSOR_H_)
+#define _DUALDISTANCESENSOR_H_
+
+#include "IDistanceSensor.h"
+#include "CommonDefines.h"
+#include "Protothread.h"
+
+namespace CNEGR
+{
+  /// @brief DualDistanceSensor class definition
+  ///
+  /// Combines two distance sensors mounted side by side (left and right), facing the
+  /// same direction and separated by a known baseline. The sensors are pinged
+  /// alternately, never closer than the crosstalk guard time, so that one sensor can't
+  /// pick up the echo of the other one. Each measurement pings one sensor and fuses the
+  /// result with the latest reading of the other sensor, if that reading was pinged
+  /// within the maximum pair interval. An older reading describes where the subject was,
+  /// not where it is: the pair is then invalid and the fresh reading is returned alone,
+  /// with no offset and no yaw.
+  ///
+  /// A sensor that doesn't answer (RESULT_DEV_ERR) leaves its pings without reading, they
+  /// return the latest reading of the other sensor alone. RESULT_DEV_ERR is returned only
+  /// when neither of the sensors answers.
+  ///
+  /// The fused distance is the shorter of the two readings (the closest point of the
+  /// subject). When both sensors see the subject the yaw angle is estimated from the
+  /// difference between the readings. When only one sensor sees the subject, the subject
+  /// is considered to be offset towards that sensor by half of the baseline.
+  ///
+  class DualDistanceSensor: public IDistanceSensor
+  {
+  public:
+    /// @brief Constructor.
+    DualDistanceSensor(IDistanceSensor  *leftSensor,              ///< The sensor mounted on the left side
+                       IDistanceSensor  *rightSensor,             ///< The sensor mounted on the right side
+                       uint32_t         baselineMm,               ///< The distance between the two sensors in millimeters
+                       uint32_t         crosstalkGuardTimeMs,     ///< The minimum time between two pings in milliseconds
+                       uint32_t         maxPairIntervalMs         ///< The maximum time between the pings of a fused pair in milliseconds
+                      );
+
+    /// @brief Destructor.
+    virtual ~DualDistanceSensor();
+
+  public:
+    /// @brief Initialization function.
+    ///
+    /// @note Both sensors must be initialized before calling this method
+    ///
+    /// @param configuration      The configuration data. Only the name is used.
+    ///
+    /// @retval RESULT_OK         The device was successfully configured.
+    /// @retval RESULT_BUSY       The  device was already configured.
+    ///                           Deinit() must be called before calling Init() again.
+    /// @retval RESULT_DEV_ERR    One of the sensors is not initialized.
+    /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+    ///
+    virtual Result Init(const Config& configuration);
+
+    /// @brief Get whether the sensor device was initialized
+    ///
+    /// @return boolean true if it is initialized
+    /// and available for use
+    virtual bool IsInitialized() const;
+
+    /// @brief Deinitialization function for the device.
+    ///
+    /// @note The two sensors are not deinitialized
+    ///
+    virtual void Deinit();
+
+    /// @brief Measures the distance.
+    ///
+    /// @param distance           Contains the fused distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_TIMEOUT    Neither of the sensors sees the subject.
+    /// @retval RESULT_DEV_ERR    Both sensors are not present or are in some kind
+    ///                           of error state.
+    virtual Result MeasureDistance(uint32_t& distance);
+
+    /// @brief Measures the distance and adjusts the result for the ambient temperature.
+    ///
+    /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+    /// @param distance           Contains the fused distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_TIMEOUT    Neither of the sensors sees the subject.
+    /// @retval RESULT_DEV_ERR    Both sensors are not present or are in some kind
+    ///                           of error state.
+    virtual Result MeasureDistance(uint32_t ambientTemperature, uint32_t& distance);
+
+    /// @brief Measures the distance and adjusts the result for the ambient temperature and relative humidity.
+    ///
+    /// @note Temperatures below zero are passed as the two's complement of the value.
+    ///
+    /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+    /// @param relativeHumidity   The relative humidity in percent
+    /// @param distance           Contains the fused distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_TIMEOUT    Neither of the sensors sees the subject.
+    /// @retval RESULT_DEV_ERR    Both sensors are not present or are in some kind
+    ///                           of error state.
+    virtual Result MeasureDistance(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance);
+
+    /// @brief Measures the distance without blocking.
+    ///
+    /// @note The first call starts the measurement and the method must then be called
+    /// repeatedly until it returns something else than RESULT_BUSY. The temperature
+    /// and humidity passed to the first call are used for the whole measurement.
+    ///
+    /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+    /// @param relativeHumidity   The relative humidity in percent
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_BUSY       The measurement is in progress.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+    ///                           of error state.
+    virtual Result MeasureDistanceAsync(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance);
+
+    /// @brief Limits the range of the measurements
+    ///
+    /// @note The echo timeout is computed from the range limit, so a shorter range makes
+    /// the measurements without target shorter. A target beyond the limit is reported as
+    /// a timeout. The limit is clipped to the maximum distance the sensor can detect.
+    ///
+    /// @param rangeLimitMm       The range limit in millimeters, 0 to use the full range
+    ///
+    /// @retval RESULT_OK         The range limit was changed.
+    /// @retval RESULT_NOT_READY  The sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_BAD_PARAM  The range limit is below the minimum distance the sensor can detect.
+    ///
+    virtual Result SetRangeLimit(uint32_t rangeLimitMm);
+
+  public:
+    /// @brief Gets the estimated lateral offset of the subject
+    ///
+    /// @retval The lateral offset in millimeters. A positive value means that the subject
+    /// is offset towards the right sensor, zero means that it is centered or that the
+    /// pair was invalid.
+    ///
+    int32_t GetLateralOffset() const;
+
+    /// @brief Gets the estimated yaw angle of the subject
+    ///
+    /// @retval The yaw angle in milliradians. A positive value means that the subject's
+    /// right side is further away than its left side. Zero if the angle can't be estimated.
+    ///
+    int32_t GetYaw() const;
+
+  private:
+    /// @brief Fuses the latest readings of the two sensors
+    ///
+    /// @param which              The sensor that measured last
+    /// @param distance           Contains the fused distance in millimeters if successful.
+    ///
+    /// @retval RESULT_OK         At least one sensor sees the subject.
+    /// @retval RESULT_TIMEOUT    Neither of the sensors sees the subject.
+    ///
+    Result Fuse(uint8_t which, uint32_t& distance);
+
+    /// @brief Stores the result of a sensor measurement and fuses the readings
+    ///
+    /// @param which              The sensor that measured the distance
+    /// @param result             The measurement result
+    /// @param sensorDistance     The distance measured by the sensor
+    /// @param distance           Contains the fused distance in millimeters if successful.
+    ///
+    /// @retval RESULT_OK         At least one sensor sees the subject.
+    /// @retval RESULT_TIMEOUT    Neither of the sensors sees the subject.
+    /// @retval RESULT_DEV_ERR    Both sensors don't answer.
+    /// @retval Any other error returned by the sensor
+    ///
+    Result Update(uint8_t which, Result result, uint32_t sensorDistance, uint32_t& distance);
+
+  private:
+    /// @brief Default Constructor.
+    DualDistanceSensor();
+
+  private:
+    bool            _initDone;                        ///< A flag to indicate whether the sensor was initialized
+    char            _name[MAX_COMPONENT_NAME_LENGTH]; ///< A symbolic name for this sensor
+    IDistanceSensor *_sensors[2];                     ///< The left and right sensors
+    uint32_t        _baselineMm;                      ///< The distance between the two sensors in millimeters
+    uint32_t        _crosstalkGuardTimeMs;            ///< The minimum time between two pings in milliseconds
+    uint32_t        _maxPairIntervalMs;               ///< The maximum time between the pings of a fused pair in milliseconds
+    uint8_t         _nextSensor;                      ///< The index of the sensor to be pinged next
+    uint32_t        _lastPingTimeMs;                  ///< The time of the previous ping in milliseconds
+    uint32_t        _distances[2];                    ///< The latest reading of each sensor, UINT32_MAX if none
+    uint32_t        _pingTimesMs[2];                  ///< The ping time of the latest reading of each sensor
+    bool            _valid[2];                        ///< A flag per sensor to indicate that it has a reading
+    bool            _lost[2];                         ///< A flag per sensor to indicate that it doesn't answer
+    int32_t         _lateralOffsetMm;                 ///< The estimated lateral offset in millimeters
+    int32_t         _yawMrad;                         ///< The estimated yaw angle in milliradians
+    Protothread     _measurement;                     ///< The asynchronous measurement state
+    uint8_t         _pendingSensor;                   ///< The sensor measuring in the asynchronous measurement
+    Result          _sensorResult;                    ///< The result of the asynchronous sensor measurement
+    uint32_t        _sensorDistance;                  ///< The distance of the asynchronous sensor measurement
+  };
+}
+#endif // _DUALDISTANCESENSOR_H_
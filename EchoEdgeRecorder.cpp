@@ -0,0 +1,165 @@
+///
+/// @file EchoEdgeRecorder.cpp
+///
+/// @brief EchoEdgeRecorder class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include <string.h>
+#include "EchoEdgeRecorder.h"
+
+namespace CNEGR
+{
+  /// @brief Constructor.
+  EchoEdgeRecorder::EchoEdgeRecorder()
+    :_triggerTimeUs(0),
+     _pingCount(0),
+     _pings(0),
+     _edgeCount(0),
+     _lostEdges(0),
+     _active(false)
+  {
+    memset(_edges, 0, sizeof(_edges));
+  }
+
+  /// @brief Destructor.
+  EchoEdgeRecorder::~EchoEdgeRecorder()
+  {
+  }
+
+  /// @brief Starts a new capture, the previous edges are discarded
+  ///
+  /// @param pingCount          The number of pings to record
+  ///
+  /// @retval RESULT_OK         The capture was started.
+  /// @retval RESULT_BAD_PARAM  The ping count is 0.
+  ///
+  Result EchoEdgeRecorder::Start(uint8_t pingCount)
+  {
+    if (pingCount == 0)
+      return RESULT_BAD_PARAM;
+
+    // The interrupt handler doesn't touch the buffer until the flag is set again
+    _active     = false;
+    _pingCount  = pingCount;
+    _pings      = 0;
+    _edgeCount  = 0;
+    _lostEdges  = 0;
+    _active     = true;
+
+    return RESULT_OK;
+  }
+
+  /// @brief Stops the capture, the edges recorded so far are kept
+  ///
+  void EchoEdgeRecorder::Stop()
+  {
+    _active = false;
+  }
+
+  /// @brief Get whether the capture is running
+  ///
+  /// @return boolean true if the edges are being recorded
+  ///
+  bool EchoEdgeRecorder::IsActive() const
+  {
+    return _active;
+  }
+
+  /// @brief Starts the record of a new ping
+  ///
+  /// @param timeUs             The trigger time in microseconds
+  ///
+  void EchoEdgeRecorder::OnTrigger(uint32_t timeUs)
+  {
+    if (!_active)
+      return;
+
+    // The last ping ends with the next trigger
+    if (_pings >= _pingCount)
+    {
+      _active = false;
+      return;
+    }
+
+    _triggerTimeUs = timeUs;
+    _pings = _pings + 1;
+  }
+
+  /// @brief Records an edge
+  ///
+  /// @note Called from the interrupt handler
+  ///
+  /// @param timeUs             The edge time in microseconds
+  /// @param level              The echo level after the edge, true when active
+  ///
+  void EchoEdgeRecorder::OnEdge(uint32_t timeUs, bool level)
+  {
+    if (!_active || (_pings == 0))
+      return;
+
+    uint8_t count = _edgeCount;
+    if (count >= ECHO_EDGE_RECORDER_SIZE)
+    {
+      if (_lostEdges != UINT8_MAX)
+        _lostEdges = _lostEdges + 1;
+      return;
+    }
+
+    uint32_t elapsed = timeUs - _triggerTimeUs;
+
+    EchoEdge& edge = _edges[count];
+    edge.ping   = _pings - 1;
+    edge.level  = level ? 1 : 0;
+    edge.timeUs = (elapsed > UINT16_MAX) ? UINT16_MAX : (uint16_t)elapsed;
+
+    // Published last so that the main loop never reads a partial edge
+    _edgeCount = count + 1;
+  }
+
+  /// @brief Gets the number of edges recorded
+  ///
+  /// @retval The number of edges
+  ///
+  uint8_t EchoEdgeRecorder::GetEdgeCount() const
+  {
+    return _edgeCount;
+  }
+
+  /// @brief Gets the number of edges that didn't fit in the buffer
+  ///
+  /// @retval The number of edges lost, saturated at 255
+  ///
+  uint8_t EchoEdgeRecorder::GetLostEdgeCount() const
+  {
+    return _lostEdges;
+  }
+
+  /// @brief Gets the number of pings recorded, including the one being recorded
+  ///
+  /// @retval The number of pings
+  ///
+  uint8_t EchoEdgeRecorder::GetPingCount() const
+  {
+    return _pings;
+  }
+
+  /// @brief Gets a recorded edge
+  ///
+  /// @param index              The edge index, 0 to GetEdgeCount() - 1
+  /// @param edge               Contains the edge
+  ///
+  /// @retval RESULT_OK         The edge was retrieved.
+  /// @retval RESULT_BAD_PARAM  The index is out of range.
+  ///
+  Result EchoEdgeRecorder::GetEdge(uint8_t index, EchoEdge& edge) const
+  {
+    if (index >= _edgeCount)
+      return RESULT_BAD_PARAM;
+
+    edge = _edges[index];
+    return RESULT_OK;
+  }
+}
@@ -0,0 +1,131 @@
+///
+/// @file EchoEdgeRecorder.h
+///
+/// @brief EchoEdgeRecorder class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+/// This file and EchoEdgeRecorder.cpp don't depend on the Arduino framework. The
+/// recorded edges received with the telemetry are analyzed on the host, see
+/// extras/host/EchoEdgeAnalysis.h and the echo-edges tool.
+///
+#pragma once
+
+#if !defined(_ECHOEDGERECORDER_H_)
+#define _ECHOEDGERECORDER_H_
+
+#include <stdint.h>
+#include "Result.h"
+
+namespace CNEGR
+{
+  /// The number of edges recorded, 4 bytes each
+  #define ECHO_EDGE_RECORDER_SIZE   32
+
+  /// @brief An edge of the echo signal
+  ///
+  struct EchoEdge
+  {
+    uint8_t   ping;                   ///< The index of the ping in the capture, from 0
+    uint8_t   level;                  ///< The echo level after the edge, 1 when the echo becomes active
+    uint16_t  timeUs;                 ///< The time since the trigger in microseconds, saturated at 65535
+  };
+
+  /// @brief EchoEdgeRecorder class definition
+  ///
+  /// Records every edge of the echo signal for the next pings, including the edges that
+  /// the measurement ignores (reflections after the first pulse, glitches), into a fixed
+  /// buffer. The sensor calls OnTrigger() right before each trigger pulse and OnEdge()
+  /// from its echo interrupt handler after it took the edge timestamp, so the capture
+  /// doesn't change the timing of the measurement.
+  ///
+  /// The edges of a ping are recorded until the next trigger, the capture is complete
+  /// when the ping after the last one is triggered.
+  ///
+  /// @note OnTrigger() must be called with the interrupts disabled, Start() and Stop()
+  /// only change the flag read by the interrupt handler last.
+  ///
+  class EchoEdgeRecorder
+  {
+  public:
+    /// @brief Constructor.
+    EchoEdgeRecorder();
+
+    /// @brief Destructor.
+    ~EchoEdgeRecorder();
+
+  public:
+    /// @brief Starts a new capture, the previous edges are discarded
+    ///
+    /// @param pingCount          The number of pings to record
+    ///
+    /// @retval RESULT_OK         The capture was started.
+    /// @retval RESULT_BAD_PARAM  The ping count is 0.
+    ///
+    Result Start(uint8_t pingCount);
+
+    /// @brief Stops the capture, the edges recorded so far are kept
+    ///
+    void Stop();
+
+    /// @brief Get whether the capture is running
+    ///
+    /// @return boolean true if the edges are being recorded
+    ///
+    bool IsActive() const;
+
+    /// @brief Starts the record of a new ping
+    ///
+    /// @param timeUs             The trigger time in microseconds
+    ///
+    void OnTrigger(uint32_t timeUs);
+
+    /// @brief Records an edge
+    ///
+    /// @note Called from the interrupt handler
+    ///
+    /// @param timeUs             The edge time in microseconds
+    /// @param level              The echo level after the edge, true when active
+    ///
+    void OnEdge(uint32_t timeUs, bool level);
+
+    /// @brief Gets the number of edges recorded
+    ///
+    /// @retval The number of edges
+    ///
+    uint8_t GetEdgeCount() const;
+
+    /// @brief Gets the number of edges that didn't fit in the buffer
+    ///
+    /// @retval The number of edges lost, saturated at 255
+    ///
+    uint8_t GetLostEdgeCount() const;
+
+    /// @brief Gets the number of pings recorded, including the one being recorded
+    ///
+    /// @retval The number of pings
+    ///
+    uint8_t GetPingCount() const;
+
+    /// @brief Gets a recorded edge
+    ///
+    /// @param index              The edge index, 0 to GetEdgeCount() - 1
+    /// @param edge               Contains the edge
+    ///
+    /// @retval RESULT_OK         The edge was retrieved.
+    /// @retval RESULT_BAD_PARAM  The index is out of range.
+    ///
+    Result GetEdge(uint8_t index, EchoEdge& edge) const;
+
+  private:
+    EchoEdge          _edges[ECHO_EDGE_RECORDER_SIZE];  ///< The recorded edges
+    uint32_t          _triggerTimeUs;                   ///< The trigger time of the ping being recorded
+    uint8_t           _pingCount;                       ///< The number of pings to record
+    volatile uint8_t  _pings;                           ///< The number of pings triggered since the start
+    volatile uint8_t  _edgeCount;                       ///< The number of edges recorded
+    volatile uint8_t  _lostEdges;                       ///< The number of edges that didn't fit in the buffer
+    volatile bool     _active;                          ///< A flag to indicate whether the edges are recorded
+  };
+}
+#endif // _ECHOEDGERECORDER_H_
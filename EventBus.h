@@ -0,0 +1,66 @@
+///
+/// @file EventBus.h
+///
+/// @brief EventBus class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_EVENTBUS_H_)
+#define _EVENTBUS_H_
+
+namespace CNEGR
+{
+  /// @brief The base of the event subscribers
+  ///
+  /// A subscriber is a class with a static OnEvent() overload for every event it
+  /// handles. The events it doesn't handle go to the empty handler below, which
+  /// the subscriber must bring in scope with "using EventSubscriber::OnEvent;".
+  ///
+  struct EventSubscriber
+  {
+    template <typename Event>
+    static void OnEvent(const Event&)
+    {
+    }
+  };
+
+  /// @brief EventBus class definition
+  ///
+  /// Dispatches the events to a list of subscribers fixed at compile time, e.g.
+  ///
+  ///   typedef EventBus<TelemetrySubscriber, BuzzerSubscriber> AppEventBus;
+  ///   AppEventBus::Publish(event);
+  ///
+  /// Publish() expands to a direct call of every subscriber handler in the list order,
+  /// which the compiler usually inlines. There is no heap, no virtual call and no
+  /// subscriber table in RAM, and a subscriber not interested in an event costs nothing.
+  ///
+  /// @tparam Subscribers   The subscribers, derived from EventSubscriber
+  ///
+  template <typename... Subscribers>
+  struct EventBus;
+
+  template <>
+  struct EventBus<>
+  {
+    template <typename Event>
+    static void Publish(const Event&)
+    {
+    }
+  };
+
+  template <typename First, typename... Rest>
+  struct EventBus<First, Rest...>
+  {
+    template <typename Event>
+    static void Publish(const Event& event)
+    {
+      First::OnEvent(event);
+      EventBus<Rest...>::Publish(event);
+    }
+  };
+}
+#endif // _EVENTBUS_H_
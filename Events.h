@@ -0,0 +1,60 @@
+///
+/// @file Events.h
+///
+/// @brief The events published by the components
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_EVENTS_H_)
+#define _EVENTS_H_
+
+#include <stdint.h>
+#include "Result.h"
+
+namespace CNEGR
+{
+  /// @brief Published by the state machine after every measurement
+  ///
+  struct SampleEvent
+  {
+    uint32_t  timeMs;                 ///< The measurement time in milliseconds
+    uint32_t  rawDistanceMm;          ///< The measured distance, UINT32_MAX if the measurement timed out
+    uint32_t  filteredDistanceMm;     ///< The distance after the outlier filter, UINT32_MAX if the measurement timed out
+    uint32_t  trackedDistanceMm;      ///< The tracked distance, UINT32_MAX if the target is not tracked
+    int32_t   velocityMmPerS;         ///< The tracked velocity in millimeters per second
+    uint8_t   state;                  ///< The state machine state after the update
+  };
+
+  /// @brief Published by the state machine when the state changes
+  ///
+  struct StateChangedEvent
+  {
+    uint32_t  timeMs;                 ///< The transition time in milliseconds
+    uint8_t   fromState;              ///< The previous state
+    uint8_t   toState;                ///< The new state
+  };
+
+  /// @brief Published when a component fails
+  ///
+  struct FaultEvent
+  {
+    uint32_t  timeMs;                 ///< The time of the failure in milliseconds
+    Result    result;                 ///< The error returned by the component
+  };
+
+  /// @brief Publishes an event to all the subscribers
+  ///
+  /// @note These functions are defined by the application, usually by forwarding
+  /// the event to its EventBus. The producers are bound to the subscribers at link
+  /// time, without any registration at runtime.
+  ///
+  /// @param event  The event
+  ///
+  void Publish(const SampleEvent& event);
+  void Publish(const StateChangedEvent& event);
+  void Publish(const FaultEvent& event);
+}
+#endif // _EVENTS_H_
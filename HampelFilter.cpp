@@ -0,0 +1,150 @@
+///
+/// @file HampelFilter.cpp
+///
+/// @brief HampelFilter class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "HampelFilter.h"
+
+namespace CNEGR
+{
+  /// @brief Orders a pair of values without branching so that a <= b afterwards
+  ///
+  static inline void CompareExchange(uint16_t& a, uint16_t& b)
+  {
+    uint16_t mask = (uint16_t)(0 - (uint16_t)(b < a));
+    uint16_t diff = (uint16_t)((a ^ b) & mask);
+    a ^= diff;
+    b ^= diff;
+  }
+
+  /// @brief Gets the absolute difference of two values without branching
+  ///
+  static inline uint16_t AbsDiff(uint16_t a, uint16_t b)
+  {
+    int32_t d = (int32_t)a - (int32_t)b;
+    int32_t sign = d >> 31;
+    return (uint16_t)((d ^ sign) - sign);
+  }
+
+  /// @brief Constructor.
+  HampelFilter::HampelFilter()
+    :_next(0),
+     _count(0),
+     _outlierCount(0)
+  {
+    _config.thresholdX16   = 0;
+    _config.minDeviationMm = 0;
+  }
+
+  /// @brief Destructor.
+  HampelFilter::~HampelFilter()
+  {
+  }
+
+  /// @brief Initialization function.
+  ///
+  /// @param configuration      The configuration data.
+  ///
+  /// @retval RESULT_OK         The filter was successfully configured.
+  /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+  ///
+  Result HampelFilter::Init(const Config& configuration)
+  {
+    if (configuration.thresholdX16 == 0)
+      return RESULT_BAD_PARAM;
+
+    _config = configuration;
+    Reset();
+
+    return RESULT_OK;
+  }
+
+  /// @brief Clears the filter history
+  ///
+  void HampelFilter::Reset()
+  {
+    _next         = 0;
+    _count        = 0;
+    _outlierCount = 0;
+  }
+
+  /// @brief Filters a new reading
+  ///
+  /// @param distanceMm         The measured distance in millimeters
+  ///
+  /// @retval The filtered distance in millimeters. Until the window is filled
+  /// the readings are passed through unchanged.
+  ///
+  uint32_t HampelFilter::Filter(uint32_t distanceMm)
+  {
+    uint16_t reading = (distanceMm > UINT16_MAX) ? UINT16_MAX : (uint16_t)distanceMm;
+
+    // The raw reading goes into the window, so a genuine step change is accepted
+    // as soon as it makes up the majority of the window
+    _window[_next] = reading;
+    _next = (_next + 1) % HAMPEL_WINDOW_SIZE;
+
+    if (_count < HAMPEL_WINDOW_SIZE)
+    {
+      _count++;
+      return distanceMm;
+    }
+
+    uint16_t sorted[HAMPEL_WINDOW_SIZE];
+    for (uint8_t i = 0; i < HAMPEL_WINDOW_SIZE; i++)
+      sorted[i] = _window[i];
+
+    uint16_t median = Median(sorted);
+
+    uint16_t deviations[HAMPEL_WINDOW_SIZE];
+    for (uint8_t i = 0; i < HAMPEL_WINDOW_SIZE; i++)
+      deviations[i] = AbsDiff(_window[i], median);
+
+    uint16_t mad = Median(deviations);
+    uint16_t deviation = AbsDiff(reading, median);
+
+    uint8_t isOutlier = (uint8_t)(((uint32_t)deviation * 16 > (uint32_t)mad * _config.thresholdX16) &
+                                  (deviation > _config.minDeviationMm));
+
+    _outlierCount += isOutlier;
+
+    // Select the median for an outlier and the reading otherwise
+    uint16_t mask = (uint16_t)(0 - (uint16_t)isOutlier);
+    return (uint16_t)((median & mask) | (reading & ~mask));
+  }
+
+  /// @brief Gets the number of readings replaced since the last Reset()
+  ///
+  /// @retval The number of rejected outliers
+  ///
+  uint32_t HampelFilter::GetOutlierCount() const
+  {
+    return _outlierCount;
+  }
+
+  /// @brief Computes the median of HAMPEL_WINDOW_SIZE values
+  ///
+  /// @param values The values, they are sorted in place
+  ///
+  /// @retval The median value
+  ///
+  uint16_t HampelFilter::Median(uint16_t *values)
+  {
+    // Optimal 9 comparator sorting network for 5 elements
+    CompareExchange(values[0], values[1]);
+    CompareExchange(values[3], values[4]);
+    CompareExchange(values[2], values[4]);
+    CompareExchange(values[2], values[3]);
+    CompareExchange(values[0], values[3]);
+    CompareExchange(values[0], values[2]);
+    CompareExchange(values[1], values[4]);
+    CompareExchange(values[1], values[3]);
+    CompareExchange(values[1], values[2]);
+
+    return values[HAMPEL_WINDOW_SIZE / 2];
+  }
+}
@@ -0,0 +1,95 @@
+///
+/// @file HampelFilter.h
+///
+/// @brief HampelFilter class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_HAMPELFILTER_H_)
+#define _HAMPELFILTER_H_
+
+#include <stdint.h>
+#include "Result.h"
+
+namespace CNEGR
+{
+  #define HAMPEL_WINDOW_SIZE 5
+
+  /// @brief HampelFilter class definition
+  ///
+  /// Rejects isolated spikes in the distance readings. The newest reading is compared
+  /// with the median of the last HAMPEL_WINDOW_SIZE readings and replaced by the median
+  /// when it deviates by more than a multiple of the median absolute deviation (MAD).
+  ///
+  /// The medians are computed with a fixed sorting network built from branchless
+  /// compare-exchange operations, so the filter executes in constant time.
+  ///
+  class HampelFilter
+  {
+  public:
+    struct Config
+    {
+      uint16_t thresholdX16;          ///< The outlier threshold as a multiple of the MAD, in 1/16 units.
+                                      ///< 3 sigma for normally distributed noise is 3 * 1.4826 * 16 = 71
+      uint16_t minDeviationMm;        ///< The minimum deviation from the median in millimeters for a reading
+                                      ///< to be considered an outlier. Prevents rejecting small changes when
+                                      ///< the readings are perfectly steady and the MAD is zero
+    };
+
+  public:
+    /// @brief Constructor.
+    HampelFilter();
+
+    /// @brief Destructor.
+    ~HampelFilter();
+
+  public:
+    /// @brief Initialization function.
+    ///
+    /// @param configuration      The configuration data.
+    ///
+    /// @retval RESULT_OK         The filter was successfully configured.
+    /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+    ///
+    Result Init(const Config& configuration);
+
+    /// @brief Clears the filter history
+    ///
+    void Reset();
+
+    /// @brief Filters a new reading
+    ///
+    /// @param distanceMm         The measured distance in millimeters
+    ///
+    /// @retval The filtered distance in millimeters. Until the window is filled
+    /// the readings are passed through unchanged.
+    ///
+    uint32_t Filter(uint32_t distanceMm);
+
+    /// @brief Gets the number of readings replaced since the last Reset()
+    ///
+    /// @retval The number of rejected outliers
+    ///
+    uint32_t GetOutlierCount() const;
+
+  private:
+    /// @brief Computes the median of HAMPEL_WINDOW_SIZE values
+    ///
+    /// @param values The values, they are sorted in place
+    ///
+    /// @retval The median value
+    ///
+    static uint16_t Median(uint16_t *values);
+
+  private:
+    Config    _config;                            ///< The filter configuration
+    uint16_t  _window[HAMPEL_WINDOW_SIZE];        ///< The last readings (circular buffer)
+    uint8_t   _next;                              ///< The index of the next window slot to be written
+    uint8_t   _count;                             ///< The number of valid readings in the window
+    uint32_t  _outlierCount;                      ///< The number of rejected outliers
+  };
+}
+#endif // _HAMPELFILTER_H_
@@ -0,0 +1,86 @@
+///
+/// @file IButton.h
+///
+/// @brief IButton interface definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_IBUTTON_H_)
+#define _IBUTTON_H_
+
+#include <Arduino.h>
+#include "Result.h"
+#include "CommonDefines.h"
+
+namespace CNEGR
+{
+  /// @brief IButton interface definition
+  ///
+  class IButton
+  {
+  public:
+    virtual ~IButton() {}
+
+  public:
+    struct Config
+    {
+      const char*     name;                       ///< A symbolic name for the button
+      uint8_t         pin;                        ///< The GPIO pin number (input)
+      SignalPolarity  polarity;                   ///< The pin level when the button is pressed,
+                                                  ///< ActiveLow enables the internal pull-up
+      uint16_t        debounceTimeMs;             ///< The time the pin must stay at the same level for the level to be accepted
+      uint16_t        longPressTimeMs;            ///< The minimum press duration reported as a long press
+    };
+
+    enum Event
+    {
+      Press,                                      ///< The button was pressed and released
+      LongPress                                   ///< The button was held for at least longPressTimeMs and released
+    };
+
+    /// @brief Initialization function.
+    ///
+    /// @param configuration      The configuration data.
+    ///
+    /// @retval RESULT_OK         The device was successfully configured.
+    /// @retval RESULT_BUSY       The  device was already configured. Deinit() must be called before calling Init() again.
+    /// @retval RESULT_NOT_SUP    The pin doesn't support interrupts.
+    /// @retval RESULT_NO_RESOURCE Too many buttons are in use.
+    /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+    ///
+    virtual Result Init(const Config& configuration) = 0;
+
+    /// @brief Get whether the device was initialized
+    ///
+    /// @return boolean true if it is initialized
+    /// and available for use
+    virtual bool IsInitialized() const = 0;
+
+    /// @brief Deinitialization function for the device.
+    ///
+    virtual void Deinit() = 0;
+
+    /// @brief Gets the oldest button event
+    ///
+    /// @note This method never blocks and must be called from the main loop
+    ///
+    /// @param event              Contains the event if successful
+    ///
+    /// @retval RESULT_OK         An event was retrieved.
+    /// @retval RESULT_NO_DATA    There are no events.
+    /// @retval RESULT_NOT_READY  The device was not initialized (Init() method wasn't called)
+    ///
+    virtual Result GetEvent(Event& event) = 0;
+
+    /// @brief Gets the number of events lost because the main loop didn't retrieve them in time
+    ///
+    /// @retval The number of lost events
+    ///
+    virtual uint16_t GetLostEventCount() const = 0;
+  };
+}
+
+#endif // _IBUTTON_H_
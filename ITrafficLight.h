@@ -126,6 +126,18 @@ namespace CNEGR
     /// @retval RESULT_DEV_ERR    The device is not present or is in some kind of error state.
     ///
     virtual Result PerformLightsTest() = 0;
+
+    /// @brief Performs a test of the lights without blocking.
+    ///
+    /// @note The test takes about 1.5 seconds, the method must be called repeatedly
+    /// until it returns something else than RESULT_BUSY.
+    ///
+    /// @retval RESULT_OK         The test completed successfully.
+    /// @retval RESULT_BUSY       The test is in progress.
+    /// @retval RESULT_NOT_READY  The execution failed because the device was not initialized (Init() method wasn't called).
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind of error state.
+    ///
+    virtual Result PerformLightsTestAsync() = 0;
   };
 }
 
@@ -0,0 +1,241 @@
+///
+/// @file InstrumentedTrafficLight.cpp
+///
+/// @brief InstrumentedTrafficLight class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "InstrumentedTrafficLight.h"
+
+namespace CNEGR
+{
+  /// @brief Constructor.
+  InstrumentedTrafficLight::InstrumentedTrafficLight(ITrafficLight    *trafficLight,            ///< The light writing the pins
+                                                     ClockProc         captureTime,             ///< Gets the time of the last capture in microseconds
+                                                     LatencyHistogram *histogram,               ///< Receives the latencies
+                                                     ClockProc         clock                    ///< The microseconds clock, nullptr for micros()
+                                                    )
+    :_initDone(false),
+     _trafficLight(trafficLight),
+     _captureTime(captureTime),
+     _histogram(histogram),
+     _clock(clock),
+     _lastCaptureTimeUs(0)
+  {
+    _name[0] = '\0';
+  }
+
+  /// @brief Destructor.
+  InstrumentedTrafficLight::~InstrumentedTrafficLight()
+  {
+    Deinit();
+  }
+
+  /// @brief Initialization function.
+  ///
+  /// @note The wrapped light must be initialized before calling this method
+  ///
+  /// @param configuration      The configuration data. Only the name is used.
+  ///
+  /// @retval RESULT_OK         The device was successfully configured.
+  /// @retval RESULT_BUSY       The  device was already configured. Deinit() must be called before calling Init() again.
+  /// @retval RESULT_DEV_ERR    The wrapped light is not initialized.
+  /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+  ///
+  Result InstrumentedTrafficLight::Init(const Config& configuration)
+  {
+    if (IsInitialized())
+    {
+      // Already initialized
+      return RESULT_BUSY;
+    }
+
+    if ((configuration.name == NULL) || (_trafficLight == nullptr) || (_captureTime == nullptr) || (_histogram == nullptr))
+    {
+      // Invalid name, light, capture time or histogram
+      return RESULT_BAD_PARAM;
+    }
+
+    if (!_trafficLight->IsInitialized())
+    {
+      return RESULT_DEV_ERR;
+    }
+
+    // Copy the name
+    strncpy((char *)(&_name[0]), configuration.name, sizeof(_name)-1);
+
+    // A capture made before the light was instrumented is not recorded
+    _lastCaptureTimeUs = _captureTime();
+
+    // Set the init done flag
+    _initDone = true;
+    return RESULT_OK;
+  }
+
+  /// @brief Get whether the device was initialized
+  ///
+  /// @return boolean true if it is initialized
+  /// and available for use
+  bool InstrumentedTrafficLight::IsInitialized() const
+  {
+    return _initDone;
+  }
+
+  /// @brief Deinitialization function for the device.
+  ///
+  /// @note The wrapped light is not deinitialized
+  ///
+  void InstrumentedTrafficLight::Deinit()
+  {
+    // Clear the name
+    _name[0] = '\0';
+
+    // And reset the init done flag
+    _initDone = false;
+  }
+
+  /// @brief Turns On the specified light. Only one light can be turned on at a time. If a light is already on when this method
+  /// is invoked it will be turned off before the new light is turned on.
+  ///
+  /// @param whichLight         Defines which light should be turned on.
+  ///
+  /// @retval RESULT_OK         The light was successfully turned on.
+  /// @retval RESULT_NOT_READY  The execution failed because the device was not initialized (Init() method wasn't called)
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind of error state.
+  Result InstrumentedTrafficLight::TurnOn(LightSelector whichLight)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    Result result = _trafficLight->TurnOn(whichLight);
+    RecordLatency();
+    return result;
+  }
+
+  /// @brief Turns Off the specified light.
+  ///
+  /// @param whichLight         Defines which light should be turned off.
+  ///
+  /// @retval RESULT_OK         The light was successfully turned off.
+  /// @retval RESULT_NOT_READY  The execution failed because the device was not initialized (Init() method wasn't called)
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind of error state.
+  Result InstrumentedTrafficLight::TurnOff(LightSelector whichLight)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    Result result = _trafficLight->TurnOff(whichLight);
+    RecordLatency();
+    return result;
+  }
+
+  /// @brief Sets the state for the specified light.
+  ///
+  /// @param whichLight         Defines which light should be turned ON or OFF.
+  /// @param state              The light state
+  ///
+  /// @retval RESULT_OK         The light state was successfully set.
+  /// @retval RESULT_NOT_READY  The execution failed because the device was not initialized (Init() method wasn't called)
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind of error state.
+  /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+  ///
+  Result InstrumentedTrafficLight::SetState(LightSelector whichLight, LightState state)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    Result result = _trafficLight->SetState(whichLight, state);
+    RecordLatency();
+    return result;
+  }
+
+  /// @brief Gets the state for the specified light.
+  ///
+  /// @param whichLight         Defines which light should be turned ON or OFF.
+  /// @param state              The light state
+  ///
+  /// @retval RESULT_OK         The light state was retrieved successfully.
+  /// @retval RESULT_NOT_READY  The execution failed because the device was not initialized (Init() method wasn't called)
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind of error state.
+  /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+  ///
+  Result InstrumentedTrafficLight::GetState(LightSelector whichLight, LightState& state)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    return _trafficLight->GetState(whichLight, state);
+  }
+
+  /// @brief Turns off all the lights.
+  ///
+  /// @retval RESULT_OK         The light state was successfully set.
+  /// @retval RESULT_NOT_READY  The execution failed because the device was not initialized (Init() method wasn't called)
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind of error state.
+  ///
+  Result InstrumentedTrafficLight::SetAllLightsOff()
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    Result result = _trafficLight->SetAllLightsOff();
+    RecordLatency();
+    return result;
+  }
+
+  /// @brief Performs a test of the lights.
+  ///
+  /// @retval RESULT_OK         The test completed successfully.
+  /// @retval RESULT_NOT_READY  The execution failed because the device was not initialized (Init() method wasn't called).
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind of error state.
+  ///
+  Result InstrumentedTrafficLight::PerformLightsTest()
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    return _trafficLight->PerformLightsTest();
+  }
+
+  /// @brief Performs a test of the lights without blocking.
+  ///
+  /// @note The method must be called repeatedly until it returns something else than RESULT_BUSY.
+  ///
+  /// @retval RESULT_OK         The test completed successfully.
+  /// @retval RESULT_BUSY       The test is in progress.
+  /// @retval RESULT_NOT_READY  The execution failed because the device was not initialized (Init() method wasn't called).
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind of error state.
+  ///
+  Result InstrumentedTrafficLight::PerformLightsTestAsync()
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    return _trafficLight->PerformLightsTestAsync();
+  }
+
+  /// @brief Records the latency of the last capture if it wasn't recorded yet
+  ///
+  /// @note Called after the write, so the latency includes the write itself
+  ///
+  void InstrumentedTrafficLight::RecordLatency()
+  {
+    uint32_t captureTimeUs = _captureTime();
+    if (captureTimeUs == _lastCaptureTimeUs)
+      return;
+
+    _lastCaptureTimeUs = captureTimeUs;
+    _histogram->Record(GetTime() - captureTimeUs);
+  }
+
+  /// @brief Gets the current time from the clock
+  ///
+  /// @retval The time in microseconds
+  ///
+  uint32_t InstrumentedTrafficLight::GetTime() const
+  {
+    return (_clock != nullptr) ? _clock() : micros();
+  }
+}
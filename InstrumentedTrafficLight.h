@@ -0,0 +1,165 @@
+///
+/// @file InstrumentedTrafficLight.h
+///
+/// @brief InstrumentedTrafficLight class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_INSTRUMENTEDTRAFFICLIGHT_H_)
+#define _INSTRUMENTEDTRAFFICLIGHT_H_
+
+#include <Arduino.h>
+#include "ITrafficLight.h"
+#include "LatencyHistogram.h"
+#include "CommonDefines.h"
+
+namespace CNEGR
+{
+  /// @brief InstrumentedTrafficLight class definition
+  ///
+  /// Measures the latency from the capture of a sample to the light it causes: the
+  /// first write to the lights after a new capture records the time elapsed since that
+  /// capture in a histogram. Writes of the same sample, and samples that don't write
+  /// the lights, are not recorded. Everything else is forwarded to the wrapped light.
+  ///
+  class InstrumentedTrafficLight: public ITrafficLight
+  {
+  public:
+    /// @brief Constructor.
+    InstrumentedTrafficLight(ITrafficLight    *trafficLight,            ///< The light writing the pins
+                             ClockProc         captureTime,             ///< Gets the time of the last capture in microseconds
+                             LatencyHistogram *histogram,               ///< Receives the latencies
+                             ClockProc         clock                    ///< The microseconds clock, nullptr for micros()
+                            );
+
+    /// @brief Destructor.
+    virtual ~InstrumentedTrafficLight();
+
+  public:
+    /// @brief Initialization function.
+    ///
+    /// @note The wrapped light must be initialized before calling this method
+    ///
+    /// @param configuration      The configuration data. Only the name is used.
+    ///
+    /// @retval RESULT_OK         The device was successfully configured.
+    /// @retval RESULT_BUSY       The  device was already configured. Deinit() must be called before calling Init() again.
+    /// @retval RESULT_DEV_ERR    The wrapped light is not initialized.
+    /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+    ///
+    virtual Result Init(const Config& configuration);
+
+    /// @brief Get whether the device was initialized
+    ///
+    /// @return boolean true if it is initialized
+    /// and available for use
+    virtual bool IsInitialized() const;
+
+    /// @brief Deinitialization function for the device.
+    ///
+    /// @note The wrapped light is not deinitialized
+    ///
+    virtual void Deinit();
+
+    /// @brief Turns On the specified light. Only one light can be turned on at a time. If a light is already on when this method
+    /// is invoked it will be turned off before the new light is turned on.
+    ///
+    /// @param whichLight         Defines which light should be turned on.
+    ///
+    /// @retval RESULT_OK         The light was successfully turned on.
+    /// @retval RESULT_NOT_READY  The execution failed because the device was not initialized (Init() method wasn't called)
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind of error state.
+    virtual Result TurnOn(LightSelector whichLight);
+
+    /// @brief Turns Off the specified light.
+    ///
+    /// @param whichLight         Defines which light should be turned off.
+    ///
+    /// @retval RESULT_OK         The light was successfully turned off.
+    /// @retval RESULT_NOT_READY  The execution failed because the device was not initialized (Init() method wasn't called)
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind of error state.
+    virtual Result TurnOff(LightSelector whichLight);
+
+    /// @brief Sets the state for the specified light.
+    ///
+    /// @param whichLight         Defines which light should be turned ON or OFF.
+    /// @param state              The light state
+    ///
+    /// @retval RESULT_OK         The light state was successfully set.
+    /// @retval RESULT_NOT_READY  The execution failed because the device was not initialized (Init() method wasn't called)
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind of error state.
+    /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+    ///
+    virtual Result SetState(LightSelector whichLight, LightState state);
+
+    /// @brief Gets the state for the specified light.
+    ///
+    /// @param whichLight         Defines which light should be turned ON or OFF.
+    /// @param state              The light state
+    ///
+    /// @retval RESULT_OK         The light state was retrieved successfully.
+    /// @retval RESULT_NOT_READY  The execution failed because the device was not initialized (Init() method wasn't called)
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind of error state.
+    /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+    ///
+    virtual Result GetState(LightSelector whichLight, LightState& state);
+
+    /// @brief Turns off all the lights.
+    ///
+    /// @retval RESULT_OK         The light state was successfully set.
+    /// @retval RESULT_NOT_READY  The execution failed because the device was not initialized (Init() method wasn't called)
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind of error state.
+    ///
+    virtual Result SetAllLightsOff();
+
+    /// @brief Performs a test of the lights.
+    ///
+    /// @retval RESULT_OK         The test completed successfully.
+    /// @retval RESULT_NOT_READY  The execution failed because the device was not initialized (Init() method wasn't called).
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind of error state.
+    ///
+    virtual Result PerformLightsTest();
+
+    /// @brief Performs a test of the lights without blocking.
+    ///
+    /// @note The method must be called repeatedly until it returns something else than RESULT_BUSY.
+    ///
+    /// @retval RESULT_OK         The test completed successfully.
+    /// @retval RESULT_BUSY       The test is in progress.
+    /// @retval RESULT_NOT_READY  The execution failed because the device was not initialized (Init() method wasn't called).
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind of error state.
+    ///
+    virtual Result PerformLightsTestAsync();
+
+  private:
+    /// @brief Records the latency of the last capture if it wasn't recorded yet
+    ///
+    /// @note Called after the write, so the latency includes the write itself
+    ///
+    void RecordLatency();
+
+    /// @brief Gets the current time from the clock
+    ///
+    /// @retval The time in microseconds
+    ///
+    uint32_t GetTime() const;
+
+  private:
+    /// @brief Default Constructor.
+    InstrumentedTrafficLight();
+
+  private:
+    bool              _initDone;                      ///< A flag to indicate whether the light was initialized
+    char              _name[MAX_COMPONENT_NAME_LENGTH]; ///< A symbolic name for this light
+    ITrafficLight    *_trafficLight;                  ///< The light writing the pins
+    ClockProc         _captureTime;                   ///< Gets the time of the last capture in microseconds
+    LatencyHistogram *_histogram;                     ///< Receives the latencies
+    ClockProc         _clock;                         ///< The microseconds clock, nullptr for micros()
+    uint32_t          _lastCaptureTimeUs;             ///< The capture whose latency was recorded last
+  };
+}
+
+#endif // _INSTRUMENTEDTRAFFICLIGHT_H_
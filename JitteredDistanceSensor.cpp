@@ -0,0 +1,296 @@
+///
+/// @file JitteredDistanceSensor.cpp
+///
+/// @brief JitteredDistanceSensor class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "JitteredDistanceSensor.h"
+#include "DebugUtils.h"
+#include "SpeedOfSound.h"
+
+namespace CNEGR
+{
+  /// @brief Constructor.
+  JitteredDistanceSensor::JitteredDistanceSensor(IDistanceSensor  *sensor,                  ///< The sensor protected against the interference
+                                                 uint32_t         maxJitterMs,              ///< The longest random delay before a ping in milliseconds
+                                                 uint32_t         toleranceMm,              ///< The largest difference between two consistent readings in millimeters
+                                                 uint32_t         seed,                     ///< The seed of the delays, must be different on every device
+                                                 ClockProc        clock                     ///< The clock timing the delays, nullptr for millis()
+                                                )
+    :_initDone(false),
+     _sensor(sensor),
+     _maxJitterMs(maxJitterMs),
+     _toleranceMm(toleranceMm),
+     _random(seed),
+     _clock(clock),
+     _historyIndex(0),
+     _jitterStartMs(0),
+     _jitterMs(0),
+     _sensorResult(RESULT_OK),
+     _sensorDistance(0)
+  {
+    _name[0] = '\0';
+    memset(&_statistics, 0, sizeof(_statistics));
+
+    for (uint8_t i = 0; i < JITTEREDDISTANCESENSOR_HISTORY_SIZE; i++)
+      _history[i] = UINT32_MAX;
+
+    PT_INIT(&_measurement);
+  }
+
+  /// @brief Destructor.
+  JitteredDistanceSensor::~JitteredDistanceSensor()
+  {
+    Deinit();
+  }
+
+  /// @brief Initialization function.
+  ///
+  /// @note The sensor must be initialized before calling this method
+  ///
+  /// @param configuration      The configuration data. Only the name is used.
+  ///
+  /// @retval RESULT_OK         The device was successfully configured.
+  /// @retval RESULT_BUSY       The  device was already configured.
+  ///                           Deinit() must be called before calling Init() again.
+  /// @retval RESULT_DEV_ERR    The sensor is not initialized.
+  /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+  ///
+  Result JitteredDistanceSensor::Init(const Config& configuration)
+  {
+    if (IsInitialized())
+    {
+      // Already initialized
+      return RESULT_BUSY;
+    }
+
+    if ((configuration.name == NULL) || (_sensor == nullptr))
+    {
+      // Invalid name or sensor
+      return RESULT_BAD_PARAM;
+    }
+
+    if (!_sensor->IsInitialized())
+    {
+      return RESULT_DEV_ERR;
+    }
+
+    // Copy the name
+    strncpy((char *)(&_name[0]), configuration.name, sizeof(_name)-1);
+
+    for (uint8_t i = 0; i < JITTEREDDISTANCESENSOR_HISTORY_SIZE; i++)
+      _history[i] = UINT32_MAX;
+
+    _historyIndex = 0;
+    memset(&_statistics, 0, sizeof(_statistics));
+    PT_INIT(&_measurement);
+
+    // Set the init done flag
+    _initDone = true;
+    return RESULT_OK;
+  }
+
+  /// @brief Get whether the sensor device was initialized
+  ///
+  /// @return boolean true if it is initialized
+  /// and available for use
+  bool JitteredDistanceSensor::IsInitialized() const
+  {
+    return _initDone;
+  }
+
+  /// @brief Deinitialization function for the device.
+  ///
+  /// @note The sensor is not deinitialized
+  ///
+  void JitteredDistanceSensor::Deinit()
+  {
+    // Clear the name
+    _name[0] = '\0';
+
+    // And reset the init done flag
+    _initDone = false;
+  }
+
+  /// @brief Measures the distance.
+  ///
+  /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_TIMEOUT    There was no echo or the reading was not consistent with the last ones.
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+  ///                           of error state.
+  Result JitteredDistanceSensor::MeasureDistance(uint32_t& distance)
+  {
+    const uint32_t ambientTemperature = 20 * 10;
+    return MeasureDistance(ambientTemperature, distance);
+  }
+
+  /// @brief Measures the distance and adjusts the result for the ambient temperature.
+  ///
+  /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+  /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_TIMEOUT    There was no echo or the reading was not consistent with the last ones.
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+  ///                           of error state.
+  Result JitteredDistanceSensor::MeasureDistance(uint32_t ambientTemperature, uint32_t& distance)
+  {
+    return MeasureDistance(ambientTemperature, DEFAULT_RELATIVE_HUMIDITY, distance);
+  }
+
+  /// @brief Measures the distance and adjusts the result for the ambient temperature and relative humidity.
+  ///
+  /// @note Temperatures below zero are passed as the two's complement of the value.
+  ///
+  /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+  /// @param relativeHumidity   The relative humidity in percent
+  /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_TIMEOUT    There was no echo or the reading was not consistent with the last ones.
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+  ///                           of error state.
+  Result JitteredDistanceSensor::MeasureDistance(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    delay(NextJitter());
+
+    uint32_t sensorDistance = 0;
+    Result result = _sensor->MeasureDistance(ambientTemperature, relativeHumidity, sensorDistance);
+
+    return Check(result, sensorDistance, distance);
+  }
+
+  /// @brief Measures the distance without blocking.
+  ///
+  /// @note The first call starts the random delay and the method must then be called
+  /// repeatedly until it returns something else than RESULT_BUSY. The temperature
+  /// and humidity passed to the first call are used for the whole measurement.
+  ///
+  /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+  /// @param relativeHumidity   The relative humidity in percent
+  /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_BUSY       The measurement is in progress.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_TIMEOUT    There was no echo or the reading was not consistent with the last ones.
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+  ///                           of error state.
+  Result JitteredDistanceSensor::MeasureDistanceAsync(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    PT_BEGIN(&_measurement);
+
+    _jitterMs      = NextJitter();
+    _jitterStartMs = GetTime();
+
+    PT_WAIT_UNTIL(&_measurement, GetTime() - _jitterStartMs >= _jitterMs);
+
+    PT_WAIT_UNTIL(&_measurement, (_sensorResult = _sensor->MeasureDistanceAsync(ambientTemperature, relativeHumidity, _sensorDistance)) != RESULT_BUSY);
+
+    PT_EXIT(&_measurement, Check(_sensorResult, _sensorDistance, distance));
+
+    PT_END(&_measurement);
+  }
+
+  /// @brief Limits the range of the measurements
+  ///
+  /// @note The limit is applied to the protected sensor.
+  ///
+  /// @param rangeLimitMm       The range limit in millimeters, 0 to use the full range
+  ///
+  /// @retval RESULT_OK         The range limit was changed.
+  /// @retval RESULT_NOT_READY  The sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_BAD_PARAM  The range limit is below the minimum distance the sensor can detect.
+  ///
+  Result JitteredDistanceSensor::SetRangeLimit(uint32_t rangeLimitMm)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    return _sensor->SetRangeLimit(rangeLimitMm);
+  }
+
+  /// @brief Gets the counters collected since Init()
+  ///
+  /// @param statistics         Contains the counters
+  ///
+  void JitteredDistanceSensor::GetStatistics(Statistics& statistics) const
+  {
+    statistics = _statistics;
+  }
+
+  /// @brief Checks a reading against the last ones and records it
+  ///
+  /// @param result             The result of the sensor measurement
+  /// @param sensorDistance     The distance measured by the sensor
+  /// @param distance           Contains the distance in millimeters if the reading is consistent
+  ///
+  /// @retval RESULT_OK         The reading is consistent.
+  /// @retval RESULT_TIMEOUT    There was no echo or the reading is not consistent.
+  /// @retval Any other error returned by the sensor
+  ///
+  Result JitteredDistanceSensor::Check(Result result, uint32_t sensorDistance, uint32_t& distance)
+  {
+    uint32_t reading = (result == RESULT_OK) ? sensorDistance : UINT32_MAX;
+
+    bool consistent = false;
+    for (uint8_t i = 0; i < JITTEREDDISTANCESENSOR_HISTORY_SIZE; i++)
+    {
+      if (_history[i] == UINT32_MAX)
+        continue;
+
+      uint32_t difference = (reading > _history[i]) ? reading - _history[i] : _history[i] - reading;
+      if (difference <= _toleranceMm)
+        consistent = true;
+    }
+
+    // The rejected readings are kept too, the next reading confirms a real jump
+    _history[_historyIndex] = reading;
+    _historyIndex = (_historyIndex + 1) % JITTEREDDISTANCESENSOR_HISTORY_SIZE;
+
+    if (result != RESULT_OK)
+      return result;
+
+    _statistics.readings++;
+
+    if (!consistent)
+    {
+      Logger::Debug(F("Inconsistent reading %lu mm rejected"), sensorDistance);
+      _statistics.rejected++;
+      return RESULT_TIMEOUT;
+    }
+
+    distance = sensorDistance;
+    return RESULT_OK;
+  }
+
+  /// @brief Draws the delay of the next ping
+  ///
+  /// @retval The delay in milliseconds, 0 to maxJitterMs
+  ///
+  uint32_t JitteredDistanceSensor::NextJitter()
+  {
+    // Linear congruential generator, the low bits have a short period so only the high bits are used
+    _random = _random * 1664525UL + 1013904223UL;
+    return (uint32_t)(_random >> 16) % (_maxJitterMs + 1);
+  }
+
+  uint32_t JitteredDistanceSensor::GetTime() const
+  {
+    return (_clock != nullptr) ? _clock() : millis();
+  }
+}
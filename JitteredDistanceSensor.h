@@ -0,0 +1,205 @@
+///
+/// @file JitteredDistanceSensor.h
+///
+/// @brief JitteredDistanceSensor class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_JITTEREDDISTANCESENSOR_H_)
+#define _JITTEREDDISTANCESENSOR_H_
+
+#include "IDistanceSensor.h"
+#include "CommonDefines.h"
+#include "Protothread.h"
+
+namespace CNEGR
+{
+  /// The number of recent readings a new reading is compared with
+  #define JITTEREDDISTANCESENSOR_HISTORY_SIZE 3
+
+  /// @brief JitteredDistanceSensor class definition
+  ///
+  /// Rejects the interference of the sensors in the neighbouring bays. Boards running
+  /// the same firmware ping with almost the same period, so when the pings of two
+  /// sensors overlap they keep overlapping for many seconds and one sensor keeps
+  /// receiving the burst of the other one as a short echo. Every ping is delayed by a
+  /// random time, different on every device, so that the overlaps become isolated
+  /// readings. A reading is then only returned when it is consistent with one of the
+  /// last readings, an isolated reading is reported as a timeout.
+  ///
+  /// A steady or moving target is returned without delay. Only the first reading of a
+  /// target appearing or jumping is reported as a timeout, it is returned by the next
+  /// measurement if it is confirmed.
+  ///
+  class JitteredDistanceSensor: public IDistanceSensor
+  {
+  public:
+    /// @brief The counters since Init()
+    ///
+    struct Statistics
+    {
+      uint32_t  readings;                     ///< The number of readings with an echo
+      uint32_t  rejected;                     ///< The number of readings rejected as inconsistent
+    };
+
+  public:
+    /// @brief Constructor.
+    JitteredDistanceSensor(IDistanceSensor  *sensor,                  ///< The sensor protected against the interference
+                           uint32_t         maxJitterMs,              ///< The longest random delay before a ping in milliseconds
+                           uint32_t         toleranceMm,              ///< The largest difference between two consistent readings in millimeters
+                           uint32_t         seed,                     ///< The seed of the delays, must be different on every device
+                           ClockProc        clock                     ///< The clock timing the delays, nullptr for millis()
+                          );
+
+    /// @brief Destructor.
+    virtual ~JitteredDistanceSensor();
+
+  public:
+    /// @brief Initialization function.
+    ///
+    /// @note The sensor must be initialized before calling this method
+    ///
+    /// @param configuration      The configuration data. Only the name is used.
+    ///
+    /// @retval RESULT_OK         The device was successfully configured.
+    /// @retval RESULT_BUSY       The  device was already configured.
+    ///                           Deinit() must be called before calling Init() again.
+    /// @retval RESULT_DEV_ERR    The sensor is not initialized.
+    /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+    ///
+    virtual Result Init(const Config& configuration);
+
+    /// @brief Get whether the sensor device was initialized
+    ///
+    /// @return boolean true if it is initialized
+    /// and available for use
+    virtual bool IsInitialized() const;
+
+    /// @brief Deinitialization function for the device.
+    ///
+    /// @note The sensor is not deinitialized
+    ///
+    virtual void Deinit();
+
+    /// @brief Measures the distance.
+    ///
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_TIMEOUT    There was no echo or the reading was not consistent with the last ones.
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+    ///                           of error state.
+    virtual Result MeasureDistance(uint32_t& distance);
+
+    /// @brief Measures the distance and adjusts the result for the ambient temperature.
+    ///
+    /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_TIMEOUT    There was no echo or the reading was not consistent with the last ones.
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+    ///                           of error state.
+    virtual Result MeasureDistance(uint32_t ambientTemperature, uint32_t& distance);
+
+    /// @brief Measures the distance and adjusts the result for the ambient temperature and relative humidity.
+    ///
+    /// @note Temperatures below zero are passed as the two's complement of the value.
+    ///
+    /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+    /// @param relativeHumidity   The relative humidity in percent
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_TIMEOUT    There was no echo or the reading was not consistent with the last ones.
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+    ///                           of error state.
+    virtual Result MeasureDistance(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance);
+
+    /// @brief Measures the distance without blocking.
+    ///
+    /// @note The first call starts the random delay and the method must then be called
+    /// repeatedly until it returns something else than RESULT_BUSY. The temperature
+    /// and humidity passed to the first call are used for the whole measurement.
+    ///
+    /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+    /// @param relativeHumidity   The relative humidity in percent
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_BUSY       The measurement is in progress.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_TIMEOUT    There was no echo or the reading was not consistent with the last ones.
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+    ///                           of error state.
+    virtual Result MeasureDistanceAsync(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance);
+
+    /// @brief Limits the range of the measurements
+    ///
+    /// @note The limit is applied to the protected sensor.
+    ///
+    /// @param rangeLimitMm       The range limit in millimeters, 0 to use the full range
+    ///
+    /// @retval RESULT_OK         The range limit was changed.
+    /// @retval RESULT_NOT_READY  The sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_BAD_PARAM  The range limit is below the minimum distance the sensor can detect.
+    ///
+    virtual Result SetRangeLimit(uint32_t rangeLimitMm);
+
+  public:
+    /// @brief Gets the counters collected since Init()
+    ///
+    /// @param statistics         Contains the counters
+    ///
+    void GetStatistics(Statistics& statistics) const;
+
+  private:
+    /// @brief Checks a reading against the last ones and records it
+    ///
+    /// @param result             The result of the sensor measurement
+    /// @param sensorDistance     The distance measured by the sensor
+    /// @param distance           Contains the distance in millimeters if the reading is consistent
+    ///
+    /// @retval RESULT_OK         The reading is consistent.
+    /// @retval RESULT_TIMEOUT    There was no echo or the reading is not consistent.
+    /// @retval Any other error returned by the sensor
+    ///
+    Result Check(Result result, uint32_t sensorDistance, uint32_t& distance);
+
+    /// @brief Draws the delay of the next ping
+    ///
+    /// @retval The delay in milliseconds, 0 to maxJitterMs
+    ///
+    uint32_t NextJitter();
+
+    uint32_t GetTime() const;
+
+  private:
+    /// @brief Default Constructor.
+    JitteredDistanceSensor();
+
+  private:
+    bool            _initDone;                        ///< A flag to indicate whether the sensor was initialized
+    char            _name[MAX_COMPONENT_NAME_LENGTH]; ///< A symbolic name for this sensor
+    IDistanceSensor *_sensor;                         ///< The sensor protected against the interference
+    uint32_t        _maxJitterMs;                     ///< The longest random delay before a ping in milliseconds
+    uint32_t        _toleranceMm;                     ///< The largest difference between two consistent readings
+    uint32_t        _random;                          ///< The pseudo random generator state
+    ClockProc       _clock;                           ///< The clock timing the delays, nullptr for millis()
+    uint32_t        _history[JITTEREDDISTANCESENSOR_HISTORY_SIZE];  ///< The last readings, UINT32_MAX for no echo
+    uint8_t         _historyIndex;                    ///< The index of the oldest reading in the history
+    Protothread     _measurement;                     ///< The asynchronous measurement state
+    uint32_t        _jitterStartMs;                   ///< The start time of the random delay
+    uint32_t        _jitterMs;                        ///< The random delay of the asynchronous measurement
+    Result          _sensorResult;                    ///< The result of the asynchronous sensor measurement
+    uint32_t        _sensorDistance;                  ///< The distance of the asynchronous sensor measurement
+    Statistics      _statistics;                      ///< The counters since Init()
+  };
+}
+#endif // _JITTEREDDISTANCESENSOR_H_
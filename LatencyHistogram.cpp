@@ -0,0 +1,190 @@
+///
+/// @file LatencyHistogram.cpp
+///
+/// @brief LatencyHistogram class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "LatencyHistogram.h"
+
+namespace CNEGR
+{
+  /// @brief Constructor.
+  LatencyHistogram::LatencyHistogram()
+  {
+    Clear();
+  }
+
+  /// @brief Destructor.
+  LatencyHistogram::~LatencyHistogram()
+  {
+  }
+
+  /// @brief Clears the recorded latencies
+  ///
+  void LatencyHistogram::Clear()
+  {
+    memset(_buckets, 0, sizeof(_buckets));
+    _count        = 0;
+    _maxLatencyUs = 0;
+  }
+
+  /// @brief Records a latency
+  ///
+  /// @param latencyUs          The latency in microseconds
+  ///
+  void LatencyHistogram::Record(uint32_t latencyUs)
+  {
+    uint8_t bucket = GetBucket(latencyUs);
+
+    // The percentiles stay right when a bucket saturates
+    // as long as the other buckets don't fill up as well
+    if (_buckets[bucket] < UINT16_MAX)
+      _buckets[bucket]++;
+
+    _count++;
+
+    if (latencyUs > _maxLatencyUs)
+      _maxLatencyUs = latencyUs;
+  }
+
+  /// @brief Gets the number of recorded latencies
+  ///
+  /// @retval The number of latencies since the last Clear()
+  ///
+  uint32_t LatencyHistogram::GetCount() const
+  {
+    return _count;
+  }
+
+  /// @brief Gets the largest recorded latency
+  ///
+  /// @retval The latency in microseconds, 0 if none was recorded
+  ///
+  uint32_t LatencyHistogram::GetMax() const
+  {
+    return _maxLatencyUs;
+  }
+
+  /// @brief Gets a percentile of the recorded latencies
+  ///
+  /// @param percent            The percentile, 1 to 100
+  /// @param latencyUs          Contains the upper bound of the bucket holding the percentile,
+  ///                           never more than the largest latency
+  ///
+  /// @retval RESULT_OK         The percentile was computed.
+  /// @retval RESULT_NO_DATA    No latency was recorded.
+  /// @retval RESULT_BAD_PARAM  The percentile is invalid.
+  ///
+  Result LatencyHistogram::GetPercentile(uint8_t percent, uint32_t& latencyUs) const
+  {
+    if ((percent == 0) || (percent > 100))
+      return RESULT_BAD_PARAM;
+
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < LATENCYHISTOGRAM_BUCKET_COUNT; i++)
+      total += _buckets[i];
+
+    if (total == 0)
+      return RESULT_NO_DATA;
+
+    // The rank of the percentile, rounded up
+    uint32_t rank  = (uint32_t)(((uint64_t)total * percent + 99) / 100);
+    uint32_t count = 0;
+
+    for (uint8_t i = 0; i < LATENCYHISTOGRAM_BUCKET_COUNT; i++)
+    {
+      count += _buckets[i];
+      if (count >= rank)
+      {
+        uint32_t upperBound = GetUpperBound(i);
+        latencyUs = ((upperBound != 0) && (upperBound < _maxLatencyUs)) ? upperBound : _maxLatencyUs;
+        return RESULT_OK;
+      }
+    }
+
+    latencyUs = _maxLatencyUs;
+    return RESULT_OK;
+  }
+
+  /// @brief Prints the count, p50, p99 and max, one "name=value" line per value,
+  /// followed by the non-empty buckets as "le<upper bound>=count" lines
+  ///
+  /// @param output             Where the latencies are printed
+  ///
+  void LatencyHistogram::Print(::Print& output) const
+  {
+    uint32_t p50 = 0;
+    uint32_t p99 = 0;
+    GetPercentile(50, p50);
+    GetPercentile(99, p99);
+
+    output.print(F("count="));  output.println(_count);
+    output.print(F("p50Us="));  output.println(p50);
+    output.print(F("p99Us="));  output.println(p99);
+    output.print(F("maxUs="));  output.println(_maxLatencyUs);
+
+    for (uint8_t i = 0; i < LATENCYHISTOGRAM_BUCKET_COUNT; i++)
+    {
+      if (_buckets[i] == 0)
+        continue;
+
+      uint32_t upperBound = GetUpperBound(i);
+      if (upperBound != 0)
+      {
+        output.print(F("le"));
+        output.print(upperBound);
+      }
+      else
+      {
+        output.print(F("inf"));
+      }
+
+      output.print(F("="));
+      output.println(_buckets[i]);
+    }
+  }
+
+  /// @brief Gets the bucket of a latency
+  ///
+  uint8_t LatencyHistogram::GetBucket(uint32_t latencyUs)
+  {
+    if (latencyUs < LATENCYHISTOGRAM_MIN_LATENCY_US)
+      return 0;
+
+    // Bucket 1 starts at the minimum latency, two buckets per power of two
+    uint8_t  bucket = 1;
+    uint32_t lower  = LATENCYHISTOGRAM_MIN_LATENCY_US;
+
+    while (bucket < LATENCYHISTOGRAM_BUCKET_COUNT - 2)
+    {
+      if (latencyUs < lower + lower / 2)
+        return bucket;
+
+      if (latencyUs < lower * 2)
+        return bucket + 1;
+
+      bucket += 2;
+      lower  *= 2;
+    }
+
+    return LATENCYHISTOGRAM_BUCKET_COUNT - 1;
+  }
+
+  /// @brief Gets the upper bound of a bucket, the last bucket has none
+  ///
+  uint32_t LatencyHistogram::GetUpperBound(uint8_t bucket)
+  {
+    if (bucket >= LATENCYHISTOGRAM_BUCKET_COUNT - 1)
+      return 0;
+
+    if (bucket == 0)
+      return LATENCYHISTOGRAM_MIN_LATENCY_US;
+
+    // Odd buckets end at one and a half times their power of two, even ones at the next one
+    uint32_t lower = (uint32_t)LATENCYHISTOGRAM_MIN_LATENCY_US << ((bucket - 1) / 2);
+    return (bucket % 2 != 0) ? lower + lower / 2 : lower * 2;
+  }
+}
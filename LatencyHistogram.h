@@ -0,0 +1,98 @@
+///
+/// @file LatencyHistogram.h
+///
+/// @brief LatencyHistogram class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_LATENCYHISTOGRAM_H_)
+#define _LATENCYHISTOGRAM_H_
+
+#include <Arduino.h>
+#include "Result.h"
+
+namespace CNEGR
+{
+  /// The number of buckets, the last one ends above 3 seconds
+  #define LATENCYHISTOGRAM_BUCKET_COUNT 32
+
+  /// The upper bound of the first bucket in microseconds, a power of two
+  #define LATENCYHISTOGRAM_MIN_LATENCY_US 64
+
+  /// @brief LatencyHistogram class definition
+  ///
+  /// Counts latencies in buckets of half an octave: every power of two is split in two
+  /// buckets, at one and a half times the power of two. The percentiles are therefore
+  /// known within 50%, which is enough to tell apart the milliseconds of the processing
+  /// from the tens of milliseconds of a blocking log, in 64 bytes of memory.
+  ///
+  class LatencyHistogram
+  {
+  public:
+    /// @brief Constructor.
+    LatencyHistogram();
+
+    /// @brief Destructor.
+    ~LatencyHistogram();
+
+  public:
+    /// @brief Clears the recorded latencies
+    ///
+    void Clear();
+
+    /// @brief Records a latency
+    ///
+    /// @param latencyUs          The latency in microseconds
+    ///
+    void Record(uint32_t latencyUs);
+
+    /// @brief Gets the number of recorded latencies
+    ///
+    /// @retval The number of latencies since the last Clear()
+    ///
+    uint32_t GetCount() const;
+
+    /// @brief Gets the largest recorded latency
+    ///
+    /// @retval The latency in microseconds, 0 if none was recorded
+    ///
+    uint32_t GetMax() const;
+
+    /// @brief Gets a percentile of the recorded latencies
+    ///
+    /// @param percent            The percentile, 1 to 100
+    /// @param latencyUs          Contains the upper bound of the bucket holding the percentile,
+    ///                           never more than the largest latency
+    ///
+    /// @retval RESULT_OK         The percentile was computed.
+    /// @retval RESULT_NO_DATA    No latency was recorded.
+    /// @retval RESULT_BAD_PARAM  The percentile is invalid.
+    ///
+    Result GetPercentile(uint8_t percent, uint32_t& latencyUs) const;
+
+    /// @brief Prints the count, p50, p99 and max, one "name=value" line per value,
+    /// followed by the non-empty buckets as "le<upper bound>=count" lines
+    ///
+    /// @param output             Where the latencies are printed
+    ///
+    void Print(::Print& output) const;
+
+  private:
+    /// @brief Gets the bucket of a latency
+    ///
+    static uint8_t GetBucket(uint32_t latencyUs);
+
+    /// @brief Gets the upper bound of a bucket, the last bucket has none
+    ///
+    static uint32_t GetUpperBound(uint8_t bucket);
+
+  private:
+    uint16_t  _buckets[LATENCYHISTOGRAM_BUCKET_COUNT];  ///< The number of latencies in every bucket, saturated
+    uint32_t  _count;                                   ///< The number of latencies since the last Clear()
+    uint32_t  _maxLatencyUs;                            ///< The largest latency since the last Clear()
+  };
+}
+#endif // _LATENCYHISTOGRAM_H_
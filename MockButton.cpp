@@ -0,0 +1,140 @@
+///
+/// @file MockButton.cpp
+///
+/// @brief MockButton class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "MockButton.h"
+
+namespace CNEGR
+{
+  /// @brief Constructor.
+  MockButton::MockButton()
+    :_initDone(false),
+     _first(0),
+     _count(0),
+     _lostEvents(0)
+  {
+    _name[0] = '\0';
+  }
+
+  /// @brief Destructor.
+  MockButton::~MockButton()
+  {
+    Deinit();
+  }
+
+  /// @brief Initialization function.
+  ///
+  /// @param configuration      The configuration data. Only the name is used.
+  ///
+  /// @retval RESULT_OK         The device was successfully configured.
+  /// @retval RESULT_BUSY       The  device was already configured. Deinit() must be called before calling Init() again.
+  /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+  ///
+  Result MockButton::Init(const Config& configuration)
+  {
+    if (IsInitialized())
+    {
+      // Already initialized
+      return RESULT_BUSY;
+    }
+
+    if (configuration.name == NULL)
+    {
+      // Name is invalid
+      return RESULT_BAD_PARAM;
+    }
+
+    // Copy the name
+    strncpy((char *)(&_name[0]), configuration.name, sizeof(_name)-1);
+
+    _first      = 0;
+    _count      = 0;
+    _lostEvents = 0;
+
+    // Set the init done flag
+    _initDone = true;
+    return RESULT_OK;
+  }
+
+  /// @brief Get whether the device was initialized
+  ///
+  /// @return boolean true if it is initialized
+  /// and available for use
+  bool MockButton::IsInitialized() const
+  {
+    return _initDone;
+  }
+
+  /// @brief Deinitialization function for the device.
+  ///
+  void MockButton::Deinit()
+  {
+    // Clear the name
+    _name[0] = '\0';
+
+    // And reset the init done flag
+    _initDone = false;
+  }
+
+  /// @brief Gets the oldest button event
+  ///
+  /// @param event              Contains the event if successful
+  ///
+  /// @retval RESULT_OK         An event was retrieved.
+  /// @retval RESULT_NO_DATA    There are no events.
+  /// @retval RESULT_NOT_READY  The device was not initialized (Init() method wasn't called)
+  ///
+  Result MockButton::GetEvent(Event& event)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    if (_count == 0)
+      return RESULT_NO_DATA;
+
+    event = _events[_first];
+    _first = (_first + 1) % MOCKBUTTON_QUEUE_SIZE;
+    _count--;
+
+    return RESULT_OK;
+  }
+
+  /// @brief Gets the number of events lost because the queue was full
+  ///
+  /// @retval The number of lost events
+  ///
+  uint16_t MockButton::GetLostEventCount() const
+  {
+    return _lostEvents;
+  }
+
+  /// @brief Queues an event as if the button was pressed
+  ///
+  /// @param event              The event to queue
+  ///
+  /// @retval RESULT_OK         The event was queued.
+  /// @retval RESULT_OVERFLOW   The queue is full, the event is lost.
+  /// @retval RESULT_NOT_READY  The device was not initialized (Init() method wasn't called)
+  ///
+  Result MockButton::InjectEvent(Event event)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    if (_count == MOCKBUTTON_QUEUE_SIZE)
+    {
+      _lostEvents++;
+      return RESULT_OVERFLOW;
+    }
+
+    _events[(_first + _count) % MOCKBUTTON_QUEUE_SIZE] = event;
+    _count++;
+
+    return RESULT_OK;
+  }
+}
@@ -0,0 +1,91 @@
+///
+/// @file MockButton.h
+///
+/// @brief MockButton class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_MOCKBUTTON_H_)
+#define _MOCKBUTTON_H_
+
+#include "IButton.h"
+#include "CommonDefines.h"
+
+namespace CNEGR
+{
+  #define MOCKBUTTON_QUEUE_SIZE       8     ///< The number of events buffered
+
+  /// @brief MockButton class definition
+  ///
+  /// A button without hardware, the events are injected with InjectEvent()
+  ///
+  class MockButton: public IButton
+  {
+  public:
+    /// @brief Constructor.
+    MockButton();
+
+    /// @brief Destructor.
+    virtual ~MockButton();
+
+  public:
+    /// @brief Initialization function.
+    ///
+    /// @param configuration      The configuration data. Only the name is used.
+    ///
+    /// @retval RESULT_OK         The device was successfully configured.
+    /// @retval RESULT_BUSY       The  device was already configured. Deinit() must be called before calling Init() again.
+    /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+    ///
+    virtual Result Init(const Config& configuration);
+
+    /// @brief Get whether the device was initialized
+    ///
+    /// @return boolean true if it is initialized
+    /// and available for use
+    virtual bool IsInitialized() const;
+
+    /// @brief Deinitialization function for the device.
+    ///
+    virtual void Deinit();
+
+    /// @brief Gets the oldest button event
+    ///
+    /// @param event              Contains the event if successful
+    ///
+    /// @retval RESULT_OK         An event was retrieved.
+    /// @retval RESULT_NO_DATA    There are no events.
+    /// @retval RESULT_NOT_READY  The device was not initialized (Init() method wasn't called)
+    ///
+    virtual Result GetEvent(Event& event);
+
+    /// @brief Gets the number of events lost because the queue was full
+    ///
+    /// @retval The number of lost events
+    ///
+    virtual uint16_t GetLostEventCount() const;
+
+    /// @brief Queues an event as if the button was pressed
+    ///
+    /// @param event              The event to queue
+    ///
+    /// @retval RESULT_OK         The event was queued.
+    /// @retval RESULT_OVERFLOW   The queue is full, the event is lost.
+    /// @retval RESULT_NOT_READY  The device was not initialized (Init() method wasn't called)
+    ///
+    Result InjectEvent(Event event);
+
+  private:
+    bool            _initDone;                          ///< A flag to indicate whether the button was initialized
+    char            _name[MAX_COMPONENT_NAME_LENGTH];   ///< A symbolic name for this button
+    Event           _events[MOCKBUTTON_QUEUE_SIZE];     ///< The events queue
+    uint8_t         _first;                             ///< The index of the oldest event
+    uint8_t         _count;                             ///< The number of events in the queue
+    uint16_t        _lostEvents;                        ///< The number of events lost because the queue was full
+  };
+}
+
+#endif // _MOCKBUTTON_H_
@@ -8,20 +8,21 @@
 ///
 
 #include "MockDistanceSensor.h"
+#include "SpeedOfSound.h"
 
 namespace CNEGR
 {
   const uint32_t minTriggerPulseDurationUs  = 10;                         ///< The minimum trigger pulse duration in microseconds
   const uint32_t minDistanceMm              = 20;                         ///< The minimum distance the sensor can detect in millimeters
   const uint32_t maxDistanceMm              = 4000;                       ///< The maximum distance the sensor can detect in millimeters
-  const uint32_t speedOfSound               = 340;                        ///< The speed of sound in meters per second
 
   /// @brief Constructor.
   MockDistanceSensor::MockDistanceSensor()
     :_initDone(false),
     _minTriggerPulseDurationUs(minTriggerPulseDurationUs),
     _minDistanceMm(minDistanceMm),
-    _maxDistanceMm(maxDistanceMm)
+    _maxDistanceMm(maxDistanceMm),
+    _rangeLimitMm(maxDistanceMm)
   {
     _name[0] = '\0';
   }
@@ -63,6 +64,9 @@ namespace CNEGR
     // Copy the name
     strncpy((char *)(&_name[0]), configuration.name, sizeof(_name)-1);
 
+    // The full range until the application limits it
+    _rangeLimitMm = _maxDistanceMm;
+
     // Set the init done flag
     _initDone = true;
     return RESULT_OK;
@@ -114,6 +118,24 @@ namespace CNEGR
   /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
   ///                           of error state.
   Result MockDistanceSensor::MeasureDistance(uint32_t ambientTemperature, uint32_t& distance)
+  {
+    return MeasureDistance(ambientTemperature, DEFAULT_RELATIVE_HUMIDITY, distance);
+  }
+
+  /// @brief Measures the distance and adjusts the result for the ambient temperature and relative humidity.
+  ///
+  /// @note Temperatures below zero are passed as the two's complement of the value.
+  ///
+  /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+  /// @param relativeHumidity   The relative humidity in percent
+  /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+  ///                           of error state.
+  Result MockDistanceSensor::MeasureDistance(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance)
   {
     if (!IsInitialized())
       return RESULT_NOT_READY;
@@ -123,10 +145,57 @@ namespace CNEGR
 
     // Simulate reading the distance from the sensor
     distance = 0;
-    ReadDistance(ambientTemperature, distance);
+    ReadDistance(GetSpeedOfSound((int32_t)ambientTemperature, relativeHumidity), distance);
+
+    if (distance > _rangeLimitMm)
+      return RESULT_TIMEOUT;
 
     return RESULT_OK;
   }
+  /// @brief Measures the distance without blocking.
+  ///
+  /// @note The mock measurement completes immediately, RESULT_BUSY is never returned.
+  ///
+  /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+  /// @param relativeHumidity   The relative humidity in percent
+  /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+  ///                           of error state.
+  Result MockDistanceSensor::MeasureDistanceAsync(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance)
+  {
+    return MeasureDistance(ambientTemperature, relativeHumidity, distance);
+  }
+
+  /// @brief Limits the range of the measurements
+  ///
+  /// @note The echo timeout is computed from the range limit, so a shorter range makes
+  /// the measurements without target shorter. A target beyond the limit is reported as
+  /// a timeout. The limit is clipped to the maximum distance the sensor can detect.
+  ///
+  /// @param rangeLimitMm       The range limit in millimeters, 0 to use the full range
+  ///
+  /// @retval RESULT_OK         The range limit was changed.
+  /// @retval RESULT_NOT_READY  The sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_BAD_PARAM  The range limit is below the minimum distance the sensor can detect.
+  ///
+  Result MockDistanceSensor::SetRangeLimit(uint32_t rangeLimitMm)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    if (rangeLimitMm == 0)
+      rangeLimitMm = _maxDistanceMm;
+
+    if (rangeLimitMm < _minDistanceMm)
+      return RESULT_BAD_PARAM;
+
+    _rangeLimitMm = (rangeLimitMm < _maxDistanceMm) ? rangeLimitMm : _maxDistanceMm;
+    return RESULT_OK;
+  }
 
   void MockDistanceSensor::TriggerMeasurement()
   {
@@ -139,32 +208,13 @@ namespace CNEGR
     delayMicroseconds(_minTriggerPulseDurationUs/5);
   }
 
-  /// @brief Gets the speed of sound at the specified ambient temperature
-  ///
-  /// @param ambientTemperature The ambient temperature in deci-degrees celsius
-  ///
-  float SpeedOfSound(float ambientTemperature)
-  {
-    return 331.4f + (0.6f * (float)ambientTemperature / 10.0f);
-  }
-
-  static uint32_t Distance2Time(uint32_t ambientTemperature, uint32_t distanceMm)
-  {
-    // The time in seconds is calculated as:
-    //    timeInSeconds = distance * 2 / speedOfSound;
-
-    // Calculate the distance in millimeters
-    uint32_t timeUs = ((float)distanceMm/1000.0f / (SpeedOfSound(ambientTemperature) / 2)) * 1000.0f * 1000.0f;
-    return timeUs;
-  }
-
-  void MockDistanceSensor::ReadDistance(uint32_t ambientTemperature, uint32_t& distance)
+  void MockDistanceSensor::ReadDistance(uint16_t speedOfSound, uint32_t& distance)
   {
     // Generate a random value in the [_minDistanceMm, _maxDistanceMm] interval
     distance = random(_minDistanceMm, _maxDistanceMm);
 
-    // Simulate waiting for the measurement
-    uint32_t timeUs = Distance2Time(ambientTemperature, distance);
+    // Simulate waiting for the measurement, a real sensor stops waiting at the range limit
+    uint32_t timeUs = DistanceToEchoTime(speedOfSound, (distance < _rangeLimitMm) ? distance : _rangeLimitMm);
 
     if (timeUs < 1000)
       delayMicroseconds(timeUs);
@@ -76,9 +76,56 @@ namespace CNEGR
     ///                           of error state.
     virtual Result MeasureDistance(uint32_t ambientTemperature, uint32_t& distance);
 
+    /// @brief Measures the distance and adjusts the result for the ambient temperature and relative humidity.
+    ///
+    /// @note Temperatures below zero are passed as the two's complement of the value.
+    ///
+    /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+    /// @param relativeHumidity   The relative humidity in percent
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+    ///                           of error state.
+    virtual Result MeasureDistance(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance);
+
+    /// @brief Measures the distance without blocking.
+    ///
+    /// @note The first call starts the measurement and the method must then be called
+    /// repeatedly until it returns something else than RESULT_BUSY. The temperature
+    /// and humidity passed to the first call are used for the whole measurement.
+    ///
+    /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+    /// @param relativeHumidity   The relative humidity in percent
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_BUSY       The measurement is in progress.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+    ///                           of error state.
+    virtual Result MeasureDistanceAsync(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance);
+
+    /// @brief Limits the range of the measurements
+    ///
+    /// @note The echo timeout is computed from the range limit, so a shorter range makes
+    /// the measurements without target shorter. A target beyond the limit is reported as
+    /// a timeout. The limit is clipped to the maximum distance the sensor can detect.
+    ///
+    /// @param rangeLimitMm       The range limit in millimeters, 0 to use the full range
+    ///
+    /// @retval RESULT_OK         The range limit was changed.
+    /// @retval RESULT_NOT_READY  The sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_BAD_PARAM  The range limit is below the minimum distance the sensor can detect.
+    ///
+    virtual Result SetRangeLimit(uint32_t rangeLimitMm);
+
   private:
     void TriggerMeasurement();
-    void ReadDistance(uint32_t ambientTemperature, uint32_t& distance);
+    void ReadDistance(uint16_t speedOfSound, uint32_t& distance);
 
   private:
     bool            _initDone;                        ///< A flag to indicate whether the sensor was initialized
@@ -86,6 +133,7 @@ namespace CNEGR
     uint32_t        _minTriggerPulseDurationUs;       ///< The minimum trigger pulse duration in microseconds
     uint32_t        _minDistanceMm;                   ///< The minimum distance the sensor can detect in millimeters
     uint32_t        _maxDistanceMm;                   ///< The maximum distance the sensor can detect in millimeters
+    uint32_t        _rangeLimitMm;                    ///< The distance beyond which the echo is not waited for in millimeters
   };
 }
 #endif // _MOCKDISTANCESENSOR_H_
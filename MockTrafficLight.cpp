@@ -15,9 +15,26 @@ namespace CNEGR
     :_initDone(false),
     _redLightState(LightState::Off),
     _yellowLightState(LightState::Off),
-    _greenLightState(LightState::Off)
+    _greenLightState(LightState::Off),
+    _clock(nullptr)
   {
     _name[0] = '\0';
+    PT_INIT(&_lightsTest);
+  }
+
+  /// @brief Constructor.
+  ///
+  /// @param clock    The clock used to time the lights test, nullptr to use millis()
+  ///
+  MockTrafficLight::MockTrafficLight(ClockProc clock)
+    :_initDone(false),
+    _redLightState(LightState::Off),
+    _yellowLightState(LightState::Off),
+    _greenLightState(LightState::Off),
+    _clock(clock)
+  {
+    _name[0] = '\0';
+    PT_INIT(&_lightsTest);
   }
 
   /// @brief Destructor.
@@ -55,6 +72,9 @@ namespace CNEGR
     // Make sure that all the lights are off
     SetAllLightsOff();
 
+    // No lights test is in progress
+    PT_INIT(&_lightsTest);
+
     // Set the init done flag
     _initDone = true;
     return RESULT_OK;
@@ -221,30 +241,67 @@ namespace CNEGR
   /// @retval RESULT_DEV_ERR    The device is not present or is in some kind of error state.
   ///
   Result MockTrafficLight::PerformLightsTest()
+  {
+    Result result = RESULT_OK;
+
+    // Run the sequence to completion
+    PT_INIT(&_lightsTest);
+    while ((result = PerformLightsTestAsync()) == RESULT_BUSY)
+    {
+    }
+
+    return result;
+  }
+
+  /// @brief Performs a test of the lights without blocking.
+  ///
+  /// @note The test takes about 1.5 seconds, the method must be called repeatedly
+  /// until it returns something else than RESULT_BUSY.
+  ///
+  /// @retval RESULT_OK         The test completed successfully.
+  /// @retval RESULT_BUSY       The test is in progress.
+  /// @retval RESULT_NOT_READY  The execution failed because the device was not initialized (Init() method wasn't called).
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind of error state.
+  ///
+  Result MockTrafficLight::PerformLightsTestAsync()
   {
     if (!IsInitialized())
       return RESULT_NOT_READY;
 
-    Result result = TurnOn(LightSelector::RedLight);
+    Result result = RESULT_OK;
 
-    if(result == RESULT_OK)
-    {
-      delay(500);
-      result = TurnOn(LightSelector::YellowLight);
-    }
+    PT_BEGIN(&_lightsTest);
 
-    if(result == RESULT_OK)
-    {
-      delay(500);
-      result = TurnOn(LightSelector::GreenLight);
-    }
+    result = TurnOn(LightSelector::RedLight);
+    if (result != RESULT_OK)
+      PT_EXIT(&_lightsTest, result);
 
-    if(result == RESULT_OK)
-    {
-      delay(500);
-      result = SetAllLightsOff();
-    }
+    PT_WAIT_CLOCK(&_lightsTest, GetTime, 500);
 
-    return result;
+    result = TurnOn(LightSelector::YellowLight);
+    if (result != RESULT_OK)
+      PT_EXIT(&_lightsTest, result);
+
+    PT_WAIT_CLOCK(&_lightsTest, GetTime, 500);
+
+    result = TurnOn(LightSelector::GreenLight);
+    if (result != RESULT_OK)
+      PT_EXIT(&_lightsTest, result);
+
+    PT_WAIT_CLOCK(&_lightsTest, GetTime, 500);
+
+    result = SetAllLightsOff();
+    PT_EXIT(&_lightsTest, result);
+
+    PT_END(&_lightsTest);
+  }
+
+  /// @brief Gets the current time from the clock
+  ///
+  /// @retval The time in milliseconds
+  ///
+  uint32_t MockTrafficLight::GetTime() const
+  {
+    return (_clock != nullptr) ? _clock() : millis();
   }
 }
@@ -12,6 +12,7 @@
 #define _MOCKTRAFFICLIGHT_H_
 
 #include "ITrafficLight.h"
+#include "Protothread.h"
 #include "CommonDefines.h"
 
 namespace CNEGR
@@ -26,6 +27,12 @@ namespace CNEGR
     /// @brief Constructor.
     MockTrafficLight();
 
+    /// @brief Constructor.
+    ///
+    /// @param clock    The clock used to time the lights test, nullptr to use millis()
+    ///
+    explicit MockTrafficLight(ClockProc clock);
+
     /// @brief Destructor.
     virtual ~MockTrafficLight();
 
@@ -110,12 +117,33 @@ namespace CNEGR
     ///
     virtual Result PerformLightsTest();
 
+    /// @brief Performs a test of the lights without blocking.
+    ///
+    /// @note The test takes about 1.5 seconds, the method must be called repeatedly
+    /// until it returns something else than RESULT_BUSY.
+    ///
+    /// @retval RESULT_OK         The test completed successfully.
+    /// @retval RESULT_BUSY       The test is in progress.
+    /// @retval RESULT_NOT_READY  The execution failed because the device was not initialized (Init() method wasn't called).
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind of error state.
+    ///
+    virtual Result PerformLightsTestAsync();
+
+  private:
+    /// @brief Gets the current time from the clock
+    ///
+    /// @retval The time in milliseconds
+    ///
+    uint32_t GetTime() const;
+
   private:
     bool            _initDone;                        ///< A flag to indicate whether the sensor was initialized
     char            _name[MAX_DEVICE_NAME_LENGTH];    ///< A symbolic name for this sensor
     LightState      _redLightState;                   ///< The state of the Red light
     LightState      _yellowLightState;                ///< The state of the Yellow light
     LightState      _greenLightState;                 ///< The state of the Green light
+    Protothread     _lightsTest;                      ///< The lights test sequence state
+    ClockProc       _clock;                           ///< The clock used to time the lights test, nullptr for millis()
   };
 }
 
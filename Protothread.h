@@ -0,0 +1,110 @@
+///
+/// @file Protothread.h
+///
+/// @brief Stackless coroutine (protothread) macros
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+/// A protothread is a function that can wait without blocking: when the condition it
+/// waits for is not met it returns RESULT_BUSY and, when it is called again, it resumes
+/// right after the point where it returned. The resume point is kept in a Protothread
+/// structure, usually a class member, so any number of sequences can interleave on a
+/// single stack.
+///
+///   Result Blink::Run()
+///   {
+///     PT_BEGIN(&_pt);
+///     digitalWrite(LED_BUILTIN, HIGH);
+///     PT_WAIT_MS(&_pt, 500);
+///     digitalWrite(LED_BUILTIN, LOW);
+///     PT_END(&_pt);
+///   }
+///
+/// @note The local variables are not preserved across the wait points, the state
+/// that must survive a wait has to be kept in members. A switch statement can't
+/// contain a wait point since the macros are implemented with a switch, and there
+/// can be at most one wait point per source line.
+///
+#pragma once
+
+#if !defined(_PROTOTHREAD_H_)
+#define _PROTOTHREAD_H_
+
+#include <Arduino.h>
+#include "Result.h"
+
+namespace CNEGR
+{
+  /// @brief The protothread state
+  ///
+  struct Protothread
+  {
+    uint16_t  resumeLine;             ///< The source line where the protothread resumes, 0 at the beginning
+    uint32_t  waitStartTime;          ///< The start time of the running PT_WAIT_MS()/PT_WAIT_US()
+  };
+}
+
+/// Restarts the protothread from the beginning
+#define PT_INIT(pt)               do { (pt)->resumeLine = 0; } while(0)
+
+/// Get whether the protothread is in progress, i.e. it returned RESULT_BUSY last time
+#define PT_IS_RUNNING(pt)         ((pt)->resumeLine != 0)
+
+/// Marks the fall through into the resume label as intended, for -Wimplicit-fallthrough
+#if defined(__GNUC__) && (__GNUC__ >= 7)
+#define PT_FALLTHROUGH            __attribute__((fallthrough))
+#else
+#define PT_FALLTHROUGH            do { } while(0)
+#endif
+
+/// Starts the protothread body
+#define PT_BEGIN(pt)              switch((pt)->resumeLine) { case 0:
+
+/// Ends the protothread body, the protothread returns RESULT_OK and restarts on the next call
+#define PT_END(pt)                } (pt)->resumeLine = 0; return RESULT_OK
+
+/// Returns RESULT_BUSY until the condition is true
+#define PT_WAIT_UNTIL(pt, condition)                                      \
+  do                                                                      \
+  {                                                                       \
+    (pt)->resumeLine = __LINE__;                                          \
+    PT_FALLTHROUGH;                                                       \
+    case __LINE__:                                                        \
+    if (!(condition))                                                     \
+      return RESULT_BUSY;                                                 \
+  } while(0)
+
+/// Returns RESULT_BUSY once, letting the other protothreads run
+#define PT_YIELD(pt)                                                      \
+  do                                                                      \
+  {                                                                       \
+    (pt)->resumeLine = __LINE__;                                          \
+    return RESULT_BUSY;                                                   \
+    PT_FALLTHROUGH;                                                       \
+    case __LINE__:;                                                       \
+  } while(0)
+
+/// Returns RESULT_BUSY until the given clock advanced by the given duration
+#define PT_WAIT_CLOCK(pt, clock, duration)                                \
+  do                                                                      \
+  {                                                                       \
+    (pt)->waitStartTime = (clock)();                                      \
+    PT_WAIT_UNTIL(pt, (clock)() - (pt)->waitStartTime >= (duration));     \
+  } while(0)
+
+/// Returns RESULT_BUSY until the given number of milliseconds have passed
+#define PT_WAIT_MS(pt, durationMs)    PT_WAIT_CLOCK(pt, millis, durationMs)
+
+/// Returns RESULT_BUSY until the given number of microseconds have passed
+#define PT_WAIT_US(pt, durationUs)    PT_WAIT_CLOCK(pt, micros, durationUs)
+
+/// Ends the protothread early, it returns the given result and restarts on the next call
+#define PT_EXIT(pt, result)                                               \
+  do                                                                      \
+  {                                                                       \
+    (pt)->resumeLine = 0;                                                 \
+    return (result);                                                      \
+  } while(0)
+
+#endif // _PROTOTHREAD_H_
@@ -0,0 +1,376 @@
+///
+/// @file PushButton.cpp
+///
+/// @brief PushButton class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "PushButton.h"
+
+namespace CNEGR
+{
+  PushButton * volatile PushButton::_instances[PUSHBUTTON_MAX_INSTANCES] = { nullptr };
+
+  /// @brief Constructor.
+  PushButton::PushButton()
+    :_initDone(false),
+     _pressed(false),
+     _rawPressed(false),
+     _settling(false),
+     _pinChangeInterrupt(false),
+     _edgeTimeMs(0),
+     _pressTimeMs(0),
+     _lostEvents(0)
+  {
+    _name[0] = '\0';
+    _config.name            = nullptr;
+    _config.pin             = 0;
+    _config.polarity        = SignalPolarity::ActiveLow;
+    _config.debounceTimeMs  = 0;
+    _config.longPressTimeMs = 0;
+  }
+
+  /// @brief Destructor.
+  PushButton::~PushButton()
+  {
+    Deinit();
+  }
+
+  /// @brief Initialization function.
+  ///
+  /// @param configuration      The configuration data.
+  ///
+  /// @retval RESULT_OK         The device was successfully configured.
+  /// @retval RESULT_BUSY       The  device was already configured. Deinit() must be called before calling Init() again.
+  /// @retval RESULT_NOT_SUP    The pin doesn't support interrupts.
+  /// @retval RESULT_NO_RESOURCE Too many buttons are in use.
+  /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+  ///
+  Result PushButton::Init(const Config& configuration)
+  {
+    if (IsInitialized())
+    {
+      // Already initialized
+      return RESULT_BUSY;
+    }
+
+    if ((configuration.name == NULL) || (configuration.debounceTimeMs == 0) || (configuration.longPressTimeMs <= configuration.debounceTimeMs))
+    {
+      // Invalid name or timing
+      return RESULT_BAD_PARAM;
+    }
+
+    // Find a free instance slot
+    uint8_t slot = 0;
+    while ((slot < PUSHBUTTON_MAX_INSTANCES) && (_instances[slot] != nullptr))
+      slot++;
+
+    if (slot == PUSHBUTTON_MAX_INSTANCES)
+      return RESULT_NO_RESOURCE;
+
+    // Copy the name
+    strncpy((char *)(&_name[0]), configuration.name, sizeof(_name)-1);
+
+    _config = configuration;
+    _config.name = _name;
+
+    pinMode(_config.pin, (_config.polarity == SignalPolarity::ActiveLow) ? INPUT_PULLUP : INPUT);
+
+    _pressed        = ReadPressed();
+    _rawPressed     = _pressed;
+    _settling       = false;
+    _edgeTimeMs     = millis();
+    _pressTimeMs    = _edgeTimeMs;
+    _lostEvents     = 0;
+    _events.Clear();
+
+    // The button must be fully setup before the interrupt handler sees it
+    _instances[slot] = this;
+
+    Result result = EnableInterrupt();
+    if (result != RESULT_OK)
+    {
+      _instances[slot] = nullptr;
+      _name[0] = '\0';
+      return result;
+    }
+
+    EnableTimer(true);
+
+    // Set the init done flag
+    _initDone = true;
+    return RESULT_OK;
+  }
+
+  /// @brief Get whether the device was initialized
+  ///
+  /// @return boolean true if it is initialized
+  /// and available for use
+  bool PushButton::IsInitialized() const
+  {
+    return _initDone;
+  }
+
+  /// @brief Deinitialization function for the device.
+  ///
+  void PushButton::Deinit()
+  {
+    if (!_initDone)
+      return;
+
+    DisableInterrupt();
+
+    bool lastInstance = true;
+
+    noInterrupts();
+    for (uint8_t i = 0; i < PUSHBUTTON_MAX_INSTANCES; i++)
+    {
+      if (_instances[i] == this)
+        _instances[i] = nullptr;
+      else if (_instances[i] != nullptr)
+        lastInstance = false;
+    }
+    interrupts();
+
+    if (lastInstance)
+      EnableTimer(false);
+
+    // Clear the name
+    _name[0] = '\0';
+
+    // And reset the init done flag
+    _initDone = false;
+  }
+
+  /// @brief Gets the oldest button event
+  ///
+  /// @note This method never blocks and must be called from the main loop
+  ///
+  /// @param event              Contains the event if successful
+  ///
+  /// @retval RESULT_OK         An event was retrieved.
+  /// @retval RESULT_NO_DATA    There are no events.
+  /// @retval RESULT_NOT_READY  The device was not initialized (Init() method wasn't called)
+  ///
+  Result PushButton::GetEvent(Event& event)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    uint8_t data = 0;
+    if (!_events.Pop(data))
+      return RESULT_NO_DATA;
+
+    event = (Event)data;
+
+    return RESULT_OK;
+  }
+
+  /// @brief Gets the number of events lost because the main loop didn't retrieve them in time
+  ///
+  /// @retval The number of lost events
+  ///
+  uint16_t PushButton::GetLostEventCount() const
+  {
+    noInterrupts();
+    uint16_t lostEvents = _lostEvents;
+    interrupts();
+
+    return lostEvents;
+  }
+
+  /// @brief Handles the pin change interrupts for all the buttons
+  ///
+  /// @note Called from the interrupt handlers only
+  ///
+  void PushButton::OnPinChange()
+  {
+    // The pin change interrupts are shared by several pins, let every
+    // button check its own pin
+    for (uint8_t i = 0; i < PUSHBUTTON_MAX_INSTANCES; i++)
+    {
+      PushButton *button = _instances[i];
+      if (button != nullptr)
+        button->HandlePinChange();
+    }
+  }
+
+  /// @brief Samples the buttons whose debounce period expired
+  ///
+  /// @note Called from the timer interrupt handler, or every millisecond by the
+  /// application when PUSHBUTTON_USE_TIMER0_COMPB is 0 or the board isn't an AVR
+  ///
+  void PushButton::OnTimerTick()
+  {
+    for (uint8_t i = 0; i < PUSHBUTTON_MAX_INSTANCES; i++)
+    {
+      PushButton *button = _instances[i];
+      if (button != nullptr)
+        button->HandleTimerTick();
+    }
+  }
+
+  /// @brief Handles a pin change interrupt
+  ///
+  void PushButton::HandlePinChange()
+  {
+    // Ignore the changes of the other pins of the port
+    bool pressed = ReadPressed();
+    if (pressed == _rawPressed)
+      return;
+
+    // Every bounce restarts the debounce period, the level is
+    // only trusted once the timer samples it
+    _rawPressed = pressed;
+    _edgeTimeMs = millis();
+    _settling   = true;
+  }
+
+  /// @brief Handles a timer tick
+  ///
+  void PushButton::HandleTimerTick()
+  {
+    uint32_t now = millis();
+    bool pressed = ReadPressed();
+
+    // A change without interrupt, e.g. two bounces before the handler
+    // ran, restarts the debounce period like an edge
+    if (pressed != _rawPressed)
+    {
+      _rawPressed = pressed;
+      _edgeTimeMs = now;
+      _settling   = true;
+      return;
+    }
+
+    if (!_settling || (now - _edgeTimeMs < _config.debounceTimeMs))
+      return;
+
+    // The pin is stable, a glitch or a tap shorter than the debounce
+    // period ends at the debounced level and is ignored
+    _settling = false;
+    if (pressed == _pressed)
+      return;
+
+    _pressed = pressed;
+
+    if (pressed)
+    {
+      _pressTimeMs = _edgeTimeMs;
+      return;
+    }
+
+    // The event is reported when the button is released
+    Event event = (_edgeTimeMs - _pressTimeMs >= _config.longPressTimeMs) ? Event::LongPress : Event::Press;
+
+    if (!_events.Push((uint8_t)event))
+      _lostEvents++;
+  }
+
+  /// @brief Reads the pin
+  ///
+  /// @return boolean true if the button is pressed
+  ///
+  bool PushButton::ReadPressed() const
+  {
+    int level = digitalRead(_config.pin);
+    return (_config.polarity == SignalPolarity::ActiveLow) ? (level == LOW) : (level == HIGH);
+  }
+
+  /// @brief Enables the pin change interrupt for the button pin
+  ///
+  /// @retval RESULT_OK         The interrupt was enabled.
+  /// @retval RESULT_NOT_SUP    The pin doesn't support interrupts.
+  ///
+  Result PushButton::EnableInterrupt()
+  {
+#if defined(__AVR__)
+    volatile uint8_t *pcicr = digitalPinToPCICR(_config.pin);
+    _pinChangeInterrupt = (pcicr != nullptr) && ((PUSHBUTTON_PCINT_PORTS & bit(digitalPinToPCICRbit(_config.pin))) != 0);
+
+    if (_pinChangeInterrupt)
+    {
+      *digitalPinToPCMSK(_config.pin) |= bit(digitalPinToPCMSKbit(_config.pin));
+      *pcicr |= bit(digitalPinToPCICRbit(_config.pin));
+      return RESULT_OK;
+    }
+#endif
+
+    // The port vector belongs to another library, or there is none
+    int interrupt = digitalPinToInterrupt(_config.pin);
+    if (interrupt == NOT_AN_INTERRUPT)
+      return RESULT_NOT_SUP;
+
+    attachInterrupt(interrupt, OnPinChange, CHANGE);
+
+    return RESULT_OK;
+  }
+
+  /// @brief Disables the pin change interrupt for the button pin
+  ///
+  void PushButton::DisableInterrupt()
+  {
+#if defined(__AVR__)
+    if (_pinChangeInterrupt)
+    {
+      // The port interrupt is left enabled, other pins may still use it
+      *digitalPinToPCMSK(_config.pin) &= ~bit(digitalPinToPCMSKbit(_config.pin));
+      return;
+    }
+#endif
+
+    detachInterrupt(digitalPinToInterrupt(_config.pin));
+  }
+
+  /// @brief Enables or disables the debounce timer tick
+  ///
+  /// @param enabled            true to enable the tick
+  ///
+  void PushButton::EnableTimer(bool enabled)
+  {
+#if defined(__AVR__) && PUSHBUTTON_USE_TIMER0_COMPB
+    // Timer0 keeps running for millis(), only its compare B interrupt is used
+    if (enabled)
+      TIMSK0 |= bit(OCIE0B);
+    else
+      TIMSK0 &= ~bit(OCIE0B);
+#else
+    // The application calls OnTimerTick()
+    (void)enabled;
+#endif
+  }
+}
+
+#if defined(__AVR__)
+// The interrupt handlers must be defined outside of the namespace, only
+// the vectors left to PushButton by PUSHBUTTON_PCINT_PORTS are defined
+#if (PUSHBUTTON_PCINT_PORTS & 0x01) && defined(PCINT0_vect)
+ISR(PCINT0_vect)
+{
+  CNEGR::PushButton::OnPinChange();
+}
+#endif
+
+#if (PUSHBUTTON_PCINT_PORTS & 0x02) && defined(PCINT1_vect)
+ISR(PCINT1_vect)
+{
+  CNEGR::PushButton::OnPinChange();
+}
+#endif
+
+#if (PUSHBUTTON_PCINT_PORTS & 0x04) && defined(PCINT2_vect)
+ISR(PCINT2_vect)
+{
+  CNEGR::PushButton::OnPinChange();
+}
+#endif
+
+#if PUSHBUTTON_USE_TIMER0_COMPB
+ISR(TIMER0_COMPB_vect)
+{
+  CNEGR::PushButton::OnTimerTick();
+}
+#endif
+#endif
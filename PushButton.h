@@ -0,0 +1,170 @@
+///
+/// @file PushButton.h
+///
+/// @brief PushButton class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_PUSHBUTTON_H_)
+#define _PUSHBUTTON_H_
+
+#include "IButton.h"
+#include "CommonDefines.h"
+#include "SpscQueue.h"
+
+namespace CNEGR
+{
+  #define PUSHBUTTON_MAX_INSTANCES    2     ///< The maximum number of buttons initialized at the same time
+  #define PUSHBUTTON_QUEUE_SIZE       8     ///< The number of events buffered, must be a power of two
+
+  /// The pin change interrupt vectors defined by PushButton on AVR, one bit per port:
+  /// bit 0 for PCINT0_vect (pins 8 to 13 on the Uno), bit 1 for PCINT1_vect (A0 to A5)
+  /// and bit 2 for PCINT2_vect (0 to 7). Another library using a vector, e.g.
+  /// SoftwareSerial, needs its bit cleared. A button on a port without its vector falls
+  /// back to attachInterrupt(), only pins 2 and 3 support it on the Uno.
+  #if !defined(PUSHBUTTON_PCINT_PORTS)
+  #define PUSHBUTTON_PCINT_PORTS      0x01
+  #endif
+
+  /// If 1 the debounce timer runs from the Timer0 compare B interrupt on AVR, which ticks
+  /// every 1.024 ms next to millis() without changing Timer0. If 0, or on another
+  /// architecture, the application must call PushButton::OnTimerTick() every millisecond.
+  #if !defined(PUSHBUTTON_USE_TIMER0_COMPB)
+  #define PUSHBUTTON_USE_TIMER0_COMPB 1
+  #endif
+
+  /// @brief PushButton class definition
+  ///
+  /// A push button read with pin change interrupts and debounced by a timer. Every edge
+  /// of the pin restarts the debounce period, and the timer tick samples the pin once the
+  /// period expired without another edge. The sampled level is accepted only if it
+  /// differs from the debounced state, so a glitch or a tap shorter than the debounce
+  /// period is ignored instead of leaving the button pressed. The timer tick also
+  /// notices a level change whose edge interrupt was missed.
+  ///
+  /// The press duration is measured between the last edges of the press and of the
+  /// release, and the events are handed to the main loop through a SpscQueue. The main
+  /// loop retrieves them with GetEvent().
+  ///
+  /// @note The state of the buttons is only changed by the interrupt handlers, which
+  /// don't interrupt each other on AVR.
+  ///
+  class PushButton: public IButton
+  {
+  public:
+    /// @brief Constructor.
+    PushButton();
+
+    /// @brief Destructor.
+    virtual ~PushButton();
+
+  public:
+    /// @brief Initialization function.
+    ///
+    /// @param configuration      The configuration data.
+    ///
+    /// @retval RESULT_OK         The device was successfully configured.
+    /// @retval RESULT_BUSY       The  device was already configured. Deinit() must be called before calling Init() again.
+    /// @retval RESULT_NOT_SUP    The pin doesn't support interrupts.
+    /// @retval RESULT_NO_RESOURCE Too many buttons are in use.
+    /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+    ///
+    virtual Result Init(const Config& configuration);
+
+    /// @brief Get whether the device was initialized
+    ///
+    /// @return boolean true if it is initialized
+    /// and available for use
+    virtual bool IsInitialized() const;
+
+    /// @brief Deinitialization function for the device.
+    ///
+    virtual void Deinit();
+
+    /// @brief Gets the oldest button event
+    ///
+    /// @note This method never blocks and must be called from the main loop
+    ///
+    /// @param event              Contains the event if successful
+    ///
+    /// @retval RESULT_OK         An event was retrieved.
+    /// @retval RESULT_NO_DATA    There are no events.
+    /// @retval RESULT_NOT_READY  The device was not initialized (Init() method wasn't called)
+    ///
+    virtual Result GetEvent(Event& event);
+
+    /// @brief Gets the number of events lost because the main loop didn't retrieve them in time
+    ///
+    /// @retval The number of lost events
+    ///
+    virtual uint16_t GetLostEventCount() const;
+
+  public:
+    /// @brief Handles the pin change interrupts for all the buttons
+    ///
+    /// @note Called from the interrupt handlers only
+    ///
+    static void OnPinChange();
+
+    /// @brief Samples the buttons whose debounce period expired
+    ///
+    /// @note Called from the timer interrupt handler, or every millisecond by the
+    /// application when PUSHBUTTON_USE_TIMER0_COMPB is 0 or the board isn't an AVR
+    ///
+    static void OnTimerTick();
+
+  private:
+    /// @brief Handles a pin change interrupt
+    ///
+    void HandlePinChange();
+
+    /// @brief Handles a timer tick
+    ///
+    void HandleTimerTick();
+
+    /// @brief Reads the pin
+    ///
+    /// @return boolean true if the button is pressed
+    ///
+    bool ReadPressed() const;
+
+    /// @brief Enables the pin change interrupt for the button pin
+    ///
+    /// @retval RESULT_OK         The interrupt was enabled.
+    /// @retval RESULT_NOT_SUP    The pin doesn't support interrupts.
+    ///
+    Result EnableInterrupt();
+
+    /// @brief Disables the pin change interrupt for the button pin
+    ///
+    void DisableInterrupt();
+
+    /// @brief Enables or disables the debounce timer tick
+    ///
+    /// @param enabled            true to enable the tick
+    ///
+    static void EnableTimer(bool enabled);
+
+  private:
+    static PushButton * volatile _instances[PUSHBUTTON_MAX_INSTANCES];  ///< The initialized buttons
+
+  private:
+    bool              _initDone;                          ///< A flag to indicate whether the button was initialized
+    char              _name[MAX_COMPONENT_NAME_LENGTH];   ///< A symbolic name for this button
+    Config            _config;                            ///< The button configuration
+    bool              _pressed;                           ///< The debounced button state
+    bool              _rawPressed;                        ///< The pin state seen by the last interrupt
+    bool              _settling;                          ///< A flag to indicate that the pin changed and must be sampled
+                                                          ///< once it is stable for the debounce time
+    bool              _pinChangeInterrupt;                ///< A flag to indicate that the pin uses a pin change interrupt
+    uint32_t          _edgeTimeMs;                        ///< The time of the last edge of the pin
+    uint32_t          _pressTimeMs;                       ///< The time when the button was pressed
+    SpscQueue<uint8_t, PUSHBUTTON_QUEUE_SIZE> _events;    ///< The events queue, filled by the interrupt handler
+    volatile uint16_t _lostEvents;                        ///< The number of events lost because the queue was full
+  };
+}
+
+#endif // _PUSHBUTTON_H_
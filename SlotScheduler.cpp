@@ -0,0 +1,193 @@
+///
+/// @file SlotScheduler.cpp
+///
+/// @brief SlotScheduler class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "SlotScheduler.h"
+#include "DebugUtils.h"
+
+namespace CNEGR
+{
+  /// @brief Constructor.
+  SlotScheduler::SlotScheduler()
+    :_initDone(false),
+     _frameTimeMs(0),
+     _frameStartMs(0),
+     _lastSyncMs(0),
+     _sending(false)
+  {
+    memset(&_config, 0, sizeof(_config));
+    memset(&_statistics, 0, sizeof(_statistics));
+  }
+
+  /// @brief Destructor.
+  SlotScheduler::~SlotScheduler()
+  {
+    Deinit();
+  }
+
+  /// @brief Initialization function.
+  ///
+  /// @param configuration      The configuration data.
+  ///
+  /// @retval RESULT_OK         The scheduler was successfully initialized.
+  /// @retval RESULT_BUSY       The scheduler was already initialized.
+  ///                           Deinit() must be called before calling Init() again.
+  /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+  ///
+  Result SlotScheduler::Init(const Config& configuration)
+  {
+    if (IsInitialized())
+      return RESULT_BUSY;
+
+    if ((configuration.slotCount == 0) || (configuration.slot >= configuration.slotCount) ||
+        (configuration.pingWindowMs == 0) || (configuration.pingWindowMs > configuration.slotTimeMs) ||
+        (configuration.syncTimeoutFrames == 0))
+    {
+      return RESULT_BAD_PARAM;
+    }
+
+    _config       = configuration;
+    _frameTimeMs  = (uint32_t)configuration.slotCount * configuration.slotTimeMs;
+    _sending      = false;
+    memset(&_statistics, 0, sizeof(_statistics));
+
+    // Free running on the local clock until the first pulse
+    _frameStartMs = GetTime();
+    _lastSyncMs   = _frameStartMs;
+
+    _initDone = true;
+    return RESULT_OK;
+  }
+
+  /// @brief Get whether the scheduler was initialized
+  ///
+  /// @return boolean true if it is initialized
+  ///
+  bool SlotScheduler::IsInitialized() const
+  {
+    return _initDone;
+  }
+
+  /// @brief Deinitialization function.
+  ///
+  void SlotScheduler::Deinit()
+  {
+    _initDone = false;
+  }
+
+  /// @brief Reports a sync pulse sent by another board
+  ///
+  /// @param timeMs             The time when the pulse was received, same clock as the scheduler
+  ///
+  void SlotScheduler::OnSync(uint32_t timeMs)
+  {
+    if (!IsInitialized())
+      return;
+
+    if (_sending)
+    {
+      // Another board took over, the boards stop sending and the one
+      // with the lowest slot will resume sending first
+      Logger::Warning(F("Sync pulse received while sending, slot %u stops sending"), _config.slot);
+      _sending = false;
+    }
+
+    _frameStartMs = timeMs;
+    _lastSyncMs   = timeMs;
+    _statistics.syncsReceived++;
+  }
+
+  /// @brief Advances the frames, must be called from the main loop
+  ///
+  /// @return boolean true if this board must send the sync pulse now
+  ///
+  bool SlotScheduler::Update()
+  {
+    if (!IsInitialized())
+      return false;
+
+    uint32_t now = GetTime();
+
+    if (!_sending)
+    {
+      // The slots take over one frame after the other
+      uint32_t timeoutMs = ((uint32_t)_config.syncTimeoutFrames + _config.slot) * _frameTimeMs;
+      if (now - _lastSyncMs < timeoutMs)
+        return false;
+
+      Logger::Warning(F("No sync pulse for %lu ms, slot %u starts sending"), now - _lastSyncMs, _config.slot);
+      _sending = true;
+      _statistics.takeovers++;
+    }
+
+    // Keep the phase of the last frame, the other boards are still following it
+    if (now - _frameStartMs < _frameTimeMs)
+      return false;
+
+    _frameStartMs += (now - _frameStartMs) / _frameTimeMs * _frameTimeMs;
+    _lastSyncMs    = _frameStartMs;
+    _statistics.syncsSent++;
+
+    return true;
+  }
+
+  /// @brief Get whether this board sends the sync pulses
+  ///
+  /// @return boolean true if this board sends the pulses
+  ///
+  bool SlotScheduler::IsSending() const
+  {
+    return _sending;
+  }
+
+  /// @brief Get whether the ping window of the slot of this board is open
+  ///
+  /// @param slotStartMs        Contains the start time of the slot if the window is open
+  ///
+  /// @return boolean true if a ping can start now
+  ///
+  bool SlotScheduler::IsPingWindowOpen(uint32_t& slotStartMs) const
+  {
+    if (!IsInitialized())
+      return false;
+
+    // The frames following the last pulse are extrapolated with the local clock
+    uint32_t now        = GetTime();
+    uint32_t position   = (now - _frameStartMs) % _frameTimeMs;
+    uint32_t slotOffset = (uint32_t)_config.slot * _config.slotTimeMs;
+
+    if ((position < slotOffset) || (position - slotOffset >= _config.pingWindowMs))
+      return false;
+
+    slotStartMs = now - (position - slotOffset);
+    return true;
+  }
+
+  /// @brief Gets the frame duration
+  ///
+  /// @retval The frame duration in milliseconds
+  ///
+  uint32_t SlotScheduler::GetFrameTime() const
+  {
+    return _frameTimeMs;
+  }
+
+  /// @brief Gets the counters collected since Init()
+  ///
+  /// @param statistics         Contains the counters
+  ///
+  void SlotScheduler::GetStatistics(Statistics& statistics) const
+  {
+    statistics = _statistics;
+  }
+
+  uint32_t SlotScheduler::GetTime() const
+  {
+    return (_config.clock != nullptr) ? _config.clock() : millis();
+  }
+}
@@ -0,0 +1,141 @@
+///
+/// @file SlotScheduler.h
+///
+/// @brief SlotScheduler class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_SLOTSCHEDULER_H_)
+#define _SLOTSCHEDULER_H_
+
+#include <Arduino.h>
+#include "CommonDefines.h"
+#include "Result.h"
+
+namespace CNEGR
+{
+  /// @brief SlotScheduler class definition
+  ///
+  /// Shares the air between the boards of neighbouring bays with time slots (TDMA). The
+  /// time is divided in repeating frames of slotCount slots, every board owns one slot
+  /// and only pings at the beginning of it, so the echo has died out before the next
+  /// board pings. A sync pulse on a wire shared by all the boards marks the start of
+  /// every frame.
+  ///
+  /// Any board can send the sync pulse. The board owning slot 0 sends it once it hasn't
+  /// received any for syncTimeoutFrames frames, the board owning slot n waits n more
+  /// frames, so when the sending board disappears the next one takes over without two
+  /// boards sending at the same time. A board that receives a pulse stops sending. Until
+  /// then, and after a boot, every board keeps the frame timing of the last pulse with
+  /// its own clock.
+  ///
+  /// The scheduler doesn't access the wire: the application reports the pulses received
+  /// with OnSync() and sends a pulse when Update() returns true.
+  ///
+  class SlotScheduler
+  {
+  public:
+    struct Config
+    {
+      uint8_t   slotCount;                    ///< The number of slots in a frame
+      uint8_t   slot;                         ///< The slot owned by this board, 0 to slotCount - 1
+      uint32_t  slotTimeMs;                   ///< The slot duration in milliseconds
+      uint32_t  pingWindowMs;                 ///< The time after the start of the slot during which a ping can start, must
+                                              ///< leave enough time for the longest echo to die out before the next slot
+      uint8_t   syncTimeoutFrames;            ///< The number of frames without pulse after which the board owning slot 0 sends them
+      ClockProc clock;                        ///< The clock, nullptr for millis()
+    };
+
+    /// @brief The counters since Init()
+    ///
+    struct Statistics
+    {
+      uint32_t  syncsSent;                    ///< The number of pulses sent
+      uint32_t  syncsReceived;                ///< The number of pulses received
+      uint32_t  takeovers;                    ///< The number of times this board started sending the pulses
+    };
+
+  public:
+    /// @brief Constructor.
+    SlotScheduler();
+
+    /// @brief Destructor.
+    ~SlotScheduler();
+
+  public:
+    /// @brief Initialization function.
+    ///
+    /// @param configuration      The configuration data.
+    ///
+    /// @retval RESULT_OK         The scheduler was successfully initialized.
+    /// @retval RESULT_BUSY       The scheduler was already initialized.
+    ///                           Deinit() must be called before calling Init() again.
+    /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+    ///
+    Result Init(const Config& configuration);
+
+    /// @brief Get whether the scheduler was initialized
+    ///
+    /// @return boolean true if it is initialized
+    ///
+    bool IsInitialized() const;
+
+    /// @brief Deinitialization function.
+    ///
+    void Deinit();
+
+    /// @brief Reports a sync pulse sent by another board
+    ///
+    /// @param timeMs             The time when the pulse was received, same clock as the scheduler
+    ///
+    void OnSync(uint32_t timeMs);
+
+    /// @brief Advances the frames, must be called from the main loop
+    ///
+    /// @return boolean true if this board must send the sync pulse now
+    ///
+    bool Update();
+
+    /// @brief Get whether this board sends the sync pulses
+    ///
+    /// @return boolean true if this board sends the pulses
+    ///
+    bool IsSending() const;
+
+    /// @brief Get whether the ping window of the slot of this board is open
+    ///
+    /// @param slotStartMs        Contains the start time of the slot if the window is open
+    ///
+    /// @return boolean true if a ping can start now
+    ///
+    bool IsPingWindowOpen(uint32_t& slotStartMs) const;
+
+    /// @brief Gets the frame duration
+    ///
+    /// @retval The frame duration in milliseconds
+    ///
+    uint32_t GetFrameTime() const;
+
+    /// @brief Gets the counters collected since Init()
+    ///
+    /// @param statistics         Contains the counters
+    ///
+    void GetStatistics(Statistics& statistics) const;
+
+  private:
+    uint32_t GetTime() const;
+
+  private:
+    bool        _initDone;                    ///< A flag to indicate whether the scheduler was initialized
+    Config      _config;                      ///< The configuration
+    uint32_t    _frameTimeMs;                 ///< The frame duration in milliseconds
+    uint32_t    _frameStartMs;                ///< The start time of a frame, the following ones are extrapolated
+    uint32_t    _lastSyncMs;                  ///< The time of the last pulse sent or received
+    bool        _sending;                     ///< A flag to indicate whether this board sends the pulses
+    Statistics  _statistics;                  ///< The counters since Init()
+  };
+}
+#endif // _SLOTSCHEDULER_H_
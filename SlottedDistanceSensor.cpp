@@ -0,0 +1,231 @@
+///
+/// @file SlottedDistanceSensor.cpp
+///
+/// @brief SlottedDistanceSensor class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "SlottedDistanceSensor.h"
+#include "SpeedOfSound.h"
+
+namespace CNEGR
+{
+  /// @brief Constructor.
+  SlottedDistanceSensor::SlottedDistanceSensor(IDistanceSensor  *sensor,                  ///< The sensor pinging in the slot
+                                               SlotScheduler    *scheduler                ///< The scheduler of the slots, must be initialized
+                                              )
+    :_initDone(false),
+     _sensor(sensor),
+     _scheduler(scheduler),
+     _pinged(false),
+     _lastSlotStartMs(0)
+  {
+    _name[0] = '\0';
+    PT_INIT(&_measurement);
+  }
+
+  /// @brief Destructor.
+  SlottedDistanceSensor::~SlottedDistanceSensor()
+  {
+    Deinit();
+  }
+
+  /// @brief Initialization function.
+  ///
+  /// @note The sensor and the scheduler must be initialized before calling this method
+  ///
+  /// @param configuration      The configuration data. Only the name is used.
+  ///
+  /// @retval RESULT_OK         The device was successfully configured.
+  /// @retval RESULT_BUSY       The  device was already configured.
+  ///                           Deinit() must be called before calling Init() again.
+  /// @retval RESULT_DEV_ERR    The sensor or the scheduler is not initialized.
+  /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+  ///
+  Result SlottedDistanceSensor::Init(const Config& configuration)
+  {
+    if (IsInitialized())
+    {
+      // Already initialized
+      return RESULT_BUSY;
+    }
+
+    if ((configuration.name == NULL) || (_sensor == nullptr) || (_scheduler == nullptr))
+    {
+      // Invalid name, sensor or scheduler
+      return RESULT_BAD_PARAM;
+    }
+
+    if (!_sensor->IsInitialized() || !_scheduler->IsInitialized())
+    {
+      return RESULT_DEV_ERR;
+    }
+
+    // Copy the name
+    strncpy((char *)(&_name[0]), configuration.name, sizeof(_name)-1);
+
+    _pinged = false;
+    PT_INIT(&_measurement);
+
+    // Set the init done flag
+    _initDone = true;
+    return RESULT_OK;
+  }
+
+  /// @brief Get whether the sensor device was initialized
+  ///
+  /// @return boolean true if it is initialized
+  /// and available for use
+  bool SlottedDistanceSensor::IsInitialized() const
+  {
+    return _initDone;
+  }
+
+  /// @brief Deinitialization function for the device.
+  ///
+  /// @note The sensor and the scheduler are not deinitialized
+  ///
+  void SlottedDistanceSensor::Deinit()
+  {
+    // Clear the name
+    _name[0] = '\0';
+
+    // And reset the init done flag
+    _initDone = false;
+  }
+
+  /// @brief Measures the distance.
+  ///
+  /// @note Waits for the slot of this board.
+  ///
+  /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+  ///                           of error state.
+  Result SlottedDistanceSensor::MeasureDistance(uint32_t& distance)
+  {
+    const uint32_t ambientTemperature = 20 * 10;
+    return MeasureDistance(ambientTemperature, distance);
+  }
+
+  /// @brief Measures the distance and adjusts the result for the ambient temperature.
+  ///
+  /// @note Waits for the slot of this board.
+  ///
+  /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+  /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+  ///                           of error state.
+  Result SlottedDistanceSensor::MeasureDistance(uint32_t ambientTemperature, uint32_t& distance)
+  {
+    return MeasureDistance(ambientTemperature, DEFAULT_RELATIVE_HUMIDITY, distance);
+  }
+
+  /// @brief Measures the distance and adjusts the result for the ambient temperature and relative humidity.
+  ///
+  /// @note Waits for the slot of this board. Temperatures below zero are passed as the
+  /// two's complement of the value.
+  ///
+  /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+  /// @param relativeHumidity   The relative humidity in percent
+  /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+  ///                           of error state.
+  Result SlottedDistanceSensor::MeasureDistance(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    // The frames only advance with the scheduler's clock, the
+    // application keeps updating the scheduler from its main loop
+    while (!IsSlotAvailable())
+      ;
+
+    return _sensor->MeasureDistance(ambientTemperature, relativeHumidity, distance);
+  }
+
+  /// @brief Measures the distance without blocking.
+  ///
+  /// @note The first call starts waiting for the slot and the method must then be called
+  /// repeatedly until it returns something else than RESULT_BUSY. The temperature
+  /// and humidity passed to the first call are used for the whole measurement.
+  ///
+  /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+  /// @param relativeHumidity   The relative humidity in percent
+  /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_BUSY       The measurement is in progress.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+  /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+  ///                           of error state.
+  Result SlottedDistanceSensor::MeasureDistanceAsync(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    Result result = RESULT_BUSY;
+
+    PT_BEGIN(&_measurement);
+
+    PT_WAIT_UNTIL(&_measurement, IsSlotAvailable());
+
+    PT_WAIT_UNTIL(&_measurement, (result = _sensor->MeasureDistanceAsync(ambientTemperature, relativeHumidity, distance)) != RESULT_BUSY);
+
+    PT_EXIT(&_measurement, result);
+
+    PT_END(&_measurement);
+  }
+
+  /// @brief Limits the range of the measurements
+  ///
+  /// @note The limit is applied to the sensor pinging in the slot.
+  ///
+  /// @param rangeLimitMm       The range limit in millimeters, 0 to use the full range
+  ///
+  /// @retval RESULT_OK         The range limit was changed.
+  /// @retval RESULT_NOT_READY  The sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_BAD_PARAM  The range limit is below the minimum distance the sensor can detect.
+  ///
+  Result SlottedDistanceSensor::SetRangeLimit(uint32_t rangeLimitMm)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    return _sensor->SetRangeLimit(rangeLimitMm);
+  }
+
+  /// @brief Get whether the ping can start now
+  ///
+  /// @return boolean true if the ping window of a new slot is open
+  ///
+  bool SlottedDistanceSensor::IsSlotAvailable()
+  {
+    uint32_t slotStartMs = 0;
+    if (!_scheduler->IsPingWindowOpen(slotStartMs))
+      return false;
+
+    // A pulse received during the window moves the slot start by the clock drift,
+    // the same slot is recognized by a start within half a frame of the last one
+    if (_pinged && ((int32_t)(slotStartMs - _lastSlotStartMs) < (int32_t)(_scheduler->GetFrameTime() / 2)))
+      return false;
+
+    _pinged          = true;
+    _lastSlotStartMs = slotStartMs;
+    return true;
+  }
+}
@@ -0,0 +1,159 @@
+///
+/// @file SlottedDistanceSensor.h
+///
+/// @brief SlottedDistanceSensor class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_SLOTTEDDISTANCESENSOR_H_)
+#define _SLOTTEDDISTANCESENSOR_H_
+
+#include "IDistanceSensor.h"
+#include "CommonDefines.h"
+#include "Protothread.h"
+#include "SlotScheduler.h"
+
+namespace CNEGR
+{
+  /// @brief SlottedDistanceSensor class definition
+  ///
+  /// Aligns the pings of another sensor to the slot of this board in the frames of a
+  /// SlotScheduler. A measurement waits for the ping window of the slot and pings at
+  /// most once per slot, so it can wait up to one frame before the ping starts.
+  ///
+  class SlottedDistanceSensor: public IDistanceSensor
+  {
+  public:
+    /// @brief Constructor.
+    SlottedDistanceSensor(IDistanceSensor  *sensor,                  ///< The sensor pinging in the slot
+                          SlotScheduler    *scheduler                ///< The scheduler of the slots, must be initialized
+                         );
+
+    /// @brief Destructor.
+    virtual ~SlottedDistanceSensor();
+
+  public:
+    /// @brief Initialization function.
+    ///
+    /// @note The sensor and the scheduler must be initialized before calling this method
+    ///
+    /// @param configuration      The configuration data. Only the name is used.
+    ///
+    /// @retval RESULT_OK         The device was successfully configured.
+    /// @retval RESULT_BUSY       The  device was already configured.
+    ///                           Deinit() must be called before calling Init() again.
+    /// @retval RESULT_DEV_ERR    The sensor or the scheduler is not initialized.
+    /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+    ///
+    virtual Result Init(const Config& configuration);
+
+    /// @brief Get whether the sensor device was initialized
+    ///
+    /// @return boolean true if it is initialized
+    /// and available for use
+    virtual bool IsInitialized() const;
+
+    /// @brief Deinitialization function for the device.
+    ///
+    /// @note The sensor and the scheduler are not deinitialized
+    ///
+    virtual void Deinit();
+
+    /// @brief Measures the distance.
+    ///
+    /// @note Waits for the slot of this board.
+    ///
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+    ///                           of error state.
+    virtual Result MeasureDistance(uint32_t& distance);
+
+    /// @brief Measures the distance and adjusts the result for the ambient temperature.
+    ///
+    /// @note Waits for the slot of this board.
+    ///
+    /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+    ///                           of error state.
+    virtual Result MeasureDistance(uint32_t ambientTemperature, uint32_t& distance);
+
+    /// @brief Measures the distance and adjusts the result for the ambient temperature and relative humidity.
+    ///
+    /// @note Waits for the slot of this board. Temperatures below zero are passed as the
+    /// two's complement of the value.
+    ///
+    /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+    /// @param relativeHumidity   The relative humidity in percent
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+    ///                           of error state.
+    virtual Result MeasureDistance(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance);
+
+    /// @brief Measures the distance without blocking.
+    ///
+    /// @note The first call starts waiting for the slot and the method must then be called
+    /// repeatedly until it returns something else than RESULT_BUSY. The temperature
+    /// and humidity passed to the first call are used for the whole measurement.
+    ///
+    /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+    /// @param relativeHumidity   The relative humidity in percent
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_BUSY       The measurement is in progress.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_TIMEOUT    The distance measurement failed because there was a timeout while waiting for the echo signal.
+    /// @retval RESULT_DEV_ERR    The device is not present or is in some kind
+    ///                           of error state.
+    virtual Result MeasureDistanceAsync(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance);
+
+    /// @brief Limits the range of the measurements
+    ///
+    /// @note The limit is applied to the sensor pinging in the slot.
+    ///
+    /// @param rangeLimitMm       The range limit in millimeters, 0 to use the full range
+    ///
+    /// @retval RESULT_OK         The range limit was changed.
+    /// @retval RESULT_NOT_READY  The sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_BAD_PARAM  The range limit is below the minimum distance the sensor can detect.
+    ///
+    virtual Result SetRangeLimit(uint32_t rangeLimitMm);
+
+  private:
+    /// @brief Get whether the ping can start now
+    ///
+    /// @return boolean true if the ping window of a new slot is open
+    ///
+    bool IsSlotAvailable();
+
+  private:
+    /// @brief Default Constructor.
+    SlottedDistanceSensor();
+
+  private:
+    bool            _initDone;                        ///< A flag to indicate whether the sensor was initialized
+    char            _name[MAX_COMPONENT_NAME_LENGTH]; ///< A symbolic name for this sensor
+    IDistanceSensor *_sensor;                         ///< The sensor pinging in the slot
+    SlotScheduler   *_scheduler;                      ///< The scheduler of the slots
+    Protothread     _measurement;                     ///< The asynchronous measurement state
+    bool            _pinged;                          ///< A flag to indicate whether a slot was used since Init()
+    uint32_t        _lastSlotStartMs;                 ///< The start time of the last slot used
+  };
+}
+#endif // _SLOTTEDDISTANCESENSOR_H_
@@ -0,0 +1,118 @@
+///
+/// @file SpeedOfSound.cpp
+///
+/// @brief Speed of sound model implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include <Arduino.h>
+#include "SpeedOfSound.h"
+
+namespace CNEGR
+{
+  const int32_t  temperatureStep  = 50;     ///< The table temperature step in deci-degrees celsius
+  const uint32_t humidityStep     = 25;     ///< The table relative humidity step in percent
+  const uint8_t  temperatureCount = 15;     ///< The number of table rows
+  const uint8_t  humidityCount    = 5;      ///< The number of table columns
+
+  /// The speed of sound in centimeters per second, indexed by temperature and relative humidity
+  static const uint16_t SPEED_OF_SOUND_TABLE[temperatureCount][humidityCount] PROGMEM =
+  {
+    //   0%     25%    50%    75%    100%
+    { 31909, 31910, 31912, 31913, 31915 },  // -20 C
+    { 32222, 32224, 32227, 32229, 32231 },  // -15 C
+    { 32532, 32536, 32540, 32543, 32547 },  // -10 C
+    { 32840, 32845, 32851, 32856, 32861 },  //  -5 C
+    { 33145, 33153, 33160, 33168, 33176 },  //   0 C
+    { 33447, 33458, 33469, 33481, 33492 },  //   5 C
+    { 33746, 33762, 33778, 33794, 33810 },  //  10 C
+    { 34042, 34065, 34088, 34110, 34133 },  //  15 C
+    { 34336, 34367, 34399, 34430, 34461 },  //  20 C
+    { 34627, 34670, 34713, 34756, 34798 },  //  25 C
+    { 34915, 34973, 35031, 35089, 35147 },  //  30 C
+    { 35200, 35278, 35355, 35433, 35510 },  //  35 C
+    { 35483, 35585, 35688, 35790, 35892 },  //  40 C
+    { 35762, 35897, 36031, 36165, 36298 },  //  45 C
+    { 36039, 36213, 36387, 36560, 36733 },  //  50 C
+  };
+
+  /// @brief Gets the speed of sound in air
+  ///
+  /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+  /// @param relativeHumidity   The relative humidity in percent
+  ///
+  /// @retval The speed of sound in centimeters per second
+  ///
+  uint16_t GetSpeedOfSound(int32_t ambientTemperature, uint32_t relativeHumidity)
+  {
+    if (ambientTemperature < SPEED_OF_SOUND_MIN_TEMPERATURE)
+      ambientTemperature = SPEED_OF_SOUND_MIN_TEMPERATURE;
+    else if (ambientTemperature > SPEED_OF_SOUND_MAX_TEMPERATURE)
+      ambientTemperature = SPEED_OF_SOUND_MAX_TEMPERATURE;
+
+    if (relativeHumidity > 100)
+      relativeHumidity = 100;
+
+    // Find the table cell and the position within it
+    uint32_t temperatureOffset = (uint32_t)(ambientTemperature - SPEED_OF_SOUND_MIN_TEMPERATURE);
+    uint8_t  row               = temperatureOffset / temperatureStep;
+    uint32_t rowFraction       = temperatureOffset % temperatureStep;
+    uint8_t  column            = relativeHumidity / humidityStep;
+    uint32_t columnFraction    = relativeHumidity % humidityStep;
+
+    // The upper edges are interpolated from the last cell
+    if (row >= temperatureCount - 1)
+    {
+      row = temperatureCount - 2;
+      rowFraction = temperatureStep;
+    }
+
+    if (column >= humidityCount - 1)
+    {
+      column = humidityCount - 2;
+      columnFraction = humidityStep;
+    }
+
+    uint32_t a = pgm_read_word(&SPEED_OF_SOUND_TABLE[row][column]);
+    uint32_t b = pgm_read_word(&SPEED_OF_SOUND_TABLE[row][column + 1]);
+    uint32_t c = pgm_read_word(&SPEED_OF_SOUND_TABLE[row + 1][column]);
+    uint32_t d = pgm_read_word(&SPEED_OF_SOUND_TABLE[row + 1][column + 1]);
+
+    // Interpolate along the humidity axis and then along the temperature axis
+    uint32_t low  = a * (humidityStep - columnFraction) + b * columnFraction;
+    uint32_t high = c * (humidityStep - columnFraction) + d * columnFraction;
+    uint32_t scale = humidityStep * temperatureStep;
+
+    return (uint16_t)((low * (temperatureStep - rowFraction) + high * rowFraction + scale / 2) / scale);
+  }
+
+  /// @brief Converts the round trip time of an echo to the distance of the reflecting object
+  ///
+  /// @param speedOfSound The speed of sound in centimeters per second
+  /// @param timeUs       The round trip time in microseconds
+  ///
+  /// @retval The distance in millimeters
+  ///
+  uint32_t EchoTimeToDistance(uint16_t speedOfSound, uint32_t timeUs)
+  {
+    // distance[mm] = time[us] / 1000000 * speed[cm/s] * 10 / 2
+    // The product doesn't overflow for echoes shorter than ~115 ms
+    return (timeUs * speedOfSound + 100000UL) / 200000UL;
+  }
+
+  /// @brief Converts the distance of a reflecting object to the round trip time of its echo
+  ///
+  /// @param speedOfSound The speed of sound in centimeters per second
+  /// @param distanceMm   The distance in millimeters
+  ///
+  /// @retval The round trip time in microseconds
+  ///
+  uint32_t DistanceToEchoTime(uint16_t speedOfSound, uint32_t distanceMm)
+  {
+    // time[us] = distance[mm] * 2 / (speed[cm/s] * 10) * 1000000
+    // The product doesn't overflow for distances shorter than ~21 m
+    return (distanceMm * 200000UL + speedOfSound / 2) / speedOfSound;
+  }
+}
@@ -0,0 +1,55 @@
+///
+/// @file SpeedOfSound.h
+///
+/// @brief Speed of sound model definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_SPEEDOFSOUND_H_)
+#define _SPEEDOFSOUND_H_
+
+#include <stdint.h>
+
+namespace CNEGR
+{
+  #define SPEED_OF_SOUND_MIN_TEMPERATURE    (-200)    ///< The lowest tabulated temperature in deci-degrees celsius
+  #define SPEED_OF_SOUND_MAX_TEMPERATURE    500       ///< The highest tabulated temperature in deci-degrees celsius
+  #define DEFAULT_RELATIVE_HUMIDITY         50        ///< The relative humidity assumed when there is no humidity sensor
+
+  /// @brief Gets the speed of sound in air
+  ///
+  /// The speed of sound is looked up in a table stored in the program space (flash memory)
+  /// and bilinearly interpolated. The table was generated with the Cramer (1993) model for
+  /// air at sea level pressure and 400 ppm CO2, every 5 degrees celsius from -20 to 50 degrees
+  /// celsius and every 25% relative humidity. The interpolation error is below 0.04 m/s.
+  /// Values outside the tabulated range are clamped.
+  ///
+  /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+  /// @param relativeHumidity   The relative humidity in percent
+  ///
+  /// @retval The speed of sound in centimeters per second
+  ///
+  uint16_t GetSpeedOfSound(int32_t ambientTemperature, uint32_t relativeHumidity);
+
+  /// @brief Converts the round trip time of an echo to the distance of the reflecting object
+  ///
+  /// @param speedOfSound The speed of sound in centimeters per second
+  /// @param timeUs       The round trip time in microseconds
+  ///
+  /// @retval The distance in millimeters
+  ///
+  uint32_t EchoTimeToDistance(uint16_t speedOfSound, uint32_t timeUs);
+
+  /// @brief Converts the distance of a reflecting object to the round trip time of its echo
+  ///
+  /// @param speedOfSound The speed of sound in centimeters per second
+  /// @param distanceMm   The distance in millimeters
+  ///
+  /// @retval The round trip time in microseconds
+  ///
+  uint32_t DistanceToEchoTime(uint16_t speedOfSound, uint32_t distanceMm);
+}
+#endif // _SPEEDOFSOUND_H_
@@ -0,0 +1,183 @@
+///
+/// @file SpscQueue.h
+///
+/// @brief SpscQueue class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_SPSCQUEUE_H_)
+#define _SPSCQUEUE_H_
+
+#include <stdint.h>
+
+#if !defined(__AVR__)
+#include <atomic>
+#endif
+
+namespace CNEGR
+{
+  /// @brief SpscQueue class definition
+  ///
+  /// A lock-free ring buffer with a single producer and a single consumer, typically an
+  /// interrupt handler and the main loop. Only the producer calls Push() and only the
+  /// consumer calls Pop() and Clear(), the interrupts are never disabled.
+  ///
+  /// The indices are single bytes, which the AVR reads and writes atomically. On the AVR
+  /// the ordering between the item and the index accesses is enforced by compiler barriers,
+  /// which is enough on a single core. Elsewhere the indices are std::atomic with
+  /// acquire/release ordering so the queue can be used between two threads.
+  ///
+  /// @tparam T     The item type, must be copyable
+  /// @tparam SIZE  The number of slots, a power of two between 2 and 128.
+  ///               The queue holds at most SIZE - 1 items.
+  ///
+  template <typename T, uint8_t SIZE>
+  class SpscQueue
+  {
+    static_assert((SIZE >= 2) && (SIZE <= 128) && ((SIZE & (SIZE - 1)) == 0), "SIZE must be a power of two between 2 and 128");
+
+  public:
+    /// @brief Constructor.
+    SpscQueue()
+      :_head(0),
+       _tail(0)
+    {
+    }
+
+  public:
+    /// @brief Adds an item at the end of the queue
+    ///
+    /// @note Must be called by the producer only
+    ///
+    /// @param item     The item to add
+    ///
+    /// @return boolean true if the item was added, false if the queue is full
+    ///
+    bool Push(const T& item)
+    {
+      uint8_t head = LoadRelaxed(_head);
+      uint8_t next = (uint8_t)((head + 1) & MASK);
+
+      if (next == LoadAcquire(_tail))
+        return false;
+
+      _items[head] = item;
+
+      // Publish the item only after it was written
+      StoreRelease(_head, next);
+      return true;
+    }
+
+    /// @brief Removes the item at the beginning of the queue
+    ///
+    /// @note Must be called by the consumer only
+    ///
+    /// @param item     Contains the item if successful
+    ///
+    /// @return boolean true if an item was removed, false if the queue is empty
+    ///
+    bool Pop(T& item)
+    {
+      uint8_t tail = LoadRelaxed(_tail);
+
+      if (tail == LoadAcquire(_head))
+        return false;
+
+      item = _items[tail];
+
+      // Release the slot only after the item was read
+      StoreRelease(_tail, (uint8_t)((tail + 1) & MASK));
+      return true;
+    }
+
+    /// @brief Removes all the items
+    ///
+    /// @note Must be called by the consumer only
+    ///
+    void Clear()
+    {
+      StoreRelease(_tail, LoadAcquire(_head));
+    }
+
+    /// @brief Get whether the queue is empty
+    ///
+    /// @return boolean true if the queue is empty
+    ///
+    bool IsEmpty() const
+    {
+      return LoadAcquire(_head) == LoadAcquire(_tail);
+    }
+
+    /// @brief Gets the number of items in the queue
+    ///
+    /// @note The value may be out of date by the time it is used
+    /// if the other side changes the queue concurrently
+    ///
+    /// @retval The number of items
+    ///
+    uint8_t GetCount() const
+    {
+      return (uint8_t)((LoadAcquire(_head) - LoadAcquire(_tail)) & MASK);
+    }
+
+    /// @brief Gets the maximum number of items in the queue
+    ///
+    /// @retval The capacity
+    ///
+    static uint8_t GetCapacity()
+    {
+      return SIZE - 1;
+    }
+
+  private:
+    static const uint8_t MASK = SIZE - 1;
+
+#if defined(__AVR__)
+    typedef volatile uint8_t Index;
+
+    static uint8_t LoadRelaxed(const Index& index)
+    {
+      return index;
+    }
+
+    static uint8_t LoadAcquire(const Index& index)
+    {
+      uint8_t value = index;
+      __asm__ __volatile__("" ::: "memory");
+      return value;
+    }
+
+    static void StoreRelease(Index& index, uint8_t value)
+    {
+      __asm__ __volatile__("" ::: "memory");
+      index = value;
+    }
+#else
+    typedef std::atomic<uint8_t> Index;
+
+    static uint8_t LoadRelaxed(const Index& index)
+    {
+      return index.load(std::memory_order_relaxed);
+    }
+
+    static uint8_t LoadAcquire(const Index& index)
+    {
+      return index.load(std::memory_order_acquire);
+    }
+
+    static void StoreRelease(Index& index, uint8_t value)
+    {
+      index.store(value, std::memory_order_release);
+    }
+#endif
+
+  private:
+    T         _items[SIZE];           ///< The items
+    Index     _head;                  ///< The index of the next item written, changed by the producer only
+    Index     _tail;                  ///< The index of the next item read, changed by the consumer only
+  };
+}
+#endif // _SPSCQUEUE_H_
@@ -9,6 +9,7 @@
 
 #include "DebugUtils.h"
 #include "StateMachine.h"
+#include "SpeedOfSound.h"
 
 namespace CNEGR
 {
@@ -19,14 +20,21 @@ namespace CNEGR
      _previousState(State::Invalid),
      _distanceSensor(nullptr),
      _trafficLight(nullptr),
+     _clock(nullptr),
+     _ambient(nullptr),
+     _deferLightsTest(false),
+     _bayEmpty(false),
+     _bayEmptyTime(0),
      _previousDistance(UINT32_MAX),
      _previousTime(0),
+     _filteredDistance(UINT32_MAX),
      _maxDistanceThresholdMm(0),
      _farThresholdMm(0),
      _nearThresholdMm(0),
      _movingDistanceDetectionThresholdMm(0),
      _movingTimeThresholdMs(0),
-     _holdingTimeThresholdMs(0)
+     _holdingTimeThresholdMs(0),
+     _lightsTestResult(RESULT_NOT_EXECUTED)
   {
   }
 
@@ -48,6 +56,59 @@ namespace CNEGR
 
     _distanceSensor                     = configuration.distanceSensor;
     _trafficLight                       = configuration.trafficLight;
+    _clock                              = configuration.clock;
+    _ambient                            = configuration.ambient;
+    _deferLightsTest                    = configuration.deferLightsTest;
+
+    // Without the assert the filters keep their defaults, say so
+    Result result = Reconfigure(configuration);
+    if (result != RESULT_OK)
+      Logger::Warning(F("Reconfigure returned %s"), ResultToStr(result));
+
+    assert(result == RESULT_OK);
+
+    _state = State::Initializing;
+    _previousDistance = UINT32_MAX;
+    _previousTime = 0;
+    _filteredDistance = UINT32_MAX;
+    _lightsTestResult = RESULT_NOT_EXECUTED;
+    _bayEmpty = false;
+
+    memset(&_statistics, 0, sizeof(_statistics));
+
+    // The lights are tested by the first updates, or later when the bay is idle
+    if (!_deferLightsTest)
+      Logger::Info(F("Testing lights..."));
+
+    _initDone = true;
+  }
+
+  /// @brief Changes the thresholds and the filters configuration at runtime
+  ///
+  /// @note The distance sensor, the traffic light and the clock are not changed.
+  /// The filters history and the outlier and rejected target counts are cleared.
+  /// The sensor range is limited to the maximum distance threshold.
+  ///
+  /// @param configuration      The configuration data.
+  ///
+  /// @retval RESULT_OK         The configuration was successfully changed.
+  /// @retval RESULT_BAD_PARAM  A filter configuration is invalid, the previous
+  ///                           configuration is kept.
+  ///
+  Result StateMachine::Reconfigure(const Config& configuration)
+  {
+    // Validate all the filters configuration before changing anything
+    HampelFilter outlierFilter;
+    TargetClassifier classifier;
+    AlphaBetaTracker tracker;
+
+    if ((outlierFilter.Init(configuration.outlierFilter) != RESULT_OK) ||
+        (classifier.Init(configuration.classifier) != RESULT_OK) ||
+        (tracker.Init(configuration.tracker) != RESULT_OK))
+    {
+      return RESULT_BAD_PARAM;
+    }
+
     _maxDistanceThresholdMm             = configuration.maxDistanceThresholdMm;
     _farThresholdMm                     = configuration.farThresholdMm;
     _nearThresholdMm                    = configuration.nearThresholdMm;
@@ -55,29 +116,142 @@ namespace CNEGR
     _movingTimeThresholdMs              = configuration.movingTimeThresholdMs;
     _holdingTimeThresholdMs             = configuration.holdingTimeThresholdMs;
 
-    _state = State::Initializing;
-    _previousDistance = UINT32_MAX;
-    _previousTime = 0;
+    _outlierFilter = outlierFilter;
+    _classifier    = classifier;
+    _tracker       = tracker;
 
-    _initDone = true;
+    // Nothing beyond the maximum distance threshold is used, don't wait for its echo
+    Result result = _distanceSensor->SetRangeLimit(_maxDistanceThresholdMm);
+    if (result != RESULT_OK)
+      Logger::Warning(F("SetRangeLimit returned %s, the sensor keeps its full range"), ResultToStr(result));
+
+    return RESULT_OK;
+  }
+
+  /// @brief Gets the statistics collected since Init()
+  ///
+  /// @param statistics         Contains the statistics
+  ///
+  void StateMachine::GetStatistics(Statistics& statistics) const
+  {
+    statistics                 = _statistics;
+    statistics.outliers        = _outlierFilter.GetOutlierCount();
+    statistics.rejectedTargets = _classifier.GetRejectedCount();
+  }
+
+  /// @brief Gets the last measured distance after the outlier filter
+  ///
+  /// @retval The distance in millimeters, UINT32_MAX if the last measurement timed out
+  ///
+  uint32_t StateMachine::GetFilteredDistance() const
+  {
+    return _filteredDistance;
+  }
+
+  /// @brief Gets the lights test result
+  ///
+  /// @retval RESULT_NOT_EXECUTED The test didn't complete yet.
+  /// @retval Any other value returned by the lights test
+  ///
+  Result StateMachine::GetLightsTestResult() const
+  {
+    return _lightsTestResult;
+  }
+
+  /// @brief Get whether the sensor answers the measurements
+  ///
+  /// @return boolean true if the sensor stopped answering
+  ///
+  bool StateMachine::IsSensorFaulty() const
+  {
+    return (_state == State::SensorFault);
+  }
+
+  /// @brief Gets the current state
+  ///
+  /// @retval The state, same value as in the events
+  ///
+  uint8_t StateMachine::GetState() const
+  {
+    return (uint8_t)_state;
+  }
+
+  /// @brief Gets the name of a state
+  ///
+  /// @param state              A state returned by GetState() or sent in the events
+  ///
+  /// @retval The name of the state
+  ///
+  const char *StateMachine::GetStateName(uint8_t state)
+  {
+    return ToString((State)(int8_t)state);
   }
 
   /// @brief Update the state machine state.
   ///
-  /// @note This method must be called periodically
-  /// in the main app loop
+  /// @note This method must be called periodically in the main app loop. It
+  /// never blocks: while the lights test or the distance measurement are in
+  /// progress it returns RESULT_BUSY and it must be called again, as soon as
+  /// possible, to complete the update.
+  /// While the sensor doesn't answer the lights are off and the state machine
+  /// stays in the SensorFault state, it starts over from Idle when the sensor
+  /// answers again.
+  ///
+  /// @retval RESULT_OK         The update is complete.
+  /// @retval RESULT_BUSY       The update is in progress.
   ///
-  void StateMachine::Update()
+  Result StateMachine::Update()
   {
     assert(_initDone == true);
 
+    // The lights are tested once, before the first measurement. When the test is
+    // deferred the lights show the distance as soon as possible after a reset, and
+    // the test waits for the bay to stay empty for the holding time. It doesn't
+    // start under a car arriving, and not at all while the bay stays occupied.
+    bool bayEmpty = (_state == State::Idle) && _bayEmpty && (GetTime() - _bayEmptyTime > _holdingTimeThresholdMs);
+
+    if ((_lightsTestResult == RESULT_NOT_EXECUTED) && (!_deferLightsTest || bayEmpty))
+    {
+      Result result = TestLights();
+      if (result == RESULT_BUSY)
+        return RESULT_BUSY;
+
+      _lightsTestResult = result;
+    }
+
     // Get the current distance
-    uint32_t distance = MeasureDistance();
+    uint32_t rawDistance = 0;
+    Result measurementResult = MeasureDistance(rawDistance);
+    if (measurementResult == RESULT_BUSY)
+      return RESULT_BUSY;
+
     // and current time
-    uint32_t time     = millis();
+    uint32_t time        = GetTime();
+
+    // Feed the tracker, a missing measurement is replaced by the predicted position
+    // and spikes are replaced by the median of the recent readings
+    _statistics.updates++;
+
+    if (rawDistance == UINT32_MAX)
+    {
+      _statistics.timeouts++;
+      _filteredDistance = UINT32_MAX;
+      _classifier.Miss();
+      _tracker.Predict(time);
+    }
+    else
+    {
+      _filteredDistance = _outlierFilter.Filter(rawDistance);
+      _classifier.Update(_filteredDistance);
+      _tracker.Update(time, _filteredDistance);
+    }
+
+    uint32_t distance = _tracker.GetDistance();
+
+    Logger::Info(F("Tracked distance is %lu mm, velocity is %ld mm/s"), distance, _tracker.GetVelocity());
 
     // Calculate deltaT and deltaD
-    uint32_t deltaT = millis() - _previousTime;
+    uint32_t deltaT = GetTime() - _previousTime;
     int32_t  deltaD = (distance > _previousDistance) ?
                             (int32_t)(distance - _previousDistance) :
                             ((int32_t)(_previousDistance - distance) * (-1));
@@ -100,13 +274,37 @@ namespace CNEGR
     {
       case State::Initializing:
         _previousTime = time;
-        nextState = State::Idle;
-        if (TestLights() != RESULT_OK)
-          nextState = State::Error;
+        nextState = ((_lightsTestResult == RESULT_OK) || (_lightsTestResult == RESULT_NOT_EXECUTED)) ?
+                        State::Idle : State::Error;
+
+        // On a fast start the first reading in range is shown right away, the classifier
+        // would take persistenceSamples readings to confirm a car already in front of
+        // the sensor. The tracker starts from this reading too.
+        if (_deferLightsTest && (nextState == State::Idle) && (rawDistance <= _maxDistanceThresholdMm))
+        {
+          _classifier.Seed(_filteredDistance);
+          SetTrafficLights(distance);
+          nextState = State::SubjectApproaching;
+        }
         break;
 
       case State::Idle:
         _previousTime = time;
+        // A deferred lights test failed
+        if ((_lightsTestResult != RESULT_OK) && (_lightsTestResult != RESULT_NOT_EXECUTED))
+        {
+          nextState = State::Error;
+          break;
+        }
+
+        // Ignore any movement until the returns come from a persistent target
+        // so that somebody walking through the beam doesn't turn the lights on
+        if (!_classifier.IsConfirmed())
+        {
+          Logger::Info(F("Target not confirmed"));
+          movingDirection = MovingDirection::Stopped;
+        }
+
         switch(movingDirection)
         {
           case MovingDirection::Stopped:
@@ -171,6 +369,16 @@ namespace CNEGR
         }
         break;
 
+      case State::SensorFault:
+        if (measurementResult == RESULT_DEV_ERR)
+          break;
+
+        // The sensor answers again, start over without restarting the application
+        Logger::Info(F("The sensor answers again"));
+        _previousTime = time;
+        nextState = State::Idle;
+        break;
+
       case State::Invalid:
         nextState = State::Error;
         break;
@@ -184,25 +392,75 @@ namespace CNEGR
         break;
     }
 
+    // The sensor doesn't answer, whatever the state. The measurements go on so
+    // that the state machine resumes as soon as the sensor is plugged back in.
+    if ((measurementResult == RESULT_DEV_ERR) && (_state != State::Error))
+    {
+      if (_state != State::SensorFault)
+      {
+        Logger::Error(F("The sensor doesn't answer"));
+        _statistics.sensorFaults++;
+        PublishFault(measurementResult);
+        SetAllLightsOff();
+      }
+
+      nextState = State::SensorFault;
+    }
+
+    if (nextState != _state)
+      _statistics.transitions++;
+
+    PublishEvents(time, rawDistance, nextState);
+
+    // The bay is empty while the state machine stays idle with nothing in range
+    if ((nextState != State::Idle) || (rawDistance != UINT32_MAX))
+    {
+      _bayEmpty = false;
+    }
+    else if (!_bayEmpty)
+    {
+      _bayEmpty     = true;
+      _bayEmptyTime = time;
+    }
+
     // Update the previous state and the current state
     _previousState = _state;
     _state = nextState;
 
     Logger::Info(F("Next state is %s"), ToString(_state));
+
+    return RESULT_OK;
   }
 
-  /// @brief Measures the distance.
+  /// @brief Measures the distance without blocking.
   ///
-  /// @retval returns the measured distance in millimeters.
+  /// @param distance           Contains the measured distance in millimeters,
+  ///                           UINT32_MAX if the measurement timed out
   ///
-  uint32_t StateMachine::MeasureDistance()
+  /// @retval RESULT_OK         The measurement is complete.
+  /// @retval RESULT_BUSY       The measurement is in progress.
+  /// @retval RESULT_DEV_ERR    The sensor doesn't answer, the distance is UINT32_MAX.
+  ///
+  Result StateMachine::MeasureDistance(uint32_t& distance)
   {
-    uint32_t distance = 0;
-    Result result = RESULT_OK;
-    result = _distanceSensor->MeasureDistance(distance);
+    int32_t  ambientTemperature = STATEMACHINE_DEFAULT_TEMPERATURE;
+    uint32_t relativeHumidity   = DEFAULT_RELATIVE_HUMIDITY;
+
+    if ((_ambient != nullptr) && !_ambient(ambientTemperature, relativeHumidity))
+    {
+      ambientTemperature = STATEMACHINE_DEFAULT_TEMPERATURE;
+      relativeHumidity   = DEFAULT_RELATIVE_HUMIDITY;
+    }
+
+    distance = 0;
+    Result result = _distanceSensor->MeasureDistanceAsync((uint32_t)ambientTemperature, relativeHumidity, distance);
 
     switch(result)
     {
+      case RESULT_BUSY:
+        // The echo didn't come back yet
+        return RESULT_BUSY;
+
       case RESULT_OK:
         Logger::Info(F("MeasureDistance returned RESULT_OK and distance is %d mm"), distance);
         break;
@@ -214,12 +472,11 @@ namespace CNEGR
         break;
 
       case RESULT_DEV_ERR:
-        // Some sort of device error
-        // Reset the board to reinitialize everything and hope that it works after that
-        Logger::Error(F("MeasureDistance returned RESULT_DEV_ERR, restarting the application"));
-        delay(1000);
-        Reset();
-        break;
+        // The sensor doesn't answer, it reconfigures itself at every measurement
+        // until it is plugged back in
+        Logger::Warning(F("MeasureDistance returned RESULT_DEV_ERR"));
+        distance = UINT32_MAX;
+        return RESULT_DEV_ERR;
 
       case RESULT_NOT_READY:
         // Init() must be called before the loop starts executing
@@ -236,7 +493,7 @@ namespace CNEGR
         break;
     }
 
-    return distance;
+    return RESULT_OK;
   }
 
   /// @brief Sets Off all traffic lights
@@ -247,15 +504,21 @@ namespace CNEGR
     _trafficLight->SetAllLightsOff();
   }
 
-  /// @brief Tests the traffic lights
+  /// @brief Tests the traffic lights without blocking
+  ///
+  /// @retval RESULT_BUSY       The test is in progress.
+  /// @retval Any other value returned by the lights test
   ///
   Result StateMachine::TestLights()
   {
-    Logger::Info(F("Testing lights..."));
-    Result result = _trafficLight->PerformLightsTest();
+    Result result = _trafficLight->PerformLightsTestAsync();
+    if (result == RESULT_BUSY)
+      return result;
+
     if (result != RESULT_OK)
     {
       Logger::Error(F("Lights test error: %s"), ResultToStr(result));
+      PublishFault(result);
     }
     else
     {
@@ -265,6 +528,54 @@ namespace CNEGR
     return result;
   }
 
+  /// @brief Publishes the sample and the state change, if any
+  ///
+  /// @param time         The measurement time in milliseconds
+  /// @param rawDistance  The measured distance in millimeters
+  /// @param nextState    The state after this update
+  ///
+  void StateMachine::PublishEvents(uint32_t time, uint32_t rawDistance, State nextState)
+  {
+    SampleEvent sample;
+    sample.timeMs             = time;
+    sample.rawDistanceMm      = rawDistance;
+    sample.filteredDistanceMm = _filteredDistance;
+    sample.trackedDistanceMm  = _tracker.GetDistance();
+    sample.velocityMmPerS     = _tracker.GetVelocity();
+    sample.state              = (uint8_t)nextState;
+    Publish(sample);
+
+    if (nextState != _state)
+    {
+      StateChangedEvent stateChanged;
+      stateChanged.timeMs    = time;
+      stateChanged.fromState = (uint8_t)_state;
+      stateChanged.toState   = (uint8_t)nextState;
+      Publish(stateChanged);
+    }
+  }
+
+  /// @brief Publishes a component failure
+  ///
+  /// @param result       The error returned by the component
+  ///
+  void StateMachine::PublishFault(Result result)
+  {
+    FaultEvent fault;
+    fault.timeMs = GetTime();
+    fault.result = result;
+    Publish(fault);
+  }
+
+  /// @brief Gets the current time from the clock
+  ///
+  /// @retval The time in milliseconds
+  ///
+  uint32_t StateMachine::GetTime() const
+  {
+    return (_clock != nullptr) ? _clock() : millis();
+  }
+
   /// @brief Sets the traffic lights based on the measured distance.
   ///
   /// @param distance The distance in millimeters
@@ -294,6 +605,7 @@ namespace CNEGR
     }
 
     assert (result == RESULT_OK);
+    (void)result;
   }
 
 
@@ -349,6 +661,7 @@ namespace CNEGR
     static const char STATE_ERROR[]          = "Error";
     static const char STATE_APPROACHING[]    = "SubjectApproaching";
     static const char STATE_RETREATING[]     = "SubjectRetreating";
+    static const char STATE_SENSOR_FAULT[]   = "SensorFault";
     static const char STATE_UNKNOWN[]        = "Unknown";
 
     const char* const STATE_STRINGS[] =
@@ -359,12 +672,13 @@ namespace CNEGR
         STATE_ERROR,
         STATE_APPROACHING,
         STATE_RETREATING,
+        STATE_SENSOR_FAULT,
         STATE_UNKNOWN
     };
 
-    if ((state >= State::Invalid) && (state <= State::SubjectRetreating))
+    if ((state >= State::Invalid) && (state <= State::SensorFault))
       return reinterpret_cast<const char *>(STATE_STRINGS[state + 1]);
     else
-      return reinterpret_cast<const char *>(STATE_STRINGS[State::SubjectRetreating + 2]);
+      return reinterpret_cast<const char *>(STATE_STRINGS[State::SensorFault + 2]);
   }
 }
@@ -13,9 +13,17 @@
 
 #include "IDistanceSensor.h"
 #include "ITrafficLight.h"
+#include "AlphaBetaTracker.h"
+#include "HampelFilter.h"
+#include "TargetClassifier.h"
+#include "Events.h"
+#include "CommonDefines.h"
 
 namespace CNEGR
 {
+  /// The ambient temperature in deci-degrees celsius assumed when there is no ambient sensor
+  #define STATEMACHINE_DEFAULT_TEMPERATURE 200
+
   /// @brief StateMachine class definition
   ///
   class StateMachine
@@ -28,7 +36,8 @@ namespace CNEGR
         Idle,
         Error,
         SubjectApproaching,
-        SubjectRetreating
+        SubjectRetreating,
+        SensorFault
     };
 
     enum MovingDirection
@@ -43,6 +52,15 @@ namespace CNEGR
     {
       IDistanceSensor *distanceSensor;                        ///< The distance sensor to use for distance measurements
       ITrafficLight   *trafficLight;                          ///< The traffic light component to use for signaling
+      ClockProc       clock;                                  ///< The millisecond clock, nullptr to use millis()
+      AmbientProc     ambient;                                ///< Reads the ambient temperature and humidity, nullptr
+                                                              ///< to assume STATEMACHINE_DEFAULT_TEMPERATURE
+                                                              ///< and DEFAULT_RELATIVE_HUMIDITY
+      bool            deferLightsTest;                        ///< If true the first updates measure right away and the
+                                                              ///< lights test runs later, once the bay is idle and
+                                                              ///< nothing was in range for the holding time. The
+                                                              ///< first reading in range is shown without waiting
+                                                              ///< for the classifier to confirm it
       uint32_t        maxDistanceThresholdMm;                 ///< The maximum distance threshold in millimiters.
                                                               ///< If the measured distance is greater than this value
                                                               ///< then the suject is considered out of range
@@ -62,6 +80,22 @@ namespace CNEGR
                                                               ///< as a valid movement
       uint32_t        holdingTimeThresholdMs;                 ///< The minimum amount of time that the subject needs to be
                                                               ///< in the same position to detect that the move stopped
+      HampelFilter::Config     outlierFilter;                 ///< The configuration of the filter used to reject spikes
+                                                              ///< in the measured distance
+      TargetClassifier::Config classifier;                    ///< The configuration of the classifier used to ignore
+                                                              ///< transient targets while idle
+      AlphaBetaTracker::Config tracker;                       ///< The configuration of the tracker used to smooth the
+                                                              ///< measured distance
+    };
+
+    struct Statistics
+    {
+      uint32_t        updates;                                ///< The number of completed Update() calls
+      uint32_t        timeouts;                               ///< The number of measurements that timed out
+      uint32_t        transitions;                            ///< The number of state changes
+      uint32_t        outliers;                               ///< The number of readings rejected as outliers
+      uint32_t        rejectedTargets;                        ///< The number of targets rejected as transient
+      uint32_t        sensorFaults;                           ///< The number of times the sensor stopped answering
     };
 
   public:
@@ -78,12 +112,73 @@ namespace CNEGR
     ///
     void Init(const Config& configuration);
 
+    /// @brief Changes the thresholds and the filters configuration at runtime
+    ///
+    /// @note The distance sensor, the traffic light and the clock are not changed.
+    /// The filters history and the outlier and rejected target counts are cleared.
+    /// The sensor range is limited to the maximum distance threshold.
+    ///
+    /// @param configuration      The configuration data.
+    ///
+    /// @retval RESULT_OK         The configuration was successfully changed.
+    /// @retval RESULT_BAD_PARAM  A filter configuration is invalid, the previous
+    ///                           configuration is kept.
+    ///
+    Result Reconfigure(const Config& configuration);
+
+    /// @brief Gets the statistics collected since Init()
+    ///
+    /// @param statistics         Contains the statistics
+    ///
+    void GetStatistics(Statistics& statistics) const;
+
+    /// @brief Gets the last measured distance after the outlier filter
+    ///
+    /// @retval The distance in millimeters, UINT32_MAX if the last measurement timed out
+    ///
+    uint32_t GetFilteredDistance() const;
+
+    /// @brief Gets the lights test result
+    ///
+    /// @retval RESULT_NOT_EXECUTED The test didn't complete yet.
+    /// @retval Any other value returned by the lights test
+    ///
+    Result GetLightsTestResult() const;
+
     /// @brief Update the state machine state.
     ///
-    /// @note This method must be called periodically
-    /// in the main app loop
+    /// @note This method must be called periodically in the main app loop. It
+    /// never blocks: while the lights test or the distance measurement are in
+    /// progress it returns RESULT_BUSY and it must be called again, as soon as
+    /// possible, to complete the update.
+    /// While the sensor doesn't answer the lights are off and the state machine
+    /// stays in the SensorFault state, it starts over from Idle when the sensor
+    /// answers again.
     ///
-    void Update();
+    /// @retval RESULT_OK         The update is complete.
+    /// @retval RESULT_BUSY       The update is in progress.
+    ///
+    Result Update();
+
+    /// @brief Get whether the sensor answers the measurements
+    ///
+    /// @return boolean true if the sensor stopped answering
+    ///
+    bool IsSensorFaulty() const;
+
+    /// @brief Gets the current state
+    ///
+    /// @retval The state, same value as in the events
+    ///
+    uint8_t GetState() const;
+
+    /// @brief Gets the name of a state
+    ///
+    /// @param state              A state returned by GetState() or sent in the events
+    ///
+    /// @retval The name of the state
+    ///
+    static const char *GetStateName(uint8_t state);
 
   private:
     /// @brief Gets the moving direction based on the time and distance
@@ -96,11 +191,16 @@ namespace CNEGR
     ///
     MovingDirection GetMovingDirection(uint32_t deltaT, int32_t  deltaD);
 
-    /// @brief Measures the distance.
+    /// @brief Measures the distance without blocking.
+    ///
+    /// @param distance           Contains the measured distance in millimeters,
+    ///                           UINT32_MAX if the measurement timed out
     ///
-    /// @retval returns the measured distance in millimeters.
+    /// @retval RESULT_OK         The measurement is complete.
+    /// @retval RESULT_BUSY       The measurement is in progress.
+    /// @retval RESULT_DEV_ERR    The sensor doesn't answer, the distance is UINT32_MAX.
     ///
-    uint32_t MeasureDistance();
+    Result MeasureDistance(uint32_t& distance);
 
     /// @brief Sets the traffic lights based on the measured distance.
     ///
@@ -112,10 +212,33 @@ namespace CNEGR
     ///
     void SetAllLightsOff();
 
-    /// @brief Tests the traffic lights
+    /// @brief Tests the traffic lights without blocking
+    ///
+    /// @retval RESULT_BUSY       The test is in progress.
+    /// @retval Any other value returned by the lights test
     ///
     Result TestLights();
 
+    /// @brief Publishes the sample and the state change, if any
+    ///
+    /// @param time         The measurement time in milliseconds
+    /// @param rawDistance  The measured distance in millimeters
+    /// @param nextState    The state after this update
+    ///
+    void PublishEvents(uint32_t time, uint32_t rawDistance, State nextState);
+
+    /// @brief Publishes a component failure
+    ///
+    /// @param result       The error returned by the component
+    ///
+    void PublishFault(Result result);
+
+    /// @brief Gets the current time from the clock
+    ///
+    /// @retval The time in milliseconds
+    ///
+    uint32_t GetTime() const;
+
   private:
     static const char *ToString(MovingDirection movingDirection);
     static const char *ToString(State state);
@@ -126,8 +249,14 @@ namespace CNEGR
     State           _previousState;                       ///< The previous state
     IDistanceSensor *_distanceSensor;                     ///< The distance sensor to use for distance measurements
     ITrafficLight   *_trafficLight;                       ///< The traffic light component to use for signaling
+    ClockProc       _clock;                               ///< The millisecond clock, nullptr for millis()
+    AmbientProc     _ambient;                             ///< Reads the ambient conditions, nullptr for the defaults
+    bool            _deferLightsTest;                     ///< A flag to indicate that the lights test waits for the bay to be empty
+    bool            _bayEmpty;                            ///< A flag to indicate that nothing was in range since _bayEmptyTime
+    uint32_t        _bayEmptyTime;                        ///< The time of the first idle update with nothing in range
     uint32_t        _previousDistance;                    ///< The previous distance measured in millimiters
     uint32_t        _previousTime;                        ///< The previous time measured in milliseconds
+    uint32_t        _filteredDistance;                    ///< The last measured distance after the outlier filter
     uint32_t        _maxDistanceThresholdMm;              ///< The maximum distance threshold in millimiters.
     uint32_t        _farThresholdMm;                      ///< The "far" distance threshold in millimiters.
     uint32_t        _nearThresholdMm;                     ///< The "near" distance threshold in millimiters.
@@ -137,6 +266,11 @@ namespace CNEGR
                                                           ///< as a valid movement
     uint32_t        _holdingTimeThresholdMs;              ///< The minimum amount of time that the subject needs to be
                                                           ///< in the same position to detect that the move stopped
+    HampelFilter    _outlierFilter;                       ///< The filter used to reject spikes in the measured distance
+    TargetClassifier _classifier;                         ///< The classifier used to ignore transient targets while idle
+    AlphaBetaTracker _tracker;                            ///< The tracker used to smooth the measured distance
+    Statistics      _statistics;                          ///< The statistics collected since Init()
+    Result          _lightsTestResult;                    ///< The lights test result, RESULT_NOT_EXECUTED until it completes
 
   };
 }
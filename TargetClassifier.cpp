@@ -0,0 +1,130 @@
+///
+/// @file TargetClassifier.cpp
+///
+/// @brief TargetClassifier class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "TargetClassifier.h"
+
+namespace CNEGR
+{
+  /// @brief Constructor.
+  TargetClassifier::TargetClassifier()
+    :_lastDistanceMm(0),
+     _consistentSamples(0),
+     _missedSamples(0),
+     _rejectedCount(0)
+  {
+    _config.persistenceSamples = 0;
+    _config.maxStepMm          = 0;
+    _config.maxMissedSamples   = 0;
+  }
+
+  /// @brief Destructor.
+  TargetClassifier::~TargetClassifier()
+  {
+  }
+
+  /// @brief Initialization function.
+  ///
+  /// @param configuration      The configuration data.
+  ///
+  /// @retval RESULT_OK         The classifier was successfully configured.
+  /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+  ///
+  Result TargetClassifier::Init(const Config& configuration)
+  {
+    if ((configuration.persistenceSamples == 0) || (configuration.persistenceSamples == UINT8_MAX))
+      return RESULT_BAD_PARAM;
+
+    _config = configuration;
+    Reset();
+    _rejectedCount = 0;
+
+    return RESULT_OK;
+  }
+
+  /// @brief Drops the current target
+  ///
+  void TargetClassifier::Reset()
+  {
+    // A target seen for a while but never confirmed was a transient one
+    if ((_consistentSamples > 1) && (_consistentSamples < _config.persistenceSamples))
+      _rejectedCount++;
+
+    _lastDistanceMm    = 0;
+    _consistentSamples = 0;
+    _missedSamples     = 0;
+  }
+
+  /// @brief Updates the classifier with a new reading
+  ///
+  /// @param distanceMm         The measured distance in millimeters
+  ///
+  void TargetClassifier::Update(uint32_t distanceMm)
+  {
+    uint16_t distance = (distanceMm > UINT16_MAX) ? UINT16_MAX : (uint16_t)distanceMm;
+    uint16_t step = (distance > _lastDistanceMm) ? (distance - _lastDistanceMm) : (_lastDistanceMm - distance);
+
+    if ((_consistentSamples != 0) && (step > _config.maxStepMm))
+    {
+      // Erratic return, start over from this reading
+      Reset();
+    }
+
+    _lastDistanceMm = distance;
+    _missedSamples  = 0;
+
+    // Saturate once the target is confirmed
+    if (_consistentSamples < _config.persistenceSamples)
+      _consistentSamples++;
+  }
+
+  /// @brief Updates the classifier when the reading is missing
+  ///
+  void TargetClassifier::Miss()
+  {
+    if (_consistentSamples == 0)
+      return;
+
+    if (_missedSamples >= _config.maxMissedSamples)
+    {
+      Reset();
+      return;
+    }
+
+    _missedSamples++;
+  }
+
+  /// @brief Confirms a target from a single reading, without waiting for the persistence
+  ///
+  /// @param distanceMm         The measured distance in millimeters
+  ///
+  void TargetClassifier::Seed(uint32_t distanceMm)
+  {
+    _lastDistanceMm    = (distanceMm > UINT16_MAX) ? UINT16_MAX : (uint16_t)distanceMm;
+    _consistentSamples = _config.persistenceSamples;
+    _missedSamples     = 0;
+  }
+
+  /// @brief Get whether the returns come from a persistent target
+  ///
+  /// @return boolean true if the target is confirmed
+  ///
+  bool TargetClassifier::IsConfirmed() const
+  {
+    return _consistentSamples >= _config.persistenceSamples;
+  }
+
+  /// @brief Gets the number of targets rejected as transient since Init()
+  ///
+  /// @retval The number of rejected targets
+  ///
+  uint16_t TargetClassifier::GetRejectedCount() const
+  {
+    return _rejectedCount;
+  }
+}
@@ -0,0 +1,103 @@
+///
+/// @file TargetClassifier.h
+///
+/// @brief TargetClassifier class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_TARGETCLASSIFIER_H_)
+#define _TARGETCLASSIFIER_H_
+
+#include <stdint.h>
+#include "Result.h"
+
+namespace CNEGR
+{
+  /// @brief TargetClassifier class definition
+  ///
+  /// Decides whether the returns come from a persistent target (i.e. a car) or from a
+  /// transient one (i.e. a pedestrian walking through the beam). A target is confirmed
+  /// only after persistenceSamples consecutive readings where each reading is within
+  /// maxStepMm of the previous one. Erratic readings restart the count and too many
+  /// missing readings in a row drop the target.
+  ///
+  /// The step is checked per reading and not per unit of time, so a target moving more than
+  /// maxStepMm between two readings is never confirmed. At 150 mm and one reading every
+  /// 100 ms that is anything faster than 1.5 m/s.
+  ///
+  /// An instance takes 10 bytes of RAM on AVR, 4 of them for the configuration.
+  ///
+  class TargetClassifier
+  {
+  public:
+    struct Config
+    {
+      uint8_t   persistenceSamples;   ///< The number of consistent readings needed to confirm a target
+      uint16_t  maxStepMm;            ///< The maximum distance change between two consecutive readings
+                                      ///< for them to be considered consistent, a target faster than
+                                      ///< maxStepMm per measurement period is never confirmed
+      uint8_t   maxMissedSamples;     ///< The number of consecutive missing readings tolerated before
+                                      ///< the target is dropped
+    };
+
+  public:
+    /// @brief Constructor.
+    TargetClassifier();
+
+    /// @brief Destructor.
+    ~TargetClassifier();
+
+  public:
+    /// @brief Initialization function.
+    ///
+    /// @param configuration      The configuration data.
+    ///
+    /// @retval RESULT_OK         The classifier was successfully configured.
+    /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+    ///
+    Result Init(const Config& configuration);
+
+    /// @brief Drops the current target
+    ///
+    void Reset();
+
+    /// @brief Updates the classifier with a new reading
+    ///
+    /// @param distanceMm         The measured distance in millimeters
+    ///
+    void Update(uint32_t distanceMm);
+
+    /// @brief Updates the classifier when the reading is missing
+    ///
+    void Miss();
+
+    /// @brief Confirms a target from a single reading, without waiting for the persistence
+    ///
+    /// @param distanceMm         The measured distance in millimeters
+    ///
+    void Seed(uint32_t distanceMm);
+
+    /// @brief Get whether the returns come from a persistent target
+    ///
+    /// @return boolean true if the target is confirmed
+    ///
+    bool IsConfirmed() const;
+
+    /// @brief Gets the number of targets rejected as transient since Init()
+    ///
+    /// @retval The number of rejected targets
+    ///
+    uint16_t GetRejectedCount() const;
+
+  private:
+    Config    _config;                ///< The classifier configuration
+    uint16_t  _lastDistanceMm;        ///< The previous reading in millimeters
+    uint8_t   _consistentSamples;     ///< The number of consecutive consistent readings
+    uint8_t   _missedSamples;         ///< The number of consecutive missing readings
+    uint16_t  _rejectedCount;         ///< The number of targets rejected as transient
+  };
+}
+#endif // _TARGETCLASSIFIER_H_
@@ -0,0 +1,191 @@
+///
+/// @file TeachIn.cpp
+///
+/// @brief TeachIn class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "TeachIn.h"
+
+namespace CNEGR
+{
+  /// @brief Constructor.
+  TeachIn::TeachIn()
+    :_initDone(false),
+     _active(false),
+     _samples(0),
+     _missedSamples(0),
+     _sumMm(0),
+     _minMm(UINT32_MAX),
+     _maxMm(0),
+     _stopDistanceMm(UINT32_MAX)
+  {
+    _config.sampleCount      = 0;
+    _config.maxMissedSamples = 0;
+    _config.maxSpreadMm      = 0;
+    _config.stopToleranceMm  = 0;
+    _config.yellowZoneMm     = 0;
+    _config.greenZoneMm      = 0;
+    _config.maxRangeMm       = 0;
+  }
+
+  /// @brief Destructor.
+  TeachIn::~TeachIn()
+  {
+  }
+
+  /// @brief Initialization function.
+  ///
+  /// @param configuration      The configuration data.
+  ///
+  /// @retval RESULT_OK         The teach-in was successfully configured.
+  /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+  ///
+  Result TeachIn::Init(const Config& configuration)
+  {
+    // The zones must not be empty otherwise the thresholds are not ordered
+    if ((configuration.sampleCount == 0) || (configuration.yellowZoneMm == 0) || (configuration.greenZoneMm == 0))
+      return RESULT_BAD_PARAM;
+
+    // Even a stop position at zero distance needs a green zone within the range
+    if ((uint32_t)configuration.stopToleranceMm + configuration.yellowZoneMm >= configuration.maxRangeMm)
+      return RESULT_BAD_PARAM;
+
+    _config         = configuration;
+    _active         = false;
+    _stopDistanceMm = UINT32_MAX;
+    _initDone       = true;
+
+    return RESULT_OK;
+  }
+
+  /// @brief Starts a new capture
+  ///
+  /// @retval RESULT_OK         The capture was started.
+  /// @retval RESULT_NOT_READY  Init() wasn't called.
+  /// @retval RESULT_BUSY       A capture is already running.
+  ///
+  Result TeachIn::Start()
+  {
+    if (!_initDone)
+      return RESULT_NOT_READY;
+
+    if (_active)
+      return RESULT_BUSY;
+
+    _samples        = 0;
+    _missedSamples  = 0;
+    _sumMm          = 0;
+    _minMm          = UINT32_MAX;
+    _maxMm          = 0;
+    _stopDistanceMm = UINT32_MAX;
+    _active         = true;
+
+    return RESULT_OK;
+  }
+
+  /// @brief Stops the running capture, if any
+  ///
+  void TeachIn::Abort()
+  {
+    _active = false;
+  }
+
+  /// @brief Get whether a capture is running
+  ///
+  /// @return boolean true if the capture is running
+  ///
+  bool TeachIn::IsActive() const
+  {
+    return _active;
+  }
+
+  /// @brief Adds a reading to the running capture
+  ///
+  /// @param distanceMm         The measured distance in millimeters, UINT32_MAX if missing
+  ///
+  /// @retval RESULT_NO_DATA    More readings are needed.
+  /// @retval RESULT_OK         The capture is complete, the thresholds are available.
+  /// @retval RESULT_TIMEOUT    Too many readings were missing, the capture is stopped.
+  /// @retval RESULT_NOT_VALID  The readings are not stable, the capture is stopped.
+  /// @retval RESULT_NOT_READY  No capture is running.
+  ///
+  Result TeachIn::AddSample(uint32_t distanceMm)
+  {
+    if (!_active)
+      return RESULT_NOT_READY;
+
+    if (distanceMm == UINT32_MAX)
+    {
+      if (++_missedSamples > _config.maxMissedSamples)
+      {
+        _active = false;
+        return RESULT_TIMEOUT;
+      }
+
+      return RESULT_NO_DATA;
+    }
+
+    _sumMm += distanceMm;
+    if (distanceMm < _minMm)
+      _minMm = distanceMm;
+    if (distanceMm > _maxMm)
+      _maxMm = distanceMm;
+
+    // Fail early, there is no point in waiting for the remaining readings
+    if (_maxMm - _minMm > _config.maxSpreadMm)
+    {
+      _active = false;
+      return RESULT_NOT_VALID;
+    }
+
+    if (++_samples < _config.sampleCount)
+      return RESULT_NO_DATA;
+
+    _stopDistanceMm = (_sumMm + _samples / 2) / _samples;
+    _active = false;
+
+    return RESULT_OK;
+  }
+
+  /// @brief Gets the captured stop distance
+  ///
+  /// @retval The stop distance in millimeters, UINT32_MAX if no capture completed
+  ///
+  uint32_t TeachIn::GetStopDistance() const
+  {
+    return _stopDistanceMm;
+  }
+
+  /// @brief Gets the thresholds derived from the captured stop distance
+  ///
+  /// @param thresholds         Contains the thresholds if successful
+  ///
+  /// @retval RESULT_OK         The thresholds are available.
+  /// @retval RESULT_NO_DATA    No capture completed.
+  /// @retval RESULT_BAD_PARAM  The far threshold is beyond the range of the sensor.
+  ///
+  Result TeachIn::GetThresholds(Thresholds& thresholds) const
+  {
+    if (_stopDistanceMm == UINT32_MAX)
+      return RESULT_NO_DATA;
+
+    uint32_t nearThresholdMm = _stopDistanceMm + _config.stopToleranceMm;
+    uint32_t farThresholdMm  = nearThresholdMm + _config.yellowZoneMm;
+
+    if (farThresholdMm >= _config.maxRangeMm)
+      return RESULT_BAD_PARAM;
+
+    // The sensor times out beyond its range, a car there would never turn the green light on
+    thresholds.nearThresholdMm        = nearThresholdMm;
+    thresholds.farThresholdMm         = farThresholdMm;
+    thresholds.maxDistanceThresholdMm = farThresholdMm + _config.greenZoneMm;
+
+    if (thresholds.maxDistanceThresholdMm > _config.maxRangeMm)
+      thresholds.maxDistanceThresholdMm = _config.maxRangeMm;
+
+    return RESULT_OK;
+  }
+}
@@ -0,0 +1,132 @@
+///
+/// @file TeachIn.h
+///
+/// @brief TeachIn class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_TEACHIN_H_)
+#define _TEACHIN_H_
+
+#include <stdint.h>
+#include "Result.h"
+
+namespace CNEGR
+{
+  /// @brief TeachIn class definition
+  ///
+  /// Captures the stop position of a parked car and derives the distance thresholds
+  /// from it. The capture is started with Start() and then fed one reading per main
+  /// loop iteration with AddSample(), so it never stalls the loop. The stop distance
+  /// is the average of sampleCount valid readings, the capture fails if the readings
+  /// are spread over more than maxSpreadMm or if too many readings are missing.
+  ///
+  /// The thresholds are derived as:
+  ///   near = stop + stopToleranceMm   (red light from here on)
+  ///   far  = near + yellowZoneMm      (yellow light between near and far)
+  ///   max  = far  + greenZoneMm       (green light between far and max)
+  ///
+  /// The max threshold is clamped to the range of the sensor, which shortens the green
+  /// zone of a stop position far from the sensor. The teach-in fails when the far
+  /// threshold itself is beyond the range, no green light could ever be shown.
+  ///
+  class TeachIn
+  {
+  public:
+    struct Config
+    {
+      uint8_t   sampleCount;          ///< The number of valid readings averaged
+      uint8_t   maxMissedSamples;     ///< The number of missing readings tolerated during the capture
+      uint16_t  maxSpreadMm;          ///< The maximum difference between the readings
+      uint16_t  stopToleranceMm;      ///< The distance between the stop position and the near threshold
+      uint16_t  yellowZoneMm;         ///< The distance between the near and far thresholds
+      uint16_t  greenZoneMm;          ///< The distance between the far and max thresholds
+      uint32_t  maxRangeMm;           ///< The range of the sensor, the max threshold is clamped to it
+    };
+
+    struct Thresholds
+    {
+      uint32_t  nearThresholdMm;      ///< See StateMachine::Config
+      uint32_t  farThresholdMm;       ///< See StateMachine::Config
+      uint32_t  maxDistanceThresholdMm; ///< See StateMachine::Config
+    };
+
+  public:
+    /// @brief Constructor.
+    TeachIn();
+
+    /// @brief Destructor.
+    ~TeachIn();
+
+  public:
+    /// @brief Initialization function.
+    ///
+    /// @param configuration      The configuration data.
+    ///
+    /// @retval RESULT_OK         The teach-in was successfully configured.
+    /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+    ///
+    Result Init(const Config& configuration);
+
+    /// @brief Starts a new capture
+    ///
+    /// @retval RESULT_OK         The capture was started.
+    /// @retval RESULT_NOT_READY  Init() wasn't called.
+    /// @retval RESULT_BUSY       A capture is already running.
+    ///
+    Result Start();
+
+    /// @brief Stops the running capture, if any
+    ///
+    void Abort();
+
+    /// @brief Get whether a capture is running
+    ///
+    /// @return boolean true if the capture is running
+    ///
+    bool IsActive() const;
+
+    /// @brief Adds a reading to the running capture
+    ///
+    /// @param distanceMm         The measured distance in millimeters, UINT32_MAX if missing
+    ///
+    /// @retval RESULT_NO_DATA    More readings are needed.
+    /// @retval RESULT_OK         The capture is complete, the thresholds are available.
+    /// @retval RESULT_TIMEOUT    Too many readings were missing, the capture is stopped.
+    /// @retval RESULT_NOT_VALID  The readings are not stable, the capture is stopped.
+    /// @retval RESULT_NOT_READY  No capture is running.
+    ///
+    Result AddSample(uint32_t distanceMm);
+
+    /// @brief Gets the captured stop distance
+    ///
+    /// @retval The stop distance in millimeters, UINT32_MAX if no capture completed
+    ///
+    uint32_t GetStopDistance() const;
+
+    /// @brief Gets the thresholds derived from the captured stop distance
+    ///
+    /// @param thresholds         Contains the thresholds if successful
+    ///
+    /// @retval RESULT_OK         The thresholds are available.
+    /// @retval RESULT_NO_DATA    No capture completed.
+    /// @retval RESULT_BAD_PARAM  The far threshold is beyond the range of the sensor.
+    ///
+    Result GetThresholds(Thresholds& thresholds) const;
+
+  private:
+    Config    _config;                ///< The teach-in configuration
+    bool      _initDone;              ///< A flag to indicate whether the teach-in was initialized
+    bool      _active;                ///< A flag to indicate whether a capture is running
+    uint8_t   _samples;               ///< The number of valid readings captured
+    uint8_t   _missedSamples;         ///< The number of missing readings
+    uint32_t  _sumMm;                 ///< The sum of the valid readings
+    uint32_t  _minMm;                 ///< The smallest valid reading
+    uint32_t  _maxMm;                 ///< The largest valid reading
+    uint32_t  _stopDistanceMm;        ///< The captured stop distance, UINT32_MAX if none
+  };
+}
+#endif // _TEACHIN_H_
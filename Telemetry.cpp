@@ -0,0 +1,147 @@
+///
+/// @file Telemetry.cpp
+///
+/// @brief Telemetry class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "Telemetry.h"
+
+namespace CNEGR
+{
+  /// @brief Constructor.
+  Telemetry::Telemetry()
+    :_output(nullptr),
+     _enabled(false),
+     _sequence(0)
+  {
+  }
+
+  /// @brief Destructor.
+  Telemetry::~Telemetry()
+  {
+  }
+
+  /// @brief Initialization function.
+  ///
+  /// @param output             The output where the frames are sent
+  ///
+  /// @retval RESULT_OK         The telemetry was successfully initialized.
+  /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+  ///
+  Result Telemetry::Init(Print *output)
+  {
+    if (output == nullptr)
+      return RESULT_BAD_PARAM;
+
+    _output   = output;
+    _enabled  = false;
+    _sequence = 0;
+
+    return RESULT_OK;
+  }
+
+  /// @brief Enables or disables sending the frames
+  ///
+  /// @param enabled            true to send the frames
+  ///
+  void Telemetry::SetEnabled(bool enabled)
+  {
+    _enabled = enabled && (_output != nullptr);
+  }
+
+  /// @brief Get whether the frames are sent
+  ///
+  /// @return boolean true if the telemetry is enabled
+  ///
+  bool Telemetry::IsEnabled() const
+  {
+    return _enabled;
+  }
+
+  /// @brief Sends a sample message
+  ///
+  /// @param message            The message to send
+  ///
+  /// @retval RESULT_OK         The message was sent.
+  /// @retval RESULT_NOT_READY  The telemetry is not initialized or not enabled.
+  ///
+  Result Telemetry::Send(const TelemetrySample& message)
+  {
+    if (!_enabled)
+      return RESULT_NOT_READY;
+
+    uint8_t payload[TELEMETRY_MAX_PAYLOAD_LENGTH];
+    size_t length = EncodeTelemetryPayload(message, payload);
+
+    return SendFrame(TelemetrySampleMessage, payload, length);
+  }
+
+  /// @brief Sends a transition message
+  ///
+  /// @param message            The message to send
+  ///
+  /// @retval RESULT_OK         The message was sent.
+  /// @retval RESULT_NOT_READY  The telemetry is not initialized or not enabled.
+  ///
+  Result Telemetry::Send(const TelemetryTransition& message)
+  {
+    if (!_enabled)
+      return RESULT_NOT_READY;
+
+    uint8_t payload[TELEMETRY_MAX_PAYLOAD_LENGTH];
+    size_t length = EncodeTelemetryPayload(message, payload);
+
+    return SendFrame(TelemetryTransitionMessage, payload, length);
+  }
+
+  /// @brief Sends a statistics message
+  ///
+  /// @param message            The message to send
+  ///
+  /// @retval RESULT_OK         The message was sent.
+  /// @retval RESULT_NOT_READY  The telemetry is not initialized or not enabled.
+  ///
+  Result Telemetry::Send(const TelemetryStatistics& message)
+  {
+    if (!_enabled)
+      return RESULT_NOT_READY;
+
+    uint8_t payload[TELEMETRY_MAX_PAYLOAD_LENGTH];
+    size_t length = EncodeTelemetryPayload(message, payload);
+
+    return SendFrame(TelemetryStatisticsMessage, payload, length);
+  }
+
+  /// @brief Sends an echo edges message
+  ///
+  /// @param message            The message to send
+  ///
+  /// @retval RESULT_OK         The message was sent.
+  /// @retval RESULT_NOT_READY  The telemetry is not initialized or not enabled.
+  ///
+  Result Telemetry::Send(const TelemetryEchoEdges& message)
+  {
+    if (!_enabled)
+      return RESULT_NOT_READY;
+
+    uint8_t payload[TELEMETRY_MAX_PAYLOAD_LENGTH];
+    size_t length = EncodeTelemetryPayload(message, payload);
+
+    return SendFrame(TelemetryEchoEdgesMessage, payload, length);
+  }
+
+  /// @brief Builds and sends a frame
+  ///
+  Result Telemetry::SendFrame(uint8_t type, const uint8_t *payload, size_t payloadLength)
+  {
+    uint8_t frame[TELEMETRY_MAX_ENCODED_LENGTH];
+    size_t length = BuildTelemetryFrame(type, _sequence++, payload, payloadLength, frame);
+
+    _output->write(frame, length);
+
+    return RESULT_OK;
+  }
+}
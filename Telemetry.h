@@ -0,0 +1,83 @@
+///
+/// @file Telemetry.h
+///
+/// @brief Telemetry class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_TELEMETRY_H_)
+#define _TELEMETRY_H_
+
+#include <Arduino.h>
+#include "Result.h"
+#include "TelemetryProtocol.h"
+
+namespace CNEGR
+{
+  /// @brief Telemetry class definition
+  ///
+  /// Sends the binary telemetry frames described in TelemetryProtocol.h. A sample
+  /// takes 18 bytes on the wire instead of the few hundred bytes of the text logs,
+  /// so every measurement can be sent even at 19200 baud.
+  ///
+  /// The telemetry is disabled after Init(), the frames are sent only after
+  /// SetEnabled(true) is called.
+  ///
+  class Telemetry
+  {
+  public:
+    /// @brief Constructor.
+    Telemetry();
+
+    /// @brief Destructor.
+    ~Telemetry();
+
+  public:
+    /// @brief Initialization function.
+    ///
+    /// @param output             The output where the frames are sent
+    ///
+    /// @retval RESULT_OK         The telemetry was successfully initialized.
+    /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+    ///
+    Result Init(Print *output);
+
+    /// @brief Enables or disables sending the frames
+    ///
+    /// @param enabled            true to send the frames
+    ///
+    void SetEnabled(bool enabled);
+
+    /// @brief Get whether the frames are sent
+    ///
+    /// @return boolean true if the telemetry is enabled
+    ///
+    bool IsEnabled() const;
+
+    /// @brief Sends a message
+    ///
+    /// @param message            The message to send
+    ///
+    /// @retval RESULT_OK         The message was sent.
+    /// @retval RESULT_NOT_READY  The telemetry is not initialized or not enabled.
+    ///
+    Result Send(const TelemetrySample& message);
+    Result Send(const TelemetryTransition& message);
+    Result Send(const TelemetryStatistics& message);
+    Result Send(const TelemetryEchoEdges& message);
+
+  private:
+    /// @brief Builds and sends a frame
+    ///
+    Result SendFrame(uint8_t type, const uint8_t *payload, size_t payloadLength);
+
+  private:
+    Print     *_output;                 ///< The output where the frames are sent
+    bool      _enabled;                 ///< A flag to indicate whether the frames are sent
+    uint8_t   _sequence;                ///< The sequence number of the next frame
+  };
+}
+#endif // _TELEMETRY_H_
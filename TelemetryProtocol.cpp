@@ -0,0 +1,218 @@
+///
+/// @file TelemetryProtocol.cpp
+///
+/// @brief The binary telemetry protocol implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include <string.h>
+#include "TelemetryProtocol.h"
+#include "Crc16.h"
+
+namespace CNEGR
+{
+  const size_t SAMPLE_PAYLOAD_LENGTH      = 11;
+  const size_t TRANSITION_PAYLOAD_LENGTH  = 6;
+  const size_t STATISTICS_PAYLOAD_LENGTH  = 24;
+  const size_t ECHO_EDGES_HEADER_LENGTH   = 4;
+  const size_t ECHO_EDGE_LENGTH           = 4;
+
+  static uint8_t *Put16(uint8_t *p, uint16_t value)
+  {
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    return p + 2;
+  }
+
+  static uint8_t *Put32(uint8_t *p, uint32_t value)
+  {
+    p = Put16(p, (uint16_t)value);
+    return Put16(p, (uint16_t)(value >> 16));
+  }
+
+  static const uint8_t *Get16(const uint8_t *p, uint16_t& value)
+  {
+    value = (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+    return p + 2;
+  }
+
+  static const uint8_t *Get32(const uint8_t *p, uint32_t& value)
+  {
+    uint16_t low  = 0;
+    uint16_t high = 0;
+    p = Get16(p, low);
+    p = Get16(p, high);
+    value = (uint32_t)low | ((uint32_t)high << 16);
+    return p;
+  }
+
+  /// @brief Serializes a sample message payload
+  ///
+  size_t EncodeTelemetryPayload(const TelemetrySample& message, uint8_t *payload)
+  {
+    uint8_t *p = payload;
+    p = Put32(p, message.timeMs);
+    p = Put16(p, message.rawDistanceMm);
+    p = Put16(p, message.trackedDistanceMm);
+    p = Put16(p, (uint16_t)message.velocityMmPerS);
+    *p++ = message.state;
+    return p - payload;
+  }
+
+  /// @brief Serializes a transition message payload
+  ///
+  size_t EncodeTelemetryPayload(const TelemetryTransition& message, uint8_t *payload)
+  {
+    uint8_t *p = payload;
+    p = Put32(p, message.timeMs);
+    *p++ = message.fromState;
+    *p++ = message.toState;
+    return p - payload;
+  }
+
+  /// @brief Serializes a statistics message payload
+  ///
+  size_t EncodeTelemetryPayload(const TelemetryStatistics& message, uint8_t *payload)
+  {
+    uint8_t *p = payload;
+    p = Put32(p, message.timeMs);
+    p = Put32(p, message.updates);
+    p = Put32(p, message.timeouts);
+    p = Put32(p, message.transitions);
+    p = Put32(p, message.outliers);
+    p = Put32(p, message.rejectedTargets);
+    return p - payload;
+  }
+
+  /// @brief Serializes an echo edges message payload
+  ///
+  size_t EncodeTelemetryPayload(const TelemetryEchoEdges& message, uint8_t *payload)
+  {
+    uint8_t count = (message.count < TELEMETRY_MAX_ECHO_EDGES) ? message.count : TELEMETRY_MAX_ECHO_EDGES;
+
+    uint8_t *p = payload;
+    *p++ = message.firstIndex;
+    *p++ = count;
+    *p++ = message.totalCount;
+    *p++ = message.lostCount;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+      *p++ = message.edges[i].ping;
+      *p++ = message.edges[i].level;
+      p = Put16(p, message.edges[i].timeUs);
+    }
+
+    return p - payload;
+  }
+
+  /// @brief Deserializes a sample message payload
+  ///
+  Result DecodeTelemetryPayload(const uint8_t *payload, size_t length, TelemetrySample& message)
+  {
+    if (length != SAMPLE_PAYLOAD_LENGTH)
+      return RESULT_PARSE_ERROR;
+
+    uint16_t velocity = 0;
+    const uint8_t *p = payload;
+    p = Get32(p, message.timeMs);
+    p = Get16(p, message.rawDistanceMm);
+    p = Get16(p, message.trackedDistanceMm);
+    p = Get16(p, velocity);
+    message.velocityMmPerS = (int16_t)velocity;
+    message.state = *p;
+    return RESULT_OK;
+  }
+
+  /// @brief Deserializes a transition message payload
+  ///
+  Result DecodeTelemetryPayload(const uint8_t *payload, size_t length, TelemetryTransition& message)
+  {
+    if (length != TRANSITION_PAYLOAD_LENGTH)
+      return RESULT_PARSE_ERROR;
+
+    const uint8_t *p = payload;
+    p = Get32(p, message.timeMs);
+    message.fromState = p[0];
+    message.toState   = p[1];
+    return RESULT_OK;
+  }
+
+  /// @brief Deserializes a statistics message payload
+  ///
+  Result DecodeTelemetryPayload(const uint8_t *payload, size_t length, TelemetryStatistics& message)
+  {
+    if (length != STATISTICS_PAYLOAD_LENGTH)
+      return RESULT_PARSE_ERROR;
+
+    const uint8_t *p = payload;
+    p = Get32(p, message.timeMs);
+    p = Get32(p, message.updates);
+    p = Get32(p, message.timeouts);
+    p = Get32(p, message.transitions);
+    p = Get32(p, message.outliers);
+    Get32(p, message.rejectedTargets);
+    return RESULT_OK;
+  }
+
+  /// @brief Deserializes an echo edges message payload
+  ///
+  Result DecodeTelemetryPayload(const uint8_t *payload, size_t length, TelemetryEchoEdges& message)
+  {
+    if (length < ECHO_EDGES_HEADER_LENGTH)
+      return RESULT_PARSE_ERROR;
+
+    uint8_t count = payload[1];
+    if ((count > TELEMETRY_MAX_ECHO_EDGES) || (length != ECHO_EDGES_HEADER_LENGTH + count * ECHO_EDGE_LENGTH))
+      return RESULT_PARSE_ERROR;
+
+    const uint8_t *p = payload;
+    message.firstIndex = *p++;
+    message.count      = *p++;
+    message.totalCount = *p++;
+    message.lostCount  = *p++;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+      message.edges[i].ping  = *p++;
+      message.edges[i].level = *p++;
+      p = Get16(p, message.edges[i].timeUs);
+    }
+
+    return RESULT_OK;
+  }
+
+  /// @brief Builds a complete frame ready to be sent
+  ///
+  /// @param type           The message type
+  /// @param sequence       The frame sequence number
+  /// @param payload        The message payload
+  /// @param payloadLength  The payload length, at most TELEMETRY_MAX_PAYLOAD_LENGTH bytes
+  /// @param frame          The buffer receiving the frame, at least TELEMETRY_MAX_ENCODED_LENGTH bytes long
+  ///
+  /// @retval The frame length in bytes, including the delimiters
+  ///
+  size_t BuildTelemetryFrame(uint8_t type, uint8_t sequence, const uint8_t *payload, size_t payloadLength, uint8_t *frame)
+  {
+    uint8_t raw[TELEMETRY_MAX_FRAME_LENGTH];
+
+    if (payloadLength > TELEMETRY_MAX_PAYLOAD_LENGTH)
+      payloadLength = TELEMETRY_MAX_PAYLOAD_LENGTH;
+
+    raw[0] = type;
+    raw[1] = sequence;
+    memcpy(&raw[TELEMETRY_HEADER_LENGTH], payload, payloadLength);
+
+    size_t length = TELEMETRY_HEADER_LENGTH + payloadLength;
+    Put16(&raw[length], Crc16(raw, length));
+    length += TELEMETRY_CRC_LENGTH;
+
+    frame[0] = COBS_DELIMITER;
+    length = CobsEncode(raw, length, &frame[1]) + 1;
+    frame[length++] = COBS_DELIMITER;
+
+    return length;
+  }
+}
@@ -0,0 +1,144 @@
+///
+/// @file TelemetryProtocol.h
+///
+/// @brief The binary telemetry protocol definitions
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+/// Every message is sent as a frame:
+///
+///   0x00 | COBS( type | sequence | payload | CRC-16 ) | 0x00
+///
+/// - type      The message type (TelemetryMessageType), one byte
+/// - sequence  Incremented for every frame sent, one byte, lets the receiver count the lost frames
+/// - payload   The message fields, little endian, see the message structures below
+/// - CRC-16    The CRC-16/CCITT-FALSE of the type, sequence and payload, little endian
+///
+/// The COBS encoding guarantees that the frame doesn't contain any zero byte, so the
+/// receiver can always resynchronize on the next 0x00 delimiter. The leading delimiter
+/// separates the frame from any text sent before it (e.g. console replies), which is
+/// then received as a separate frame that fails the checks and is dropped.
+///
+/// This file and TelemetryProtocol.cpp don't depend on the Arduino framework, the host
+/// tools decode the stream with them and extras/host/TelemetryDecoder.cpp.
+///
+#pragma once
+
+#if !defined(_TELEMETRYPROTOCOL_H_)
+#define _TELEMETRYPROTOCOL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Result.h"
+#include "Cobs.h"
+#include "EchoEdgeRecorder.h"
+
+namespace CNEGR
+{
+  #define TELEMETRY_HEADER_LENGTH         2     ///< The type and sequence bytes
+  #define TELEMETRY_CRC_LENGTH            2     ///< The CRC-16 bytes
+  #define TELEMETRY_MAX_PAYLOAD_LENGTH    32    ///< The maximum payload length of any message
+
+  /// The maximum frame length before the COBS encoding
+  #define TELEMETRY_MAX_FRAME_LENGTH      (TELEMETRY_HEADER_LENGTH + TELEMETRY_MAX_PAYLOAD_LENGTH + TELEMETRY_CRC_LENGTH)
+
+  /// The maximum frame length after the COBS encoding, including the delimiters
+  #define TELEMETRY_MAX_ENCODED_LENGTH    (COBS_MAX_ENCODED_LENGTH(TELEMETRY_MAX_FRAME_LENGTH) + 2)
+
+  /// The distance value sent when the measurement timed out or the target is not tracked
+  #define TELEMETRY_NO_DISTANCE           0xFFFF
+
+  /// The maximum number of echo edges sent in one message
+  #define TELEMETRY_MAX_ECHO_EDGES        7
+
+  enum TelemetryMessageType
+  {
+    TelemetrySampleMessage      = 1,    ///< A TelemetrySample, sent for every measurement
+    TelemetryTransitionMessage  = 2,    ///< A TelemetryTransition, sent for every state change
+    TelemetryStatisticsMessage  = 3,    ///< A TelemetryStatistics, sent periodically
+    TelemetryEchoEdgesMessage   = 4,    ///< A TelemetryEchoEdges, sent on request after an edge capture
+  };
+
+  /// @brief A distance measurement, 11 bytes payload
+  ///
+  struct TelemetrySample
+  {
+    uint32_t  timeMs;                 ///< The measurement time in milliseconds
+    uint16_t  rawDistanceMm;          ///< The measured distance or TELEMETRY_NO_DISTANCE
+    uint16_t  trackedDistanceMm;      ///< The filtered distance or TELEMETRY_NO_DISTANCE
+    int16_t   velocityMmPerS;         ///< The tracked velocity in millimeters per second
+    uint8_t   state;                  ///< The state machine state
+  };
+
+  /// @brief A state machine transition, 6 bytes payload
+  ///
+  struct TelemetryTransition
+  {
+    uint32_t  timeMs;                 ///< The transition time in milliseconds
+    uint8_t   fromState;              ///< The previous state
+    uint8_t   toState;                ///< The new state
+  };
+
+  /// @brief The state machine statistics, 24 bytes payload
+  ///
+  struct TelemetryStatistics
+  {
+    uint32_t  timeMs;                 ///< The time in milliseconds
+    uint32_t  updates;                ///< See StateMachine::Statistics
+    uint32_t  timeouts;               ///< See StateMachine::Statistics
+    uint32_t  transitions;            ///< See StateMachine::Statistics
+    uint32_t  outliers;               ///< See StateMachine::Statistics
+    uint32_t  rejectedTargets;        ///< See StateMachine::Statistics
+  };
+
+  /// @brief A part of a recorded echo edge capture, 4 bytes payload plus 4 bytes per edge
+  ///
+  struct TelemetryEchoEdges
+  {
+    uint8_t   firstIndex;                           ///< The index of the first edge in the capture
+    uint8_t   count;                                ///< The number of edges in this message, at most TELEMETRY_MAX_ECHO_EDGES
+    uint8_t   totalCount;                           ///< The number of edges in the capture
+    uint8_t   lostCount;                            ///< The number of edges that didn't fit in the capture buffer
+    EchoEdge  edges[TELEMETRY_MAX_ECHO_EDGES];      ///< The edges
+  };
+
+  /// @brief Serializes a message payload
+  ///
+  /// @param message  The message
+  /// @param payload  The buffer receiving the payload, at least TELEMETRY_MAX_PAYLOAD_LENGTH bytes long
+  ///
+  /// @retval The payload length in bytes
+  ///
+  size_t EncodeTelemetryPayload(const TelemetrySample& message, uint8_t *payload);
+  size_t EncodeTelemetryPayload(const TelemetryTransition& message, uint8_t *payload);
+  size_t EncodeTelemetryPayload(const TelemetryStatistics& message, uint8_t *payload);
+  size_t EncodeTelemetryPayload(const TelemetryEchoEdges& message, uint8_t *payload);
+
+  /// @brief Deserializes a message payload
+  ///
+  /// @param payload  The payload
+  /// @param length   The payload length in bytes
+  /// @param message  Contains the message if successful
+  ///
+  /// @retval RESULT_OK           The message was successfully decoded.
+  /// @retval RESULT_PARSE_ERROR  The payload length doesn't match the message.
+  ///
+  Result DecodeTelemetryPayload(const uint8_t *payload, size_t length, TelemetrySample& message);
+  Result DecodeTelemetryPayload(const uint8_t *payload, size_t length, TelemetryTransition& message);
+  Result DecodeTelemetryPayload(const uint8_t *payload, size_t length, TelemetryStatistics& message);
+  Result DecodeTelemetryPayload(const uint8_t *payload, size_t length, TelemetryEchoEdges& message);
+
+  /// @brief Builds a complete frame ready to be sent
+  ///
+  /// @param type           The message type
+  /// @param sequence       The frame sequence number
+  /// @param payload        The message payload
+  /// @param payloadLength  The payload length, at most TELEMETRY_MAX_PAYLOAD_LENGTH bytes
+  /// @param frame          The buffer receiving the frame, at least TELEMETRY_MAX_ENCODED_LENGTH bytes long
+  ///
+  /// @retval The frame length in bytes, including the delimiters
+  ///
+  size_t BuildTelemetryFrame(uint8_t type, uint8_t sequence, const uint8_t *payload, size_t payloadLength, uint8_t *frame);
+}
+#endif // _TELEMETRYPROTOCOL_H_
@@ -0,0 +1,288 @@
+///
+/// @file UpdateProfiler.cpp
+///
+/// @brief UpdateProfiler class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "UpdateProfiler.h"
+#include "StateMachine.h"
+#include "DebugUtils.h"
+
+namespace CNEGR
+{
+  volatile uint16_t UpdateProfiler::_timerOverflows = 0;
+
+  /// @brief Constructor.
+  UpdateProfiler::UpdateProfiler()
+    :_paths(nullptr),
+     _pathCount(0),
+     _overflow(false),
+     _measuring(false),
+     _state(0),
+     _startCycles(0),
+     _overheadCycles(0)
+  {
+  }
+
+  /// @brief Destructor.
+  UpdateProfiler::~UpdateProfiler()
+  {
+    Stop();
+  }
+
+  /// @brief Clears the paths and starts counting the cycles of the updates
+  ///
+  /// @retval RESULT_OK         The profiler was started.
+  /// @retval RESULT_BUSY       The profiler is already running.
+  /// @retval RESULT_NO_MEM     The paths table can't be allocated.
+  ///
+  Result UpdateProfiler::Start()
+  {
+    if (IsRunning())
+      return RESULT_BUSY;
+
+    _paths = new Path[UPDATEPROFILER_MAX_PATHS];
+    if (_paths == nullptr)
+      return RESULT_NO_MEM;
+
+    _pathCount = 0;
+    _overflow  = false;
+    _measuring = false;
+
+    EnableCounter(true);
+
+    // The counter is read once at the end of Begin() and once at the start of End()
+    uint32_t startCycles = GetCycles();
+    _overheadCycles      = (uint16_t)(GetCycles() - startCycles);
+
+    return RESULT_OK;
+  }
+
+  /// @brief Stops counting and releases the paths table
+  ///
+  void UpdateProfiler::Stop()
+  {
+    if (!IsRunning())
+      return;
+
+    EnableCounter(false);
+
+    delete[] _paths;
+    _paths     = nullptr;
+    _pathCount = 0;
+    _measuring = false;
+  }
+
+  /// @brief Get whether the profiler is running
+  ///
+  /// @return boolean true if the updates are profiled
+  ///
+  bool UpdateProfiler::IsRunning() const
+  {
+    return (_paths != nullptr);
+  }
+
+  /// @brief Starts counting the cycles of an update, does nothing if the profiler is stopped
+  ///
+  /// @param state              The state before the update
+  ///
+  void UpdateProfiler::Begin(uint8_t state)
+  {
+    if (!IsRunning())
+      return;
+
+    _state       = state;
+    _measuring   = true;
+    _startCycles = GetCycles();
+  }
+
+  /// @brief Records the cycles of the update since Begin(), does nothing if the profiler is stopped
+  ///
+  /// @param nextState          The state after the update
+  /// @param result             The value returned by the update
+  ///
+  void UpdateProfiler::End(uint8_t nextState, Result result)
+  {
+    uint32_t cycles = GetCycles() - _startCycles;
+
+    if (!IsRunning() || !_measuring)
+      return;
+
+    _measuring = false;
+    cycles     = (cycles > _overheadCycles) ? cycles - _overheadCycles : 0;
+
+    uint8_t logLevel = (uint8_t)Logger::GetLogLevel();
+    uint8_t i;
+
+    for (i = 0; i < _pathCount; i++)
+    {
+      const Path& path = _paths[i];
+      if ((path.logLevel == logLevel) && (path.state == _state) && (path.nextState == nextState) && (path.result == (uint8_t)result))
+        break;
+    }
+
+    if (i == _pathCount)
+    {
+      if (_pathCount == UPDATEPROFILER_MAX_PATHS)
+      {
+        _overflow = true;
+        return;
+      }
+
+      Path& path     = _paths[_pathCount++];
+      path.logLevel  = logLevel;
+      path.state     = _state;
+      path.nextState = nextState;
+      path.result    = (uint8_t)result;
+      path.count     = 0;
+      path.maxCycles = 0;
+    }
+
+    Path& path = _paths[i];
+
+    if (path.count < UINT16_MAX)
+      path.count++;
+
+    if (cycles > path.maxCycles)
+      path.maxCycles = cycles;
+  }
+
+  /// @brief Gets the number of recorded paths
+  ///
+  /// @retval The number of distinct paths taken since Start()
+  ///
+  uint8_t UpdateProfiler::GetPathCount() const
+  {
+    return _pathCount;
+  }
+
+  /// @brief Gets a recorded path
+  ///
+  /// @param index              The index of the path, in the order they were first taken
+  /// @param path               Contains the path
+  ///
+  /// @retval RESULT_OK         The path was returned.
+  /// @retval RESULT_BAD_PARAM  The index is beyond the recorded paths.
+  ///
+  Result UpdateProfiler::GetPath(uint8_t index, Path& path) const
+  {
+    if (index >= _pathCount)
+      return RESULT_BAD_PARAM;
+
+    path = _paths[index];
+    return RESULT_OK;
+  }
+
+  /// @brief Prints the paths, one "logLevel state nextState result count maxCycles" line
+  /// per path, followed by the largest count as "maxCycles=value"
+  ///
+  /// @param output             Where the paths are printed
+  ///
+  void UpdateProfiler::Print(::Print& output) const
+  {
+    uint32_t maxCycles = 0;
+
+    for (uint8_t i = 0; i < _pathCount; i++)
+    {
+      const Path& path = _paths[i];
+
+      output.print(path.logLevel);
+      output.print(F(" "));
+      output.print(StateMachine::GetStateName(path.state));
+      output.print(F(" "));
+      output.print(StateMachine::GetStateName(path.nextState));
+      output.print(F(" "));
+      output.print(ResultToStr((Result)path.result));
+      output.print(F(" "));
+      output.print(path.count);
+      output.print(F(" "));
+      output.println(path.maxCycles);
+
+      if (path.maxCycles > maxCycles)
+        maxCycles = path.maxCycles;
+    }
+
+    output.print(F("maxCycles="));
+    output.println(maxCycles);
+
+    if (_overflow)
+      output.println(F("overflow=1"));
+  }
+
+  /// @brief Counts the overflows of Timer1
+  ///
+  /// @note Called from the Timer1 overflow interrupt handler
+  ///
+  void UpdateProfiler::OnTimerOverflow()
+  {
+    _timerOverflows++;
+  }
+
+  /// @brief Gets the current cycle count
+  ///
+  /// @retval The number of cycles, it wraps around
+  ///
+  uint32_t UpdateProfiler::GetCycles()
+  {
+#if defined(__AVR__) && UPDATEPROFILER_USE_TIMER1
+    uint8_t oldSREG = SREG;
+    cli();
+
+    uint16_t count     = TCNT1;
+    uint16_t overflows = _timerOverflows;
+
+    // An overflow not served yet, the count read after it is low
+    if ((TIFR1 & bit(TOV1)) && (count < 0x8000))
+      overflows++;
+
+    SREG = oldSREG;
+    return ((uint32_t)overflows << 16) | count;
+#else
+    return micros() * clockCyclesPerMicrosecond();
+#endif
+  }
+
+  /// @brief Starts or stops the cycle counter
+  ///
+  /// @param enabled            true to start it
+  ///
+  void UpdateProfiler::EnableCounter(bool enabled)
+  {
+#if defined(__AVR__) && UPDATEPROFILER_USE_TIMER1
+    uint8_t oldSREG = SREG;
+    cli();
+
+    if (enabled)
+    {
+      // Normal mode, no prescaler: the counter follows the CPU clock
+      _timerOverflows = 0;
+      TCCR1A = 0;
+      TCCR1B = bit(CS10);
+      TCNT1  = 0;
+      TIFR1  = bit(TOV1);
+      TIMSK1 |= bit(TOIE1);
+    }
+    else
+    {
+      TIMSK1 &= ~bit(TOIE1);
+      TCCR1B = 0;
+    }
+
+    SREG = oldSREG;
+#else
+    // micros() is always running
+    (void)enabled;
+#endif
+  }
+}
+
+#if defined(__AVR__) && UPDATEPROFILER_USE_TIMER1
+// The interrupt handler must be defined outside of the namespace
+ISR(TIMER1_OVF_vect)
+{
+  CNEGR::UpdateProfiler::OnTimerOverflow();
+}
+#endif
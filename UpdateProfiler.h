@@ -0,0 +1,153 @@
+///
+/// @file UpdateProfiler.h
+///
+/// @brief UpdateProfiler class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_UPDATEPROFILER_H_)
+#define _UPDATEPROFILER_H_
+
+#include <Arduino.h>
+#include "Result.h"
+
+namespace CNEGR
+{
+  /// The number of distinct paths that can be recorded, 10 bytes each while the profiler runs
+  #if !defined(UPDATEPROFILER_MAX_PATHS)
+  #define UPDATEPROFILER_MAX_PATHS    16
+  #endif
+
+  /// If 1 the cycles are counted by Timer1 on AVR, running at the CPU clock with its overflow
+  /// interrupt while the profiler runs, which disables the PWM of pins 9 and 10. The Timer1
+  /// overflow vector is taken, another library using it needs 0. If 0, or on another
+  /// architecture, the cycles are derived from micros() and have its resolution.
+  #if !defined(UPDATEPROFILER_USE_TIMER1)
+  #define UPDATEPROFILER_USE_TIMER1   1
+  #endif
+
+  /// @brief UpdateProfiler class definition
+  ///
+  /// Counts the CPU cycles of every StateMachine::Update() call made by the main loop and
+  /// keeps the largest count of every path. A path is the log level, the state the update
+  /// starts from, the state it ends in and the value it returns, so the calls returning
+  /// RESULT_BUSY while the echo travels are kept apart from the ones that complete the
+  /// update. The paths are those the board actually takes: the manoeuvres must be driven
+  /// in front of the sensor at each log level, the host UpdateTimingHarness replays all of
+  /// them on the host.
+  ///
+  /// The cycle count includes the interrupts served during the update. The cost of
+  /// reading the counter is measured when the profiler starts and removed.
+  ///
+  class UpdateProfiler
+  {
+  public:
+    /// @brief The timing of one path
+    ///
+    struct Path
+    {
+      uint8_t   logLevel;                     ///< The log level during the update
+      uint8_t   state;                        ///< The state the update started from, see StateMachine::GetState()
+      uint8_t   nextState;                    ///< The state after the update
+      uint8_t   result;                       ///< The value returned by the update
+      uint16_t  count;                        ///< The number of updates that took this path, saturated
+      uint32_t  maxCycles;                    ///< The largest cycle count of the path
+    };
+
+  public:
+    /// @brief Constructor.
+    UpdateProfiler();
+
+    /// @brief Destructor.
+    ~UpdateProfiler();
+
+  public:
+    /// @brief Clears the paths and starts counting the cycles of the updates
+    ///
+    /// @retval RESULT_OK         The profiler was started.
+    /// @retval RESULT_BUSY       The profiler is already running.
+    /// @retval RESULT_NO_MEM     The paths table can't be allocated.
+    ///
+    Result Start();
+
+    /// @brief Stops counting and releases the paths table
+    ///
+    void Stop();
+
+    /// @brief Get whether the profiler is running
+    ///
+    /// @return boolean true if the updates are profiled
+    ///
+    bool IsRunning() const;
+
+    /// @brief Starts counting the cycles of an update, does nothing if the profiler is stopped
+    ///
+    /// @param state              The state before the update
+    ///
+    void Begin(uint8_t state);
+
+    /// @brief Records the cycles of the update since Begin(), does nothing if the profiler is stopped
+    ///
+    /// @param nextState          The state after the update
+    /// @param result             The value returned by the update
+    ///
+    void End(uint8_t nextState, Result result);
+
+    /// @brief Gets the number of recorded paths
+    ///
+    /// @retval The number of distinct paths taken since Start()
+    ///
+    uint8_t GetPathCount() const;
+
+    /// @brief Gets a recorded path
+    ///
+    /// @param index              The index of the path, in the order they were first taken
+    /// @param path               Contains the path
+    ///
+    /// @retval RESULT_OK         The path was returned.
+    /// @retval RESULT_BAD_PARAM  The index is beyond the recorded paths.
+    ///
+    Result GetPath(uint8_t index, Path& path) const;
+
+    /// @brief Prints the paths, one "logLevel state nextState result count maxCycles" line
+    /// per path, followed by the largest count as "maxCycles=value"
+    ///
+    /// @param output             Where the paths are printed
+    ///
+    void Print(::Print& output) const;
+
+    /// @brief Counts the overflows of Timer1
+    ///
+    /// @note Called from the Timer1 overflow interrupt handler
+    ///
+    static void OnTimerOverflow();
+
+  private:
+    /// @brief Gets the current cycle count
+    ///
+    /// @retval The number of cycles, it wraps around
+    ///
+    static uint32_t GetCycles();
+
+    /// @brief Starts or stops the cycle counter
+    ///
+    /// @param enabled            true to start it
+    ///
+    static void EnableCounter(bool enabled);
+
+  private:
+    Path              *_paths;                ///< The recorded paths, allocated while the profiler runs
+    uint8_t           _pathCount;             ///< The number of recorded paths
+    bool              _overflow;              ///< A flag to indicate that some paths were not recorded
+    bool              _measuring;             ///< A flag to indicate that Begin() was called and End() wasn't
+    uint8_t           _state;                 ///< The state passed to Begin()
+    uint32_t          _startCycles;           ///< The cycle count at Begin()
+    uint16_t          _overheadCycles;        ///< The cycles of a Begin() and End() pair without update
+
+    static volatile uint16_t _timerOverflows; ///< The number of Timer1 overflows, the high word of the count
+  };
+}
+#endif // _UPDATEPROFILER_H_
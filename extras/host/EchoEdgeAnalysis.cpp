@@ -0,0 +1,169 @@
+///
+/// @file EchoEdgeAnalysis.cpp
+///
+/// @brief EchoEdgeCapture class implementation and analysis of the recorded echo edges
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include <string.h>
+#include "EchoEdgeAnalysis.h"
+
+namespace CNEGR
+{
+  /// @brief Constructor.
+  EchoEdgeCapture::EchoEdgeCapture()
+  {
+    Reset();
+  }
+
+  /// @brief Destructor.
+  EchoEdgeCapture::~EchoEdgeCapture()
+  {
+  }
+
+  /// @brief Discards the edges received so far
+  ///
+  void EchoEdgeCapture::Reset()
+  {
+    memset(_edges, 0, sizeof(_edges));
+    _edgeCount  = 0;
+    _totalCount = 0;
+    _lostCount  = 0;
+  }
+
+  /// @brief Adds the edges of a message to the capture
+  ///
+  /// @param message            The decoded message
+  ///
+  /// @retval RESULT_OK         The edges were added.
+  /// @retval RESULT_BAD_PARAM  The edges don't fit in a capture.
+  /// @retval RESULT_NOT_VALID  The message doesn't follow the previous one of the capture.
+  ///
+  Result EchoEdgeCapture::Add(const TelemetryEchoEdges& message)
+  {
+    if ((message.count > TELEMETRY_MAX_ECHO_EDGES) || (message.totalCount > ECHO_EDGE_RECORDER_SIZE) ||
+        (message.firstIndex + message.count > message.totalCount))
+      return RESULT_BAD_PARAM;
+
+    if (message.firstIndex == 0)
+      Reset();
+    else if ((message.firstIndex != _edgeCount) || (message.totalCount != _totalCount))
+      return RESULT_NOT_VALID;
+
+    memcpy(&_edges[_edgeCount], message.edges, message.count * sizeof(EchoEdge));
+    _edgeCount += message.count;
+    _totalCount = message.totalCount;
+    _lostCount  = message.lostCount;
+
+    return RESULT_OK;
+  }
+
+  /// @brief Get whether every edge of the capture was received
+  ///
+  /// @return boolean true if the capture is complete
+  ///
+  bool EchoEdgeCapture::IsComplete() const
+  {
+    return _edgeCount == _totalCount;
+  }
+
+  /// @brief Gets the edges received, in the order in which they were recorded
+  ///
+  const EchoEdge *EchoEdgeCapture::GetEdges() const
+  {
+    return _edges;
+  }
+
+  /// @brief Gets the number of edges received
+  ///
+  uint8_t EchoEdgeCapture::GetEdgeCount() const
+  {
+    return _edgeCount;
+  }
+
+  /// @brief Gets the number of edges that didn't fit in the capture buffer of the board
+  ///
+  uint8_t EchoEdgeCapture::GetLostEdgeCount() const
+  {
+    return _lostCount;
+  }
+
+  /// @brief Gets the number of pings with at least one edge
+  ///
+  /// @retval The index of the last ping with an edge plus one, 0 without edges
+  ///
+  uint8_t EchoEdgeCapture::GetPingCount() const
+  {
+    return (_edgeCount == 0) ? 0 : _edges[_edgeCount - 1].ping + 1;
+  }
+
+  /// @brief Analyzes the echo pulses of a ping
+  ///
+  /// @param edges              The recorded edges, in the order in which they were recorded
+  /// @param count              The number of edges
+  /// @param ping               The ping to analyze
+  /// @param statistics         Contains the pulses of the ping
+  ///
+  /// @retval RESULT_OK         The ping was analyzed.
+  /// @retval RESULT_BAD_PARAM  The edges are missing.
+  /// @retval RESULT_NO_DATA    No edge was recorded for the ping.
+  ///
+  Result AnalyzeEchoEdges(const EchoEdge *edges, uint8_t count, uint8_t ping, EchoPulseStatistics& statistics)
+  {
+    if (edges == nullptr)
+      return RESULT_BAD_PARAM;
+
+    memset(&statistics, 0, sizeof(statistics));
+    statistics.shortestWidthUs = UINT16_MAX;
+
+    bool     active = false;
+    uint16_t riseUs = 0;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+      if (edges[i].ping != ping)
+        continue;
+
+      statistics.edgeCount++;
+
+      if (edges[i].level != 0)
+      {
+        // A second rising edge without falling edge means one was missed, keep the first
+        if (!active)
+        {
+          riseUs = edges[i].timeUs;
+          active = true;
+
+          if (statistics.pulseCount == 0)
+            statistics.firstRiseUs = riseUs;
+        }
+      }
+      else if (active)
+      {
+        // A falling edge before any rising edge belongs to the previous ping
+        uint16_t width = edges[i].timeUs - riseUs;
+
+        if (statistics.pulseCount == 0)
+          statistics.firstWidthUs = width;
+
+        if (width < statistics.shortestWidthUs)
+          statistics.shortestWidthUs = width;
+
+        statistics.pulseCount++;
+        statistics.lastFallUs = edges[i].timeUs;
+        active = false;
+      }
+    }
+
+    if (statistics.edgeCount == 0)
+      return RESULT_NO_DATA;
+
+    if (statistics.pulseCount == 0)
+      statistics.shortestWidthUs = 0;
+
+    statistics.unterminated = active;
+    return RESULT_OK;
+  }
+}
@@ -0,0 +1,109 @@
+///
+/// @file EchoEdgeAnalysis.h
+///
+/// @brief EchoEdgeCapture class definition and analysis of the recorded echo edges
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+/// The board records the echo edges with an EchoEdgeRecorder and sends them as
+/// TelemetryEchoEdges messages, the capture is put back together and analyzed here.
+///
+#pragma once
+
+#if !defined(_ECHOEDGEANALYSIS_H_)
+#define _ECHOEDGEANALYSIS_H_
+
+#include <stdint.h>
+#include "EchoEdgeRecorder.h"
+#include "TelemetryProtocol.h"
+
+namespace CNEGR
+{
+  /// @brief The echo pulses of a ping
+  ///
+  struct EchoPulseStatistics
+  {
+    uint8_t   edgeCount;              ///< The number of edges recorded for the ping
+    uint8_t   pulseCount;             ///< The number of complete pulses, more than one means multipath or crosstalk
+    uint16_t  firstRiseUs;            ///< The time of the first rising edge, 0 if there is none
+    uint16_t  firstWidthUs;           ///< The width of the first pulse, the value used by the measurement
+    uint16_t  lastFallUs;             ///< The time of the last falling edge, 0 if there is none
+    uint16_t  shortestWidthUs;        ///< The width of the shortest pulse, glitches are a few microseconds wide
+    bool      unterminated;           ///< The echo was still active at the end of the capture
+  };
+
+  /// @brief EchoEdgeCapture class definition
+  ///
+  /// Puts a capture back together from the TelemetryEchoEdges messages sent by the
+  /// 'edges' console command. A message with the first index 0 starts a new capture.
+  ///
+  class EchoEdgeCapture
+  {
+  public:
+    /// @brief Constructor.
+    EchoEdgeCapture();
+
+    /// @brief Destructor.
+    ~EchoEdgeCapture();
+
+  public:
+    /// @brief Discards the edges received so far
+    ///
+    void Reset();
+
+    /// @brief Adds the edges of a message to the capture
+    ///
+    /// @param message            The decoded message
+    ///
+    /// @retval RESULT_OK         The edges were added.
+    /// @retval RESULT_BAD_PARAM  The edges don't fit in a capture.
+    /// @retval RESULT_NOT_VALID  The message doesn't follow the previous one of the capture.
+    ///
+    Result Add(const TelemetryEchoEdges& message);
+
+    /// @brief Get whether every edge of the capture was received
+    ///
+    /// @return boolean true if the capture is complete
+    ///
+    bool IsComplete() const;
+
+    /// @brief Gets the edges received, in the order in which they were recorded
+    ///
+    const EchoEdge *GetEdges() const;
+
+    /// @brief Gets the number of edges received
+    ///
+    uint8_t GetEdgeCount() const;
+
+    /// @brief Gets the number of edges that didn't fit in the capture buffer of the board
+    ///
+    uint8_t GetLostEdgeCount() const;
+
+    /// @brief Gets the number of pings with at least one edge
+    ///
+    /// @retval The index of the last ping with an edge plus one, 0 without edges
+    ///
+    uint8_t GetPingCount() const;
+
+  private:
+    EchoEdge  _edges[ECHO_EDGE_RECORDER_SIZE];  ///< The edges received
+    uint8_t   _edgeCount;                       ///< The number of edges received
+    uint8_t   _totalCount;                      ///< The number of edges in the capture
+    uint8_t   _lostCount;                       ///< The number of edges lost by the board
+  };
+
+  /// @brief Analyzes the echo pulses of a ping
+  ///
+  /// @param edges              The recorded edges, in the order in which they were recorded
+  /// @param count              The number of edges
+  /// @param ping               The ping to analyze
+  /// @param statistics         Contains the pulses of the ping
+  ///
+  /// @retval RESULT_OK         The ping was analyzed.
+  /// @retval RESULT_BAD_PARAM  The edges are missing.
+  /// @retval RESULT_NO_DATA    No edge was recorded for the ping.
+  ///
+  Result AnalyzeEchoEdges(const EchoEdge *edges, uint8_t count, uint8_t ping, EchoPulseStatistics& statistics);
+}
+#endif // _ECHOEDGEANALYSIS_H_
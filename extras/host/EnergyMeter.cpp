@@ -0,0 +1,150 @@
+///
+/// @file EnergyMeter.cpp
+///
+/// @brief EnergyMeter class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "EnergyMeter.h"
+
+namespace CNEGR
+{
+  /// @brief Constructor.
+  EnergyMeter::EnergyMeter()
+    :_initDone(false)
+  {
+    memset(&_model, 0, sizeof(_model));
+    memset(&_totals, 0, sizeof(_totals));
+  }
+
+  /// @brief Destructor.
+  EnergyMeter::~EnergyMeter()
+  {
+    Deinit();
+  }
+
+  /// @brief Initialization function.
+  ///
+  /// @param model              The currents of the components.
+  ///
+  /// @retval RESULT_OK         The meter was successfully initialized.
+  /// @retval RESULT_BUSY       The meter was already initialized.
+  ///                           Deinit() must be called before calling Init() again.
+  ///
+  Result EnergyMeter::Init(const Model& model)
+  {
+    if (IsInitialized())
+      return RESULT_BUSY;
+
+    _model = model;
+    memset(&_totals, 0, sizeof(_totals));
+
+    _initDone = true;
+    return RESULT_OK;
+  }
+
+  /// @brief Get whether the meter was initialized
+  ///
+  /// @return boolean true if it is initialized
+  ///
+  bool EnergyMeter::IsInitialized() const
+  {
+    return _initDone;
+  }
+
+  /// @brief Deinitialization function.
+  ///
+  void EnergyMeter::Deinit()
+  {
+    _initDone = false;
+  }
+
+  /// @brief Accounts a time interval
+  ///
+  /// @param elapsedUs          The duration of the interval in microseconds
+  /// @param mcuActiveUs        The part of the interval during which the MCU was running
+  /// @param lightsOn           The number of lights that were on during the interval
+  ///
+  void EnergyMeter::AddInterval(uint32_t elapsedUs, uint32_t mcuActiveUs, uint8_t lightsOn)
+  {
+    if (!IsInitialized())
+      return;
+
+    _totals.elapsedUs   += elapsedUs;
+    _totals.mcuActiveUs += (mcuActiveUs < elapsedUs) ? mcuActiveUs : elapsedUs;
+    _totals.lightOnUs   += (uint64_t)elapsedUs * lightsOn;
+  }
+
+  /// @brief Accounts a ping
+  ///
+  /// @param echoTimeUs         The time until the echo came back, 0 if there was no echo
+  ///
+  void EnergyMeter::AddPing(uint32_t echoTimeUs)
+  {
+    if (!IsInitialized())
+      return;
+
+    // Without echo the sensor keeps listening until its own timeout,
+    // even if the application stopped waiting before
+    _totals.sensorPingUs += (echoTimeUs != 0) ? echoTimeUs : _model.sensorTimeoutUs;
+    _totals.pings++;
+  }
+
+  /// @brief Accounts the times accumulated by another meter
+  ///
+  /// @param totals             The accumulated times to add
+  ///
+  void EnergyMeter::AddTotals(const Totals& totals)
+  {
+    if (!IsInitialized())
+      return;
+
+    _totals.elapsedUs    += totals.elapsedUs;
+    _totals.mcuActiveUs  += totals.mcuActiveUs;
+    _totals.sensorPingUs += totals.sensorPingUs;
+    _totals.lightOnUs    += totals.lightOnUs;
+    _totals.pings        += totals.pings;
+  }
+
+  /// @brief Gets the accumulated times
+  ///
+  /// @param totals             Contains the accumulated times
+  ///
+  void EnergyMeter::GetTotals(Totals& totals) const
+  {
+    totals = _totals;
+  }
+
+  /// @brief Gets the average current over the accounted time
+  ///
+  /// @retval The average current in microamperes, 0 if no time was accounted
+  ///
+  uint32_t EnergyMeter::GetAverageCurrent() const
+  {
+    if (_totals.elapsedUs == 0)
+      return 0;
+
+    // The charge in microampere-microseconds, the sensor idle current is
+    // replaced by the ping current while it pings
+    uint64_t sensorPingUs = (_totals.sensorPingUs < _totals.elapsedUs) ? _totals.sensorPingUs : _totals.elapsedUs;
+
+    uint64_t charge = _totals.mcuActiveUs * _model.mcuActiveUa +
+                      (_totals.elapsedUs - _totals.mcuActiveUs) * _model.mcuSleepUa +
+                      sensorPingUs * _model.sensorPingUa +
+                      (_totals.elapsedUs - sensorPingUs) * _model.sensorIdleUa +
+                      _totals.lightOnUs * _model.lightUa;
+
+    return (uint32_t)(charge / _totals.elapsedUs);
+  }
+
+  /// @brief Gets the charge drawn per day at the average current
+  ///
+  /// @retval The charge in microampere-hours per day
+  ///
+  uint32_t EnergyMeter::GetDailyCharge() const
+  {
+    return GetAverageCurrent() * 24;
+  }
+}
@@ -0,0 +1,128 @@
+///
+/// @file EnergyMeter.h
+///
+/// @brief EnergyMeter class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_ENERGYMETER_H_)
+#define _ENERGYMETER_H_
+
+#include <Arduino.h>
+#include "Result.h"
+
+namespace CNEGR
+{
+  /// @brief EnergyMeter class definition
+  ///
+  /// Estimates the charge drawn by the board from the time its components spend in each
+  /// of their states, without any measurement: the MCU is either active or asleep, the
+  /// sensor is idle except during the pings and every light draws its current while it
+  /// is on. The currents come from the datasheets or from a bench measurement, so that
+  /// two power strategies can be compared by simulating them.
+  ///
+  /// The meter only accumulates times, the charge is computed when it is read so the
+  /// currents of a model can be changed without running the simulation again.
+  ///
+  class EnergyMeter
+  {
+  public:
+    /// @brief The currents drawn by the components
+    ///
+    struct Model
+    {
+      uint32_t  mcuActiveUa;                  ///< The MCU current while it runs, in microamperes
+      uint32_t  mcuSleepUa;                   ///< The MCU current while it sleeps, in microamperes
+      uint32_t  sensorIdleUa;                 ///< The sensor current between the pings, in microamperes
+      uint32_t  sensorPingUa;                 ///< The sensor current during a ping, in microamperes
+      uint32_t  sensorTimeoutUs;              ///< How long the sensor stays active when there is no echo
+      uint32_t  lightUa;                      ///< The current of one light while it is on, in microamperes
+    };
+
+    /// @brief The accumulated times
+    ///
+    struct Totals
+    {
+      uint64_t  elapsedUs;                    ///< The accounted time
+      uint64_t  mcuActiveUs;                  ///< The time the MCU was running, it slept the rest of the time
+      uint64_t  sensorPingUs;                 ///< The time the sensor was pinging
+      uint64_t  lightOnUs;                    ///< The time the lights were on, summed over the lights
+      uint32_t  pings;                        ///< The number of pings
+    };
+
+  public:
+    /// @brief Constructor.
+    EnergyMeter();
+
+    /// @brief Destructor.
+    ~EnergyMeter();
+
+  public:
+    /// @brief Initialization function.
+    ///
+    /// @param model              The currents of the components.
+    ///
+    /// @retval RESULT_OK         The meter was successfully initialized.
+    /// @retval RESULT_BUSY       The meter was already initialized.
+    ///                           Deinit() must be called before calling Init() again.
+    ///
+    Result Init(const Model& model);
+
+    /// @brief Get whether the meter was initialized
+    ///
+    /// @return boolean true if it is initialized
+    ///
+    bool IsInitialized() const;
+
+    /// @brief Deinitialization function.
+    ///
+    void Deinit();
+
+    /// @brief Accounts a time interval
+    ///
+    /// @param elapsedUs          The duration of the interval in microseconds
+    /// @param mcuActiveUs        The part of the interval during which the MCU was running
+    /// @param lightsOn           The number of lights that were on during the interval
+    ///
+    void AddInterval(uint32_t elapsedUs, uint32_t mcuActiveUs, uint8_t lightsOn);
+
+    /// @brief Accounts a ping
+    ///
+    /// @param echoTimeUs         The time until the echo came back, 0 if there was no echo
+    ///
+    void AddPing(uint32_t echoTimeUs);
+
+    /// @brief Accounts the times accumulated by another meter
+    ///
+    /// @param totals             The accumulated times to add
+    ///
+    void AddTotals(const Totals& totals);
+
+    /// @brief Gets the accumulated times
+    ///
+    /// @param totals             Contains the accumulated times
+    ///
+    void GetTotals(Totals& totals) const;
+
+    /// @brief Gets the average current over the accounted time
+    ///
+    /// @retval The average current in microamperes, 0 if no time was accounted
+    ///
+    uint32_t GetAverageCurrent() const;
+
+    /// @brief Gets the charge drawn per day at the average current
+    ///
+    /// @retval The charge in microampere-hours per day
+    ///
+    uint32_t GetDailyCharge() const;
+
+  private:
+    bool      _initDone;                      ///< A flag to indicate whether the meter was initialized
+    Model     _model;                         ///< The currents of the components
+    Totals    _totals;                        ///< The accumulated times
+  };
+}
+#endif // _ENERGYMETER_H_
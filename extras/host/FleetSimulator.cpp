@@ -0,0 +1,455 @@
+///
+/// @file FleetSimulator.cpp
+///
+/// @brief FleetSimulator class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "FleetSimulator.h"
+#include "DebugUtils.h"
+#include "SpeedOfSound.h"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace CNEGR
+{
+  bool                  FleetSimulator::_active = false;
+  thread_local uint32_t FleetSimulator::_time   = 0;
+
+  /// @brief Constructor.
+  FleetSimulator::Bay::Bay()
+    :trafficLight(&FleetSimulator::GetTime),
+     phase(SimulatedDistanceSensor::Empty),
+     arrived(false),
+     redShown(false)
+  {
+  }
+
+  /// @brief Constructor.
+  FleetSimulator::FleetSimulator()
+    :_bays(nullptr),
+     _shards(nullptr),
+     _shardCount(0),
+     _nextShard(0),
+     _speedOfSound(0)
+  {
+    memset(&_config, 0, sizeof(_config));
+  }
+
+  /// @brief Destructor.
+  FleetSimulator::~FleetSimulator()
+  {
+    Deinit();
+  }
+
+  /// @brief Initialization function.
+  ///
+  /// @note Only one simulator can be initialized at a time since the bays use the
+  /// simulated clocks of the worker threads.
+  ///
+  /// @param configuration      The configuration data.
+  ///
+  /// @retval RESULT_OK         The simulator was successfully initialized.
+  /// @retval RESULT_BUSY       A simulator is already initialized.
+  /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+  /// @retval RESULT_NO_MEM     The bays don't fit in the memory.
+  ///
+  Result FleetSimulator::Init(const Config& configuration)
+  {
+    if (_active)
+      return RESULT_BUSY;
+
+    if ((configuration.bayCount == 0) || (configuration.periodMs == 0) || (configuration.durationMs == 0))
+      return RESULT_BAD_PARAM;
+
+    // The StateMachine asserts on an invalid configuration, check it first
+    HampelFilter outlierFilter;
+    TargetClassifier classifier;
+    AlphaBetaTracker tracker;
+
+    if ((outlierFilter.Init(configuration.stateMachine.outlierFilter) != RESULT_OK) ||
+        (classifier.Init(configuration.stateMachine.classifier) != RESULT_OK) ||
+        (tracker.Init(configuration.stateMachine.tracker) != RESULT_OK))
+    {
+      return RESULT_BAD_PARAM;
+    }
+
+    // The bays are created at the time 0 of the calling thread, like the shards start
+    _time = 0;
+
+    _bays = new Bay[configuration.bayCount];
+    if (_bays == nullptr)
+      return RESULT_NO_MEM;
+
+    _shardCount = (configuration.bayCount + FLEETSIMULATOR_SHARD_BAYS - 1) / FLEETSIMULATOR_SHARD_BAYS;
+    _shards     = new Shard[_shardCount];
+    if (_shards == nullptr)
+    {
+      delete[] _bays;
+      _bays = nullptr;
+      return RESULT_NO_MEM;
+    }
+
+    _config = configuration;
+    _active = true;
+
+    for (uint16_t i = 0; i < _shardCount; i++)
+    {
+      Shard& shard = _shards[i];
+      shard.firstBay = i * FLEETSIMULATOR_SHARD_BAYS;
+      shard.bayCount = ((_config.bayCount - shard.firstBay) < FLEETSIMULATOR_SHARD_BAYS) ?
+                          (_config.bayCount - shard.firstBay) : FLEETSIMULATOR_SHARD_BAYS;
+      shard.time     = 0;
+      memset(&shard.results, 0, sizeof(shard.results));
+      shard.energyMeter.Init(_config.energy);
+    }
+
+    _speedOfSound = GetSpeedOfSound(20 * 10, DEFAULT_RELATIVE_HUMIDITY);
+
+    // The state machines log every update, keep only the errors while they are created
+    Logger::Level logLevel = Logger::GetLogLevel();
+    Logger::SetLogLevel(Logger::Level::ERROR);
+
+    Result result = RESULT_OK;
+
+    for (uint16_t i = 0; (i < _config.bayCount) && (result == RESULT_OK); i++)
+    {
+      Bay& bay = _bays[i];
+
+      IDistanceSensor::Config sensorConfig;
+      sensorConfig.name       = "sim";
+      sensorConfig.triggerPin = 0;
+      sensorConfig.echoPin    = 0;
+
+      ITrafficLight::Config trafficLightConfig;
+      trafficLightConfig.name           = "sim";
+      trafficLightConfig.redLightPin    = 0;
+      trafficLightConfig.yellowLightPin = 0;
+      trafficLightConfig.greenLightPin  = 0;
+      trafficLightConfig.pinsPolarity   = SignalPolarity::ActiveHigh;
+
+      // Every bay gets its own phase and noise
+      result = bay.sensor.SetScenario(&_config.scenario, &FleetSimulator::GetTime, _config.seed + i);
+
+      if (result == RESULT_OK)
+        result = bay.sensor.Init(sensorConfig);
+
+      if (result == RESULT_OK)
+        result = bay.trafficLight.Init(trafficLightConfig);
+
+      if (result == RESULT_OK)
+      {
+        StateMachine::Config stateMachineConfig = _config.stateMachine;
+        stateMachineConfig.distanceSensor = &bay.sensor;
+        stateMachineConfig.trafficLight   = &bay.trafficLight;
+        stateMachineConfig.clock          = &FleetSimulator::GetTime;
+
+        bay.stateMachine.Init(stateMachineConfig);
+
+        uint32_t distance = 0;
+        bay.phase = bay.sensor.GetPhase(distance);
+      }
+    }
+
+    Logger::SetLogLevel(logLevel);
+
+    if (result != RESULT_OK)
+      Deinit();
+
+    return result;
+  }
+
+  /// @brief Get whether the simulator was initialized
+  ///
+  /// @return boolean true if it is initialized
+  ///
+  bool FleetSimulator::IsInitialized() const
+  {
+    return (_bays != nullptr);
+  }
+
+  /// @brief Deinitialization function, releases the bays.
+  ///
+  void FleetSimulator::Deinit()
+  {
+    if (_bays == nullptr)
+      return;
+
+    delete[] _shards;
+    _shards     = nullptr;
+    _shardCount = 0;
+
+    delete[] _bays;
+    _bays   = nullptr;
+    _active = false;
+  }
+
+  /// @brief Runs the simulation for the configured duration
+  ///
+  /// @param results            Contains the aggregated results
+  ///
+  /// @retval RESULT_OK         The simulation completed.
+  /// @retval RESULT_NOT_READY  The simulator was not initialized.
+  ///
+  Result FleetSimulator::Run(Results& results)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    uint16_t threadCount = _config.threadCount;
+    if (threadCount == 0)
+      threadCount = (uint16_t)std::thread::hardware_concurrency();
+    if (threadCount == 0)
+      threadCount = 1;
+    if (threadCount > _shardCount)
+      threadCount = _shardCount;
+
+    Logger::Level logLevel = Logger::GetLogLevel();
+    Logger::SetLogLevel(Logger::Level::OFF);
+
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    // The calling thread is one of the workers
+    _nextShard = 0;
+    std::vector<std::thread> workers;
+    for (uint16_t i = 1; i < threadCount; i++)
+      workers.emplace_back(&FleetSimulator::RunShards, this);
+
+    RunShards();
+
+    for (size_t i = 0; i < workers.size(); i++)
+      workers[i].join();
+
+    uint64_t elapsedUs = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+
+    Logger::SetLogLevel(logLevel);
+
+    memset(&results, 0, sizeof(results));
+    results.bayCount        = _config.bayCount;
+    results.bytesPerBay     = sizeof(Bay);
+    results.threadCount     = threadCount;
+    results.simulatedTimeMs = _shards[0].results.simulatedTimeMs;
+    results.elapsedUs       = (elapsedUs < UINT32_MAX) ? (uint32_t)elapsedUs : UINT32_MAX;
+
+    EnergyMeter energyMeter;
+    energyMeter.Init(_config.energy);
+
+    for (uint16_t i = 0; i < _shardCount; i++)
+    {
+      const Results& shardResults = _shards[i].results;
+      results.arrivals             += shardResults.arrivals;
+      results.redShown             += shardResults.redShown;
+      results.emptyBayLightUpdates += shardResults.emptyBayLightUpdates;
+
+      EnergyMeter::Totals shardTotals;
+      _shards[i].energyMeter.GetTotals(shardTotals);
+      energyMeter.AddTotals(shardTotals);
+    }
+
+    for (uint16_t i = 0; i < _config.bayCount; i++)
+    {
+      StateMachine::Statistics statistics;
+      _bays[i].stateMachine.GetStatistics(statistics);
+
+      results.updates         += statistics.updates;
+      results.timeouts        += statistics.timeouts;
+      results.transitions     += statistics.transitions;
+      results.outliers        += statistics.outliers;
+      results.rejectedTargets += statistics.rejectedTargets;
+    }
+
+    EnergyMeter::Totals totals;
+    energyMeter.GetTotals(totals);
+
+    if (totals.elapsedUs != 0)
+    {
+      results.mcuActivePermille = (uint32_t)(totals.mcuActiveUs * 1000 / totals.elapsedUs);
+      results.lightOnPermille   = (uint32_t)(totals.lightOnUs * 1000 / totals.elapsedUs);
+    }
+
+    results.averageCurrentUa = energyMeter.GetAverageCurrent();
+    results.dailyChargeUah   = energyMeter.GetDailyCharge();
+
+    return RESULT_OK;
+  }
+
+  /// @brief Prints the results, one "name=value" line per value
+  ///
+  /// @param output             Where the results are printed
+  /// @param results            The results to print
+  ///
+  void FleetSimulator::PrintResults(Print& output, const Results& results)
+  {
+    output.print(F("bays="));                 output.println(results.bayCount);
+    output.print(F("bytesPerBay="));          output.println(results.bytesPerBay);
+    output.print(F("threads="));              output.println(results.threadCount);
+    output.print(F("simulatedMs="));          output.println(results.simulatedTimeMs);
+    output.print(F("elapsedUs="));            output.println(results.elapsedUs);
+    output.print(F("updates="));              output.println(results.updates);
+    output.print(F("timeouts="));             output.println(results.timeouts);
+    output.print(F("transitions="));          output.println(results.transitions);
+    output.print(F("outliers="));             output.println(results.outliers);
+    output.print(F("rejectedTargets="));      output.println(results.rejectedTargets);
+    output.print(F("arrivals="));             output.println(results.arrivals);
+    output.print(F("redShown="));             output.println(results.redShown);
+    output.print(F("emptyBayLights="));       output.println(results.emptyBayLightUpdates);
+    output.print(F("mcuActivePermille="));    output.println(results.mcuActivePermille);
+    output.print(F("lightOnPermille="));      output.println(results.lightOnPermille);
+    output.print(F("averageCurrentUa="));     output.println(results.averageCurrentUa);
+
+    // mAh with three decimals
+    output.print(F("mAhPerDay="));            output.print(results.dailyChargeUah / 1000);
+    output.print(F("."));
+    uint32_t fraction = results.dailyChargeUah % 1000;
+    if (fraction < 100)
+      output.print(F("0"));
+    if (fraction < 10)
+      output.print(F("0"));
+    output.println(fraction);
+
+    if (results.elapsedUs != 0)
+    {
+      output.print(F("updatesPerS="));
+      output.println((uint32_t)((uint64_t)results.updates * 1000000UL / results.elapsedUs));
+    }
+  }
+
+  /// @brief Gets the simulated time of the calling thread
+  ///
+  /// @retval The simulated time in milliseconds
+  ///
+  uint32_t FleetSimulator::GetTime()
+  {
+    return _time;
+  }
+
+  /// @brief Runs the shards until there are none left
+  ///
+  /// @note Runs in every worker thread
+  ///
+  void FleetSimulator::RunShards()
+  {
+    for (;;)
+    {
+      uint16_t index = _nextShard++;
+      if (index >= _shardCount)
+        return;
+
+      RunShard(_shards[index]);
+    }
+  }
+
+  /// @brief Runs the bays of a shard for the configured duration
+  ///
+  /// @param shard              The shard to run
+  ///
+  void FleetSimulator::RunShard(Shard& shard)
+  {
+    // The clock of the thread follows the shard, which continues from its previous run
+    _time = shard.time;
+    memset(&shard.results, 0, sizeof(shard.results));
+
+    Bay *bays = &_bays[shard.firstBay];
+
+    for (uint32_t elapsed = 0; elapsed < _config.durationMs; elapsed += _config.periodMs)
+    {
+      for (uint16_t i = 0; i < shard.bayCount; i++)
+      {
+        // A busy update is resumed on the next period, like a slow measurement
+        bool pinged = (bays[i].stateMachine.Update() == RESULT_OK);
+        if (pinged)
+          CheckLights(bays[i], shard.results);
+
+        AccountEnergy(bays[i], pinged, shard.energyMeter);
+      }
+
+      _time += _config.periodMs;
+      shard.results.simulatedTimeMs += _config.periodMs;
+    }
+
+    shard.time = _time;
+  }
+
+  /// @brief Checks the lights of a bay against its parking cycle phase
+  ///
+  /// @param bay                The bay to check
+  /// @param results            The results to update
+  ///
+  void FleetSimulator::CheckLights(Bay& bay, Results& results)
+  {
+    ITrafficLight::LightState red    = ITrafficLight::Off;
+    ITrafficLight::LightState yellow = ITrafficLight::Off;
+    ITrafficLight::LightState green  = ITrafficLight::Off;
+
+    bay.trafficLight.GetState(ITrafficLight::RedLight, red);
+    bay.trafficLight.GetState(ITrafficLight::YellowLight, yellow);
+    bay.trafficLight.GetState(ITrafficLight::GreenLight, green);
+
+    uint32_t distance = 0;
+    SimulatedDistanceSensor::Phase phase = bay.sensor.GetPhase(distance);
+
+    if ((phase == SimulatedDistanceSensor::Empty) &&
+        ((red == ITrafficLight::On) || (yellow == ITrafficLight::On) || (green == ITrafficLight::On)))
+    {
+      results.emptyBayLightUpdates++;
+    }
+
+    if ((phase == SimulatedDistanceSensor::Arriving) && (bay.phase != SimulatedDistanceSensor::Arriving))
+    {
+      // A new car, only the cars seen from the start of the approach are counted
+      bay.arrived  = true;
+      bay.redShown = false;
+    }
+
+    if (red == ITrafficLight::On)
+      bay.redShown = true;
+
+    if ((phase == SimulatedDistanceSensor::Leaving) && (bay.phase != SimulatedDistanceSensor::Leaving) && bay.arrived)
+    {
+      results.arrivals++;
+      if (bay.redShown)
+        results.redShown++;
+
+      bay.arrived = false;
+    }
+
+    bay.phase = phase;
+  }
+
+  /// @brief Accounts the energy used by a bay during one period
+  ///
+  /// @param bay                The bay to account
+  /// @param pinged             True if the bay measured the distance during the period
+  /// @param energyMeter        The meter of the shard
+  ///
+  void FleetSimulator::AccountEnergy(Bay& bay, bool pinged, EnergyMeter& energyMeter)
+  {
+    if (pinged)
+    {
+      // The echo of the simulated car, the noise and the dropouts don't change the ping duration
+      uint32_t distance = 0;
+      bool echo = (bay.sensor.GetPhase(distance) != SimulatedDistanceSensor::Empty);
+
+      energyMeter.AddPing(echo ? DistanceToEchoTime(_speedOfSound, distance) : 0);
+    }
+
+    uint8_t lightsOn = 0;
+    const ITrafficLight::LightSelector lights[] = { ITrafficLight::RedLight, ITrafficLight::YellowLight, ITrafficLight::GreenLight };
+    for (uint8_t i = 0; i < sizeof(lights) / sizeof(lights[0]); i++)
+    {
+      ITrafficLight::LightState state = ITrafficLight::Off;
+      bay.trafficLight.GetState(lights[i], state);
+      if (state == ITrafficLight::On)
+        lightsOn++;
+    }
+
+    // The main loop either spins until the next update or sleeps
+    uint32_t periodUs    = _config.periodMs * 1000;
+    uint32_t mcuActiveUs = _config.sleepWhenIdle ? _config.updateActiveTimeUs : periodUs;
+
+    energyMeter.AddInterval(periodUs, mcuActiveUs, lightsOn);
+  }
+}
@@ -0,0 +1,211 @@
+///
+/// @file FleetSimulator.h
+///
+/// @brief FleetSimulator class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_FLEETSIMULATOR_H_)
+#define _FLEETSIMULATOR_H_
+
+#include <Arduino.h>
+#include <atomic>
+#include "Result.h"
+#include "StateMachine.h"
+#include "SimulatedDistanceSensor.h"
+#include "MockTrafficLight.h"
+#include "EnergyMeter.h"
+
+namespace CNEGR
+{
+  #define FLEETSIMULATOR_SHARD_BAYS   64    ///< The number of bays in a shard, small enough to stay in the cache
+
+  /// @brief FleetSimulator class definition
+  ///
+  /// Runs the unmodified StateMachine for many parking bays at once, every bay having its
+  /// own SimulatedDistanceSensor, MockTrafficLight and StateMachine. The bays follow a
+  /// simulated clock which the simulator advances by the measurement period after updating
+  /// them, so an hour of parking is simulated in a fraction of a second and the results
+  /// don't depend on the speed of the machine running the simulation.
+  ///
+  /// The bays are split in shards of FLEETSIMULATOR_SHARD_BAYS consecutive bays. A pool of
+  /// worker threads, one per core unless configured otherwise, takes the shards one after
+  /// the other and runs each of them for the whole duration with its own clock, results
+  /// and EnergyMeter, so the workers share nothing while they run. The results are added
+  /// up once all the shards are done. They don't depend on the number of threads.
+  ///
+  /// The simulator checks that every car saw the red light before stopping and that the
+  /// lights stay off while the bays are empty. Every update is also accounted by an
+  /// EnergyMeter: one ping per measurement, with the echo time of the simulated car, the
+  /// lights that are on and the MCU time, so that the results include the average current
+  /// and the daily charge of one bay.
+  ///
+  /// @note The StateMachine logs through the Logger and publishes its events with the
+  /// application Publish() functions, which are shared by all the instances. The logs are
+  /// turned off while the simulation runs and Publish() must be thread safe.
+  ///
+  class FleetSimulator
+  {
+  public:
+    struct Config
+    {
+      uint16_t                          bayCount;           ///< The number of simulated bays
+      uint32_t                          durationMs;         ///< The simulated time
+      uint32_t                          periodMs;           ///< The simulated time between two updates of a bay
+      uint32_t                          seed;               ///< The seed of the bays phase and noise
+      uint16_t                          threadCount;        ///< The number of worker threads, 0 for one per core
+      SimulatedDistanceSensor::Scenario scenario;           ///< The parking cycle replayed by all the bays
+      StateMachine::Config              stateMachine;       ///< The thresholds and filters configuration, the
+                                                            ///< distance sensor, traffic light and clock are
+                                                            ///< set by the simulator
+      EnergyMeter::Model                energy;             ///< The currents of the components
+      uint32_t                          updateActiveTimeUs; ///< The MCU time needed by an update, without the echo wait
+      bool                              sleepWhenIdle;      ///< If true the MCU sleeps between the updates and while the
+                                                            ///< echo travels, otherwise the main loop keeps running
+    };
+
+    struct Results
+    {
+      uint16_t  bayCount;                     ///< The number of simulated bays
+      uint16_t  bytesPerBay;                  ///< The memory used by one bay
+      uint16_t  threadCount;                  ///< The number of worker threads that ran the shards
+      uint32_t  simulatedTimeMs;              ///< The simulated time
+      uint32_t  elapsedUs;                    ///< The time it took to run the simulation
+      uint32_t  updates;                      ///< The total number of completed StateMachine updates
+      uint32_t  timeouts;                     ///< The total number of measurements that timed out
+      uint32_t  transitions;                  ///< The total number of state changes
+      uint32_t  outliers;                     ///< The total number of readings rejected as outliers
+      uint32_t  rejectedTargets;              ///< The total number of targets rejected as transient
+      uint32_t  arrivals;                     ///< The number of cars that parked
+      uint32_t  redShown;                     ///< The number of cars that saw the red light before leaving
+      uint32_t  emptyBayLightUpdates;         ///< The number of updates with a light on while the bay was empty
+      uint32_t  mcuActivePermille;            ///< The part of the time the MCU was running, in permille
+      uint32_t  lightOnPermille;              ///< The part of the time a light was on, in permille
+      uint32_t  averageCurrentUa;             ///< The average current of one bay in microamperes
+      uint32_t  dailyChargeUah;               ///< The charge drawn by one bay per day in microampere-hours
+    };
+
+  public:
+    /// @brief Constructor.
+    FleetSimulator();
+
+    /// @brief Destructor.
+    ~FleetSimulator();
+
+  public:
+    /// @brief Initialization function.
+    ///
+    /// @note Only one simulator can be initialized at a time since the bays use the
+    /// simulated clocks of the worker threads.
+    ///
+    /// @param configuration      The configuration data.
+    ///
+    /// @retval RESULT_OK         The simulator was successfully initialized.
+    /// @retval RESULT_BUSY       A simulator is already initialized.
+    /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+    /// @retval RESULT_NO_MEM     The bays don't fit in the memory.
+    ///
+    Result Init(const Config& configuration);
+
+    /// @brief Get whether the simulator was initialized
+    ///
+    /// @return boolean true if it is initialized
+    ///
+    bool IsInitialized() const;
+
+    /// @brief Deinitialization function, releases the bays.
+    ///
+    void Deinit();
+
+    /// @brief Runs the simulation for the configured duration
+    ///
+    /// @param results            Contains the aggregated results
+    ///
+    /// @retval RESULT_OK         The simulation completed.
+    /// @retval RESULT_NOT_READY  The simulator was not initialized.
+    ///
+    Result Run(Results& results);
+
+    /// @brief Prints the results, one "name=value" line per value
+    ///
+    /// @param output             Where the results are printed
+    /// @param results            The results to print
+    ///
+    static void PrintResults(Print& output, const Results& results);
+
+    /// @brief Gets the simulated time of the calling thread
+    ///
+    /// @retval The simulated time in milliseconds
+    ///
+    static uint32_t GetTime();
+
+  private:
+    /// @brief A simulated parking bay
+    ///
+    struct Bay
+    {
+      SimulatedDistanceSensor         sensor;               ///< The bay distance sensor
+      MockTrafficLight                trafficLight;         ///< The bay traffic light
+      StateMachine                    stateMachine;         ///< The bay state machine
+      SimulatedDistanceSensor::Phase  phase;                ///< The parking cycle phase at the previous update
+      bool                            arrived;              ///< A flag to indicate that the car was seen arriving
+      bool                            redShown;             ///< A flag to indicate that the red light was on since the car arrived
+
+      /// @brief Constructor.
+      Bay();
+    };
+
+    /// @brief A group of consecutive bays run by one worker thread
+    ///
+    struct Shard
+    {
+      uint16_t                        firstBay;             ///< The index of the first bay
+      uint16_t                        bayCount;             ///< The number of bays
+      uint32_t                        time;                 ///< The simulated time of the bays in milliseconds
+      Results                         results;              ///< The results of the bays
+      EnergyMeter                     energyMeter;          ///< The energy used by the bays
+    };
+
+    /// @brief Runs the shards until there are none left
+    ///
+    /// @note Runs in every worker thread
+    ///
+    void RunShards();
+
+    /// @brief Runs the bays of a shard for the configured duration
+    ///
+    /// @param shard              The shard to run
+    ///
+    void RunShard(Shard& shard);
+
+    /// @brief Checks the lights of a bay against its parking cycle phase
+    ///
+    /// @param bay                The bay to check
+    /// @param results            The results to update
+    ///
+    static void CheckLights(Bay& bay, Results& results);
+
+    /// @brief Accounts the energy used by a bay during one period
+    ///
+    /// @param bay                The bay to account
+    /// @param pinged             True if the bay measured the distance during the period
+    /// @param energyMeter        The meter of the shard
+    ///
+    void AccountEnergy(Bay& bay, bool pinged, EnergyMeter& energyMeter);
+
+  private:
+    Bay                           *_bays;         ///< The simulated bays
+    Shard                         *_shards;       ///< The bays split in shards
+    uint16_t                      _shardCount;    ///< The number of shards
+    std::atomic<uint16_t>         _nextShard;     ///< The next shard to run, shared by the worker threads
+    Config                        _config;        ///< The configuration data
+    uint16_t                      _speedOfSound;  ///< The speed of sound used to time the echoes
+
+    static bool                   _active;        ///< A flag to indicate that a simulator owns the clocks
+    static thread_local uint32_t  _time;          ///< The simulated time of the shard run by the thread, in milliseconds
+  };
+}
+#endif // _FLEETSIMULATOR_H_
@@ -0,0 +1,32 @@
+///
+/// @file HostEvents.cpp
+///
+/// @brief The default event subscribers of the host build
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+/// The sketch wires its subscribers in DistanceMeasurement.ino, which isn't built on the
+/// host. These definitions drop the events. They are only linked when the test or tool
+/// doesn't define its own Publish() functions.
+///
+
+#include "Events.h"
+
+namespace CNEGR
+{
+  void Publish(const SampleEvent& event)
+  {
+    (void)event;
+  }
+
+  void Publish(const StateChangedEvent& event)
+  {
+    (void)event;
+  }
+
+  void Publish(const FaultEvent& event)
+  {
+    (void)event;
+  }
+}
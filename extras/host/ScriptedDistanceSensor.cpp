@@ -0,0 +1,183 @@
+///
+/// @file ScriptedDistanceSensor.cpp
+///
+/// @brief ScriptedDistanceSensor class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "ScriptedDistanceSensor.h"
+#include "SpeedOfSound.h"
+
+namespace CNEGR
+{
+  /// @brief Constructor.
+  ScriptedDistanceSensor::ScriptedDistanceSensor()
+    :_initDone(false),
+     _result(RESULT_TIMEOUT),
+     _distanceMm(0),
+     _lastResult(RESULT_NOT_EXECUTED),
+     _rangeLimitMm(UINT32_MAX)
+  {
+  }
+
+  /// @brief Destructor.
+  ScriptedDistanceSensor::~ScriptedDistanceSensor()
+  {
+    Deinit();
+  }
+
+  /// @brief Initialization function.
+  ///
+  /// @param configuration      The configuration data, the pins are ignored.
+  ///
+  /// @retval RESULT_OK         The sensor was successfully configured.
+  /// @retval RESULT_BUSY       The sensor was already configured.
+  ///                           Deinit() must be called before calling Init() again.
+  /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+  ///
+  Result ScriptedDistanceSensor::Init(const Config& configuration)
+  {
+    if (IsInitialized())
+      return RESULT_BUSY;
+
+    if (configuration.name == nullptr)
+      return RESULT_BAD_PARAM;
+
+    _result       = RESULT_TIMEOUT;
+    _distanceMm   = 0;
+    _lastResult   = RESULT_NOT_EXECUTED;
+    _rangeLimitMm = UINT32_MAX;
+    _initDone     = true;
+    return RESULT_OK;
+  }
+
+  /// @brief Get whether the sensor device was initialized
+  ///
+  /// @return boolean true if it is initialized
+  /// and available for use
+  bool ScriptedDistanceSensor::IsInitialized() const
+  {
+    return _initDone;
+  }
+
+  /// @brief Deinitialization function for the device.
+  ///
+  void ScriptedDistanceSensor::Deinit()
+  {
+    _initDone = false;
+  }
+
+  /// @brief Sets the result of the next measurements
+  ///
+  /// @param result             The result returned by the measurements
+  /// @param distance           The distance in millimeters returned with RESULT_OK, a distance
+  ///                           beyond the range limit is returned as RESULT_TIMEOUT
+  ///
+  void ScriptedDistanceSensor::SetMeasurement(Result result, uint32_t distance)
+  {
+    _result     = result;
+    _distanceMm = distance;
+  }
+
+  /// @brief Gets the result of the last measurement
+  ///
+  /// @retval The result returned by the last measurement, RESULT_NOT_EXECUTED before the first one
+  ///
+  Result ScriptedDistanceSensor::GetLastResult() const
+  {
+    return _lastResult;
+  }
+
+  /// @brief Measures the distance.
+  ///
+  /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval Any other value set by SetMeasurement()
+  ///
+  Result ScriptedDistanceSensor::MeasureDistance(uint32_t& distance)
+  {
+    const uint32_t ambientTemperature = 20 * 10;
+    return MeasureDistance(ambientTemperature, distance);
+  }
+
+  /// @brief Measures the distance, the temperature is ignored.
+  ///
+  /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+  /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval Any other value set by SetMeasurement()
+  ///
+  Result ScriptedDistanceSensor::MeasureDistance(uint32_t ambientTemperature, uint32_t& distance)
+  {
+    return MeasureDistance(ambientTemperature, DEFAULT_RELATIVE_HUMIDITY, distance);
+  }
+
+  /// @brief Measures the distance, the temperature and humidity are ignored.
+  ///
+  /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+  /// @param relativeHumidity   The relative humidity in percent
+  /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval Any other value set by SetMeasurement()
+  ///
+  Result ScriptedDistanceSensor::MeasureDistance(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance)
+  {
+    (void)ambientTemperature;
+    (void)relativeHumidity;
+
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    _lastResult = _result;
+
+    // Like a real sensor, a target beyond the range limit is not waited for
+    if ((_lastResult == RESULT_OK) && (_distanceMm > _rangeLimitMm))
+      _lastResult = RESULT_TIMEOUT;
+
+    if (_lastResult == RESULT_OK)
+      distance = _distanceMm;
+
+    return _lastResult;
+  }
+
+  /// @brief Measures the distance without blocking.
+  ///
+  /// @note The scripted measurement completes immediately, RESULT_BUSY is only returned if it was set.
+  ///
+  /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+  /// @param relativeHumidity   The relative humidity in percent
+  /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval Any other value set by SetMeasurement()
+  ///
+  Result ScriptedDistanceSensor::MeasureDistanceAsync(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance)
+  {
+    return MeasureDistance(ambientTemperature, relativeHumidity, distance);
+  }
+
+  /// @brief Limits the range of the measurements
+  ///
+  /// @param rangeLimitMm       The range limit in millimeters, 0 to use the full range
+  ///
+  /// @retval RESULT_OK         The range limit was changed.
+  /// @retval RESULT_NOT_READY  The sensor was not initialized (Init() wasn't called)
+  ///
+  Result ScriptedDistanceSensor::SetRangeLimit(uint32_t rangeLimitMm)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    _rangeLimitMm = (rangeLimitMm != 0) ? rangeLimitMm : UINT32_MAX;
+    return RESULT_OK;
+  }
+}
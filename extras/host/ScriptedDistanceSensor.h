@@ -0,0 +1,135 @@
+///
+/// @file ScriptedDistanceSensor.h
+///
+/// @brief ScriptedDistanceSensor class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_SCRIPTEDDISTANCESENSOR_H_)
+#define _SCRIPTEDDISTANCESENSOR_H_
+
+#include "IDistanceSensor.h"
+#include "CommonDefines.h"
+
+namespace CNEGR
+{
+  /// @brief ScriptedDistanceSensor class definition
+  ///
+  /// A distance sensor returning exactly what the caller sets before every measurement,
+  /// without noise and without waiting. The measurements complete immediately so the
+  /// time spent by the caller can be measured without the echo wait.
+  ///
+  class ScriptedDistanceSensor: public IDistanceSensor
+  {
+  public:
+    /// @brief Constructor.
+    ScriptedDistanceSensor();
+
+    /// @brief Destructor.
+    virtual ~ScriptedDistanceSensor();
+
+  public:
+    /// @brief Initialization function.
+    ///
+    /// @param configuration      The configuration data, the pins are ignored.
+    ///
+    /// @retval RESULT_OK         The sensor was successfully configured.
+    /// @retval RESULT_BUSY       The sensor was already configured.
+    ///                           Deinit() must be called before calling Init() again.
+    /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+    ///
+    virtual Result Init(const Config& configuration);
+
+    /// @brief Get whether the sensor device was initialized
+    ///
+    /// @return boolean true if it is initialized
+    /// and available for use
+    virtual bool IsInitialized() const;
+
+    /// @brief Deinitialization function for the device.
+    ///
+    virtual void Deinit();
+
+    /// @brief Sets the result of the next measurements
+    ///
+    /// @param result             The result returned by the measurements
+    /// @param distance           The distance in millimeters returned with RESULT_OK, a distance
+    ///                           beyond the range limit is returned as RESULT_TIMEOUT
+    ///
+    void SetMeasurement(Result result, uint32_t distance);
+
+    /// @brief Gets the result of the last measurement
+    ///
+    /// @retval The result returned by the last measurement, RESULT_NOT_EXECUTED before the first one
+    ///
+    Result GetLastResult() const;
+
+    /// @brief Measures the distance.
+    ///
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval Any other value set by SetMeasurement()
+    ///
+    virtual Result MeasureDistance(uint32_t& distance);
+
+    /// @brief Measures the distance, the temperature is ignored.
+    ///
+    /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval Any other value set by SetMeasurement()
+    ///
+    virtual Result MeasureDistance(uint32_t ambientTemperature, uint32_t& distance);
+
+    /// @brief Measures the distance, the temperature and humidity are ignored.
+    ///
+    /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+    /// @param relativeHumidity   The relative humidity in percent
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval Any other value set by SetMeasurement()
+    ///
+    virtual Result MeasureDistance(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance);
+
+    /// @brief Measures the distance without blocking.
+    ///
+    /// @note The scripted measurement completes immediately, RESULT_BUSY is only returned if it was set.
+    ///
+    /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+    /// @param relativeHumidity   The relative humidity in percent
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval Any other value set by SetMeasurement()
+    ///
+    virtual Result MeasureDistanceAsync(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance);
+
+    /// @brief Limits the range of the measurements
+    ///
+    /// @param rangeLimitMm       The range limit in millimeters, 0 to use the full range
+    ///
+    /// @retval RESULT_OK         The range limit was changed.
+    /// @retval RESULT_NOT_READY  The sensor was not initialized (Init() wasn't called)
+    ///
+    virtual Result SetRangeLimit(uint32_t rangeLimitMm);
+
+  private:
+    bool            _initDone;                ///< A flag to indicate whether the sensor was initialized
+    Result          _result;                  ///< The result returned by the next measurements
+    uint32_t        _distanceMm;              ///< The distance returned by the next measurements
+    Result          _lastResult;              ///< The result returned by the last measurement
+    uint32_t        _rangeLimitMm;            ///< The distance beyond which the measurement times out
+  };
+}
+
+#endif // _SCRIPTEDDISTANCESENSOR_H_
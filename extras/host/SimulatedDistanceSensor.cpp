@@ -0,0 +1,275 @@
+///
+/// @file SimulatedDistanceSensor.cpp
+///
+/// @brief SimulatedDistanceSensor class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "SimulatedDistanceSensor.h"
+#include "SpeedOfSound.h"
+
+namespace CNEGR
+{
+  /// @brief Constructor.
+  SimulatedDistanceSensor::SimulatedDistanceSensor()
+    :_initDone(false),
+     _scenario(nullptr),
+     _clock(nullptr),
+     _phaseOffsetMs(0),
+     _random(0),
+     _rangeLimitMm(UINT32_MAX)
+  {
+  }
+
+  /// @brief Destructor.
+  SimulatedDistanceSensor::~SimulatedDistanceSensor()
+  {
+    Deinit();
+  }
+
+  /// @brief Sets the scenario replayed by the sensor
+  ///
+  /// @note Must be called before Init().
+  ///
+  /// @param scenario           The parking cycle, must remain valid while the sensor is used
+  /// @param clock              The clock driving the cycle, nullptr to use millis()
+  /// @param seed               The seed of the phase and noise, any value
+  ///
+  /// @retval RESULT_OK         The scenario was set.
+  /// @retval RESULT_BUSY       The sensor is initialized.
+  /// @retval RESULT_BAD_PARAM  The scenario is invalid.
+  ///
+  Result SimulatedDistanceSensor::SetScenario(const Scenario *scenario, ClockProc clock, uint32_t seed)
+  {
+    if (IsInitialized())
+      return RESULT_BUSY;
+
+    if ((scenario == nullptr) ||
+        (scenario->speedMmPerS == 0) ||
+        (scenario->stopDistanceMm >= scenario->startDistanceMm) ||
+        (scenario->dropoutPercent + scenario->spikePercent > 100))
+    {
+      return RESULT_BAD_PARAM;
+    }
+
+    _scenario = scenario;
+    _clock    = clock;
+    _random   = seed;
+
+    // Spread the sensors over the whole cycle so that the cars don't all arrive together
+    uint32_t driveTimeMs = (scenario->startDistanceMm - scenario->stopDistanceMm) * 1000UL / scenario->speedMmPerS;
+    uint32_t cycleTimeMs = scenario->emptyTimeMs + scenario->parkedTimeMs + 2 * driveTimeMs;
+    _phaseOffsetMs = (((uint32_t)NextRandom() << 16) | NextRandom()) % cycleTimeMs;
+
+    return RESULT_OK;
+  }
+
+  /// @brief Initialization function.
+  ///
+  /// @param configuration      The configuration data, the pins are ignored.
+  ///
+  /// @retval RESULT_OK         The sensor was successfully configured.
+  /// @retval RESULT_BUSY       The sensor was already configured.
+  ///                           Deinit() must be called before calling Init() again.
+  /// @retval RESULT_NOT_READY  SetScenario() wasn't called.
+  /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+  ///
+  Result SimulatedDistanceSensor::Init(const Config& configuration)
+  {
+    if (IsInitialized())
+      return RESULT_BUSY;
+
+    if (configuration.name == nullptr)
+      return RESULT_BAD_PARAM;
+
+    if (_scenario == nullptr)
+      return RESULT_NOT_READY;
+
+    _rangeLimitMm = UINT32_MAX;
+    _initDone = true;
+    return RESULT_OK;
+  }
+
+  /// @brief Get whether the sensor device was initialized
+  ///
+  /// @return boolean true if it is initialized
+  /// and available for use
+  bool SimulatedDistanceSensor::IsInitialized() const
+  {
+    return _initDone;
+  }
+
+  /// @brief Deinitialization function for the device.
+  ///
+  void SimulatedDistanceSensor::Deinit()
+  {
+    _initDone = false;
+  }
+
+  /// @brief Measures the distance.
+  ///
+  /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_TIMEOUT    The bay is empty or the measurement dropped out.
+  ///
+  Result SimulatedDistanceSensor::MeasureDistance(uint32_t& distance)
+  {
+    const uint32_t ambientTemperature = 20 * 10;
+    return MeasureDistance(ambientTemperature, distance);
+  }
+
+  /// @brief Measures the distance, the temperature is ignored.
+  ///
+  /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+  /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_TIMEOUT    The bay is empty or the measurement dropped out.
+  ///
+  Result SimulatedDistanceSensor::MeasureDistance(uint32_t ambientTemperature, uint32_t& distance)
+  {
+    return MeasureDistance(ambientTemperature, DEFAULT_RELATIVE_HUMIDITY, distance);
+  }
+
+  /// @brief Measures the distance, the temperature and humidity are ignored.
+  ///
+  /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+  /// @param relativeHumidity   The relative humidity in percent
+  /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_TIMEOUT    The bay is empty or the measurement dropped out.
+  ///
+  Result SimulatedDistanceSensor::MeasureDistance(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance)
+  {
+    (void)ambientTemperature;
+    (void)relativeHumidity;
+
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    uint32_t trueDistance = UINT32_MAX;
+    if (GetPhase(trueDistance) == Phase::Empty)
+      return RESULT_TIMEOUT;
+
+    // Draw the measurement errors, a dropout and a spike are mutually exclusive
+    uint16_t error = NextRandom() % 100;
+    if (error < _scenario->dropoutPercent)
+      return RESULT_TIMEOUT;
+
+    if (error < _scenario->dropoutPercent + _scenario->spikePercent)
+    {
+      // Somebody walking through the beam, anywhere in front of the car
+      distance = (uint32_t)NextRandom() * trueDistance / 65536UL;
+      return RESULT_OK;
+    }
+
+    int32_t noise = 0;
+    if (_scenario->noiseMm != 0)
+      noise = (int32_t)(NextRandom() % (2 * _scenario->noiseMm + 1)) - _scenario->noiseMm;
+
+    distance = ((int32_t)trueDistance + noise > 0) ? (uint32_t)((int32_t)trueDistance + noise) : 0;
+
+    // Like a real sensor that stopped waiting for the echo
+    if (distance > _rangeLimitMm)
+      return RESULT_TIMEOUT;
+
+    return RESULT_OK;
+  }
+
+  /// @brief Measures the distance without blocking.
+  ///
+  /// @note The simulated measurement completes immediately, RESULT_BUSY is never returned.
+  ///
+  /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+  /// @param relativeHumidity   The relative humidity in percent
+  /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+  ///
+  /// @retval RESULT_OK         The distance was successfully measured.
+  /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+  /// @retval RESULT_TIMEOUT    The bay is empty or the measurement dropped out.
+  ///
+  Result SimulatedDistanceSensor::MeasureDistanceAsync(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance)
+  {
+    return MeasureDistance(ambientTemperature, relativeHumidity, distance);
+  }
+
+  /// @brief Limits the range of the measurements
+  ///
+  /// @note The simulated sensor has no maximum distance, a car beyond the limit is
+  /// reported as a timeout.
+  ///
+  /// @param rangeLimitMm       The range limit in millimeters, 0 to use the full range
+  ///
+  /// @retval RESULT_OK         The range limit was changed.
+  /// @retval RESULT_NOT_READY  The sensor was not initialized (Init() wasn't called)
+  ///
+  Result SimulatedDistanceSensor::SetRangeLimit(uint32_t rangeLimitMm)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    _rangeLimitMm = (rangeLimitMm != 0) ? rangeLimitMm : UINT32_MAX;
+    return RESULT_OK;
+  }
+
+  /// @brief Gets the current phase of the parking cycle
+  ///
+  /// @param distance           Contains the true distance of the car in millimeters,
+  ///                           UINT32_MAX if the bay is empty
+  ///
+  /// @retval The parking cycle phase
+  ///
+  SimulatedDistanceSensor::Phase SimulatedDistanceSensor::GetPhase(uint32_t& distance) const
+  {
+    distance = UINT32_MAX;
+
+    if (_scenario == nullptr)
+      return Phase::Empty;
+
+    uint32_t driveDistanceMm = _scenario->startDistanceMm - _scenario->stopDistanceMm;
+    uint32_t driveTimeMs     = driveDistanceMm * 1000UL / _scenario->speedMmPerS;
+    uint32_t cycleTimeMs     = _scenario->emptyTimeMs + _scenario->parkedTimeMs + 2 * driveTimeMs;
+
+    uint32_t now  = (_clock != nullptr) ? _clock() : millis();
+    uint32_t time = (now + _phaseOffsetMs) % cycleTimeMs;
+
+    if (time < _scenario->emptyTimeMs)
+      return Phase::Empty;
+    time -= _scenario->emptyTimeMs;
+
+    if (time < driveTimeMs)
+    {
+      distance = _scenario->startDistanceMm - time * _scenario->speedMmPerS / 1000;
+      return Phase::Arriving;
+    }
+    time -= driveTimeMs;
+
+    if (time < _scenario->parkedTimeMs)
+    {
+      distance = _scenario->stopDistanceMm;
+      return Phase::Parked;
+    }
+    time -= _scenario->parkedTimeMs;
+
+    distance = _scenario->stopDistanceMm + time * _scenario->speedMmPerS / 1000;
+    return Phase::Leaving;
+  }
+
+  /// @brief Gets the next pseudo random number
+  ///
+  /// @retval A number in the [0, 65535] interval
+  ///
+  uint16_t SimulatedDistanceSensor::NextRandom()
+  {
+    // Linear congruential generator, the low bits have a short period so only the high bits are used
+    _random = _random * 1664525UL + 1013904223UL;
+    return (uint16_t)(_random >> 16);
+  }
+}
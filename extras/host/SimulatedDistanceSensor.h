@@ -0,0 +1,188 @@
+///
+/// @file SimulatedDistanceSensor.h
+///
+/// @brief SimulatedDistanceSensor class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_SIMULATEDDISTANCESENSOR_H_)
+#define _SIMULATEDDISTANCESENSOR_H_
+
+#include "IDistanceSensor.h"
+#include "CommonDefines.h"
+
+namespace CNEGR
+{
+  /// @brief SimulatedDistanceSensor class definition
+  ///
+  /// A distance sensor that replays a scripted parking cycle instead of measuring: the bay
+  /// is empty, a car drives in up to the stop distance, stays parked and then backs out.
+  /// The cycle repeats forever. The measurements include noise, dropouts and short spikes
+  /// like a real ultrasonic sensor.
+  ///
+  /// The position is computed from the clock, so the sensor follows a simulated clock as
+  /// well as millis(). The scenario is shared by reference and the seed gives every sensor
+  /// its own phase and noise, which keeps the per-instance memory small.
+  ///
+  class SimulatedDistanceSensor: public IDistanceSensor
+  {
+  public:
+    /// @brief The parking cycle parameters
+    ///
+    struct Scenario
+    {
+      uint32_t  startDistanceMm;              ///< The distance where the car enters the sensor range
+      uint32_t  stopDistanceMm;               ///< The distance where the car stops
+      uint32_t  speedMmPerS;                  ///< The car speed while it drives in or out
+      uint32_t  emptyTimeMs;                  ///< How long the bay stays empty
+      uint32_t  parkedTimeMs;                 ///< How long the car stays parked
+      uint16_t  noiseMm;                      ///< The maximum measurement noise, in both directions
+      uint8_t   dropoutPercent;               ///< The percentage of the measurements that time out
+      uint8_t   spikePercent;                 ///< The percentage of the measurements returning a spurious short distance
+    };
+
+    /// @brief The phase of the parking cycle
+    ///
+    enum Phase
+    {
+      Empty,
+      Arriving,
+      Parked,
+      Leaving
+    };
+
+  public:
+    /// @brief Constructor.
+    SimulatedDistanceSensor();
+
+    /// @brief Destructor.
+    virtual ~SimulatedDistanceSensor();
+
+  public:
+    /// @brief Sets the scenario replayed by the sensor
+    ///
+    /// @note Must be called before Init().
+    ///
+    /// @param scenario           The parking cycle, must remain valid while the sensor is used
+    /// @param clock              The clock driving the cycle, nullptr to use millis()
+    /// @param seed               The seed of the phase and noise, any value
+    ///
+    /// @retval RESULT_OK         The scenario was set.
+    /// @retval RESULT_BUSY       The sensor is initialized.
+    /// @retval RESULT_BAD_PARAM  The scenario is invalid.
+    ///
+    Result SetScenario(const Scenario *scenario, ClockProc clock, uint32_t seed);
+
+    /// @brief Initialization function.
+    ///
+    /// @param configuration      The configuration data, the pins are ignored.
+    ///
+    /// @retval RESULT_OK         The sensor was successfully configured.
+    /// @retval RESULT_BUSY       The sensor was already configured.
+    ///                           Deinit() must be called before calling Init() again.
+    /// @retval RESULT_NOT_READY  SetScenario() wasn't called.
+    /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+    ///
+    virtual Result Init(const Config& configuration);
+
+    /// @brief Get whether the sensor device was initialized
+    ///
+    /// @return boolean true if it is initialized
+    /// and available for use
+    virtual bool IsInitialized() const;
+
+    /// @brief Deinitialization function for the device.
+    ///
+    virtual void Deinit();
+
+    /// @brief Measures the distance.
+    ///
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_TIMEOUT    The bay is empty or the measurement dropped out.
+    ///
+    virtual Result MeasureDistance(uint32_t& distance);
+
+    /// @brief Measures the distance, the temperature is ignored.
+    ///
+    /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_TIMEOUT    The bay is empty or the measurement dropped out.
+    ///
+    virtual Result MeasureDistance(uint32_t ambientTemperature, uint32_t& distance);
+
+    /// @brief Measures the distance, the temperature and humidity are ignored.
+    ///
+    /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+    /// @param relativeHumidity   The relative humidity in percent
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_TIMEOUT    The bay is empty or the measurement dropped out.
+    ///
+    virtual Result MeasureDistance(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance);
+
+    /// @brief Measures the distance without blocking.
+    ///
+    /// @note The simulated measurement completes immediately, RESULT_BUSY is never returned.
+    ///
+    /// @param ambientTemperature The ambient temperature in deci-degrees celsius
+    /// @param relativeHumidity   The relative humidity in percent
+    /// @param distance           Contains the measured distance in millimeters if the measurement was successful.
+    ///
+    /// @retval RESULT_OK         The distance was successfully measured.
+    /// @retval RESULT_NOT_READY  The distance measurement failed because the sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_TIMEOUT    The bay is empty or the measurement dropped out.
+    ///
+    virtual Result MeasureDistanceAsync(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance);
+
+    /// @brief Limits the range of the measurements
+    ///
+    /// @note The echo timeout is computed from the range limit, so a shorter range makes
+    /// the measurements without target shorter. A target beyond the limit is reported as
+    /// a timeout. The limit is clipped to the maximum distance the sensor can detect.
+    ///
+    /// @param rangeLimitMm       The range limit in millimeters, 0 to use the full range
+    ///
+    /// @retval RESULT_OK         The range limit was changed.
+    /// @retval RESULT_NOT_READY  The sensor was not initialized (Init() wasn't called)
+    /// @retval RESULT_BAD_PARAM  The range limit is below the minimum distance the sensor can detect.
+    ///
+    virtual Result SetRangeLimit(uint32_t rangeLimitMm);
+
+    /// @brief Gets the current phase of the parking cycle
+    ///
+    /// @param distance           Contains the true distance of the car in millimeters,
+    ///                           UINT32_MAX if the bay is empty
+    ///
+    /// @retval The parking cycle phase
+    ///
+    Phase GetPhase(uint32_t& distance) const;
+
+  private:
+    /// @brief Gets the next pseudo random number
+    ///
+    /// @retval A number in the [0, 65535] interval
+    ///
+    uint16_t NextRandom();
+
+  private:
+    bool            _initDone;                ///< A flag to indicate whether the sensor was initialized
+    const Scenario  *_scenario;               ///< The parking cycle
+    ClockProc       _clock;                   ///< The clock driving the cycle, nullptr for millis()
+    uint32_t        _phaseOffsetMs;           ///< The offset of this sensor in the parking cycle
+    uint32_t        _random;                  ///< The pseudo random generator state
+    uint32_t        _rangeLimitMm;            ///< The distance beyond which the measurement times out
+  };
+}
+
+#endif // _SIMULATEDDISTANCESENSOR_H_
@@ -0,0 +1,168 @@
+///
+/// @file SimulatedEchoLine.cpp
+///
+/// @brief SimulatedEchoLine class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "SimulatedEchoLine.h"
+#include "CommonDefines.h"
+#include "SpeedOfSound.h"
+
+namespace CNEGR
+{
+  SimulatedEchoLine *SimulatedEchoLine::_instances[SIMULATEDECHOLINE_MAX_INSTANCES] = { nullptr };
+
+  /// @brief Constructor.
+  SimulatedEchoLine::SimulatedEchoLine()
+    :_attached(false),
+     _triggerPin(NOT_A_PIN),
+     _echoPin(NOT_A_PIN),
+     _triggerLevel(LOW),
+     _state(Empty),
+     _distanceMm(0),
+     _busyUntilUs(0),
+     _pingCount(0)
+  {
+  }
+
+  /// @brief Destructor.
+  SimulatedEchoLine::~SimulatedEchoLine()
+  {
+    Detach();
+  }
+
+  /// @brief Connects the module to the pins
+  ///
+  /// @param triggerPin         The trigger pin, driven by the sensor driver
+  /// @param echoPin            The echo pin, it must support interrupts
+  ///
+  /// @retval RESULT_OK         The module was attached.
+  /// @retval RESULT_BUSY       The module is already attached.
+  /// @retval RESULT_BAD_PARAM  The echo pin doesn't support interrupts.
+  /// @retval RESULT_NO_MEM     SIMULATEDECHOLINE_MAX_INSTANCES modules are attached.
+  ///
+  Result SimulatedEchoLine::Attach(uint8_t triggerPin, uint8_t echoPin)
+  {
+    if (_attached)
+      return RESULT_BUSY;
+
+    if (digitalPinToInterrupt(echoPin) == NOT_AN_INTERRUPT)
+      return RESULT_BAD_PARAM;
+
+    for (uint8_t slot = 0; slot < SIMULATEDECHOLINE_MAX_INSTANCES; slot++)
+    {
+      if (_instances[slot] == nullptr)
+      {
+        _instances[slot] = this;
+        _attached        = true;
+        _triggerPin      = triggerPin;
+        _echoPin         = echoPin;
+        _triggerLevel    = digitalRead(triggerPin);
+        _busyUntilUs     = micros();
+        _pingCount       = 0;
+
+        HostSetPin(_echoPin, LOW);
+        HostSetPinWriteHandler(OnPinWriteHandler);
+        return RESULT_OK;
+      }
+    }
+
+    return RESULT_NO_MEM;
+  }
+
+  /// @brief Disconnects the module from the pins
+  ///
+  void SimulatedEchoLine::Detach()
+  {
+    if (!_attached)
+      return;
+
+    bool anyAttached = false;
+
+    for (uint8_t slot = 0; slot < SIMULATEDECHOLINE_MAX_INSTANCES; slot++)
+    {
+      if (_instances[slot] == this)
+        _instances[slot] = nullptr;
+
+      anyAttached |= (_instances[slot] != nullptr);
+    }
+
+    if (!anyAttached)
+      HostSetPinWriteHandler(nullptr);
+
+    _attached = false;
+  }
+
+  /// @brief Places a target in front of the module
+  ///
+  /// @param distanceMm         The distance of the target in millimeters
+  ///
+  void SimulatedEchoLine::SetTarget(uint32_t distanceMm)
+  {
+    _state      = Target;
+    _distanceMm = distanceMm;
+  }
+
+  /// @brief Changes what the module sees, from the next ping
+  ///
+  /// @param state              Empty or Unplugged, Target is set by SetTarget()
+  ///
+  void SimulatedEchoLine::SetState(State state)
+  {
+    _state = state;
+  }
+
+  /// @brief Gets the number of trigger pulses received
+  ///
+  /// @retval The number of pings since Attach()
+  ///
+  uint32_t SimulatedEchoLine::GetPingCount() const
+  {
+    return _pingCount;
+  }
+
+  /// @brief Starts a ping when the trigger pulse ends
+  ///
+  void SimulatedEchoLine::OnPinWrite(uint8_t pin, uint8_t level)
+  {
+    if (pin != _triggerPin)
+      return;
+
+    bool falling = (_triggerLevel == HIGH) && (level == LOW);
+    _triggerLevel = level;
+
+    if (!falling || (_state == Unplugged))
+      return;
+
+    // Like the module, a trigger during the echo pulse is ignored
+    uint32_t now = micros();
+    if ((int32_t)(now - _busyUntilUs) < 0)
+      return;
+
+    _pingCount++;
+
+    uint32_t pulseUs = SIMULATEDECHOLINE_NO_ECHO_US;
+    if (_state == Target)
+      pulseUs = DistanceToEchoTime(GetSpeedOfSound(200, DEFAULT_RELATIVE_HUMIDITY), _distanceMm);
+
+    uint32_t riseUs = now + SIMULATEDECHOLINE_ECHO_DELAY_US;
+    _busyUntilUs = riseUs + pulseUs;
+
+    HostSchedulePin(_echoPin, HIGH, riseUs);
+    HostSchedulePin(_echoPin, LOW, _busyUntilUs);
+  }
+
+  /// @brief Dispatches the writes of the stub to the attached modules
+  ///
+  void SimulatedEchoLine::OnPinWriteHandler(uint8_t pin, uint8_t level)
+  {
+    for (uint8_t slot = 0; slot < SIMULATEDECHOLINE_MAX_INSTANCES; slot++)
+    {
+      if (_instances[slot] != nullptr)
+        _instances[slot]->OnPinWrite(pin, level);
+    }
+  }
+}
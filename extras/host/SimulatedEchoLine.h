@@ -0,0 +1,110 @@
+///
+/// @file SimulatedEchoLine.h
+///
+/// @brief SimulatedEchoLine class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_SIMULATEDECHOLINE_H_)
+#define _SIMULATEDECHOLINE_H_
+
+#include <Arduino.h>
+#include "Result.h"
+
+namespace CNEGR
+{
+  #define SIMULATEDECHOLINE_MAX_INSTANCES   2       ///< The number of modules attached at once
+  #define SIMULATEDECHOLINE_ECHO_DELAY_US   200     ///< The ultrasonic burst sent before the echo pin rises
+  #define SIMULATEDECHOLINE_NO_ECHO_US      38000   ///< The echo pulse of the module when nothing reflects the burst
+
+  /// @brief SimulatedEchoLine class definition
+  ///
+  /// An HC-SR04 module on the pins of the host Arduino core stub, for the tests of the real
+  /// sensor drivers. The falling edge of the trigger pulse schedules the echo pulse on the
+  /// simulated clock: the echo pin rises after the burst and stays high for the round trip
+  /// time of the target. Without target the module answers with its 38 ms pulse, and once
+  /// unplugged the echo pin stays low.
+  ///
+  /// The echo pin must support interrupts (pins 2 and 3 of the stub), the sensors poll the
+  /// other pins in a loop that the simulated clock can't advance.
+  ///
+  class SimulatedEchoLine
+  {
+  public:
+    /// @brief What the module sees
+    ///
+    enum State
+    {
+      Target,                           ///< A target at the set distance
+      Empty,                            ///< Nothing within range
+      Unplugged                         ///< The module doesn't answer
+    };
+
+  public:
+    /// @brief Constructor.
+    SimulatedEchoLine();
+
+    /// @brief Destructor.
+    ~SimulatedEchoLine();
+
+  public:
+    /// @brief Connects the module to the pins
+    ///
+    /// @param triggerPin         The trigger pin, driven by the sensor driver
+    /// @param echoPin            The echo pin, it must support interrupts
+    ///
+    /// @retval RESULT_OK         The module was attached.
+    /// @retval RESULT_BUSY       The module is already attached.
+    /// @retval RESULT_BAD_PARAM  The echo pin doesn't support interrupts.
+    /// @retval RESULT_NO_MEM     SIMULATEDECHOLINE_MAX_INSTANCES modules are attached.
+    ///
+    Result Attach(uint8_t triggerPin, uint8_t echoPin);
+
+    /// @brief Disconnects the module from the pins
+    ///
+    void Detach();
+
+    /// @brief Places a target in front of the module
+    ///
+    /// @param distanceMm         The distance of the target in millimeters
+    ///
+    void SetTarget(uint32_t distanceMm);
+
+    /// @brief Changes what the module sees, from the next ping
+    ///
+    /// @param state              Empty or Unplugged, Target is set by SetTarget()
+    ///
+    void SetState(State state);
+
+    /// @brief Gets the number of trigger pulses received
+    ///
+    /// @retval The number of pings since Attach()
+    ///
+    uint32_t GetPingCount() const;
+
+  private:
+    /// @brief Starts a ping when the trigger pulse ends
+    ///
+    void OnPinWrite(uint8_t pin, uint8_t level);
+
+    /// @brief Dispatches the writes of the stub to the attached modules
+    ///
+    static void OnPinWriteHandler(uint8_t pin, uint8_t level);
+
+  private:
+    static SimulatedEchoLine *_instances[SIMULATEDECHOLINE_MAX_INSTANCES];  ///< The attached modules
+
+    bool      _attached;                ///< A flag to indicate whether the module is attached
+    uint8_t   _triggerPin;              ///< The trigger pin number
+    uint8_t   _echoPin;                 ///< The echo pin number
+    uint8_t   _triggerLevel;            ///< The last level written to the trigger pin
+    State     _state;                   ///< What the module sees
+    uint32_t  _distanceMm;              ///< The distance of the target in millimeters
+    uint32_t  _busyUntilUs;             ///< The end of the current echo pulse, the triggers are ignored until then
+    uint32_t  _pingCount;               ///< The number of trigger pulses received
+  };
+}
+#endif // _SIMULATEDECHOLINE_H_
@@ -0,0 +1,162 @@
+///
+/// @file TelemetryDecoder.cpp
+///
+/// @brief TelemetryDecoder class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "TelemetryDecoder.h"
+#include "Crc16.h"
+
+namespace CNEGR
+{
+  /// @brief Constructor.
+  TelemetryDecoder::TelemetryDecoder()
+  {
+    Reset();
+  }
+
+  /// @brief Destructor.
+  TelemetryDecoder::~TelemetryDecoder()
+  {
+  }
+
+  /// @brief Discards the partially received frame and clears the counters
+  ///
+  void TelemetryDecoder::Reset()
+  {
+    _length         = 0;
+    _overflow       = false;
+    _frameLength    = 0;
+    _sequenceValid  = false;
+    _lastSequence   = 0;
+    _frameCount     = 0;
+    _errorCount     = 0;
+    _lostFrameCount = 0;
+  }
+
+  /// @brief Processes a received byte
+  ///
+  /// @param data               The received byte
+  ///
+  /// @retval RESULT_OK         A valid frame was received, the previous one is discarded.
+  /// @retval RESULT_NO_DATA    The frame is not complete yet.
+  /// @retval RESULT_OVERFLOW   The frame is too long and was dropped.
+  /// @retval RESULT_PARSE_ERROR The frame is not properly encoded and was dropped.
+  /// @retval RESULT_CRC_ERROR  The frame is corrupted and was dropped.
+  ///
+  Result TelemetryDecoder::Push(uint8_t data)
+  {
+    if (data != COBS_DELIMITER)
+    {
+      if (_length < sizeof(_buffer))
+        _buffer[_length++] = data;
+      else
+        _overflow = true;
+
+      return RESULT_NO_DATA;
+    }
+
+    Result result = RESULT_NO_DATA;
+
+    // Consecutive delimiters are allowed, they are used to flush the line
+    if (_overflow)
+      result = RESULT_OVERFLOW;
+    else if (_length != 0)
+      result = ProcessFrame();
+
+    if ((result != RESULT_OK) && (result != RESULT_NO_DATA))
+      _errorCount++;
+
+    _length   = 0;
+    _overflow = false;
+
+    return result;
+  }
+
+  /// @brief Gets the type of the last valid frame (TelemetryMessageType)
+  ///
+  uint8_t TelemetryDecoder::GetType() const
+  {
+    return (_frameLength != 0) ? _frame[0] : 0;
+  }
+
+  /// @brief Gets the sequence number of the last valid frame
+  ///
+  uint8_t TelemetryDecoder::GetSequence() const
+  {
+    return _lastSequence;
+  }
+
+  /// @brief Gets the payload of the last valid frame
+  ///
+  const uint8_t *TelemetryDecoder::GetPayload() const
+  {
+    return &_frame[TELEMETRY_HEADER_LENGTH];
+  }
+
+  /// @brief Gets the payload length of the last valid frame
+  ///
+  size_t TelemetryDecoder::GetPayloadLength() const
+  {
+    return (_frameLength != 0) ? _frameLength - TELEMETRY_HEADER_LENGTH : 0;
+  }
+
+  /// @brief Gets the number of valid frames received
+  ///
+  uint32_t TelemetryDecoder::GetFrameCount() const
+  {
+    return _frameCount;
+  }
+
+  /// @brief Gets the number of frames dropped because of errors
+  ///
+  uint32_t TelemetryDecoder::GetErrorCount() const
+  {
+    return _errorCount;
+  }
+
+  /// @brief Gets the number of frames lost, based on the gaps in the sequence numbers
+  ///
+  uint32_t TelemetryDecoder::GetLostFrameCount() const
+  {
+    return _lostFrameCount;
+  }
+
+  /// @brief Decodes and checks the received frame
+  ///
+  Result TelemetryDecoder::ProcessFrame()
+  {
+    size_t length = 0;
+
+    Result result = CobsDecode(_buffer, _length, _buffer, length);
+    if (result != RESULT_OK)
+      return result;
+
+    if (length < TELEMETRY_HEADER_LENGTH + TELEMETRY_CRC_LENGTH)
+      return RESULT_PARSE_ERROR;
+
+    length -= TELEMETRY_CRC_LENGTH;
+
+    uint16_t crc = (uint16_t)(_buffer[length] | ((uint16_t)_buffer[length + 1] << 8));
+    if (Crc16(_buffer, length) != crc)
+      return RESULT_CRC_ERROR;
+
+    for (size_t i = 0; i < length; i++)
+      _frame[i] = _buffer[i];
+
+    _frameLength = length;
+
+    uint8_t sequence = _frame[1];
+    if (_sequenceValid)
+      _lostFrameCount += (uint8_t)(sequence - _lastSequence - 1);
+
+    _sequenceValid = true;
+    _lastSequence  = sequence;
+    _frameCount++;
+
+    return RESULT_OK;
+  }
+}
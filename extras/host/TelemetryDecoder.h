@@ -0,0 +1,101 @@
+///
+/// @file TelemetryDecoder.h
+///
+/// @brief TelemetryDecoder class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_TELEMETRYDECODER_H_)
+#define _TELEMETRYDECODER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Result.h"
+#include "TelemetryProtocol.h"
+
+namespace CNEGR
+{
+  /// @brief TelemetryDecoder class definition
+  ///
+  /// Extracts the telemetry frames from a byte stream. The bytes are pushed one at
+  /// a time, as they are received, and the decoder reports when a complete and valid
+  /// frame is available. The payload can then be decoded with DecodeTelemetryPayload().
+  ///
+  /// A host only component, used by the tools reading the telemetry stream.
+  ///
+  class TelemetryDecoder
+  {
+  public:
+    /// @brief Constructor.
+    TelemetryDecoder();
+
+    /// @brief Destructor.
+    ~TelemetryDecoder();
+
+  public:
+    /// @brief Discards the partially received frame and clears the counters
+    ///
+    void Reset();
+
+    /// @brief Processes a received byte
+    ///
+    /// @param data               The received byte
+    ///
+    /// @retval RESULT_OK         A valid frame was received, the previous one is discarded.
+    /// @retval RESULT_NO_DATA    The frame is not complete yet.
+    /// @retval RESULT_OVERFLOW   The frame is too long and was dropped.
+    /// @retval RESULT_PARSE_ERROR The frame is not properly encoded and was dropped.
+    /// @retval RESULT_CRC_ERROR  The frame is corrupted and was dropped.
+    ///
+    Result Push(uint8_t data);
+
+    /// @brief Gets the type of the last valid frame (TelemetryMessageType)
+    ///
+    uint8_t GetType() const;
+
+    /// @brief Gets the sequence number of the last valid frame
+    ///
+    uint8_t GetSequence() const;
+
+    /// @brief Gets the payload of the last valid frame
+    ///
+    const uint8_t *GetPayload() const;
+
+    /// @brief Gets the payload length of the last valid frame
+    ///
+    size_t GetPayloadLength() const;
+
+    /// @brief Gets the number of valid frames received
+    ///
+    uint32_t GetFrameCount() const;
+
+    /// @brief Gets the number of frames dropped because of errors
+    ///
+    uint32_t GetErrorCount() const;
+
+    /// @brief Gets the number of frames lost, based on the gaps in the sequence numbers
+    ///
+    uint32_t GetLostFrameCount() const;
+
+  private:
+    /// @brief Decodes and checks the received frame
+    ///
+    Result ProcessFrame();
+
+  private:
+    uint8_t   _buffer[TELEMETRY_MAX_ENCODED_LENGTH];  ///< The encoded frame being received
+    size_t    _length;                                ///< The number of bytes in the buffer
+    bool      _overflow;                              ///< A flag to indicate that the frame didn't fit in the buffer
+    uint8_t   _frame[TELEMETRY_MAX_ENCODED_LENGTH];   ///< The last valid frame, decoded
+    size_t    _frameLength;                           ///< The decoded frame length, without the CRC
+    bool      _sequenceValid;                         ///< A flag to indicate that a frame was received since Reset()
+    uint8_t   _lastSequence;                          ///< The sequence number of the last valid frame
+    uint32_t  _frameCount;                            ///< The number of valid frames received
+    uint32_t  _errorCount;                            ///< The number of frames dropped
+    uint32_t  _lostFrameCount;                        ///< The number of frames lost
+  };
+}
+#endif // _TELEMETRYDECODER_H_
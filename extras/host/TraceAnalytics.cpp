@@ -0,0 +1,190 @@
+///
+/// @file TraceAnalytics.cpp
+///
+/// @brief Batch analysis of recorded distance traces
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#include <string.h>
+#include "TraceAnalytics.h"
+
+namespace CNEGR
+{
+  static uint32_t SquareRoot(uint64_t value)
+  {
+    // Bit by bit integer square root, rounded down
+    uint64_t root = 0;
+    uint64_t bit  = (uint64_t)1 << 62;
+
+    while (bit > value)
+      bit >>= 2;
+
+    while (bit != 0)
+    {
+      if (value >= root + bit)
+      {
+        value -= root + bit;
+        root = (root >> 1) + bit;
+      }
+      else
+      {
+        root >>= 1;
+      }
+      bit >>= 2;
+    }
+
+    return (uint32_t)root;
+  }
+
+  /// @brief Converts echo durations to distances
+  ///
+  /// @param speedOfSound The speed of sound in centimeters per second
+  /// @param echoTimesUs  The round trip times in microseconds, 0 when there was no echo
+  /// @param distancesMm  Contains the distances in millimeters, TRACE_NO_DISTANCE when
+  ///                     there was no echo. Must not overlap the echo times.
+  /// @param count        The number of samples
+  ///
+  void EchoTimesToDistances(uint16_t speedOfSound, const uint32_t *echoTimesUs, uint32_t *distancesMm, size_t count)
+  {
+    const uint32_t *__restrict times     = echoTimesUs;
+    uint32_t       *__restrict distances = distancesMm;
+
+    for (size_t i = 0; i < count; i++)
+    {
+      // Same arithmetic as EchoTimeToDistance(), the division by a constant
+      // is turned into a multiplication by the compiler
+      uint32_t distance = (times[i] * (uint32_t)speedOfSound + (uint32_t)100000) / (uint32_t)200000;
+      distances[i] = (times[i] != 0) ? distance : TRACE_NO_DISTANCE;
+    }
+  }
+
+  /// @brief Computes the statistics of a trace
+  ///
+  /// @param timesMs            The sample times in milliseconds, increasing
+  /// @param distancesMm        The distances in millimeters, TRACE_NO_DISTANCE when there was no echo
+  /// @param count              The number of samples
+  /// @param zones              The zone thresholds used for the dwell times
+  /// @param statistics         Contains the statistics
+  ///
+  /// @retval RESULT_OK         The statistics were computed.
+  /// @retval RESULT_BAD_PARAM  An array is missing or the thresholds are not ordered.
+  /// @retval RESULT_NO_DATA    The trace is empty.
+  ///
+  Result AnalyzeTrace(const uint32_t *timesMs, const uint32_t *distancesMm, size_t count,
+                      const TraceZones& zones, TraceStatistics& statistics)
+  {
+    if ((timesMs == nullptr) || (distancesMm == nullptr))
+      return RESULT_BAD_PARAM;
+
+    if ((zones.nearThresholdMm >= zones.farThresholdMm) || (zones.farThresholdMm >= zones.maxDistanceThresholdMm))
+      return RESULT_BAD_PARAM;
+
+    if (count == 0)
+      return RESULT_NO_DATA;
+
+    const uint32_t *__restrict times     = timesMs;
+    const uint32_t *__restrict distances = distancesMm;
+
+    memset(&statistics, 0, sizeof(statistics));
+    statistics.sampleCount = count;
+
+    // Distance range and mean. A missing echo is larger than any distance so it
+    // never becomes the minimum, and it wraps around to zero when one is added
+    // so it never becomes the maximum either.
+    uint32_t validCount  = 0;
+    uint64_t sum         = 0;
+    uint32_t minDistance = TRACE_NO_DISTANCE;
+    uint32_t maxDistance = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+      uint32_t distance = distances[i];
+      uint32_t next     = distance + 1;
+
+      validCount  += (distance != TRACE_NO_DISTANCE);
+      sum         += (distance != TRACE_NO_DISTANCE) ? distance : 0;
+      minDistance  = (distance < minDistance) ? distance : minDistance;
+      maxDistance  = (next > maxDistance) ? next : maxDistance;
+    }
+
+    statistics.validCount     = validCount;
+    statistics.minDistanceMm  = minDistance;
+    statistics.maxDistanceMm  = (maxDistance != 0) ? maxDistance - 1 : 0;
+    statistics.meanDistanceMm = (validCount != 0) ? (uint32_t)(sum / validCount) : 0;
+
+    // Zone dwell times, every sample lasts until the next one so the
+    // last sample has no duration
+    const uint32_t nearThreshold = zones.nearThresholdMm;
+    const uint32_t farThreshold  = zones.farThresholdMm;
+    const uint32_t maxThreshold  = zones.maxDistanceThresholdMm;
+
+    uint32_t redTime        = 0;
+    uint32_t yellowTime     = 0;
+    uint32_t greenTime      = 0;
+    uint32_t outOfRangeTime = 0;
+
+    for (size_t i = 0; i + 1 < count; i++)
+    {
+      uint32_t distance = distances[i];
+      uint32_t duration = times[i + 1] - times[i];
+
+      redTime        += (distance <= nearThreshold) ? duration : 0;
+      yellowTime     += (distance <= farThreshold) ? duration : 0;
+      greenTime      += (distance <= maxThreshold) ? duration : 0;
+      outOfRangeTime += duration;
+    }
+
+    // The sums above are cumulative, each zone includes the closer ones
+    outOfRangeTime -= greenTime;
+    greenTime      -= yellowTime;
+    yellowTime     -= redTime;
+
+    statistics.dwellTimeMs[TraceRedZone]        = redTime;
+    statistics.dwellTimeMs[TraceYellowZone]     = yellowTime;
+    statistics.dwellTimeMs[TraceGreenZone]      = greenTime;
+    statistics.dwellTimeMs[TraceOutOfRangeZone] = outOfRangeTime;
+
+    // Velocity between consecutive valid samples. The other pairs are masked to
+    // a zero velocity instead of being skipped, and the division is done in
+    // floating point since there is no SIMD integer division.
+    int32_t minVelocity = 0;
+    int32_t maxVelocity = 0;
+
+    for (size_t i = 0; i + 1 < count; i++)
+    {
+      uint32_t duration = times[i + 1] - times[i];
+      int32_t  valid    = (distances[i] != TRACE_NO_DISTANCE) & (distances[i + 1] != TRACE_NO_DISTANCE) & (duration != 0);
+      int32_t  delta    = (int32_t)(distances[i + 1] - distances[i]) & -valid;
+      int32_t  velocity = (int32_t)((float)delta * 1000.0f / (float)(duration | !duration));
+
+      minVelocity = (velocity < minVelocity) ? velocity : minVelocity;
+      maxVelocity = (velocity > maxVelocity) ? velocity : maxVelocity;
+    }
+
+    statistics.minVelocityMmPerS = minVelocity;
+    statistics.maxVelocityMmPerS = maxVelocity;
+
+    // Noise from the second differences of three consecutive valid samples,
+    // e = 2 * d[i] - d[i - 1] - d[i + 1] cancels a steady motion and its
+    // variance is 6 times the noise variance. The square fits in 32 bits
+    // for distances up to 32 m.
+    uint64_t sumOfSquares = 0;
+    uint32_t noiseCount   = 0;
+
+    for (size_t i = 1; i + 1 < count; i++)
+    {
+      int32_t valid = (distances[i - 1] != TRACE_NO_DISTANCE) &
+                      (distances[i] != TRACE_NO_DISTANCE) &
+                      (distances[i + 1] != TRACE_NO_DISTANCE);
+      int32_t error = (int32_t)(2 * distances[i] - distances[i - 1] - distances[i + 1]) & -valid;
+
+      sumOfSquares += (uint32_t)error * (uint32_t)error;
+      noiseCount   += valid;
+    }
+
+    statistics.noiseMm = (noiseCount != 0) ? SquareRoot(sumOfSquares / (6 * (uint64_t)noiseCount)) : 0;
+
+    return RESULT_OK;
+  }
+}
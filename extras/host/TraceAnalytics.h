@@ -0,0 +1,94 @@
+///
+/// @file TraceAnalytics.h
+///
+/// @brief Batch analysis of recorded distance traces
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+/// A trace is a recorded session kept as separate contiguous arrays, one value per
+/// sample: the sample times, the echo durations and the distances. Every function makes
+/// a few passes over the arrays with loops that have no data dependent branches and no
+/// dependency between iterations other than the reductions, which lets an optimizing
+/// compiler (e.g. g++ -O3 on the host) turn them into SIMD code.
+///
+/// The echo duration conversion gives exactly the same result as the firmware's
+/// EchoTimeToDistance() so that recorded echo times can be replayed offline.
+///
+/// A host only component, built with -O3 in the host library. The results are checked
+/// against a plain scalar version by TraceAnalyticsTest and TraceAnalyticsBenchmark.
+///
+#pragma once
+
+#if !defined(_TRACEANALYTICS_H_)
+#define _TRACEANALYTICS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Result.h"
+
+namespace CNEGR
+{
+  /// The distance of a sample without echo, like the firmware's timeout value
+  #define TRACE_NO_DISTANCE   UINT32_MAX
+
+  enum TraceZone
+  {
+    TraceRedZone,                 ///< Closer than the near threshold
+    TraceYellowZone,              ///< Between the near and the far thresholds
+    TraceGreenZone,               ///< Between the far and the maximum distance thresholds
+    TraceOutOfRangeZone,          ///< Beyond the maximum distance threshold or no echo
+    TraceZoneCount
+  };
+
+  /// @brief The zone thresholds, same meaning as in StateMachine::Config
+  ///
+  struct TraceZones
+  {
+    uint32_t  nearThresholdMm;                    ///< The upper limit of the red zone
+    uint32_t  farThresholdMm;                     ///< The upper limit of the yellow zone
+    uint32_t  maxDistanceThresholdMm;             ///< The upper limit of the green zone
+  };
+
+  /// @brief The statistics of a trace
+  ///
+  struct TraceStatistics
+  {
+    uint32_t  sampleCount;                        ///< The number of samples
+    uint32_t  validCount;                         ///< The number of samples with an echo
+    uint32_t  minDistanceMm;                      ///< The shortest distance, TRACE_NO_DISTANCE if no sample is valid
+    uint32_t  maxDistanceMm;                      ///< The longest distance, 0 if no sample is valid
+    uint32_t  meanDistanceMm;                     ///< The mean distance of the valid samples
+    uint32_t  noiseMm;                            ///< The standard deviation of the measurement noise, estimated from
+                                                  ///< the second differences so that steady motion doesn't count
+    int32_t   minVelocityMmPerS;                  ///< The fastest approach (negative) between two valid samples
+    int32_t   maxVelocityMmPerS;                  ///< The fastest retreat (positive) between two valid samples
+    uint32_t  dwellTimeMs[TraceZoneCount];        ///< The time spent in each zone, a sample lasts until the next one
+  };
+
+  /// @brief Converts echo durations to distances
+  ///
+  /// @param speedOfSound The speed of sound in centimeters per second
+  /// @param echoTimesUs  The round trip times in microseconds, 0 when there was no echo
+  /// @param distancesMm  Contains the distances in millimeters, TRACE_NO_DISTANCE when
+  ///                     there was no echo. Must not overlap the echo times.
+  /// @param count        The number of samples
+  ///
+  void EchoTimesToDistances(uint16_t speedOfSound, const uint32_t *echoTimesUs, uint32_t *distancesMm, size_t count);
+
+  /// @brief Computes the statistics of a trace
+  ///
+  /// @param timesMs            The sample times in milliseconds, increasing
+  /// @param distancesMm        The distances in millimeters, TRACE_NO_DISTANCE when there was no echo
+  /// @param count              The number of samples
+  /// @param zones              The zone thresholds used for the dwell times
+  /// @param statistics         Contains the statistics
+  ///
+  /// @retval RESULT_OK         The statistics were computed.
+  /// @retval RESULT_BAD_PARAM  An array is missing or the thresholds are not ordered.
+  /// @retval RESULT_NO_DATA    The trace is empty.
+  ///
+  Result AnalyzeTrace(const uint32_t *timesMs, const uint32_t *distancesMm, size_t count,
+                      const TraceZones& zones, TraceStatistics& statistics);
+}
+#endif // _TRACEANALYTICS_H_
@@ -0,0 +1,544 @@
+///
+/// @file UpdateTimingHarness.cpp
+///
+/// @brief UpdateTimingHarness class implementation
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include <chrono>
+#include "UpdateTimingHarness.h"
+
+namespace CNEGR
+{
+  /// The simulated time between two calls returning RESULT_BUSY, like a main loop polling
+  #define UPDATETIMINGHARNESS_BUSY_POLL_MS 10
+
+  /// The number of elements of an array
+  #define UPDATETIMINGHARNESS_COUNT(array) (sizeof(array) / sizeof(array[0]))
+
+  bool     UpdateTimingHarness::_active = false;
+  uint32_t UpdateTimingHarness::_time   = 0;
+
+  /// The bay is empty, then somebody walks through the beam
+  const UpdateTimingHarness::Segment UpdateTimingHarness::EmptyBaySegments[] =
+  {
+    { UpdateTimingHarness::Edge,    false, 3,                                 UpdateTimingHarness::Timeout     },
+    { UpdateTimingHarness::Medium,  false, 2,                                 UpdateTimingHarness::Measured    },
+    { UpdateTimingHarness::Medium,  false, 2,                                 UpdateTimingHarness::Timeout     },
+  };
+
+  /// A car parks: it drives in, stands still, misses an echo and its sensor is unplugged
+  /// while it approaches. It backs out and the same happens while it retreats. It stays
+  /// in the idle bay, misses an echo and its sensor is unplugged again. It drives in again,
+  /// changes its mind twice and parks until the bay is idle, then backs out and waits.
+  /// Every move starts from a long drive, since the outlier filter and the classifier
+  /// ignore the first readings of a car starting to move.
+  const UpdateTimingHarness::Segment UpdateTimingHarness::ParkingSegments[] =
+  {
+    { UpdateTimingHarness::Edge,    false, 8,                                 UpdateTimingHarness::Measured    },
+    { UpdateTimingHarness::Stop,    true,  UpdateTimingHarness::UntilReached, UpdateTimingHarness::Measured    },
+    { UpdateTimingHarness::Stay,    false, 2,                                 UpdateTimingHarness::Measured    },
+    { UpdateTimingHarness::Stay,    false, 1,                                 UpdateTimingHarness::Timeout     },
+    { UpdateTimingHarness::Stay,    false, 2,                                 UpdateTimingHarness::DeviceError },
+    { UpdateTimingHarness::Stay,    false, 1,                                 UpdateTimingHarness::Measured    },
+    { UpdateTimingHarness::Edge,    true,  UpdateTimingHarness::UntilReached, UpdateTimingHarness::Measured    },
+    { UpdateTimingHarness::Stay,    false, 2,                                 UpdateTimingHarness::Measured    },
+    { UpdateTimingHarness::Stay,    false, 1,                                 UpdateTimingHarness::Timeout     },
+    { UpdateTimingHarness::Stay,    false, 2,                                 UpdateTimingHarness::DeviceError },
+    { UpdateTimingHarness::Stay,    false, 1,                                 UpdateTimingHarness::Timeout     },
+    { UpdateTimingHarness::Stay,    false, 8,                                 UpdateTimingHarness::Measured    },
+    { UpdateTimingHarness::Stay,    false, 1,                                 UpdateTimingHarness::Timeout     },
+    { UpdateTimingHarness::Stay,    false, 1,                                 UpdateTimingHarness::DeviceError },
+    { UpdateTimingHarness::Stay,    false, 1,                                 UpdateTimingHarness::Measured    },
+    { UpdateTimingHarness::Stay,    false, 8,                                 UpdateTimingHarness::Measured    },
+    { UpdateTimingHarness::Stop,    true,  UpdateTimingHarness::UntilReached, UpdateTimingHarness::Measured    },
+    { UpdateTimingHarness::Edge,    true,  6,                                 UpdateTimingHarness::Measured    },
+    { UpdateTimingHarness::Stop,    true,  6,                                 UpdateTimingHarness::Measured    },
+    { UpdateTimingHarness::Stay,    false, UpdateTimingHarness::UntilHeld,    UpdateTimingHarness::Measured    },
+    { UpdateTimingHarness::Edge,    true,  UpdateTimingHarness::UntilReached, UpdateTimingHarness::Measured    },
+    { UpdateTimingHarness::Stay,    false, UpdateTimingHarness::UntilHeld,    UpdateTimingHarness::Measured    },
+  };
+
+  /// The car leaves the bay and drives out of the range of the sensor
+  const UpdateTimingHarness::Segment UpdateTimingHarness::LeavingSegments[] =
+  {
+    { UpdateTimingHarness::Stay,    false, 8,                                 UpdateTimingHarness::Measured    },
+    { UpdateTimingHarness::Gone,    true,  UpdateTimingHarness::UntilReached, UpdateTimingHarness::Measured    },
+    { UpdateTimingHarness::Stay,    false, UpdateTimingHarness::UntilHeld,    UpdateTimingHarness::Measured    },
+  };
+
+  /// @brief Constructor.
+  UpdateTimingHarness::UpdateTimingHarness()
+    :_initDone(false),
+     _trafficLight(&UpdateTimingHarness::GetTime),
+     _stepMm(0),
+     _pathCount(0),
+     _overflow(false)
+  {
+    memset(&_config, 0, sizeof(_config));
+  }
+
+  /// @brief Destructor.
+  UpdateTimingHarness::~UpdateTimingHarness()
+  {
+    Deinit();
+  }
+
+  /// @brief Initialization function.
+  ///
+  /// @note Only one harness can be initialized at a time since the state machines
+  /// use a single simulated clock.
+  ///
+  /// @param configuration      The configuration data.
+  ///
+  /// @retval RESULT_OK         The harness was successfully initialized.
+  /// @retval RESULT_BUSY       A harness is already initialized.
+  /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+  ///
+  Result UpdateTimingHarness::Init(const Config& configuration)
+  {
+    if (_active)
+      return RESULT_BUSY;
+
+    const StateMachine::Config& stateMachine = configuration.stateMachine;
+
+    if ((configuration.runs == 0) ||
+        (configuration.periodMs <= stateMachine.movingTimeThresholdMs) ||
+        (stateMachine.nearThresholdMm >= stateMachine.farThresholdMm) ||
+        (stateMachine.farThresholdMm >= stateMachine.maxDistanceThresholdMm))
+    {
+      return RESULT_BAD_PARAM;
+    }
+
+    // The StateMachine asserts on an invalid configuration, check it first
+    HampelFilter outlierFilter;
+    TargetClassifier classifier;
+    AlphaBetaTracker tracker;
+
+    if ((outlierFilter.Init(stateMachine.outlierFilter) != RESULT_OK) ||
+        (classifier.Init(stateMachine.classifier) != RESULT_OK) ||
+        (tracker.Init(stateMachine.tracker) != RESULT_OK))
+    {
+      return RESULT_BAD_PARAM;
+    }
+
+    // The car must move by more than the moving distance threshold between two
+    // updates, without looking erratic to the classifier
+    _stepMm = 2 * stateMachine.movingDistanceDetectionThresholdMm;
+    if (_stepMm > stateMachine.classifier.maxStepMm)
+      _stepMm = stateMachine.classifier.maxStepMm;
+
+    if ((_stepMm <= stateMachine.movingDistanceDetectionThresholdMm) ||
+        (_stepMm >= stateMachine.maxDistanceThresholdMm - stateMachine.farThresholdMm))
+    {
+      return RESULT_BAD_PARAM;
+    }
+
+    IDistanceSensor::Config sensorConfig;
+    sensorConfig.name       = "timing";
+    sensorConfig.triggerPin = 0;
+    sensorConfig.echoPin    = 0;
+
+    Result result = _sensor.Init(sensorConfig);
+    if (result != RESULT_OK)
+      return result;
+
+    _config     = configuration;
+    _pathCount  = 0;
+    _overflow   = false;
+    _active     = true;
+    _initDone   = true;
+    return RESULT_OK;
+  }
+
+  /// @brief Get whether the harness was initialized
+  ///
+  /// @return boolean true if it is initialized
+  ///
+  bool UpdateTimingHarness::IsInitialized() const
+  {
+    return _initDone;
+  }
+
+  /// @brief Deinitialization function.
+  ///
+  void UpdateTimingHarness::Deinit()
+  {
+    if (!_initDone)
+      return;
+
+    _sensor.Deinit();
+    _trafficLight.Deinit();
+
+    _initDone = false;
+    _active   = false;
+  }
+
+  /// @brief Replays the manoeuvre and records the time of every path
+  ///
+  /// @note The paths of the previous run are cleared.
+  ///
+  /// @param logLevel           The log level while the updates run
+  ///
+  /// @retval RESULT_OK         Every path was recorded.
+  /// @retval RESULT_NOT_READY  The harness was not initialized.
+  /// @retval RESULT_OVERFLOW   Some paths didn't fit in the table, the recorded ones are valid.
+  ///
+  Result UpdateTimingHarness::Run(Logger::Level logLevel)
+  {
+    if (!IsInitialized())
+      return RESULT_NOT_READY;
+
+    _pathCount = 0;
+    _overflow  = false;
+
+    Logger::Level previousLogLevel = Logger::GetLogLevel();
+
+    for (uint8_t run = 0; run < _config.runs; run++)
+    {
+      // The StateMachine can't be initialized twice, every run starts from a new one
+      StateMachine stateMachine;
+
+      ITrafficLight::Config trafficLightConfig;
+      trafficLightConfig.name           = "timing";
+      trafficLightConfig.redLightPin    = 0;
+      trafficLightConfig.yellowLightPin = 0;
+      trafficLightConfig.greenLightPin  = 0;
+      trafficLightConfig.pinsPolarity   = SignalPolarity::ActiveHigh;
+
+      _trafficLight.Deinit();
+      _trafficLight.Init(trafficLightConfig);
+      _sensor.SetMeasurement(RESULT_TIMEOUT, 0);
+      _time = 0;
+
+      StateMachine::Config stateMachineConfig = _config.stateMachine;
+      stateMachineConfig.distanceSensor = &_sensor;
+      stateMachineConfig.trafficLight   = &_trafficLight;
+      stateMachineConfig.clock          = &UpdateTimingHarness::GetTime;
+
+      // Only the updates are measured, the initialization logs are left out
+      Logger::SetLogLevel(Logger::Level::OFF);
+      stateMachine.Init(stateMachineConfig);
+
+      Logger::SetLogLevel(logLevel);
+      RunScript(stateMachine);
+
+      Logger::SetLogLevel(previousLogLevel);
+    }
+
+    return _overflow ? RESULT_OVERFLOW : RESULT_OK;
+  }
+
+  /// @brief Gets the number of recorded paths
+  ///
+  /// @retval The number of distinct paths taken by the last run
+  ///
+  uint8_t UpdateTimingHarness::GetPathCount() const
+  {
+    return _pathCount;
+  }
+
+  /// @brief Gets a recorded path
+  ///
+  /// @param index              The index of the path, in the order they were first taken
+  /// @param path               Contains the path
+  ///
+  /// @retval RESULT_OK         The path was returned.
+  /// @retval RESULT_BAD_PARAM  The index is beyond the recorded paths.
+  ///
+  Result UpdateTimingHarness::GetPath(uint8_t index, Path& path) const
+  {
+    if (index >= _pathCount)
+      return RESULT_BAD_PARAM;
+
+    path = _paths[index];
+    return RESULT_OK;
+  }
+
+  /// @brief Gets the longest time of all the paths
+  ///
+  /// @retval The time in nanoseconds
+  ///
+  uint32_t UpdateTimingHarness::GetMaxNs() const
+  {
+    uint32_t maxNs = 0;
+
+    for (uint8_t i = 0; i < _pathCount; i++)
+    {
+      if (_paths[i].maxNs > maxNs)
+        maxNs = _paths[i].maxNs;
+    }
+
+    return maxNs;
+  }
+
+  /// @brief Prints the paths, one "state nextState outcome lights count maxNs" line
+  /// per path, followed by the longest time as "maxNs=value"
+  ///
+  /// @param output             Where the paths are printed
+  ///
+  void UpdateTimingHarness::Print(::Print& output) const
+  {
+    for (uint8_t i = 0; i < _pathCount; i++)
+    {
+      const Path& path = _paths[i];
+
+      output.print(StateMachine::GetStateName(path.state));
+      output.print(F(" "));
+      output.print(StateMachine::GetStateName(path.nextState));
+      output.print(F(" "));
+      output.print(ToString((Outcome)path.outcome));
+      output.print(F(" "));
+      output.print(ToString((Lights)path.lights));
+      output.print(F(" "));
+      output.print(path.count);
+      output.print(F(" "));
+      output.println(path.maxNs);
+    }
+
+    output.print(F("maxNs="));
+    output.println(GetMaxNs());
+
+    if (_overflow)
+      output.println(F("overflow=1"));
+  }
+
+  /// @brief Gets the simulated time
+  ///
+  /// @retval The simulated time in milliseconds
+  ///
+  uint32_t UpdateTimingHarness::GetTime()
+  {
+    return _time;
+  }
+
+  /// @brief Replays the manoeuvre once
+  ///
+  /// @param stateMachine       The state machine, just initialized
+  ///
+  void UpdateTimingHarness::RunScript(StateMachine& stateMachine)
+  {
+    uint32_t position = GetDistance(Target::Edge, 0);
+
+    Replay(stateMachine, EmptyBaySegments, UPDATETIMINGHARNESS_COUNT(EmptyBaySegments), Target::Stop, position);
+
+    // A car parks in every range, the lights differ
+    static const Target stops[] = { Target::Far, Target::Medium, Target::Short };
+
+    for (uint8_t i = 0; i < UPDATETIMINGHARNESS_COUNT(stops); i++)
+      Replay(stateMachine, ParkingSegments, UPDATETIMINGHARNESS_COUNT(ParkingSegments), stops[i], position);
+
+    Replay(stateMachine, LeavingSegments, UPDATETIMINGHARNESS_COUNT(LeavingSegments), Target::Stop, position);
+  }
+
+  /// @brief Replays a part of the manoeuvre
+  ///
+  /// @param stateMachine       The state machine
+  /// @param segments           The segments
+  /// @param count              The number of segments
+  /// @param stop               Where the car parks, replaces the Stop target
+  /// @param position           The position of the car in millimeters, updated
+  ///
+  void UpdateTimingHarness::Replay(StateMachine& stateMachine, const Segment *segments, uint8_t count, Target stop, uint32_t& position)
+  {
+    for (uint8_t i = 0; i < count; i++)
+    {
+      const Segment& segment = segments[i];
+
+      Target   target   = (segment.target == Target::Stop) ? stop : (Target)segment.target;
+      uint32_t distance = GetDistance(target, position);
+
+      uint32_t samples = segment.samples;
+      if (samples == UntilHeld)
+        samples = _config.stateMachine.holdingTimeThresholdMs / _config.periodMs + 2;
+
+      Result result = (segment.outcome == Outcome::Timeout)     ? RESULT_TIMEOUT :
+                      (segment.outcome == Outcome::DeviceError) ? RESULT_DEV_ERR : RESULT_OK;
+
+      for (uint32_t sample = 0; (samples == UntilReached) ? (position != distance) : (sample < samples); sample++)
+      {
+        if (!segment.drive)
+          position = distance;
+        else if (position < distance)
+          position = (distance - position > _stepMm) ? position + _stepMm : distance;
+        else
+          position = (position - distance > _stepMm) ? position - _stepMm : distance;
+
+        _sensor.SetMeasurement(result, position);
+        Update(stateMachine);
+        _time += _config.periodMs;
+      }
+    }
+  }
+
+  /// @brief Completes one update, the calls returning RESULT_BUSY are measured one by one
+  ///
+  /// @param stateMachine       The state machine
+  ///
+  void UpdateTimingHarness::Update(StateMachine& stateMachine)
+  {
+    while (MeasureUpdate(stateMachine) == RESULT_BUSY)
+      _time += UPDATETIMINGHARNESS_BUSY_POLL_MS;
+  }
+
+  /// @brief Measures one Update() call and records its path
+  ///
+  /// @param stateMachine       The state machine
+  ///
+  /// @retval The value returned by Update()
+  ///
+  Result UpdateTimingHarness::MeasureUpdate(StateMachine& stateMachine)
+  {
+    uint8_t state = stateMachine.GetState();
+
+    uint32_t startNs = GetNs();
+    Result result = stateMachine.Update();
+    uint32_t ns = GetNs() - startNs;
+
+    Path path;
+    path.state     = state;
+    path.nextState = state;
+    path.outcome   = Outcome::Busy;
+    path.lights    = Lights::NotRead;
+
+    if (result != RESULT_BUSY)
+    {
+      Result measurementResult = _sensor.GetLastResult();
+      path.nextState = stateMachine.GetState();
+      path.outcome   = (measurementResult == RESULT_OK)      ? Outcome::Measured :
+                       (measurementResult == RESULT_DEV_ERR) ? Outcome::DeviceError : Outcome::Timeout;
+      path.lights    = GetLights();
+    }
+
+    Record(path, ns);
+    return result;
+  }
+
+  /// @brief Records the time of a path
+  ///
+  /// @param path               The path, the count and time are ignored
+  /// @param ns                 The time of the update in nanoseconds
+  ///
+  void UpdateTimingHarness::Record(const Path& path, uint32_t ns)
+  {
+    for (uint8_t i = 0; i < _pathCount; i++)
+    {
+      Path& recorded = _paths[i];
+
+      if ((recorded.state == path.state) && (recorded.nextState == path.nextState) &&
+          (recorded.outcome == path.outcome) && (recorded.lights == path.lights))
+      {
+        if (recorded.count < UINT16_MAX)
+          recorded.count++;
+
+        if (ns > recorded.maxNs)
+          recorded.maxNs = ns;
+
+        return;
+      }
+    }
+
+    if (_pathCount >= UPDATETIMINGHARNESS_MAX_PATHS)
+    {
+      _overflow = true;
+      return;
+    }
+
+    Path& recorded = _paths[_pathCount++];
+    recorded           = path;
+    recorded.count     = 1;
+    recorded.maxNs     = ns;
+  }
+
+  /// @brief Gets the distance of a target
+  ///
+  /// @param target             The target
+  /// @param position           The current position in millimeters
+  ///
+  /// @retval The distance in millimeters
+  ///
+  uint32_t UpdateTimingHarness::GetDistance(Target target, uint32_t position) const
+  {
+    const StateMachine::Config& thresholds = _config.stateMachine;
+
+    switch (target)
+    {
+      case Target::Edge:
+        return thresholds.maxDistanceThresholdMm - _stepMm;
+
+      case Target::Far:
+        return (thresholds.farThresholdMm + thresholds.maxDistanceThresholdMm) / 2;
+
+      case Target::Medium:
+        return (thresholds.nearThresholdMm + thresholds.farThresholdMm) / 2;
+
+      case Target::Short:
+        return thresholds.nearThresholdMm / 2;
+
+      case Target::Gone:
+        return thresholds.maxDistanceThresholdMm + 4 * _stepMm;
+
+      default:
+        return position;
+    }
+  }
+
+  /// @brief Gets the light which is on
+  ///
+  /// @retval The light, AllOff if none is on
+  ///
+  UpdateTimingHarness::Lights UpdateTimingHarness::GetLights()
+  {
+    ITrafficLight::LightState red    = ITrafficLight::Off;
+    ITrafficLight::LightState yellow = ITrafficLight::Off;
+    ITrafficLight::LightState green  = ITrafficLight::Off;
+
+    _trafficLight.GetState(ITrafficLight::RedLight, red);
+    _trafficLight.GetState(ITrafficLight::YellowLight, yellow);
+    _trafficLight.GetState(ITrafficLight::GreenLight, green);
+
+    return (red == ITrafficLight::On)    ? Lights::Red :
+           (yellow == ITrafficLight::On) ? Lights::Yellow :
+           (green == ITrafficLight::On)  ? Lights::Green : Lights::AllOff;
+  }
+
+  /// @brief Gets the current time of the counter
+  ///
+  /// @retval The time in nanoseconds
+  ///
+  uint32_t UpdateTimingHarness::GetNs() const
+  {
+    if (_config.nsCounter != nullptr)
+      return _config.nsCounter();
+
+    std::chrono::steady_clock::duration now = std::chrono::steady_clock::now().time_since_epoch();
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+  }
+
+  const char *UpdateTimingHarness::ToString(Outcome outcome)
+  {
+    switch (outcome)
+    {
+      case Outcome::Measured:       return "Measured";
+      case Outcome::Timeout:        return "Timeout";
+      case Outcome::DeviceError:    return "DeviceError";
+      case Outcome::Busy:           return "Busy";
+      default:                      return "Invalid";
+    }
+  }
+
+  const char *UpdateTimingHarness::ToString(Lights lights)
+  {
+    switch (lights)
+    {
+      case Lights::NotRead:         return "-";
+      case Lights::AllOff:          return "AllOff";
+      case Lights::Green:           return "Green";
+      case Lights::Yellow:          return "Yellow";
+      case Lights::Red:             return "Red";
+      default:                      return "Invalid";
+    }
+  }
+}
@@ -0,0 +1,277 @@
+///
+/// @file UpdateTimingHarness.h
+///
+/// @brief UpdateTimingHarness class definition
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_UPDATETIMINGHARNESS_H_)
+#define _UPDATETIMINGHARNESS_H_
+
+#include <Arduino.h>
+#include "StateMachine.h"
+#include "ScriptedDistanceSensor.h"
+#include "MockTrafficLight.h"
+#include "DebugUtils.h"
+#include "Result.h"
+
+namespace CNEGR
+{
+  /// The number of distinct paths that can be recorded
+  #define UPDATETIMINGHARNESS_MAX_PATHS 48
+
+  /// @brief UpdateTimingHarness class definition
+  ///
+  /// Measures the execution time of StateMachine::Update() on every path through it. A
+  /// scripted parking manoeuvre drives an unmodified StateMachine through every state,
+  /// every moving direction and every threshold branch: a car stops in each of the
+  /// ranges, backs out, changes direction, stays still long enough to go back to idle,
+  /// drops out of range and unplugs its sensor. The sensor answers immediately and the
+  /// clock is simulated, so every run takes the same paths on any machine.
+  ///
+  /// Every Update() call is classified from what the state machine shows outside: the
+  /// state it starts from and ends in, the measurement outcome and the lights set from the
+  /// tracked distance. The longest time of every path is kept. The logs go to their usual
+  /// output at the level given to Run(), so the cost of formatting and sending them is
+  /// included.
+  ///
+  /// The times come from the nanosecond counter of the configuration, the host steady
+  /// clock by default. Passing a counter following the simulated clock of the Arduino
+  /// stub instead, with HostSetSerialBaud(), measures how long the logs block on the
+  /// serial port at that baud rate. Neither is a cycle count of the board.
+  ///
+  class UpdateTimingHarness
+  {
+  public:
+    /// @brief The outcome of the measurement
+    ///
+    enum Outcome
+    {
+      Measured,                               ///< The distance was measured
+      Timeout,                                ///< Nothing in range
+      DeviceError,                            ///< The sensor doesn't answer
+      Busy                                    ///< The update returned before measuring
+    };
+
+    /// @brief The lights after the update, they follow the range of the tracked
+    /// distance while a subject moves in the bay
+    ///
+    enum Lights
+    {
+      NotRead,                                ///< The update returned before measuring
+      AllOff,                                 ///< Out of range, or a state without lights
+      Green,                                  ///< Between the far and the maximum distance thresholds
+      Yellow,                                 ///< Between the near and the far distance thresholds
+      Red                                     ///< Below the near distance threshold
+    };
+
+    struct Config
+    {
+      StateMachine::Config  stateMachine;     ///< The thresholds and filters configuration, the distance
+                                              ///< sensor, traffic light and clock are set by the harness
+      uint32_t              periodMs;         ///< The simulated time between two updates, must be longer
+                                              ///< than the moving time threshold
+      uint8_t               runs;             ///< The number of times the manoeuvre is replayed
+      ClockProc             nsCounter;        ///< The nanosecond counter, nullptr for the host steady clock
+    };
+
+    /// @brief The timing of one path
+    ///
+    struct Path
+    {
+      uint8_t   state;                        ///< The state the update started from, see StateMachine::GetState()
+      uint8_t   nextState;                    ///< The state after the update
+      uint8_t   outcome;                      ///< The measurement outcome, an Outcome value
+      uint8_t   lights;                       ///< The lights after the update, a Lights value
+      uint16_t  count;                        ///< The number of updates that took this path
+      uint32_t  maxNs;                        ///< The longest time of the path in nanoseconds
+    };
+
+  public:
+    /// @brief Constructor.
+    UpdateTimingHarness();
+
+    /// @brief Destructor.
+    ~UpdateTimingHarness();
+
+  public:
+    /// @brief Initialization function.
+    ///
+    /// @note Only one harness can be initialized at a time since the state machines
+    /// use a single simulated clock.
+    ///
+    /// @param configuration      The configuration data.
+    ///
+    /// @retval RESULT_OK         The harness was successfully initialized.
+    /// @retval RESULT_BUSY       A harness is already initialized.
+    /// @retval RESULT_BAD_PARAM  A parameter value is invalid
+    ///
+    Result Init(const Config& configuration);
+
+    /// @brief Get whether the harness was initialized
+    ///
+    /// @return boolean true if it is initialized
+    ///
+    bool IsInitialized() const;
+
+    /// @brief Deinitialization function.
+    ///
+    void Deinit();
+
+    /// @brief Replays the manoeuvre and records the time of every path
+    ///
+    /// @note The paths of the previous run are cleared.
+    ///
+    /// @param logLevel           The log level while the updates run
+    ///
+    /// @retval RESULT_OK         Every path was recorded.
+    /// @retval RESULT_NOT_READY  The harness was not initialized.
+    /// @retval RESULT_OVERFLOW   Some paths didn't fit in the table, the recorded ones are valid.
+    ///
+    Result Run(Logger::Level logLevel);
+
+    /// @brief Gets the number of recorded paths
+    ///
+    /// @retval The number of distinct paths taken by the last run
+    ///
+    uint8_t GetPathCount() const;
+
+    /// @brief Gets a recorded path
+    ///
+    /// @param index              The index of the path, in the order they were first taken
+    /// @param path               Contains the path
+    ///
+    /// @retval RESULT_OK         The path was returned.
+    /// @retval RESULT_BAD_PARAM  The index is beyond the recorded paths.
+    ///
+    Result GetPath(uint8_t index, Path& path) const;
+
+    /// @brief Gets the longest time of all the paths
+    ///
+    /// @retval The time in nanoseconds
+    ///
+    uint32_t GetMaxNs() const;
+
+    /// @brief Prints the paths, one "state nextState outcome lights count maxNs" line
+    /// per path, followed by the longest time as "maxNs=value"
+    ///
+    /// @param output             Where the paths are printed
+    ///
+    void Print(::Print& output) const;
+
+    /// @brief Gets the simulated time
+    ///
+    /// @retval The simulated time in milliseconds
+    ///
+    static uint32_t GetTime();
+
+  private:
+    /// @brief Where the car goes during a segment of the manoeuvre
+    ///
+    enum Target
+    {
+      Edge,                                   ///< Just inside the maximum distance threshold
+      Far,                                    ///< In the middle of the far range
+      Medium,                                 ///< In the middle of the medium range
+      Short,                                  ///< In the middle of the short range
+      Gone,                                   ///< Beyond the range limit of the sensor
+      Stay,                                   ///< Where the car already is
+      Stop                                    ///< Where the car parks in this manoeuvre
+    };
+
+    /// @brief A segment of the manoeuvre
+    ///
+    struct Segment
+    {
+      uint8_t   target;                       ///< Where the car goes, a Target value
+      bool      drive;                        ///< If true the car drives there, otherwise it appears there
+      uint8_t   samples;                      ///< The number of updates, or one of the UntilXxx values
+      uint8_t   outcome;                      ///< The measurement outcome, an Outcome value other than Busy
+    };
+
+    static const uint8_t UntilReached = 0;    ///< The segment lasts until the car reaches the target
+    static const uint8_t UntilHeld    = 255;  ///< The segment lasts longer than the holding time
+
+    static const Segment EmptyBaySegments[];  ///< The bay is empty, then somebody walks through the beam
+    static const Segment ParkingSegments[];   ///< A car parks, backs out, unplugs its sensor
+    static const Segment LeavingSegments[];   ///< The car leaves the bay
+
+    /// @brief Replays the manoeuvre once
+    ///
+    /// @param stateMachine       The state machine, just initialized
+    ///
+    void RunScript(StateMachine& stateMachine);
+
+    /// @brief Replays a part of the manoeuvre
+    ///
+    /// @param stateMachine       The state machine
+    /// @param segments           The segments
+    /// @param count              The number of segments
+    /// @param stop               Where the car parks, replaces the Stop target
+    /// @param position           The position of the car in millimeters, updated
+    ///
+    void Replay(StateMachine& stateMachine, const Segment *segments, uint8_t count, Target stop, uint32_t& position);
+
+    /// @brief Completes one update, the calls returning RESULT_BUSY are measured one by one
+    ///
+    /// @param stateMachine       The state machine
+    ///
+    void Update(StateMachine& stateMachine);
+
+    /// @brief Measures one Update() call and records its path
+    ///
+    /// @param stateMachine       The state machine
+    ///
+    /// @retval The value returned by Update()
+    ///
+    Result MeasureUpdate(StateMachine& stateMachine);
+
+    /// @brief Records the time of a path
+    ///
+    /// @param path               The path, the count and time are ignored
+    /// @param ns                 The time of the update in nanoseconds
+    ///
+    void Record(const Path& path, uint32_t ns);
+
+    /// @brief Gets the distance of a target
+    ///
+    /// @param target             The target
+    /// @param position           The current position in millimeters
+    ///
+    /// @retval The distance in millimeters
+    ///
+    uint32_t GetDistance(Target target, uint32_t position) const;
+
+    /// @brief Gets the light which is on
+    ///
+    /// @retval The light, AllOff if none is on
+    ///
+    Lights GetLights();
+
+    /// @brief Gets the current time of the counter
+    ///
+    /// @retval The time in nanoseconds
+    ///
+    uint32_t GetNs() const;
+
+    static const char *ToString(Outcome outcome);
+    static const char *ToString(Lights lights);
+
+  private:
+    bool                    _initDone;                        ///< A flag to indicate whether the harness was initialized
+    Config                  _config;                          ///< The configuration data
+    ScriptedDistanceSensor  _sensor;                          ///< The sensor replaying the manoeuvre
+    MockTrafficLight        _trafficLight;                    ///< The lights set by the state machine
+    uint32_t                _stepMm;                          ///< The distance driven by the car between two updates
+    Path                    _paths[UPDATETIMINGHARNESS_MAX_PATHS];  ///< The recorded paths
+    uint8_t                 _pathCount;                       ///< The number of recorded paths
+    bool                    _overflow;                        ///< A flag to indicate that some paths were not recorded
+
+    static bool             _active;                          ///< A flag to indicate that a harness owns the clock
+    static uint32_t         _time;                            ///< The simulated time in milliseconds
+  };
+}
+#endif // _UPDATETIMINGHARNESS_H_
@@ -0,0 +1,197 @@
+///
+/// @file Arduino.h
+///
+/// @brief The subset of the Arduino core used by the sketch, for the host build
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+/// The time, the pins and the serial port are simulated so that the sketch components
+/// can run unmodified in the host tests, benchmarks and simulators. The clock follows
+/// the host steady clock until a test takes control of it with HostSetMicros().
+///
+#pragma once
+
+#if !defined(_HOST_ARDUINO_H_)
+#define _HOST_ARDUINO_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <avr/pgmspace.h>
+#include "WString.h"
+
+#define F_CPU                         16000000L
+#define clockCyclesPerMicrosecond()   (F_CPU / 1000000L)
+
+#define HIGH                          1
+#define LOW                           0
+
+#define INPUT                         0
+#define OUTPUT                        1
+#define INPUT_PULLUP                  2
+
+#define CHANGE                        1
+#define FALLING                       2
+#define RISING                        3
+
+#define NOT_A_PIN                     0
+#define NOT_AN_INTERRUPT              -1
+#define HOST_PIN_COUNT                32
+#define HOST_INTERRUPT_COUNT          2
+
+#define digitalPinToInterrupt(p)      ((p) == 2 ? 0 : ((p) == 3 ? 1 : NOT_AN_INTERRUPT))
+#define bit(b)                        (1UL << (b))
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+
+void attachInterrupt(uint8_t interrupt, void (*handler)(void), int mode);
+void detachInterrupt(uint8_t interrupt);
+void noInterrupts();
+void interrupts();
+
+/// @brief Base class of the outputs, formats the values like the Arduino core
+///
+class Print
+{
+public:
+  virtual ~Print() {}
+
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  virtual int availableForWrite() { return 0; }
+  virtual void flush() {}
+
+  size_t write(const char *str) { return write((const uint8_t *)str, strlen(str)); }
+
+  size_t print(const __FlashStringHelper *str) { return print(reinterpret_cast<const char *>(str)); }
+  size_t print(const char *str) { return write(str); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int value) { return print((long)value); }
+  size_t print(unsigned int value) { return print((unsigned long)value); }
+  size_t print(long value);
+  size_t print(unsigned long value);
+
+  size_t println() { return write("\r\n"); }
+
+  template<typename T>
+  size_t println(T value) { size_t n = print(value); return n + println(); }
+};
+
+/// @brief Base class of the inputs
+///
+class Stream: public Print
+{
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+};
+
+/// @brief The serial port, the output goes to the standard output and the input
+/// comes from HostSerialInput()
+///
+class HardwareSerial: public Stream
+{
+public:
+  void begin(unsigned long baud);
+  void end() {}
+  operator bool() { return true; }
+
+  virtual size_t write(uint8_t c);
+  using Print::write;
+  virtual int availableForWrite();
+  virtual void flush();
+
+  virtual int available();
+  virtual int read();
+  virtual int peek();
+};
+
+extern HardwareSerial Serial;
+
+/// @brief Takes control of the clock, which stops following the host clock
+///
+/// @param us                 The new time in microseconds
+///
+void HostSetMicros(uint32_t us);
+
+/// @brief Advances the simulated clock
+///
+/// @param us                 The number of microseconds to add
+///
+void HostAdvanceMicros(uint32_t us);
+
+/// @brief Returns the clock to the host steady clock
+///
+void HostUseRealTime();
+
+/// @brief Sets the level of an input pin, calls the attached interrupt handler on a change
+///
+/// @param pin                The pin number
+/// @param level              HIGH or LOW
+///
+void HostSetPin(uint8_t pin, uint8_t level);
+
+/// @brief Sets the level of an input pin once the simulated clock reaches the given time
+///
+/// @note The clock stops at the time of each change, so the interrupt handler reads the
+/// time of the edge. The changes run in time order, a few can be pending at once.
+///
+/// @param pin                The pin number
+/// @param level              HIGH or LOW
+/// @param timeUs             The time of the change in microseconds
+///
+void HostSchedulePin(uint8_t pin, uint8_t level, uint32_t timeUs);
+
+/// @brief Calls a handler on every digitalWrite(), to simulate the devices driven by the sketch
+///
+/// @param handler            Receives the pin and the level written, nullptr to remove it
+///
+void HostSetPinWriteHandler(void (*handler)(uint8_t pin, uint8_t level));
+
+/// @brief Gets the mode set by pinMode()
+///
+/// @param pin                The pin number
+///
+/// @retval INPUT, OUTPUT or INPUT_PULLUP
+///
+uint8_t HostGetPinMode(uint8_t pin);
+
+/// @brief Queues characters to be read from Serial
+///
+/// @param text               The characters
+///
+void HostSerialInput(const char *text);
+
+/// @brief Models the time taken to send every byte written to Serial
+///
+/// @note The simulated clock advances by the byte time once the transmit buffer
+/// is full, like Serial.write() blocking on the board. 0 restores instant writes.
+///
+/// @param baud               The baud rate, 10 bits per byte
+///
+void HostSetSerialBaud(uint32_t baud);
+
+/// @brief Sends the Serial output to the standard output or drops it
+///
+/// @param enabled            true to print the output
+///
+void HostSetSerialEcho(bool enabled);
+
+#endif // _HOST_ARDUINO_H_
@@ -0,0 +1,49 @@
+///
+/// @file EEPROM.h
+///
+/// @brief The EEPROM library of the Arduino core, for the host build
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_HOST_EEPROM_H_)
+#define _HOST_EEPROM_H_
+
+#include <stdint.h>
+
+#define HOST_EEPROM_SIZE  1024        ///< The EEPROM size of the ATmega328P
+
+/// @brief The EEPROM, erased (0xFF) at startup. Counts the writes to check the wear levelling
+///
+class EEPROMClass
+{
+public:
+  EEPROMClass();
+
+  uint8_t read(int address) const;
+  void write(int address, uint8_t value);
+  void update(int address, uint8_t value);
+  uint16_t length() const { return HOST_EEPROM_SIZE; }
+
+  /// @brief Gets the number of times a cell was written
+  ///
+  /// @param address            The cell address
+  ///
+  /// @retval The number of writes that changed the cell
+  ///
+  uint32_t GetWriteCount(int address) const;
+
+  /// @brief Erases the EEPROM and clears the write counts
+  ///
+  void Erase();
+
+private:
+  uint8_t   _cells[HOST_EEPROM_SIZE];
+  uint32_t  _writes[HOST_EEPROM_SIZE];
+};
+
+extern EEPROMClass EEPROM;
+
+#endif // _HOST_EEPROM_H_
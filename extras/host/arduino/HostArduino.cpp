@@ -0,0 +1,415 @@
+///
+/// @file HostArduino.cpp
+///
+/// @brief The subset of the Arduino core used by the sketch, for the host build
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <chrono>
+#include <string>
+
+#define HOST_SERIAL_BUFFER_SIZE   64    ///< The transmit buffer size of the ATmega328P core
+#define HOST_MAX_SCHEDULED_PINS   8     ///< The number of pin changes that can be pending
+
+static bool     simulatedClock  = false;      ///< true when a test controls the clock
+static uint64_t simulatedUs     = 0;          ///< The simulated time in microseconds
+static uint32_t randomState     = 1;          ///< The state of random()
+
+static uint8_t  pinLevels[HOST_PIN_COUNT];    ///< The levels of the pins
+static uint8_t  pinModes[HOST_PIN_COUNT];     ///< The modes of the pins
+static void     (*interruptHandlers[HOST_INTERRUPT_COUNT])(void);
+static int      interruptModes[HOST_INTERRUPT_COUNT];
+
+/// @brief A pin change waiting for the simulated clock
+struct ScheduledPin
+{
+  uint64_t  timeUs;
+  uint8_t   pin;
+  uint8_t   level;
+};
+
+static ScheduledPin scheduledPins[HOST_MAX_SCHEDULED_PINS];
+static uint8_t  scheduledPinCount = 0;        ///< The number of pending pin changes
+static void     (*pinWriteHandler)(uint8_t pin, uint8_t level) = nullptr;
+
+static std::string serialInput;               ///< The characters waiting to be read
+static bool     serialEcho      = true;       ///< true to print the Serial output
+static uint32_t serialByteUs    = 0;          ///< The time to send a byte, 0 for instant writes
+static uint64_t serialFreeUs    = 0;          ///< When the last written byte will be sent
+
+HardwareSerial  Serial;
+EEPROMClass     EEPROM;
+
+/// @brief Gets the host steady clock
+///
+/// @retval The time in microseconds since the program started
+///
+static uint64_t GetHostMicros()
+{
+  static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// @brief Advances the simulated clock, through the scheduled pin changes
+///
+/// @param us                 The new time in microseconds
+///
+static void AdvanceTo(uint64_t us)
+{
+  while (scheduledPinCount != 0)
+  {
+    // The changes are kept in time order
+    ScheduledPin next = scheduledPins[0];
+    if (next.timeUs > us)
+      break;
+
+    scheduledPinCount--;
+    memmove(&scheduledPins[0], &scheduledPins[1], scheduledPinCount * sizeof(ScheduledPin));
+
+    if (next.timeUs > simulatedUs)
+      simulatedUs = next.timeUs;
+
+    HostSetPin(next.pin, next.level);
+  }
+
+  if (us > simulatedUs)
+    simulatedUs = us;
+}
+
+/// @brief Gets the current time
+///
+/// @retval The simulated or host time in microseconds
+///
+static uint64_t GetMicros()
+{
+  return simulatedClock ? simulatedUs : GetHostMicros();
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+  if (pin >= HOST_PIN_COUNT)
+    return;
+
+  pinModes[pin] = mode;
+
+  // Like the board, a pulled up input reads HIGH until something drives it
+  if (mode == INPUT_PULLUP)
+    pinLevels[pin] = HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+  if (pin < HOST_PIN_COUNT)
+    pinLevels[pin] = (value != LOW) ? HIGH : LOW;
+
+  if (pinWriteHandler != nullptr)
+    pinWriteHandler(pin, (value != LOW) ? HIGH : LOW);
+}
+
+int digitalRead(uint8_t pin)
+{
+  return (pin < HOST_PIN_COUNT) ? pinLevels[pin] : LOW;
+}
+
+int analogRead(uint8_t pin)
+{
+  // A floating input, the sketch uses it as an entropy source
+  return (int)((random(1024) + pin) & 0x3FF);
+}
+
+unsigned long millis()
+{
+  return (unsigned long)(uint32_t)(GetMicros() / 1000);
+}
+
+unsigned long micros()
+{
+  return (unsigned long)(uint32_t)GetMicros();
+}
+
+void delay(unsigned long ms)
+{
+  delayMicroseconds(ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+  if (simulatedClock)
+  {
+    AdvanceTo(simulatedUs + us);
+    return;
+  }
+
+  uint64_t start = GetHostMicros();
+  while (GetHostMicros() - start < us)
+    ;
+}
+
+long random(long howBig)
+{
+  if (howBig <= 0)
+    return 0;
+
+  randomState = randomState * 1103515245UL + 12345UL;
+  return (long)((randomState >> 8) % (uint32_t)howBig);
+}
+
+long random(long howSmall, long howBig)
+{
+  if (howSmall >= howBig)
+    return howSmall;
+
+  return howSmall + random(howBig - howSmall);
+}
+
+void randomSeed(unsigned long seed)
+{
+  if (seed != 0)
+    randomState = (uint32_t)seed;
+}
+
+void attachInterrupt(uint8_t interrupt, void (*handler)(void), int mode)
+{
+  if (interrupt >= HOST_INTERRUPT_COUNT)
+    return;
+
+  interruptHandlers[interrupt] = handler;
+  interruptModes[interrupt]    = mode;
+}
+
+void detachInterrupt(uint8_t interrupt)
+{
+  if (interrupt < HOST_INTERRUPT_COUNT)
+    interruptHandlers[interrupt] = nullptr;
+}
+
+void noInterrupts()
+{
+  // The simulated interrupts run synchronously from HostSetPin()
+}
+
+void interrupts()
+{
+}
+
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+  size_t written = 0;
+  while (size-- != 0)
+    written += write(*buffer++);
+
+  return written;
+}
+
+size_t Print::print(long value)
+{
+  char text[24];
+  snprintf(text, sizeof(text), "%ld", value);
+  return write(text);
+}
+
+size_t Print::print(unsigned long value)
+{
+  char text[24];
+  snprintf(text, sizeof(text), "%lu", value);
+  return write(text);
+}
+
+void HardwareSerial::begin(unsigned long baud)
+{
+  (void)baud;
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+  if (serialEcho)
+    putchar(c);
+
+  if ((serialByteUs != 0) && simulatedClock)
+  {
+    // Wait for room in the transmit buffer, then queue the byte
+    if (serialFreeUs < simulatedUs)
+      serialFreeUs = simulatedUs;
+
+    if (serialFreeUs - simulatedUs >= (uint64_t)HOST_SERIAL_BUFFER_SIZE * serialByteUs)
+      AdvanceTo(serialFreeUs - (uint64_t)HOST_SERIAL_BUFFER_SIZE * serialByteUs + serialByteUs);
+
+    serialFreeUs += serialByteUs;
+  }
+
+  return 1;
+}
+
+int HardwareSerial::availableForWrite()
+{
+  if ((serialByteUs == 0) || !simulatedClock || (serialFreeUs <= simulatedUs))
+    return HOST_SERIAL_BUFFER_SIZE - 1;
+
+  uint64_t queued = (serialFreeUs - simulatedUs + serialByteUs - 1) / serialByteUs;
+  return (queued >= HOST_SERIAL_BUFFER_SIZE - 1) ? 0 : (int)(HOST_SERIAL_BUFFER_SIZE - 1 - queued);
+}
+
+void HardwareSerial::flush()
+{
+  if ((serialByteUs != 0) && simulatedClock && (serialFreeUs > simulatedUs))
+    AdvanceTo(serialFreeUs);
+
+  if (serialEcho)
+    fflush(stdout);
+}
+
+int HardwareSerial::available()
+{
+  return (int)serialInput.size();
+}
+
+int HardwareSerial::read()
+{
+  if (serialInput.empty())
+    return -1;
+
+  int c = (uint8_t)serialInput[0];
+  serialInput.erase(0, 1);
+  return c;
+}
+
+int HardwareSerial::peek()
+{
+  return serialInput.empty() ? -1 : (uint8_t)serialInput[0];
+}
+
+EEPROMClass::EEPROMClass()
+{
+  Erase();
+}
+
+uint8_t EEPROMClass::read(int address) const
+{
+  return ((address >= 0) && (address < HOST_EEPROM_SIZE)) ? _cells[address] : 0xFF;
+}
+
+void EEPROMClass::write(int address, uint8_t value)
+{
+  if ((address < 0) || (address >= HOST_EEPROM_SIZE))
+    return;
+
+  _cells[address] = value;
+  _writes[address]++;
+}
+
+void EEPROMClass::update(int address, uint8_t value)
+{
+  if (read(address) != value)
+    write(address, value);
+}
+
+uint32_t EEPROMClass::GetWriteCount(int address) const
+{
+  return ((address >= 0) && (address < HOST_EEPROM_SIZE)) ? _writes[address] : 0;
+}
+
+void EEPROMClass::Erase()
+{
+  memset(_cells, 0xFF, sizeof(_cells));
+  memset(_writes, 0, sizeof(_writes));
+}
+
+void HostSetMicros(uint32_t us)
+{
+  simulatedClock    = true;
+  simulatedUs       = us;
+  serialFreeUs      = us;
+  scheduledPinCount = 0;
+}
+
+void HostAdvanceMicros(uint32_t us)
+{
+  if (!simulatedClock)
+    HostSetMicros((uint32_t)GetHostMicros());
+
+  AdvanceTo(simulatedUs + us);
+}
+
+void HostUseRealTime()
+{
+  simulatedClock = false;
+}
+
+void HostSetPin(uint8_t pin, uint8_t level)
+{
+  if (pin >= HOST_PIN_COUNT)
+    return;
+
+  uint8_t previous = pinLevels[pin];
+  pinLevels[pin] = (level != LOW) ? HIGH : LOW;
+
+  int interrupt = digitalPinToInterrupt(pin);
+  if ((interrupt == NOT_AN_INTERRUPT) || (interruptHandlers[interrupt] == nullptr) || (previous == pinLevels[pin]))
+    return;
+
+  int mode = interruptModes[interrupt];
+  if ((mode == CHANGE) ||
+      ((mode == RISING) && (pinLevels[pin] == HIGH)) ||
+      ((mode == FALLING) && (pinLevels[pin] == LOW)))
+  {
+    interruptHandlers[interrupt]();
+  }
+}
+
+void HostSchedulePin(uint8_t pin, uint8_t level, uint32_t timeUs)
+{
+  if (!simulatedClock)
+    HostSetMicros((uint32_t)GetHostMicros());
+
+  if (scheduledPinCount == HOST_MAX_SCHEDULED_PINS)
+  {
+    fprintf(stderr, "HostSchedulePin: more than %d pending pin changes\n", HOST_MAX_SCHEDULED_PINS);
+    abort();
+  }
+
+  // The time is compared with micros() like the sketch does, a time already
+  // passed runs with the next advance of the clock
+  int32_t  delayUs = (int32_t)(timeUs - (uint32_t)simulatedUs);
+  uint64_t time    = simulatedUs + ((delayUs > 0) ? (uint64_t)delayUs : 0);
+
+  uint8_t i = scheduledPinCount;
+  while ((i != 0) && (scheduledPins[i - 1].timeUs > time))
+  {
+    scheduledPins[i] = scheduledPins[i - 1];
+    i--;
+  }
+
+  scheduledPins[i].timeUs = time;
+  scheduledPins[i].pin    = pin;
+  scheduledPins[i].level  = level;
+  scheduledPinCount++;
+}
+
+void HostSetPinWriteHandler(void (*handler)(uint8_t pin, uint8_t level))
+{
+  pinWriteHandler = handler;
+}
+
+uint8_t HostGetPinMode(uint8_t pin)
+{
+  return (pin < HOST_PIN_COUNT) ? pinModes[pin] : INPUT;
+}
+
+void HostSerialInput(const char *text)
+{
+  serialInput += text;
+}
+
+void HostSetSerialBaud(uint32_t baud)
+{
+  serialByteUs = (baud != 0) ? (10UL * 1000000UL + baud / 2) / baud : 0;
+}
+
+void HostSetSerialEcho(bool enabled)
+{
+  serialEcho = enabled;
+}
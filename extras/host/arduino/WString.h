@@ -0,0 +1,21 @@
+///
+/// @file WString.h
+///
+/// @brief The flash string helpers of the Arduino core, for the host build
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_HOST_WSTRING_H_)
+#define _HOST_WSTRING_H_
+
+#include <avr/pgmspace.h>
+
+/// The host has a single address space, the flash strings are ordinary strings
+class __FlashStringHelper;
+
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(PSTR(string_literal)))
+
+#endif // _HOST_WSTRING_H_
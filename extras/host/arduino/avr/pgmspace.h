@@ -0,0 +1,38 @@
+///
+/// @file pgmspace.h
+///
+/// @brief The program space access macros of avr-libc, for the host build
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_HOST_PGMSPACE_H_)
+#define _HOST_PGMSPACE_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/// The host has a single address space, the program space is ordinary memory
+#define PROGMEM
+#define PGM_P                         const char *
+#define PSTR(s)                       (s)
+
+#define pgm_read_byte(address)        (*(const uint8_t *)(address))
+#define pgm_read_word(address)        (*(const uint16_t *)(address))
+#define pgm_read_dword(address)       (*(const uint32_t *)(address))
+#define pgm_read_ptr(address)         (*(void * const *)(address))
+
+#define memcpy_P                      memcpy
+#define strcat_P                      strcat
+#define strcmp_P                      strcmp
+#define strcpy_P                      strcpy
+#define strlen_P                      strlen
+#define strncmp_P                     strncmp
+#define strncpy_P                     strncpy
+#define snprintf_P                    snprintf
+#define vsnprintf_P                   vsnprintf
+
+#endif // _HOST_PGMSPACE_H_
@@ -0,0 +1,143 @@
+///
+/// @file AlphaBetaTrackerBenchmark.cpp
+///
+/// @brief Measures the AlphaBetaTracker update against a float alpha-beta filter
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+/// The host has a float unit and a 64 bits multiplier, the board has neither. The host
+/// times show the relative cost of the update and the prediction, they are not board
+/// cycles and the ratio to the float filter only holds on the host.
+///
+
+#include <chrono>
+#include "AlphaBetaTracker.h"
+#include "HostTest.h"
+
+using namespace CNEGR;
+
+typedef std::chrono::steady_clock Clock;
+
+#define SAMPLE_COUNT    50000000    ///< The number of samples measured
+#define PERIOD_MS       100         ///< The time between two samples
+
+static volatile uint32_t sink;      ///< Receives the results so that the loops aren't removed
+
+/// @brief Gets the time elapsed since a start time
+///
+/// @retval The time in nanoseconds
+///
+static double GetElapsedNs(Clock::time_point start)
+{
+  return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+/// @brief The same filter in float, the alternative to the fixed-point arithmetic
+///
+struct FloatTracker
+{
+  float alpha;
+  float beta;
+  float position;
+  float velocity;
+
+  __attribute__((noinline)) void Update(float deltaT, float distance)
+  {
+    position += velocity * deltaT;
+    float residual = distance - position;
+    position += alpha * residual;
+    velocity += beta * residual / deltaT;
+  }
+};
+
+/// @brief Gets the reading of a car driving back and forth with some noise
+///
+static uint32_t GetReading(uint32_t i)
+{
+  uint32_t phase = i % 400;
+  return 500 + ((phase < 200) ? phase : 400 - phase) * 12 + (i * 2654435761U >> 28);
+}
+
+/// @brief Checks that the estimates saturate instead of wrapping around
+///
+static void CheckSaturation()
+{
+  AlphaBetaTracker::Config config = { Q16_FROM_RATIO(1, 2), Q16_FROM_RATIO(199, 100), 5 };
+  AlphaBetaTracker tracker;
+  CHECK_EQUAL(RESULT_OK, tracker.Init(config));
+
+  // A reading jumping over the whole range within a millisecond
+  tracker.Update(1000, 0);
+  tracker.Update(1001, INT16_MAX);
+  CHECK_EQUAL(INT16_MAX, tracker.GetVelocity());
+
+  tracker.Update(1002, 0);
+  CHECK(tracker.GetVelocity() < 0);
+
+  tracker.Reset();
+  tracker.Update(1000, INT16_MAX);
+  tracker.Update(1001, 0);
+  CHECK_EQUAL(INT16_MIN, tracker.GetVelocity());
+
+  // The prediction stays within the range too
+  tracker.Reset();
+  tracker.Update(1000, 0);
+  tracker.Update(1001, INT16_MAX);
+  tracker.Predict(30000);
+  CHECK_EQUAL(INT16_MAX + 1, tracker.GetDistance());
+  CHECK(tracker.GetVelocity() > 0);
+}
+
+int main()
+{
+  CheckSaturation();
+
+  AlphaBetaTracker::Config config = { Q16_FROM_RATIO(1, 2), Q16_FROM_RATIO(1, 8), 5 };
+  AlphaBetaTracker tracker;
+  CHECK_EQUAL(RESULT_OK, tracker.Init(config));
+
+  FloatTracker floatTracker = { 0.5f, 0.125f, (float)GetReading(0), 0.0f };
+
+  // Every tenth reading is missing
+  uint32_t sum = 0;
+  Clock::time_point start = Clock::now();
+
+  for (uint32_t i = 0; i < SAMPLE_COUNT; i++)
+  {
+    if ((i % 10) == 9)
+      tracker.Predict(i * PERIOD_MS);
+    else
+      tracker.Update(i * PERIOD_MS, GetReading(i));
+
+    sum += tracker.GetDistance();
+  }
+
+  double fixedNs = GetElapsedNs(start) / SAMPLE_COUNT;
+  sink = sum;
+
+  // Both filters follow the car to within a few millimeters
+  start = Clock::now();
+
+  for (uint32_t i = 1; i < SAMPLE_COUNT; i++)
+  {
+    if ((i % 10) == 9)
+      floatTracker.position += floatTracker.velocity * (PERIOD_MS / 1000.0f);
+    else
+      floatTracker.Update(PERIOD_MS / 1000.0f, (float)GetReading(i));
+
+    sum += (uint32_t)floatTracker.position;
+  }
+
+  double floatNs = GetElapsedNs(start) / SAMPLE_COUNT;
+  sink = sum;
+
+  int32_t difference = (int32_t)tracker.GetDistance() - (int32_t)floatTracker.position;
+  CHECK((difference > -5) && (difference < 5));
+
+  printf("%-28s %.2f ns per sample\n", "AlphaBetaTracker", fixedNs);
+  printf("%-28s %.2f ns per sample\n", "float alpha-beta filter", floatNs);
+  printf("AlphaBetaTracker / float filter: %.2f\n", fixedNs / floatNs);
+
+  return 0;
+}
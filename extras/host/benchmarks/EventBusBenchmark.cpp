@@ -0,0 +1,148 @@
+///
+/// @file EventBusBenchmark.cpp
+///
+/// @brief Measures the EventBus dispatch against a list of virtual observers
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "EventBus.h"
+#include "Events.h"
+#include "HostTest.h"
+#include <chrono>
+
+using namespace CNEGR;
+
+typedef std::chrono::steady_clock Clock;
+
+#define SUBSCRIBER_COUNT    3       ///< The number of subscribers of each bus
+
+static uint32_t distanceSum;        ///< Accumulated by the subscribers so that the calls aren't removed
+static uint32_t stateSum;           ///< Accumulated by the subscribers so that the calls aren't removed
+
+/// @brief Gets the time elapsed since a start time
+///
+/// @retval The time in nanoseconds
+///
+static double GetElapsedNs(Clock::time_point start)
+{
+  return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+/// @brief A subscriber of the static bus
+///
+template <uint32_t WEIGHT>
+struct StaticSubscriber: public EventSubscriber
+{
+  using EventSubscriber::OnEvent;
+
+  static void OnEvent(const SampleEvent& event)
+  {
+    distanceSum += event.trackedDistanceMm * WEIGHT;
+  }
+
+  static void OnEvent(const StateChangedEvent& event)
+  {
+    stateSum += event.toState * WEIGHT;
+  }
+};
+
+typedef EventBus<StaticSubscriber<1>, StaticSubscriber<2>, StaticSubscriber<3> > StaticBus;
+
+/// @brief The runtime alternative, an observer interface with a subscriber table
+///
+struct IObserver
+{
+  virtual ~IObserver() {}
+  virtual void OnEvent(const SampleEvent& event) = 0;
+  virtual void OnEvent(const StateChangedEvent& event) = 0;
+};
+
+template <uint32_t WEIGHT>
+struct VirtualObserver: public IObserver
+{
+  virtual void OnEvent(const SampleEvent& event)
+  {
+    distanceSum += event.trackedDistanceMm * WEIGHT;
+  }
+
+  virtual void OnEvent(const StateChangedEvent& event)
+  {
+    stateSum += event.toState * WEIGHT;
+  }
+};
+
+static IObserver *observers[SUBSCRIBER_COUNT];    ///< Filled at run time like a registration table
+
+// The state machine calls Publish() in another translation unit, the benchmark keeps that call
+__attribute__((noinline)) static void PublishStatic(const SampleEvent& event)
+{
+  StaticBus::Publish(event);
+}
+
+__attribute__((noinline)) static void PublishVirtual(const SampleEvent& event)
+{
+  for (uint8_t i = 0; i < SUBSCRIBER_COUNT; i++)
+    observers[i]->OnEvent(event);
+}
+
+/// @brief Measures a dispatch function and checks that every subscriber received every event
+///
+/// @param name               The printed name
+/// @param publish            The dispatch function
+/// @param count              The number of events
+///
+/// @retval The time per event in nanoseconds
+///
+static double Benchmark(const char *name, void (*publish)(const SampleEvent&), uint32_t count)
+{
+  SampleEvent event = { 0, 0, 0, 0, 0, 0 };
+  distanceSum = 0;
+
+  Clock::time_point start = Clock::now();
+
+  for (uint32_t i = 0; i < count; i++)
+  {
+    event.timeMs            = i;
+    event.trackedDistanceMm = i & 0xFFF;
+    publish(event);
+  }
+
+  double ns = GetElapsedNs(start) / count;
+
+  // Every subscriber added its weight times the distance
+  uint32_t expected = 0;
+  for (uint32_t i = 0; i < count; i++)
+    expected += (i & 0xFFF) * (1 + 2 + 3);
+
+  CHECK_EQUAL(expected, distanceSum);
+  printf("%-28s %.2f ns per event, %d subscribers\n", name, ns, SUBSCRIBER_COUNT);
+
+  return ns;
+}
+
+int main()
+{
+  VirtualObserver<1> first;
+  VirtualObserver<2> second;
+  VirtualObserver<3> third;
+  observers[0] = &first;
+  observers[1] = &second;
+  observers[2] = &third;
+
+  const uint32_t count = 100000000;
+
+  double staticNs  = Benchmark("EventBus", PublishStatic, count);
+  double virtualNs = Benchmark("virtual observers", PublishVirtual, count);
+
+  printf("EventBus / virtual observers: %.2f\n", staticNs / virtualNs);
+
+  // A subscriber not interested in an event costs nothing, the state events only
+  // reach the subscribers handling them
+  stateSum = 0;
+  EventBus<EventSubscriber, StaticSubscriber<5> >::Publish(StateChangedEvent{ 0, 1, 2 });
+  CHECK_EQUAL(10, stateSum);
+
+  return 0;
+}
@@ -0,0 +1,141 @@
+///
+/// @file HampelFilterBenchmark.cpp
+///
+/// @brief Measures the HampelFilter cost per reading and the false transitions it removes
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+/// The filter is branchless and has no multiplication wider than 32 bits, the host time
+/// shows its constant cost but it is not a count of board cycles.
+///
+
+#include <chrono>
+#include "HampelFilter.h"
+#include "HostTest.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+using namespace CNEGR;
+
+typedef std::chrono::steady_clock Clock;
+
+#define READING_COUNT       50000000    ///< The number of readings measured
+#define TRACE_LENGTH        10000       ///< The number of readings of the idle trace
+#define IDLE_MM             2800        ///< The wall of an empty bay
+#define SPIKE_PERCENT       2           ///< The chance of a spike per reading
+#define MOVING_THRESHOLD_MM 50          ///< The movingDistanceThresholdMm of DistanceMeasurement.ino
+
+static volatile uint32_t sink;          ///< Receives the results so that the loops aren't removed
+
+/// @brief Gets the time elapsed since a start time
+///
+/// @retval The time in nanoseconds
+///
+static double GetElapsedNs(Clock::time_point start)
+{
+  return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+/// @brief Gets the time stamp counter, the reference cycles of the host
+///
+/// @retval The counter, 0 when the host has none
+///
+static uint64_t GetCycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+/// @brief A xorshift generator, the trace is the same on every run
+///
+static uint32_t NextRandom()
+{
+  static uint32_t state = 2463534242U;
+
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+/// @brief Gets a reading of an empty bay, +/-10 mm of noise and sometimes a 1200 to 1500 mm spike
+///
+static uint32_t GetIdleReading()
+{
+  uint32_t random = NextRandom();
+
+  if ((random % 100) < SPIKE_PERCENT)
+    return 1200 + (random >> 8) % 301;
+
+  return IDLE_MM - 10 + (random >> 8) % 21;
+}
+
+/// @brief Counts the readings the state machine would see as a subject approaching
+///
+/// @param readings           The readings
+/// @param count              The number of readings
+///
+/// @retval The number of readings more than MOVING_THRESHOLD_MM closer than the previous one
+///
+static uint32_t CountApproaches(const uint32_t *readings, uint32_t count)
+{
+  uint32_t approaches = 0;
+
+  for (uint32_t i = 1; i < count; i++)
+  {
+    if (readings[i] + MOVING_THRESHOLD_MM < readings[i - 1])
+      approaches++;
+  }
+
+  return approaches;
+}
+
+int main()
+{
+  HampelFilter::Config config = { 71, 40 };
+  HampelFilter filter;
+  CHECK_EQUAL(RESULT_OK, filter.Init(config));
+
+  // The false transitions of an idle bay
+  static uint32_t raw[TRACE_LENGTH];
+  static uint32_t filtered[TRACE_LENGTH];
+
+  for (uint32_t i = 0; i < TRACE_LENGTH; i++)
+  {
+    raw[i]      = GetIdleReading();
+    filtered[i] = filter.Filter(raw[i]);
+  }
+
+  uint32_t rawApproaches      = CountApproaches(raw, TRACE_LENGTH);
+  uint32_t filteredApproaches = CountApproaches(filtered + HAMPEL_WINDOW_SIZE, TRACE_LENGTH - HAMPEL_WINDOW_SIZE);
+
+  printf("approaches in %u idle readings: raw %u, filtered %u, %u outliers replaced\n",
+         TRACE_LENGTH, rawApproaches, filteredApproaches, filter.GetOutlierCount());
+
+  CHECK(rawApproaches > TRACE_LENGTH * SPIKE_PERCENT / 100 / 2);
+  CHECK(filteredApproaches * 50 < rawApproaches);
+
+  // The cost per reading, over the same mix of noise and spikes
+  uint32_t sum = 0;
+
+  filter.Reset();
+  Clock::time_point start = Clock::now();
+  uint64_t startCycles = GetCycles();
+
+  for (uint32_t i = 0; i < READING_COUNT; i++)
+    sum += filter.Filter(raw[i % TRACE_LENGTH]);
+
+  double cycles = (double)(GetCycles() - startCycles) / READING_COUNT;
+  double ns     = GetElapsedNs(start) / READING_COUNT;
+  sink = sum;
+
+  printf("%-28s %.2f ns, %.1f reference cycles per reading\n", "HampelFilter", ns, cycles);
+
+  return 0;
+}
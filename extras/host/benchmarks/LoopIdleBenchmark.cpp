@@ -0,0 +1,174 @@
+///
+/// @file LoopIdleBenchmark.cpp
+///
+/// @brief Measures the loop time the non blocking measurement and lights test give back
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+/// The loop of DistanceMeasurement.ino runs on the simulated clock, with an HCSR04 on a
+/// SimulatedEchoLine. The loop used to call delay() between the measurements and to block
+/// in the lights test and in the echo wait, it was never idle. The time the update now
+/// holds the loop is the trigger pulse, the rest is counted as idle like the 'stats'
+/// console command does. The cost of the code itself isn't simulated, the idle share is
+/// an upper bound of the board's.
+///
+
+#include <Arduino.h>
+#include <string.h>
+#include "HCSR04.h"
+#include "StateMachine.h"
+#include "DebugUtils.h"
+#include "MockTrafficLight.h"
+#include "SimulatedEchoLine.h"
+#include "HostTest.h"
+
+using namespace CNEGR;
+
+#define TRIGGER_PIN           3       ///< The pins of DistanceMeasurement.ino
+#define ECHO_PIN              2
+#define PERIOD_MS             100     ///< The waitTimeBetweenMeasurementsMs of DistanceMeasurement.ino
+#define LOOP_ITERATION_US     100     ///< The time between two iterations of the loop
+#define PHASE_TIME_MS         30000   ///< The duration of each phase
+
+/// @brief The time spent by the loop during a phase
+///
+struct LoopTime
+{
+  uint64_t totalUs;                   ///< The duration of the phase
+  uint64_t idleUs;                    ///< The time of the iterations that only waited
+  uint64_t blockedUs;                 ///< The time spent inside StateMachine::Update()
+  uint64_t waitUs;                    ///< The time the update was in progress, returning RESULT_BUSY
+  uint32_t updates;                   ///< The number of completed updates
+};
+
+/// @brief Runs the loop of DistanceMeasurement.ino for a while
+///
+/// @param stateMachine       The state machine to update
+/// @param durationMs         The duration of the phase
+/// @param time               Contains the time spent by the loop
+///
+static void RunLoop(StateMachine& stateMachine, uint32_t durationMs, LoopTime& time)
+{
+  static uint32_t lastUpdateTimeMs = 0;
+  static bool     updatePending    = false;
+
+  memset(&time, 0, sizeof(time));
+  uint32_t startTimeUs = micros();
+
+  while (micros() - startTimeUs < durationMs * 1000)
+  {
+    uint32_t iterationStartTimeUs = micros();
+    bool     idle                 = true;
+
+    if (updatePending || (millis() - lastUpdateTimeMs >= PERIOD_MS))
+    {
+      if (!updatePending)
+        lastUpdateTimeMs = millis();
+
+      uint32_t updateStartTimeUs = micros();
+      updatePending = (stateMachine.Update() == RESULT_BUSY);
+      time.blockedUs += micros() - updateStartTimeUs;
+
+      if (!updatePending)
+      {
+        idle = false;
+        time.updates++;
+      }
+    }
+
+    HostAdvanceMicros(LOOP_ITERATION_US);
+
+    uint32_t iterationTimeUs = micros() - iterationStartTimeUs;
+    time.totalUs += iterationTimeUs;
+
+    if (idle)
+      time.idleUs += iterationTimeUs;
+
+    if (updatePending)
+      time.waitUs += iterationTimeUs;
+  }
+}
+
+/// @brief Prints the time spent by the loop during a phase
+///
+static void Print(const char *phase, const LoopTime& time)
+{
+  printf("%-18s %6u updates, %6.2f ms waited and %5.1f us blocked per update, %6.3f%% idle\n",
+         phase, time.updates,
+         (double)time.waitUs / 1000 / time.updates,
+         (double)time.blockedUs / time.updates,
+         100.0 * time.idleUs / time.totalUs);
+}
+
+int main()
+{
+  Logger::SetLogLevel(Logger::Level::OFF);
+  HostSetMicros(0);
+
+  SimulatedEchoLine line;
+  CHECK_EQUAL(RESULT_OK, line.Attach(TRIGGER_PIN, ECHO_PIN));
+
+  HCSR04 sensor;
+  IDistanceSensor::Config sensorConfig;
+  sensorConfig.name       = "DistanceSensor";
+  sensorConfig.triggerPin = TRIGGER_PIN;
+  sensorConfig.echoPin    = ECHO_PIN;
+  CHECK_EQUAL(RESULT_OK, sensor.Init(sensorConfig));
+
+  MockTrafficLight trafficLight;
+  ITrafficLight::Config trafficLightConfig;
+  trafficLightConfig.name           = "TrafficLight";
+  trafficLightConfig.redLightPin    = 0;
+  trafficLightConfig.yellowLightPin = 0;
+  trafficLightConfig.greenLightPin  = 0;
+  trafficLightConfig.pinsPolarity   = SignalPolarity::ActiveHigh;
+  CHECK_EQUAL(RESULT_OK, trafficLight.Init(trafficLightConfig));
+
+  // The configuration of DistanceMeasurement.ino, the lights test runs at boot
+  StateMachine::Config config;
+  memset(&config, 0, sizeof(config));
+  config.distanceSensor                     = &sensor;
+  config.trafficLight                       = &trafficLight;
+  config.maxDistanceThresholdMm             = 3000;
+  config.farThresholdMm                     = 1500;
+  config.nearThresholdMm                    = 250;
+  config.movingDistanceDetectionThresholdMm = 50;
+  config.movingTimeThresholdMs              = 100;
+  config.holdingTimeThresholdMs             = 2000;
+  config.outlierFilter.thresholdX16         = 71;
+  config.outlierFilter.minDeviationMm       = 40;
+  config.classifier.persistenceSamples      = 5;
+  config.classifier.maxStepMm               = 150;
+  config.classifier.maxMissedSamples        = 2;
+  config.tracker.alpha                      = Q16_FROM_RATIO(1, 2);
+  config.tracker.beta                       = Q16_FROM_RATIO(1, 8);
+  config.tracker.maxPredictedSamples        = 5;
+
+  StateMachine stateMachine;
+  stateMachine.Init(config);
+
+  LoopTime time;
+
+  // The lights test, then an empty bay
+  line.SetState(SimulatedEchoLine::Empty);
+  RunLoop(stateMachine, 2000, time);
+  Print("boot", time);
+  CHECK(time.waitUs >= 1500000);
+
+  RunLoop(stateMachine, PHASE_TIME_MS, time);
+  Print("empty bay", time);
+  CHECK(time.idleUs * 100 > time.totalUs * 99);
+
+  line.SetTarget(1200);
+  RunLoop(stateMachine, PHASE_TIME_MS, time);
+  Print("car at 1200 mm", time);
+  CHECK(time.idleUs * 100 > time.totalUs * 99);
+
+  line.SetState(SimulatedEchoLine::Unplugged);
+  RunLoop(stateMachine, PHASE_TIME_MS, time);
+  Print("unplugged sensor", time);
+  CHECK(time.idleUs * 100 > time.totalUs * 99);
+
+  return 0;
+}
@@ -0,0 +1,128 @@
+///
+/// @file SpeedOfSoundBenchmark.cpp
+///
+/// @brief Measures the speed of sound lookup against the former float formula
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+/// The host has a float unit and the board doesn't, the float formula is emulated there.
+/// The host times show the cost of the interpolation, the ratio to the float formula
+/// only holds on the host and none of them are board cycles.
+///
+
+#include <Arduino.h>
+#include <chrono>
+#include "SpeedOfSound.h"
+#include "HostTest.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+using namespace CNEGR;
+
+typedef std::chrono::steady_clock Clock;
+
+#define LOOKUP_COUNT    50000000    ///< The number of conversions measured
+
+static volatile uint32_t sink;      ///< Receives the results so that the loops aren't removed
+
+/// @brief Gets the time elapsed since a start time
+///
+/// @retval The time in nanoseconds
+///
+static double GetElapsedNs(Clock::time_point start)
+{
+  return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+/// @brief Gets the time stamp counter, the reference cycles of the host
+///
+/// @retval The counter, 0 when the host has none
+///
+static uint64_t GetCycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+// The sensor calls the conversion from another translation unit, the benchmark keeps that call
+__attribute__((noinline)) static uint32_t ConvertTable(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t timeUs)
+{
+  return EchoTimeToDistance(GetSpeedOfSound((int32_t)ambientTemperature, relativeHumidity), timeUs);
+}
+
+/// @brief The conversion replaced by the table, temperature only
+__attribute__((noinline)) static uint32_t ConvertFloat(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t timeUs)
+{
+  (void)relativeHumidity;
+
+  float speedOfSound = 331.4f + (0.6f * (float)(int32_t)ambientTemperature / 10.0f);
+  return (uint32_t)(((float)timeUs / 1000.0f / 1000.0f * (speedOfSound / 2)) * 1000.0f);
+}
+
+/// @brief Measures a conversion over a sweep of temperatures, humidities and echo times
+///
+/// @param name               The printed name
+/// @param convert            The conversion
+///
+/// @retval The time per conversion in nanoseconds
+///
+static double Benchmark(const char *name, uint32_t (*convert)(uint32_t, uint32_t, uint32_t))
+{
+  uint32_t sum = 0;
+
+  Clock::time_point start = Clock::now();
+  uint64_t startCycles = GetCycles();
+
+  for (uint32_t i = 0; i < LOOKUP_COUNT; i++)
+  {
+    uint32_t ambientTemperature = (uint32_t)((int32_t)(i % 701) - 200);
+    uint32_t relativeHumidity   = i % 101;
+    uint32_t timeUs             = 600 + (i & 0x3FFF);
+
+    sum += convert(ambientTemperature, relativeHumidity, timeUs);
+  }
+
+  double cycles = (double)(GetCycles() - startCycles) / LOOKUP_COUNT;
+  double ns     = GetElapsedNs(start) / LOOKUP_COUNT;
+  sink = sum;
+
+  printf("%-28s %.2f ns, %.1f reference cycles per conversion\n", name, ns, cycles);
+  return ns;
+}
+
+int main()
+{
+  // The tabulated points are returned as is, the values beyond the table are clamped
+  CHECK_EQUAL(31909, GetSpeedOfSound(-200, 0));
+  CHECK_EQUAL(34399, GetSpeedOfSound(200, 50));
+  CHECK_EQUAL(36733, GetSpeedOfSound(500, 100));
+  CHECK_EQUAL(31909, GetSpeedOfSound(-400, 0));
+  CHECK_EQUAL(36733, GetSpeedOfSound(600, 150));
+
+  // The interpolation grows with the temperature and the humidity, between the cells too
+  for (int32_t temperature = SPEED_OF_SOUND_MIN_TEMPERATURE; temperature < SPEED_OF_SOUND_MAX_TEMPERATURE; temperature++)
+  {
+    for (uint32_t humidity = 0; humidity < 100; humidity++)
+    {
+      CHECK(GetSpeedOfSound(temperature + 1, humidity) > GetSpeedOfSound(temperature, humidity));
+      CHECK(GetSpeedOfSound(temperature, humidity + 1) >= GetSpeedOfSound(temperature, humidity));
+    }
+  }
+
+  // A target at 3 m echoes after 17.44 ms at 20 degrees and 50%, and back
+  CHECK_EQUAL(17442, DistanceToEchoTime(GetSpeedOfSound(200, 50), 3000));
+  CHECK_EQUAL(3000, EchoTimeToDistance(GetSpeedOfSound(200, 50), 17442));
+
+  double tableNs = Benchmark("table lookup", ConvertTable);
+  double floatNs = Benchmark("float formula", ConvertFloat);
+
+  printf("table lookup / float formula: %.2f\n", tableNs / floatNs);
+
+  return 0;
+}
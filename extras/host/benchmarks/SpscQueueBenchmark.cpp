@@ -0,0 +1,109 @@
+///
+/// @file SpscQueueBenchmark.cpp
+///
+/// @brief Measures the SpscQueue throughput alone and between two threads
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "SpscQueue.h"
+#include "HostTest.h"
+#include <chrono>
+#include <thread>
+
+using namespace CNEGR;
+
+typedef std::chrono::steady_clock Clock;
+
+/// @brief Gets the time elapsed since a start time
+///
+/// @retval The time in nanoseconds
+///
+static double GetElapsedNs(Clock::time_point start)
+{
+  return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+/// @brief Measures a push immediately followed by a pop, the loop hand-off of one event
+///
+static void BenchmarkPushPop(uint32_t count)
+{
+  SpscQueue<uint32_t, 16> queue;
+  uint32_t sum   = 0;
+  uint32_t value = 0;
+
+  Clock::time_point start = Clock::now();
+
+  for (uint32_t i = 0; i < count; i++)
+  {
+    queue.Push(i);
+    queue.Pop(value);
+    sum += value;
+  }
+
+  double ns = GetElapsedNs(start);
+
+  CHECK_EQUAL((uint32_t)((uint64_t)count * (count - 1) / 2), sum);
+  printf("push+pop, one thread: %.1f ns per item\n", ns / count);
+}
+
+/// @brief Measures the items per second between a producer and a consumer thread
+///
+/// @tparam SIZE              The queue size
+///
+template <uint8_t SIZE>
+static void BenchmarkTwoThreads(uint32_t count)
+{
+  SpscQueue<uint32_t, SIZE> queue;
+  uint32_t fullCount = 0;
+
+  Clock::time_point start = Clock::now();
+
+  std::thread producer([&queue, &fullCount, count]()
+  {
+    for (uint32_t i = 0; i < count; )
+    {
+      if (queue.Push(i))
+      {
+        i++;
+        continue;
+      }
+
+      fullCount++;
+      std::this_thread::yield();
+    }
+  });
+
+  uint32_t next  = 0;
+  uint32_t value = 0;
+
+  while (next < count)
+  {
+    if (!queue.Pop(value))
+    {
+      std::this_thread::yield();
+      continue;
+    }
+
+    CHECK_EQUAL(next, value);
+    next++;
+  }
+
+  producer.join();
+  double ns = GetElapsedNs(start);
+
+  printf("two threads, %3u slots: %.1f M items/s, producer found the queue full %u times\n",
+         SIZE, count * 1000.0 / ns, fullCount);
+}
+
+int main()
+{
+  printf("%u cores\n", std::thread::hardware_concurrency());
+
+  BenchmarkPushPop(50000000);
+  BenchmarkTwoThreads<16>(10000000);
+  BenchmarkTwoThreads<128>(10000000);
+
+  return 0;
+}
@@ -0,0 +1,91 @@
+///
+/// @file TraceAnalyticsBenchmark.cpp
+///
+/// @brief Measures the trace analysis throughput against the scalar reference
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include <chrono>
+#include <vector>
+#include "TraceAnalytics.h"
+#include "TraceReference.h"
+#include "HostTest.h"
+
+using namespace CNEGR;
+
+typedef std::chrono::steady_clock Clock;
+
+#define TRACE_SAMPLE_COUNT    (1 << 20)   ///< About 17 hours of 60 ms pings
+#define TRACE_REPEAT_COUNT    20          ///< The number of passes over the trace
+
+/// @brief Gets the time elapsed since a start time
+///
+/// @retval The time in nanoseconds
+///
+static double GetElapsedNs(Clock::time_point start)
+{
+  return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+/// @brief Prints the throughput of a pass
+///
+/// @retval The samples per second
+///
+static double PrintRate(const char *name, double ns)
+{
+  double rate = (double)TRACE_SAMPLE_COUNT * TRACE_REPEAT_COUNT * 1e9 / ns;
+  printf("%-36s %8.1f M samples/s\n", name, rate / 1e6);
+  return rate;
+}
+
+int main()
+{
+  const TraceZones zones = { 500, 1500, 3000 };
+  const size_t count = TRACE_SAMPLE_COUNT;
+
+  std::vector<uint32_t> times(count);
+  std::vector<uint32_t> echoTimes(count);
+  std::vector<uint32_t> expectedDistances(count);
+  std::vector<uint32_t> distances(count);
+
+  MakeTrace(&times[0], &echoTimes[0], count, 1);
+
+  // Echo time conversion
+  Clock::time_point start = Clock::now();
+  for (int i = 0; i < TRACE_REPEAT_COUNT; i++)
+    ReferenceEchoTimesToDistances(34300, &echoTimes[0], &expectedDistances[0], count);
+  double scalarConversion = PrintRate("EchoTimeToDistance() per sample", GetElapsedNs(start));
+
+  start = Clock::now();
+  for (int i = 0; i < TRACE_REPEAT_COUNT; i++)
+    EchoTimesToDistances(34300, &echoTimes[0], &distances[0], count);
+  double conversion = PrintRate("EchoTimesToDistances()", GetElapsedNs(start));
+
+  CHECK(expectedDistances == distances);
+
+  // Statistics
+  TraceStatistics expected;
+  TraceStatistics actual;
+
+  start = Clock::now();
+  for (int i = 0; i < TRACE_REPEAT_COUNT; i++)
+    ReferenceAnalyzeTrace(&times[0], &distances[0], count, zones, expected);
+  double scalarAnalysis = PrintRate("scalar analysis", GetElapsedNs(start));
+
+  start = Clock::now();
+  for (int i = 0; i < TRACE_REPEAT_COUNT; i++)
+    CHECK_EQUAL(RESULT_OK, AnalyzeTrace(&times[0], &distances[0], count, zones, actual));
+  double analysis = PrintRate("AnalyzeTrace()", GetElapsedNs(start));
+
+  CHECK_EQUAL(expected.validCount, actual.validCount);
+  CHECK_EQUAL(expected.meanDistanceMm, actual.meanDistanceMm);
+  CHECK_EQUAL(expected.noiseMm, actual.noiseMm);
+  CHECK_EQUAL(expected.minVelocityMmPerS, actual.minVelocityMmPerS);
+  CHECK_EQUAL(expected.dwellTimeMs[TraceRedZone], actual.dwellTimeMs[TraceRedZone]);
+
+  printf("speedup: conversion %.1fx, analysis %.1fx\n", conversion / scalarConversion, analysis / scalarAnalysis);
+
+  return 0;
+}
@@ -0,0 +1,241 @@
+///
+/// @file ConfigStoreTest.cpp
+///
+/// @brief Checks the slot rotation of the ConfigStore and its recovery from bad slots
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <string.h>
+#include "ConfigStore.h"
+#include "CommonDefines.h"
+#include "HostTest.h"
+
+using namespace CNEGR;
+
+#define BASE_ADDRESS    16
+#define SLOT_COUNT      4
+#define HEADER_SIZE     6           ///< The version, size, sequence and CRC of a slot
+#define SLOT_SIZE       (HEADER_SIZE + sizeof(PersistentConfig))
+
+/// @brief Gets the configuration of DistanceMeasurement.ino, marked with a number
+///
+/// @param mark               Stored as the holding time, identifies the saved configuration
+///
+static PersistentConfig GetConfig(uint32_t mark)
+{
+  PersistentConfig config;
+  memset(&config, 0, sizeof(config));
+
+  config.triggerPin                          = 12;
+  config.echoPin                             = 11;
+  config.redLightPin                         = 4;
+  config.yellowLightPin                      = 3;
+  config.greenLightPin                       = 2;
+  config.lightsPolarity                      = SignalPolarity::ActiveHigh;
+  config.maxDistanceThresholdMm              = 3000;
+  config.farThresholdMm                      = 1500;
+  config.nearThresholdMm                     = 250;
+  config.movingDistanceDetectionThresholdMm  = 50;
+  config.movingTimeThresholdMs               = 100;
+  config.holdingTimeThresholdMs              = mark;
+  config.outlierFilter.thresholdX16          = 71;
+  config.outlierFilter.minDeviationMm        = 40;
+  config.classifier.persistenceSamples       = 5;
+  config.classifier.maxStepMm                = 150;
+  config.classifier.maxMissedSamples         = 2;
+  config.tracker.alpha                       = Q16_FROM_RATIO(1, 2);
+  config.tracker.beta                        = Q16_FROM_RATIO(1, 8);
+  config.tracker.maxPredictedSamples         = 5;
+
+  return config;
+}
+
+/// @brief Gets the EEPROM address of a slot
+///
+static int GetSlotAddress(uint8_t slot)
+{
+  return BASE_ADDRESS + slot * SLOT_SIZE;
+}
+
+/// @brief Gets the sequence number written in a slot header
+///
+static uint16_t GetSequence(uint8_t slot)
+{
+  uint16_t sequence;
+  uint8_t *bytes = reinterpret_cast<uint8_t *>(&sequence);
+  bytes[0] = EEPROM.read(GetSlotAddress(slot) + 2);
+  bytes[1] = EEPROM.read(GetSlotAddress(slot) + 3);
+  return sequence;
+}
+
+/// @brief Loads the configuration like the sketch does after a reset
+///
+/// @param mark               Contains the mark of the loaded configuration
+///
+static Result Load(uint32_t& mark)
+{
+  ConfigStore store(BASE_ADDRESS, SLOT_COUNT);
+  PersistentConfig config;
+
+  Result result = store.Load(config);
+  mark = (result == RESULT_OK) ? config.holdingTimeThresholdMs : 0;
+
+  return result;
+}
+
+/// @brief Saves the configurations with the marks first to first + count - 1
+///
+static void Save(uint32_t first, uint32_t count)
+{
+  ConfigStore store(BASE_ADDRESS, SLOT_COUNT);
+  PersistentConfig config;
+  store.Load(config);
+
+  for (uint32_t mark = first; mark < first + count; mark++)
+    CHECK_EQUAL(RESULT_OK, store.Save(GetConfig(mark)));
+}
+
+static void TestBlankStore()
+{
+  EEPROM.Erase();
+
+  uint32_t mark = 0;
+  CHECK_EQUAL(RESULT_NO_DATA, Load(mark));
+
+  // The slots must fit in the EEPROM
+  ConfigStore tooBig(EEPROM.length() - SLOT_SIZE, 2);
+  PersistentConfig config;
+  CHECK_EQUAL(RESULT_NO_MEM, tooBig.Load(config));
+  CHECK_EQUAL(RESULT_NO_MEM, tooBig.Save(GetConfig(1)));
+
+  // An invalid configuration is never saved
+  ConfigStore store(BASE_ADDRESS, SLOT_COUNT);
+  config = GetConfig(1);
+  config.nearThresholdMm = config.farThresholdMm;
+  CHECK_EQUAL(RESULT_BAD_PARAM, store.Save(config));
+  CHECK_EQUAL(RESULT_NO_DATA, Load(mark));
+}
+
+static void TestRotation()
+{
+  EEPROM.Erase();
+
+  // Each save goes to the slot following the most recent one, after a reset too
+  for (uint32_t mark = 1; mark <= 2 * SLOT_COUNT + 1; mark++)
+  {
+    Save(mark, 1);
+
+    uint8_t slot = (uint8_t)((mark - 1) % SLOT_COUNT);
+    CHECK_EQUAL(mark, GetSequence(slot));
+
+    uint32_t loaded = 0;
+    CHECK_EQUAL(RESULT_OK, Load(loaded));
+    CHECK_EQUAL(mark, loaded);
+  }
+
+  // The wear is spread, every header was written as often
+  for (uint8_t slot = 1; slot < SLOT_COUNT; slot++)
+    CHECK_EQUAL(EEPROM.GetWriteCount(GetSlotAddress(1) + 4), EEPROM.GetWriteCount(GetSlotAddress(slot) + 4));
+
+  CHECK_EQUAL(0, EEPROM.GetWriteCount(BASE_ADDRESS - 1));
+  CHECK_EQUAL(0, EEPROM.GetWriteCount(GetSlotAddress(SLOT_COUNT)));
+}
+
+static void TestBadSlots()
+{
+  EEPROM.Erase();
+  Save(1, 6);
+
+  // Mark 6 is in slot 1, mark 5 in slot 0. A bit flip in the newest data
+  int address = GetSlotAddress(1) + HEADER_SIZE + 10;
+  EEPROM.write(address, EEPROM.read(address) ^ 0x04);
+
+  uint32_t mark = 0;
+  CHECK_EQUAL(RESULT_OK, Load(mark));
+  CHECK_EQUAL(5, mark);
+
+  // The next save doesn't overwrite mark 5, it goes after it
+  Save(7, 1);
+  CHECK_EQUAL(RESULT_OK, Load(mark));
+  CHECK_EQUAL(7, mark);
+  CHECK_EQUAL(6, GetSequence(1));
+
+  // A power loss during a save, the data of mark 8 is written but not its header
+  PersistentConfig config = GetConfig(8);
+  const uint8_t *data = reinterpret_cast<const uint8_t *>(&config);
+  for (uint8_t i = 0; i < sizeof(PersistentConfig); i++)
+    EEPROM.update(GetSlotAddress(2) + HEADER_SIZE + i, data[i]);
+
+  CHECK_EQUAL(RESULT_OK, Load(mark));
+  CHECK_EQUAL(7, mark);
+
+  // Nothing left to fall back to
+  for (uint8_t slot = 0; slot < SLOT_COUNT; slot++)
+    EEPROM.write(GetSlotAddress(slot) + 5, EEPROM.read(GetSlotAddress(slot) + 5) ^ 0x80);
+
+  CHECK_EQUAL(RESULT_CRC_ERROR, Load(mark));
+}
+
+static void TestSequenceWrap()
+{
+  EEPROM.Erase();
+
+  // Up to sequence 0xFFFF, then past it
+  Save(1, UINT16_MAX - 1);
+
+  uint32_t mark = 0;
+  CHECK_EQUAL(RESULT_OK, Load(mark));
+  CHECK_EQUAL(UINT16_MAX - 1, mark);
+
+  for (uint32_t next = UINT16_MAX; next < (uint32_t)UINT16_MAX + 2 * SLOT_COUNT; next++)
+  {
+    Save(next, 1);
+
+    CHECK_EQUAL(RESULT_OK, Load(mark));
+    CHECK_EQUAL(next, mark);
+  }
+
+  // The slots now hold the sequences around the wrap
+  bool wrapped = false;
+  for (uint8_t slot = 0; slot < SLOT_COUNT; slot++)
+    wrapped |= (GetSequence(slot) < SLOT_COUNT);
+
+  CHECK(wrapped);
+}
+
+static void TestVersionMismatch()
+{
+  EEPROM.Erase();
+  Save(1, 1);
+
+  // A configuration saved by another firmware version
+  EEPROM.write(GetSlotAddress(0), PERSISTENT_CONFIG_VERSION + 1);
+
+  uint32_t mark = 0;
+  CHECK_EQUAL(RESULT_NOT_VALID, Load(mark));
+
+  // The data size is part of the schema too
+  EEPROM.write(GetSlotAddress(0), PERSISTENT_CONFIG_VERSION);
+  EEPROM.write(GetSlotAddress(0) + 1, sizeof(PersistentConfig) - 1);
+  CHECK_EQUAL(RESULT_NOT_VALID, Load(mark));
+
+  // A slot of this version is still found
+  Save(2, 1);
+  CHECK_EQUAL(RESULT_OK, Load(mark));
+  CHECK_EQUAL(2, mark);
+}
+
+int main()
+{
+  TestBlankStore();
+  TestRotation();
+  TestBadSlots();
+  TestSequenceWrap();
+  TestVersionMismatch();
+
+  return 0;
+}
@@ -0,0 +1,208 @@
+///
+/// @file ConsoleTest.cpp
+///
+/// @brief Checks the Console with a simulated serial stream
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include <Arduino.h>
+#include <string>
+#include "Console.h"
+#include "HostTest.h"
+
+using namespace CNEGR;
+
+/// @brief A serial stream receiving the characters a few at a time, like a slow link
+///
+class SimulatedStream: public Stream
+{
+public:
+  SimulatedStream()
+    :_arrived(0)
+  {
+  }
+
+  /// @brief Queues characters, they arrive with Receive()
+  void Send(const char *text)
+  {
+    _input += text;
+  }
+
+  /// @brief Makes the next queued characters available
+  void Receive(size_t count)
+  {
+    _arrived += count;
+    if (_arrived > _input.size())
+      _arrived = _input.size();
+  }
+
+  /// @brief Makes all the queued characters available
+  void ReceiveAll()
+  {
+    _arrived = _input.size();
+  }
+
+  /// @brief Gets and clears the printed output
+  std::string TakeOutput()
+  {
+    std::string output;
+    output.swap(_output);
+    return output;
+  }
+
+  virtual int available()
+  {
+    return (int)_arrived;
+  }
+
+  virtual int read()
+  {
+    if (_arrived == 0)
+      return -1;
+
+    int c = (uint8_t)_input[0];
+    _input.erase(0, 1);
+    _arrived--;
+    return c;
+  }
+
+  virtual int peek()
+  {
+    return (_arrived == 0) ? -1 : (uint8_t)_input[0];
+  }
+
+  virtual size_t write(uint8_t c)
+  {
+    _output += (char)c;
+    return 1;
+  }
+
+private:
+  std::string _input;                 ///< The characters sent to the console
+  size_t      _arrived;               ///< The number of characters of the input that can be read
+  std::string _output;                ///< The characters printed by the console
+};
+
+static uint8_t      lastArgc = 0;     ///< The arguments of the last command
+static std::string  lastArgs;         ///< The arguments of the last command, separated by '|'
+
+static Result EchoCommand(Print& output, uint8_t argc, char *argv[])
+{
+  lastArgc = argc;
+  lastArgs.clear();
+
+  for (uint8_t i = 0; i < argc; i++)
+  {
+    if (i != 0)
+      lastArgs += '|';
+    lastArgs += argv[i];
+  }
+
+  output.println(lastArgs.c_str());
+  return RESULT_OK;
+}
+
+static Result FailCommand(Print& output, uint8_t argc, char *argv[])
+{
+  (void)output;
+  (void)argc;
+  (void)argv;
+  return RESULT_BAD_PARAM;
+}
+
+static const Console::Command commands[] =
+{
+  { "echo", EchoCommand },
+  { "fail", FailCommand },
+};
+
+int main()
+{
+  SimulatedStream stream;
+  Console console;
+
+  CHECK_EQUAL(RESULT_BAD_PARAM, console.Init(nullptr, commands, 2));
+  CHECK_EQUAL(RESULT_BAD_PARAM, console.Init(&stream, commands, 0));
+  CHECK_EQUAL(RESULT_OK, console.Init(&stream, commands, 2));
+
+  // Nothing to execute
+  console.Poll();
+  CHECK(!console.IsCommandPending());
+  CHECK_EQUAL(RESULT_NO_DATA, console.Execute());
+  CHECK(stream.TakeOutput().empty());
+
+  // A command arriving a few characters at a time is only complete at the end of the line
+  stream.Send("echo  get   max\r\n");
+  for (int i = 0; i < 5; i++)
+  {
+    stream.Receive(3);
+    console.Poll();
+    CHECK(!console.IsCommandPending());
+  }
+
+  stream.ReceiveAll();
+  console.Poll();
+  CHECK(console.IsCommandPending());
+  CHECK_EQUAL(RESULT_OK, console.Execute());
+  CHECK_EQUAL(3, lastArgc);
+  CHECK(lastArgs == "echo|get|max");
+  CHECK(stream.TakeOutput() == "echo|get|max\r\nOK\r\n");
+
+  // The "\n" of "\r\n" and the empty lines don't make commands
+  console.Poll();
+  CHECK(!console.IsCommandPending());
+
+  // Nothing is read while a command waits, the next line stays in the stream
+  stream.Send("\n\necho 1\necho 2\n");
+  stream.ReceiveAll();
+  console.Poll();
+  CHECK(console.IsCommandPending());
+  int waiting = stream.available();
+  console.Poll();
+  CHECK_EQUAL(waiting, stream.available());
+  CHECK_EQUAL(RESULT_OK, console.Execute());
+  CHECK(lastArgs == "echo|1");
+
+  console.Poll();
+  CHECK_EQUAL(RESULT_OK, console.Execute());
+  CHECK(lastArgs == "echo|2");
+  stream.TakeOutput();
+
+  // Unknown commands and handler errors are reported
+  stream.Send("reboot\nfail\n");
+  stream.ReceiveAll();
+  console.Poll();
+  CHECK_EQUAL(RESULT_NOT_SUP, console.Execute());
+  CHECK(stream.TakeOutput() == "ERR RESULT_NOT_SUP\r\n");
+  console.Poll();
+  CHECK_EQUAL(RESULT_BAD_PARAM, console.Execute());
+  CHECK(stream.TakeOutput() == "ERR RESULT_BAD_PARAM\r\n");
+
+  // Too many arguments
+  stream.Send("echo a b c d\n");
+  stream.ReceiveAll();
+  console.Poll();
+  lastArgc = 0;
+  CHECK_EQUAL(RESULT_OVERFLOW, console.Execute());
+  CHECK_EQUAL(0, lastArgc);
+  stream.TakeOutput();
+
+  // A line longer than the buffer is consumed up to its end and rejected,
+  // the console then accepts the next command
+  std::string longLine = "echo ";
+  longLine.append(CONSOLE_LINE_LENGTH, 'x');
+  longLine += "\necho ok\n";
+  stream.Send(longLine.c_str());
+  stream.ReceiveAll();
+  console.Poll();
+  CHECK_EQUAL(RESULT_OVERFLOW, console.Execute());
+  CHECK(stream.TakeOutput() == "ERR RESULT_OVERFLOW\r\n");
+  console.Poll();
+  CHECK_EQUAL(RESULT_OK, console.Execute());
+  CHECK(lastArgs == "echo|ok");
+  CHECK_EQUAL(0, stream.available());
+
+  return 0;
+}
@@ -0,0 +1,227 @@
+///
+/// @file ContinuousDistanceSensorTest.cpp
+///
+/// @brief Checks that the ContinuousDistanceSensor discards the ghost echoes and returns the real targets
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include <Arduino.h>
+#include <vector>
+#include "ContinuousDistanceSensor.h"
+#include "ScriptedDistanceSensor.h"
+#include "SpeedOfSound.h"
+#include "DebugUtils.h"
+#include "HostTest.h"
+
+using namespace CNEGR;
+
+#define CYCLE_TIME_MS         60      ///< The pingCycleTimeMs of DistanceMeasurement.ino
+#define GHOST_SHIFT_MS        4       ///< The ghostShiftMs of DistanceMeasurement.ino
+#define GHOST_TOLERANCE_MM    100     ///< The ghostToleranceMm of DistanceMeasurement.ino
+#define GHOST_STEP_MM         686     ///< The distance a ghost moves by between two pings, 171.5 mm per millisecond
+
+static uint32_t simulatedTimeMs;      ///< The clock of the pings
+
+static uint32_t GetTime()
+{
+  return simulatedTimeMs;
+}
+
+/// @brief A continuous sensor pinging a scripted one
+///
+struct Pinger
+{
+  ScriptedDistanceSensor    scripted;
+  ContinuousDistanceSensor  sensor;
+  std::vector<uint32_t>     pingTimesMs;
+
+  Pinger()
+    :sensor(&scripted, CYCLE_TIME_MS, GHOST_SHIFT_MS, GHOST_TOLERANCE_MM, GetTime)
+  {
+    simulatedTimeMs = 1000;
+
+    IDistanceSensor::Config config;
+    config.name = "Sensor";
+    CHECK_EQUAL(RESULT_OK, scripted.Init(config));
+    CHECK_EQUAL(RESULT_OK, sensor.Init(config));
+  }
+
+  /// @brief Polls the sensor every millisecond until its next ping completes
+  ///
+  /// @param result             The result of the ping
+  /// @param reading            The distance received by the ping
+  /// @param distance           Contains the distance of the sample
+  ///
+  /// @retval The sample returned when the ping completed, RESULT_BUSY if it is held back
+  ///
+  Result Ping(Result result, uint32_t reading, uint32_t& distance)
+  {
+    scripted.SetMeasurement(result, reading);
+
+    uint32_t pings = GetStatistics().pings;
+    distance = 0;
+
+    while (true)
+    {
+      CHECK(simulatedTimeMs - (pingTimesMs.empty() ? 1000 : pingTimesMs.back()) <= CYCLE_TIME_MS + GHOST_SHIFT_MS);
+
+      Result sample = sensor.MeasureDistanceAsync(200, DEFAULT_RELATIVE_HUMIDITY, distance);
+
+      if (GetStatistics().pings != pings)
+      {
+        pingTimesMs.push_back(simulatedTimeMs);
+        return sample;
+      }
+
+      // Nothing is returned between the pings
+      CHECK_EQUAL(RESULT_BUSY, sample);
+      simulatedTimeMs++;
+    }
+  }
+
+  /// @brief Pings a target and checks the sample returned
+  ///
+  void ExpectReading(uint32_t reading, Result expected)
+  {
+    uint32_t distance = 0;
+    CHECK_EQUAL(expected, Ping(RESULT_OK, reading, distance));
+
+    if (expected == RESULT_OK)
+      CHECK_EQUAL(reading, distance);
+  }
+
+  /// @brief Pings without echo and checks that the timeout is returned at once
+  ///
+  void ExpectMiss()
+  {
+    uint32_t distance = 0;
+    CHECK_EQUAL(RESULT_TIMEOUT, Ping(RESULT_TIMEOUT, 0, distance));
+  }
+
+  ContinuousDistanceSensor::Statistics GetStatistics()
+  {
+    ContinuousDistanceSensor::Statistics statistics;
+    sensor.GetStatistics(statistics);
+    return statistics;
+  }
+};
+
+static void TestInit()
+{
+  ScriptedDistanceSensor scripted;
+  IDistanceSensor::Config config;
+  config.name = "Sensor";
+
+  ContinuousDistanceSensor noSensor(nullptr, CYCLE_TIME_MS, GHOST_SHIFT_MS, GHOST_TOLERANCE_MM, GetTime);
+  CHECK_EQUAL(RESULT_BAD_PARAM, noSensor.Init(config));
+
+  ContinuousDistanceSensor noCycle(&scripted, 0, GHOST_SHIFT_MS, GHOST_TOLERANCE_MM, GetTime);
+  CHECK_EQUAL(RESULT_BAD_PARAM, noCycle.Init(config));
+
+  ContinuousDistanceSensor sensor(&scripted, CYCLE_TIME_MS, GHOST_SHIFT_MS, GHOST_TOLERANCE_MM, GetTime);
+  uint32_t distance = 0;
+  CHECK_EQUAL(RESULT_NOT_READY, sensor.MeasureDistanceAsync(200, DEFAULT_RELATIVE_HUMIDITY, distance));
+  CHECK_EQUAL(RESULT_DEV_ERR, sensor.Init(config));
+
+  CHECK_EQUAL(RESULT_OK, scripted.Init(config));
+  CHECK_EQUAL(RESULT_OK, sensor.Init(config));
+  CHECK_EQUAL(RESULT_BUSY, sensor.Init(config));
+}
+
+static void TestSteadyReadings()
+{
+  Pinger pinger;
+
+  // The first reading after the start waits for its confirmation, like after a miss
+  pinger.ExpectReading(1500, RESULT_BUSY);
+  pinger.ExpectReading(1500, RESULT_OK);
+
+  // Then every reading is returned by its own ping, moving or not
+  for (uint32_t i = 0; i < 20; i++)
+    pinger.ExpectReading(1500 - i * 30, RESULT_OK);
+
+  // A car leaving is a timeout at once
+  pinger.ExpectMiss();
+
+  ContinuousDistanceSensor::Statistics statistics = pinger.GetStatistics();
+  CHECK_EQUAL(23, statistics.pings);
+  CHECK_EQUAL(22, statistics.samples);
+  CHECK_EQUAL(0, statistics.ghosts);
+}
+
+static void TestGhosts()
+{
+  Pinger pinger;
+  pinger.ExpectMiss();
+
+  // A late echo of the ping without echo moves with the alternating cycle, it is
+  // returned as the timeout it hides one ping late and never as a distance
+  for (uint32_t i = 0; i < 10; i++)
+    pinger.ExpectReading((i % 2 == 0) ? 400 : 400 + GHOST_STEP_MM, (i == 0) ? RESULT_BUSY : RESULT_TIMEOUT);
+
+  pinger.ExpectMiss();
+
+  ContinuousDistanceSensor::Statistics statistics = pinger.GetStatistics();
+  CHECK_EQUAL(10, statistics.ghosts);
+
+  // A single ghost between two misses
+  pinger.ExpectReading(900, RESULT_BUSY);
+  pinger.ExpectMiss();
+  CHECK_EQUAL(11, pinger.GetStatistics().ghosts);
+}
+
+static void TestArrival()
+{
+  Pinger pinger;
+
+  for (uint32_t i = 0; i < 5; i++)
+    pinger.ExpectMiss();
+
+  // A car arriving is returned by the ping after the one that first saw it
+  pinger.ExpectReading(2900, RESULT_BUSY);
+  uint32_t firstSeenMs = pinger.pingTimesMs.back();
+
+  pinger.ExpectReading(2880, RESULT_OK);
+  uint32_t returnedMs = pinger.pingTimesMs.back();
+
+  CHECK((returnedMs - firstSeenMs == CYCLE_TIME_MS) || (returnedMs - firstSeenMs == CYCLE_TIME_MS + GHOST_SHIFT_MS));
+
+  // Within the tolerance only
+  pinger.ExpectMiss();
+  pinger.ExpectReading(2000, RESULT_BUSY);
+  pinger.ExpectReading(2000 - GHOST_TOLERANCE_MM - 1, RESULT_TIMEOUT);
+  pinger.ExpectReading(2000 - GHOST_TOLERANCE_MM - 1, RESULT_OK);
+  CHECK_EQUAL(1, pinger.GetStatistics().ghosts);
+}
+
+static void TestCycles()
+{
+  Pinger pinger;
+
+  for (uint32_t i = 0; i < 20; i++)
+    pinger.ExpectReading(1500, (i == 0) ? RESULT_BUSY : RESULT_OK);
+
+  // The first ping starts at once, then the cycles alternate between 64 and 60 ms
+  CHECK_EQUAL(1000, pinger.pingTimesMs[0]);
+
+  for (size_t i = 1; i < pinger.pingTimesMs.size(); i++)
+  {
+    uint32_t cycleMs = pinger.pingTimesMs[i] - pinger.pingTimesMs[i - 1];
+    CHECK_EQUAL((i % 2 == 1) ? CYCLE_TIME_MS + GHOST_SHIFT_MS : CYCLE_TIME_MS, cycleMs);
+  }
+}
+
+int main()
+{
+  Logger::SetLogLevel(Logger::Level::OFF);
+
+  TestInit();
+  TestSteadyReadings();
+  TestGhosts();
+  TestArrival();
+  TestCycles();
+
+  return 0;
+}
@@ -0,0 +1,191 @@
+///
+/// @file DualDistanceSensorTest.cpp
+///
+/// @brief Checks that the DualDistanceSensor only fuses the readings pinged close together
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include <Arduino.h>
+#include <math.h>
+#include "DualDistanceSensor.h"
+#include "ScriptedDistanceSensor.h"
+#include "DebugUtils.h"
+#include "HostTest.h"
+
+using namespace CNEGR;
+
+#define BASELINE_MM           1200
+#define CROSSTALK_GUARD_MS    30
+#define MAX_PAIR_INTERVAL_MS  150
+#define PERIOD_MS             100     ///< The time between two measurements
+#define MAX_YAW_ERROR_MRAD    5       ///< The documented accuracy of the yaw estimate
+
+/// @brief Measures after a measurement period
+///
+/// @param dual               The sensor
+/// @param sensor             The sensor pinged by this measurement
+/// @param result             The result of the pinged sensor
+/// @param sensorDistance     The distance of the pinged sensor
+/// @param distance           Contains the fused distance
+///
+/// @retval The fused result
+///
+static Result Measure(DualDistanceSensor& dual, ScriptedDistanceSensor& sensor, Result result, uint32_t sensorDistance, uint32_t& distance)
+{
+  HostAdvanceMicros(PERIOD_MS * 1000);
+  sensor.SetMeasurement(result, sensorDistance);
+
+  distance = 0;
+  return dual.MeasureDistance(200, 50, distance);
+}
+
+/// @brief Places a flat car rear in front of the sensors and checks the fused estimates
+///
+/// The rear is centerMm away from the middle of the baseline and turned by the given
+/// angle, a positive angle moves its right side away. Each sensor reads the distance
+/// along its beam.
+///
+/// @param centerMm           The distance of the rear at the middle of the baseline
+/// @param angleMrad          The yaw angle of the rear
+///
+static void CheckGeometry(uint32_t centerMm, int32_t angleMrad)
+{
+  IDistanceSensor::Config config;
+  config.name = "Dual";
+
+  ScriptedDistanceSensor left;
+  ScriptedDistanceSensor right;
+  CHECK_EQUAL(RESULT_OK, left.Init(config));
+  CHECK_EQUAL(RESULT_OK, right.Init(config));
+
+  DualDistanceSensor dual(&left, &right, BASELINE_MM, CROSSTALK_GUARD_MS, MAX_PAIR_INTERVAL_MS);
+  CHECK_EQUAL(RESULT_OK, dual.Init(config));
+
+  double slope = tan(angleMrad / 1000.0);
+  uint32_t leftMm  = (uint32_t)lround(centerMm - slope * BASELINE_MM / 2);
+  uint32_t rightMm = (uint32_t)lround(centerMm + slope * BASELINE_MM / 2);
+
+  uint32_t distance = 0;
+  CHECK_EQUAL(RESULT_OK, Measure(dual, left, RESULT_OK, leftMm, distance));
+  CHECK_EQUAL(RESULT_OK, Measure(dual, right, RESULT_OK, rightMm, distance));
+
+  // The closest point, the rear covers both beams so there is no offset
+  CHECK_EQUAL((leftMm < rightMm) ? leftMm : rightMm, distance);
+  CHECK_EQUAL(0, dual.GetLateralOffset());
+
+  int32_t expectedMrad = (int32_t)lround(atan(((double)rightMm - (double)leftMm) / BASELINE_MM) * 1000);
+  int32_t yawMrad = dual.GetYaw();
+
+  CHECK(abs(yawMrad - expectedMrad) <= MAX_YAW_ERROR_MRAD);
+  CHECK(abs(yawMrad - angleMrad) <= MAX_YAW_ERROR_MRAD);
+  CHECK((angleMrad == 0) ? (yawMrad == 0) : ((yawMrad > 0) == (angleMrad > 0)));
+
+  // The same rear seen by one sensor only, it is offset towards that sensor
+  CHECK_EQUAL(RESULT_OK, Measure(dual, left, RESULT_TIMEOUT, 0, distance));
+  CHECK_EQUAL(rightMm, distance);
+  CHECK_EQUAL(BASELINE_MM / 2, dual.GetLateralOffset());
+  CHECK_EQUAL(0, dual.GetYaw());
+
+  CHECK_EQUAL(RESULT_TIMEOUT, Measure(dual, right, RESULT_TIMEOUT, 0, distance));
+  CHECK_EQUAL(RESULT_OK, Measure(dual, left, RESULT_OK, leftMm, distance));
+  CHECK_EQUAL(leftMm, distance);
+  CHECK_EQUAL(-BASELINE_MM / 2, dual.GetLateralOffset());
+  CHECK_EQUAL(0, dual.GetYaw());
+}
+
+int main()
+{
+  Logger::SetLogLevel(Logger::Level::OFF);
+  HostSetMicros(1000000);
+
+  IDistanceSensor::Config config;
+  config.name = "Dual";
+
+  ScriptedDistanceSensor left;
+  ScriptedDistanceSensor right;
+  CHECK_EQUAL(RESULT_OK, left.Init(config));
+  CHECK_EQUAL(RESULT_OK, right.Init(config));
+
+  // A pair can't be closer than the guard time
+  DualDistanceSensor bad(&left, &right, BASELINE_MM, CROSSTALK_GUARD_MS, CROSSTALK_GUARD_MS - 1);
+  CHECK_EQUAL(RESULT_BAD_PARAM, bad.Init(config));
+
+  DualDistanceSensor dual(&left, &right, BASELINE_MM, CROSSTALK_GUARD_MS, MAX_PAIR_INTERVAL_MS);
+  CHECK_EQUAL(RESULT_OK, dual.Init(config));
+
+  // The first reading has no pair
+  uint32_t distance = 0;
+  CHECK_EQUAL(RESULT_OK, Measure(dual, left, RESULT_OK, 1000, distance));
+  CHECK_EQUAL(1000, distance);
+  CHECK_EQUAL(0, dual.GetLateralOffset());
+  CHECK_EQUAL(0, dual.GetYaw());
+
+  // The consecutive pings are fused, the right side of the car is further away
+  // atan(200 / 1200) is 165 mrad
+  CHECK_EQUAL(RESULT_OK, Measure(dual, right, RESULT_OK, 1200, distance));
+  CHECK_EQUAL(1000, distance);
+  CHECK_EQUAL(0, dual.GetLateralOffset());
+  CHECK(abs(dual.GetYaw() - 165) <= MAX_YAW_ERROR_MRAD);
+
+  // Only one sensor sees the car, it is offset towards it
+  CHECK_EQUAL(RESULT_OK, Measure(dual, left, RESULT_TIMEOUT, 0, distance));
+  CHECK_EQUAL(1200, distance);
+  CHECK_EQUAL(BASELINE_MM / 2, dual.GetLateralOffset());
+
+  // The measurements pause, the car drives on. Its new position isn't fused with
+  // where it was seen by the other sensor.
+  HostAdvanceMicros(2000000);
+  CHECK_EQUAL(RESULT_OK, Measure(dual, right, RESULT_OK, 500, distance));
+  CHECK_EQUAL(500, distance);
+  CHECK_EQUAL(0, dual.GetLateralOffset());
+  CHECK_EQUAL(0, dual.GetYaw());
+
+  CHECK_EQUAL(RESULT_OK, Measure(dual, left, RESULT_OK, 520, distance));
+  CHECK_EQUAL(500, distance);
+  CHECK(dual.GetYaw() < 0);
+
+  // A sensor that doesn't answer is a missing reading, the other sensor still sees the car
+  CHECK_EQUAL(RESULT_OK, Measure(dual, right, RESULT_DEV_ERR, 0, distance));
+  CHECK_EQUAL(520, distance);
+  CHECK_EQUAL(0, dual.GetLateralOffset());
+  CHECK_EQUAL(0, dual.GetYaw());
+
+  // and it leaves no reading to pair with
+  CHECK_EQUAL(RESULT_OK, Measure(dual, left, RESULT_OK, 540, distance));
+  CHECK_EQUAL(540, distance);
+  CHECK_EQUAL(0, dual.GetLateralOffset());
+
+  CHECK_EQUAL(RESULT_OK, Measure(dual, right, RESULT_DEV_ERR, 0, distance));
+  CHECK_EQUAL(540, distance);
+  CHECK_EQUAL(RESULT_TIMEOUT, Measure(dual, left, RESULT_TIMEOUT, 0, distance));
+  CHECK_EQUAL(RESULT_TIMEOUT, Measure(dual, right, RESULT_DEV_ERR, 0, distance));
+
+  // The sensor answers again
+  CHECK_EQUAL(RESULT_TIMEOUT, Measure(dual, left, RESULT_TIMEOUT, 0, distance));
+  CHECK_EQUAL(RESULT_OK, Measure(dual, right, RESULT_OK, 800, distance));
+  CHECK_EQUAL(800, distance);
+  CHECK_EQUAL(BASELINE_MM / 2, dual.GetLateralOffset());
+
+  // The fault is reported once both sensors are lost, and until one of them answers
+  CHECK_EQUAL(RESULT_OK, Measure(dual, left, RESULT_DEV_ERR, 0, distance));
+  CHECK_EQUAL(800, distance);
+  CHECK_EQUAL(RESULT_DEV_ERR, Measure(dual, right, RESULT_DEV_ERR, 0, distance));
+  CHECK_EQUAL(RESULT_DEV_ERR, Measure(dual, left, RESULT_DEV_ERR, 0, distance));
+  CHECK_EQUAL(RESULT_OK, Measure(dual, right, RESULT_OK, 900, distance));
+  CHECK_EQUAL(900, distance);
+  CHECK_EQUAL(0, dual.GetLateralOffset());
+
+  // Any other error is passed through
+  CHECK_EQUAL(RESULT_HW_FAILURE, Measure(dual, left, RESULT_HW_FAILURE, 0, distance));
+
+  // Up to 45 degrees both ways, where the approximation of the arc tangent ends
+  for (int32_t angleMrad = -785; angleMrad <= 785; angleMrad += 5)
+  {
+    CheckGeometry(1500, angleMrad);
+    CheckGeometry(700, angleMrad);
+  }
+
+  return 0;
+}
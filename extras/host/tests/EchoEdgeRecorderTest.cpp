@@ -0,0 +1,315 @@
+///
+/// @file EchoEdgeRecorderTest.cpp
+///
+/// @brief Checks the EchoEdgeRecorder capture and the analysis of its edges after the telemetry
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include <Arduino.h>
+#include <vector>
+#include "EchoEdgeRecorder.h"
+#include "EchoEdgeAnalysis.h"
+#include "Telemetry.h"
+#include "TelemetryDecoder.h"
+#include "HostTest.h"
+
+using namespace CNEGR;
+
+#define TRIGGER_TIME_US   1000000   ///< The trigger time of the first ping
+#define PING_PERIOD_US    100000    ///< The time between two pings
+
+/// @brief Records the bytes sent by the telemetry
+///
+class RecordingOutput: public Print
+{
+public:
+  virtual size_t write(uint8_t c)
+  {
+    bytes.push_back(c);
+    return 1;
+  }
+
+  using Print::write;
+
+  std::vector<uint8_t> bytes;       ///< The bytes sent
+};
+
+/// @brief Triggers a ping and records its echo pulses
+///
+/// @param recorder           The recorder
+/// @param ping               The ping index, sets its trigger time
+/// @param pulses             The rising and falling edge times since the trigger, in pairs
+/// @param count              The number of edge times, odd for an unterminated pulse
+///
+static void RecordPing(EchoEdgeRecorder& recorder, uint8_t ping, const uint32_t *pulses, uint8_t count)
+{
+  uint32_t triggerTimeUs = TRIGGER_TIME_US + ping * PING_PERIOD_US;
+  recorder.OnTrigger(triggerTimeUs);
+
+  for (uint8_t i = 0; i < count; i++)
+    recorder.OnEdge(triggerTimeUs + pulses[i], (i % 2) == 0);
+}
+
+/// @brief Records the pings used by the analysis and the round trip
+///
+/// Ping 0 is a single echo, ping 1 a glitch and a reflection after the echo, ping 2 an
+/// echo still active at the next trigger.
+///
+static void RecordCapture(EchoEdgeRecorder& recorder)
+{
+  static const uint32_t single[]       = { 460, 6300 };
+  static const uint32_t multipath[]    = { 470, 474, 480, 5100, 9000, 9800 };
+  static const uint32_t unterminated[] = { 450 };
+
+  CHECK_EQUAL(RESULT_OK, recorder.Start(3));
+  RecordPing(recorder, 0, single, 2);
+  RecordPing(recorder, 1, multipath, 6);
+  RecordPing(recorder, 2, unterminated, 1);
+
+  // The next trigger ends the capture
+  recorder.OnTrigger(TRIGGER_TIME_US + 3 * PING_PERIOD_US);
+}
+
+/// @brief Sends the recorded edges like the 'edges' console command of DistanceMeasurement.ino
+///
+static void SendEdges(Telemetry& telemetry, const EchoEdgeRecorder& recorder)
+{
+  TelemetryEchoEdges message;
+  message.totalCount = recorder.GetEdgeCount();
+  message.lostCount  = recorder.GetLostEdgeCount();
+
+  uint8_t index = 0;
+  do
+  {
+    message.firstIndex = index;
+    message.count      = 0;
+
+    while ((message.count < TELEMETRY_MAX_ECHO_EDGES) &&
+           (recorder.GetEdge(index, message.edges[message.count]) == RESULT_OK))
+    {
+      message.count++;
+      index++;
+    }
+
+    CHECK_EQUAL(RESULT_OK, telemetry.Send(message));
+  }
+  while (index < message.totalCount);
+}
+
+/// @brief Receives the edge frames into a capture
+///
+/// @param bytes              The bytes sent by the telemetry
+/// @param skippedFrame       The index of an edges frame to drop, -1 to receive them all
+/// @param capture            Contains the capture
+///
+/// @retval The number of edges frames received
+///
+static uint32_t Receive(const std::vector<uint8_t>& bytes, int skippedFrame, EchoEdgeCapture& capture)
+{
+  TelemetryDecoder decoder;
+  uint32_t frames = 0;
+
+  for (size_t i = 0; i < bytes.size(); i++)
+  {
+    if ((decoder.Push(bytes[i]) != RESULT_OK) || (decoder.GetType() != TelemetryEchoEdgesMessage))
+      continue;
+
+    if ((int)frames++ == skippedFrame)
+      continue;
+
+    TelemetryEchoEdges message;
+    CHECK_EQUAL(RESULT_OK, DecodeTelemetryPayload(decoder.GetPayload(), decoder.GetPayloadLength(), message));
+
+    Result result = capture.Add(message);
+    if (skippedFrame < 0)
+      CHECK_EQUAL(RESULT_OK, result);
+  }
+
+  return frames;
+}
+
+static void TestRecorder()
+{
+  EchoEdgeRecorder recorder;
+  CHECK_EQUAL(RESULT_BAD_PARAM, recorder.Start(0));
+
+  // Nothing is recorded before the start and the first trigger
+  recorder.OnTrigger(TRIGGER_TIME_US);
+  recorder.OnEdge(TRIGGER_TIME_US + 500, true);
+  CHECK_EQUAL(0, recorder.GetEdgeCount());
+
+  CHECK_EQUAL(RESULT_OK, recorder.Start(2));
+  CHECK(recorder.IsActive());
+  recorder.OnEdge(TRIGGER_TIME_US + 500, true);
+  CHECK_EQUAL(0, recorder.GetEdgeCount());
+  CHECK_EQUAL(0, recorder.GetPingCount());
+
+  // The times are relative to the trigger of their ping, and saturated
+  static const uint32_t pulse[] = { 500, 70000 };
+  RecordPing(recorder, 0, pulse, 2);
+  CHECK_EQUAL(1, recorder.GetPingCount());
+  RecordPing(recorder, 1, pulse, 1);
+  CHECK_EQUAL(2, recorder.GetPingCount());
+
+  EchoEdge edge;
+  CHECK_EQUAL(RESULT_OK, recorder.GetEdge(1, edge));
+  CHECK_EQUAL(0, edge.ping);
+  CHECK_EQUAL(0, edge.level);
+  CHECK_EQUAL(UINT16_MAX, edge.timeUs);
+  CHECK_EQUAL(RESULT_OK, recorder.GetEdge(2, edge));
+  CHECK_EQUAL(1, edge.ping);
+  CHECK_EQUAL(1, edge.level);
+  CHECK_EQUAL(500, edge.timeUs);
+  CHECK_EQUAL(RESULT_BAD_PARAM, recorder.GetEdge(3, edge));
+
+  // The trigger after the last ping stops the capture, the edges are kept
+  recorder.OnTrigger(TRIGGER_TIME_US + 2 * PING_PERIOD_US);
+  CHECK(!recorder.IsActive());
+  recorder.OnEdge(TRIGGER_TIME_US + 2 * PING_PERIOD_US + 500, true);
+  CHECK_EQUAL(3, recorder.GetEdgeCount());
+  CHECK_EQUAL(2, recorder.GetPingCount());
+  CHECK_EQUAL(0, recorder.GetLostEdgeCount());
+
+  // The edges that don't fit are counted, up to 255
+  CHECK_EQUAL(RESULT_OK, recorder.Start(1));
+  CHECK_EQUAL(0, recorder.GetEdgeCount());
+  recorder.OnTrigger(TRIGGER_TIME_US);
+
+  for (uint32_t i = 0; i < ECHO_EDGE_RECORDER_SIZE + 8; i++)
+    recorder.OnEdge(TRIGGER_TIME_US + 100 + i, (i % 2) == 0);
+
+  CHECK_EQUAL(ECHO_EDGE_RECORDER_SIZE, recorder.GetEdgeCount());
+  CHECK_EQUAL(8, recorder.GetLostEdgeCount());
+
+  for (uint32_t i = 0; i < 300; i++)
+    recorder.OnEdge(TRIGGER_TIME_US + 200 + i, (i % 2) == 0);
+
+  CHECK_EQUAL(UINT8_MAX, recorder.GetLostEdgeCount());
+
+  // Stopped by hand
+  recorder.Stop();
+  CHECK(!recorder.IsActive());
+  CHECK_EQUAL(ECHO_EDGE_RECORDER_SIZE, recorder.GetEdgeCount());
+}
+
+static void TestAnalysis()
+{
+  EchoEdgeRecorder recorder;
+  RecordCapture(recorder);
+
+  EchoEdge edges[ECHO_EDGE_RECORDER_SIZE];
+  uint8_t count = recorder.GetEdgeCount();
+  CHECK_EQUAL(9, count);
+
+  for (uint8_t i = 0; i < count; i++)
+    CHECK_EQUAL(RESULT_OK, recorder.GetEdge(i, edges[i]));
+
+  EchoPulseStatistics statistics;
+  CHECK_EQUAL(RESULT_BAD_PARAM, AnalyzeEchoEdges(nullptr, count, 0, statistics));
+  CHECK_EQUAL(RESULT_NO_DATA, AnalyzeEchoEdges(edges, count, 3, statistics));
+
+  CHECK_EQUAL(RESULT_OK, AnalyzeEchoEdges(edges, count, 0, statistics));
+  CHECK_EQUAL(2, statistics.edgeCount);
+  CHECK_EQUAL(1, statistics.pulseCount);
+  CHECK_EQUAL(460, statistics.firstRiseUs);
+  CHECK_EQUAL(5840, statistics.firstWidthUs);
+  CHECK_EQUAL(6300, statistics.lastFallUs);
+  CHECK_EQUAL(5840, statistics.shortestWidthUs);
+  CHECK(!statistics.unterminated);
+
+  // The glitch is the first pulse, the measurement would report it
+  CHECK_EQUAL(RESULT_OK, AnalyzeEchoEdges(edges, count, 1, statistics));
+  CHECK_EQUAL(6, statistics.edgeCount);
+  CHECK_EQUAL(3, statistics.pulseCount);
+  CHECK_EQUAL(470, statistics.firstRiseUs);
+  CHECK_EQUAL(4, statistics.firstWidthUs);
+  CHECK_EQUAL(9800, statistics.lastFallUs);
+  CHECK_EQUAL(4, statistics.shortestWidthUs);
+
+  CHECK_EQUAL(RESULT_OK, AnalyzeEchoEdges(edges, count, 2, statistics));
+  CHECK_EQUAL(1, statistics.edgeCount);
+  CHECK_EQUAL(0, statistics.pulseCount);
+  CHECK_EQUAL(450, statistics.firstRiseUs);
+  CHECK_EQUAL(0, statistics.shortestWidthUs);
+  CHECK(statistics.unterminated);
+}
+
+static void TestRoundTrip()
+{
+  // A full capture, the edges span several frames and the last 2 pings don't fit
+  EchoEdgeRecorder recorder;
+  CHECK_EQUAL(RESULT_OK, recorder.Start(10));
+
+  for (uint8_t ping = 0; ping < 10; ping++)
+  {
+    uint32_t pulses[] = { 460u + ping, 5000u + ping * 100, 8000, 8600 };
+    RecordPing(recorder, ping, pulses, 4);
+  }
+
+  CHECK_EQUAL(ECHO_EDGE_RECORDER_SIZE, recorder.GetEdgeCount());
+  CHECK_EQUAL(8, recorder.GetLostEdgeCount());
+
+  RecordingOutput output;
+  Telemetry telemetry;
+  CHECK_EQUAL(RESULT_OK, telemetry.Init(&output));
+  telemetry.SetEnabled(true);
+  SendEdges(telemetry, recorder);
+
+  EchoEdgeCapture capture;
+  uint32_t frames = Receive(output.bytes, -1, capture);
+  CHECK_EQUAL((ECHO_EDGE_RECORDER_SIZE + TELEMETRY_MAX_ECHO_EDGES - 1) / TELEMETRY_MAX_ECHO_EDGES, frames);
+
+  CHECK(capture.IsComplete());
+  CHECK_EQUAL(recorder.GetEdgeCount(), capture.GetEdgeCount());
+  CHECK_EQUAL(recorder.GetLostEdgeCount(), capture.GetLostEdgeCount());
+  CHECK_EQUAL(8, capture.GetPingCount());
+
+  for (uint8_t i = 0; i < capture.GetEdgeCount(); i++)
+  {
+    EchoEdge edge;
+    CHECK_EQUAL(RESULT_OK, recorder.GetEdge(i, edge));
+    CHECK_EQUAL(edge.ping, capture.GetEdges()[i].ping);
+    CHECK_EQUAL(edge.level, capture.GetEdges()[i].level);
+    CHECK_EQUAL(edge.timeUs, capture.GetEdges()[i].timeUs);
+  }
+
+  EchoPulseStatistics statistics;
+  CHECK_EQUAL(RESULT_OK, AnalyzeEchoEdges(capture.GetEdges(), capture.GetEdgeCount(), 3, statistics));
+  CHECK_EQUAL(2, statistics.pulseCount);
+  CHECK_EQUAL(463, statistics.firstRiseUs);
+  CHECK_EQUAL(5300 - 463, statistics.firstWidthUs);
+
+  // A lost frame in the middle of the capture is detected
+  EchoEdgeCapture partial;
+  Receive(output.bytes, 2, partial);
+  CHECK(!partial.IsComplete());
+
+  // An empty capture is one frame without edges
+  CHECK_EQUAL(RESULT_OK, recorder.Start(1));
+  output.bytes.clear();
+  SendEdges(telemetry, recorder);
+
+  EchoEdgeCapture empty;
+  CHECK_EQUAL(1, Receive(output.bytes, -1, empty));
+  CHECK(empty.IsComplete());
+  CHECK_EQUAL(0, empty.GetPingCount());
+
+  // The message must fit in the capture
+  TelemetryEchoEdges message;
+  memset(&message, 0, sizeof(message));
+  message.firstIndex = ECHO_EDGE_RECORDER_SIZE - 1;
+  message.count      = 2;
+  message.totalCount = ECHO_EDGE_RECORDER_SIZE;
+  CHECK_EQUAL(RESULT_BAD_PARAM, capture.Add(message));
+}
+
+int main()
+{
+  TestRecorder();
+  TestAnalysis();
+  TestRoundTrip();
+
+  return 0;
+}
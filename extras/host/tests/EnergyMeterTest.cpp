@@ -0,0 +1,76 @@
+///
+/// @file EnergyMeterTest.cpp
+///
+/// @brief Checks the charge computed by the EnergyMeter
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "EnergyMeter.h"
+#include "HostTest.h"
+
+using namespace CNEGR;
+
+int main()
+{
+  const EnergyMeter::Model model = { 9000, 2700, 2000, 15000, 38000, 10000 };
+  EnergyMeter meter;
+  EnergyMeter::Totals totals;
+
+  // Nothing is accounted before Init()
+  meter.AddInterval(1000000, 100000, 1);
+  meter.AddPing(5000);
+  CHECK(!meter.IsInitialized());
+  CHECK_EQUAL(0, meter.GetAverageCurrent());
+
+  CHECK_EQUAL(RESULT_OK, meter.Init(model));
+  CHECK_EQUAL(RESULT_BUSY, meter.Init(model));
+  CHECK_EQUAL(0, meter.GetAverageCurrent());
+
+  // One second with the MCU running 100 ms, one light on, a ping with an echo
+  // after 5 ms and a ping without echo lasting the sensor timeout
+  meter.AddInterval(1000000, 100000, 1);
+  meter.AddPing(5000);
+  meter.AddPing(0);
+
+  meter.GetTotals(totals);
+  CHECK_EQUAL(1000000, totals.elapsedUs);
+  CHECK_EQUAL(100000, totals.mcuActiveUs);
+  CHECK_EQUAL(43000, totals.sensorPingUs);
+  CHECK_EQUAL(1000000, totals.lightOnUs);
+  CHECK_EQUAL(2, totals.pings);
+
+  // 100 ms * 9 mA + 900 ms * 2.7 mA + 43 ms * 15 mA + 957 ms * 2 mA + 1 s * 10 mA
+  CHECK_EQUAL(15889, meter.GetAverageCurrent());
+  CHECK_EQUAL(15889 * 24, meter.GetDailyCharge());
+
+  // The active time is limited to the interval
+  EnergyMeter busy;
+  CHECK_EQUAL(RESULT_OK, busy.Init(model));
+  busy.AddInterval(1000, 5000, 0);
+  busy.GetTotals(totals);
+  CHECK_EQUAL(1000, totals.mcuActiveUs);
+  CHECK_EQUAL(model.mcuActiveUa + model.sensorIdleUa, busy.GetAverageCurrent());
+
+  // Merging an identical meter doubles the times but keeps the average
+  EnergyMeter merged;
+  CHECK_EQUAL(RESULT_OK, merged.Init(model));
+  meter.GetTotals(totals);
+  merged.AddTotals(totals);
+  merged.AddTotals(totals);
+  merged.GetTotals(totals);
+  CHECK_EQUAL(2000000, totals.elapsedUs);
+  CHECK_EQUAL(4, totals.pings);
+  CHECK_EQUAL(meter.GetAverageCurrent(), merged.GetAverageCurrent());
+
+  // A new model applies to the accumulated times
+  EnergyMeter::Model dark = model;
+  dark.lightUa = 0;
+  meter.Deinit();
+  CHECK_EQUAL(RESULT_OK, meter.Init(dark));
+  meter.AddTotals(totals);
+  CHECK_EQUAL(15889 - 10000, meter.GetAverageCurrent());
+
+  return 0;
+}
@@ -0,0 +1,92 @@
+///
+/// @file EventBusTest.cpp
+///
+/// @brief Checks the EventBus dispatch order and the event filtering
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "EventBus.h"
+#include "Events.h"
+#include "HostTest.h"
+#include <string>
+
+using namespace CNEGR;
+
+static std::string calls;     ///< The handlers called, in order
+
+/// @brief Handles the samples and the state changes
+///
+struct FirstSubscriber: public EventSubscriber
+{
+  using EventSubscriber::OnEvent;
+
+  static void OnEvent(const SampleEvent& event)
+  {
+    calls += "first:sample:" + std::to_string(event.trackedDistanceMm) + " ";
+  }
+
+  static void OnEvent(const StateChangedEvent& event)
+  {
+    calls += "first:state:" + std::to_string(event.toState) + " ";
+  }
+};
+
+/// @brief Handles the samples only
+///
+struct SecondSubscriber: public EventSubscriber
+{
+  using EventSubscriber::OnEvent;
+
+  static void OnEvent(const SampleEvent& event)
+  {
+    calls += "second:sample:" + std::to_string(event.trackedDistanceMm) + " ";
+  }
+};
+
+/// @brief Handles the faults only
+///
+struct FaultSubscriber: public EventSubscriber
+{
+  using EventSubscriber::OnEvent;
+
+  static void OnEvent(const FaultEvent& event)
+  {
+    calls += "fault:" + std::to_string((int)event.result) + " ";
+  }
+};
+
+int main()
+{
+  SampleEvent sample = { 1000, 1500, 1490, 1480, -250, 2 };
+  StateChangedEvent stateChanged = { 1100, 2, 3 };
+  FaultEvent fault = { 1200, RESULT_TIMEOUT };
+
+  // The subscribers receive the events in the list order, and only the events they handle
+  typedef EventBus<FirstSubscriber, SecondSubscriber, FaultSubscriber> Bus;
+
+  Bus::Publish(sample);
+  CHECK(calls == "first:sample:1480 second:sample:1480 ");
+
+  calls.clear();
+  Bus::Publish(stateChanged);
+  CHECK(calls == "first:state:3 ");
+
+  calls.clear();
+  Bus::Publish(fault);
+  CHECK(calls == "fault:" + std::to_string((int)RESULT_TIMEOUT) + " ");
+
+  // The order of the list is the order of the calls
+  calls.clear();
+  EventBus<SecondSubscriber, FirstSubscriber>::Publish(sample);
+  CHECK(calls == "second:sample:1480 first:sample:1480 ");
+
+  // A bus without an interested subscriber, or without subscribers, drops the event
+  calls.clear();
+  EventBus<SecondSubscriber>::Publish(fault);
+  EventBus<>::Publish(sample);
+  CHECK(calls.empty());
+
+  return 0;
+}
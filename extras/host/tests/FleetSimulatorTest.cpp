@@ -0,0 +1,120 @@
+///
+/// @file FleetSimulatorTest.cpp
+///
+/// @brief Checks that the fleet simulator results don't depend on the worker threads
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include <Arduino.h>
+#include "FleetSimulator.h"
+#include "HostTest.h"
+
+using namespace CNEGR;
+
+/// @brief Fills the configuration with the defaults of the sketch
+///
+/// @param config             The configuration to fill
+/// @param threadCount        The number of worker threads
+///
+static void GetConfig(FleetSimulator::Config& config, uint16_t threadCount)
+{
+  memset(&config, 0, sizeof(config));
+
+  // Five shards, the last one partly filled
+  config.bayCount     = 4 * FLEETSIMULATOR_SHARD_BAYS + 17;
+  config.threadCount  = threadCount;
+  config.periodMs     = 120;
+  config.durationMs   = 15 * 60000;
+  config.seed         = 7;
+
+  config.scenario.startDistanceMm = 3500;
+  config.scenario.stopDistanceMm  = 500;
+  config.scenario.speedMmPerS     = 800;
+  config.scenario.emptyTimeMs     = 60000;
+  config.scenario.parkedTimeMs    = 120000;
+  config.scenario.noiseMm         = 15;
+  config.scenario.dropoutPercent  = 5;
+  config.scenario.spikePercent    = 2;
+
+  StateMachine::Config& stateMachine = config.stateMachine;
+  stateMachine.maxDistanceThresholdMm             = 3000;
+  stateMachine.farThresholdMm                     = 1500;
+  stateMachine.nearThresholdMm                    = 600;
+  stateMachine.movingDistanceDetectionThresholdMm = 50;
+  stateMachine.movingTimeThresholdMs              = 100;
+  stateMachine.holdingTimeThresholdMs             = 2000;
+  stateMachine.deferLightsTest                    = true;
+  stateMachine.outlierFilter.thresholdX16         = 71;
+  stateMachine.outlierFilter.minDeviationMm       = 40;
+  stateMachine.classifier.persistenceSamples      = 5;
+  stateMachine.classifier.maxStepMm               = 150;
+  stateMachine.classifier.maxMissedSamples        = 2;
+  stateMachine.tracker.alpha                      = Q16_FROM_RATIO(1, 2);
+  stateMachine.tracker.beta                       = Q16_FROM_RATIO(1, 8);
+  stateMachine.tracker.maxPredictedSamples        = 5;
+
+  config.energy.mcuActiveUa     = 9000;
+  config.energy.mcuSleepUa      = 2700;
+  config.energy.sensorIdleUa    = 2000;
+  config.energy.sensorPingUa    = 15000;
+  config.energy.sensorTimeoutUs = 38000;
+  config.energy.lightUa         = 10000;
+  config.updateActiveTimeUs     = 2000;
+  config.sleepWhenIdle          = true;
+}
+
+/// @brief Runs a fleet
+///
+/// @param threadCount        The number of worker threads
+/// @param results            Contains the results
+///
+static void RunFleet(uint16_t threadCount, FleetSimulator::Results& results)
+{
+  FleetSimulator::Config config;
+  GetConfig(config, threadCount);
+
+  FleetSimulator simulator;
+  CHECK_EQUAL(RESULT_OK, simulator.Init(config));
+
+  // A second simulator can't share the clocks
+  FleetSimulator other;
+  CHECK_EQUAL(RESULT_BUSY, other.Init(config));
+
+  CHECK_EQUAL(RESULT_OK, simulator.Run(results));
+  CHECK_EQUAL(threadCount, results.threadCount);
+}
+
+int main()
+{
+  FleetSimulator::Results single;
+  FleetSimulator::Results sharded;
+
+  RunFleet(1, single);
+  RunFleet(3, sharded);
+
+  // Every bay parked several cars which all saw the red light. The lights of an empty
+  // bay only stay on while the bay goes back to idle after the car left
+  CHECK_EQUAL(15 * 60000, single.simulatedTimeMs);
+  CHECK(single.arrivals >= single.bayCount);
+  CHECK_EQUAL(single.arrivals, single.redShown);
+  CHECK(single.emptyBayLightUpdates < single.updates / 1000);
+  CHECK(single.outliers != 0);
+  CHECK(single.averageCurrentUa != 0);
+
+  // The shards run the same updates whatever thread runs them
+  CHECK_EQUAL(single.updates, sharded.updates);
+  CHECK_EQUAL(single.timeouts, sharded.timeouts);
+  CHECK_EQUAL(single.transitions, sharded.transitions);
+  CHECK_EQUAL(single.outliers, sharded.outliers);
+  CHECK_EQUAL(single.rejectedTargets, sharded.rejectedTargets);
+  CHECK_EQUAL(single.arrivals, sharded.arrivals);
+  CHECK_EQUAL(single.redShown, sharded.redShown);
+  CHECK_EQUAL(single.emptyBayLightUpdates, sharded.emptyBayLightUpdates);
+  CHECK_EQUAL(single.averageCurrentUa, sharded.averageCurrentUa);
+  CHECK_EQUAL(single.mcuActivePermille, sharded.mcuActivePermille);
+  CHECK_EQUAL(single.lightOnPermille, sharded.lightOnPermille);
+
+  return 0;
+}
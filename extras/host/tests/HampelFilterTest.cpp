@@ -0,0 +1,110 @@
+///
+/// @file HampelFilterTest.cpp
+///
+/// @brief Checks that the HampelFilter replaces the spikes and accepts the steps
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "HampelFilter.h"
+#include "HostTest.h"
+
+using namespace CNEGR;
+
+#define IDLE_MM     2800        ///< The wall of an empty bay
+
+/// @brief Initializes a filter with the configuration of DistanceMeasurement.ino
+///
+static void Init(HampelFilter& filter)
+{
+  HampelFilter::Config config = { 71, 40 };
+  CHECK_EQUAL(RESULT_OK, filter.Init(config));
+}
+
+/// @brief Fills the window with readings around the idle distance
+///
+static void Fill(HampelFilter& filter)
+{
+  static const uint32_t readings[] = { IDLE_MM - 4, IDLE_MM + 3, IDLE_MM, IDLE_MM + 6, IDLE_MM - 2 };
+
+  for (uint8_t i = 0; i < HAMPEL_WINDOW_SIZE; i++)
+    CHECK_EQUAL(readings[i], filter.Filter(readings[i]));
+}
+
+static void TestInit()
+{
+  HampelFilter filter;
+  HampelFilter::Config config = { 0, 40 };
+  CHECK_EQUAL(RESULT_BAD_PARAM, filter.Init(config));
+
+  // Until the window is filled the readings are passed through, spikes too
+  Init(filter);
+  CHECK_EQUAL(IDLE_MM, filter.Filter(IDLE_MM));
+  CHECK_EQUAL(1300, filter.Filter(1300));
+  CHECK_EQUAL(0, filter.GetOutlierCount());
+}
+
+static void TestSpike()
+{
+  HampelFilter filter;
+  Init(filter);
+  Fill(filter);
+
+  // The window now holds 1300, 2803, 2800, 2806 and 2798, the median is 2800
+  CHECK_EQUAL(IDLE_MM, filter.Filter(1300));
+  CHECK_EQUAL(1, filter.GetOutlierCount());
+
+  // A spike away from the sensor too, the median is still 2800
+  CHECK_EQUAL(IDLE_MM, filter.Filter(4000));
+  CHECK_EQUAL(2, filter.GetOutlierCount());
+
+  // The noise is passed through
+  CHECK_EQUAL(IDLE_MM + 5, filter.Filter(IDLE_MM + 5));
+  CHECK_EQUAL(IDLE_MM - 5, filter.Filter(IDLE_MM - 5));
+  CHECK_EQUAL(2, filter.GetOutlierCount());
+
+  filter.Reset();
+  CHECK_EQUAL(0, filter.GetOutlierCount());
+  CHECK_EQUAL(1300, filter.Filter(1300));
+}
+
+static void TestSteadyReadings()
+{
+  HampelFilter filter;
+  Init(filter);
+
+  for (uint8_t i = 0; i < HAMPEL_WINDOW_SIZE; i++)
+    filter.Filter(IDLE_MM);
+
+  // The MAD is zero, only a deviation beyond minDeviationMm is an outlier
+  CHECK_EQUAL(IDLE_MM + 40, filter.Filter(IDLE_MM + 40));
+  CHECK_EQUAL(IDLE_MM, filter.Filter(IDLE_MM + 41));
+  CHECK_EQUAL(1, filter.GetOutlierCount());
+}
+
+static void TestStep()
+{
+  HampelFilter filter;
+  Init(filter);
+  Fill(filter);
+
+  // A car stopping in the beam, the median follows on the third reading
+  CHECK_EQUAL(IDLE_MM, filter.Filter(1000));
+  CHECK_EQUAL(IDLE_MM - 2, filter.Filter(1000));
+  CHECK_EQUAL(1000, filter.Filter(1000));
+  CHECK_EQUAL(2, filter.GetOutlierCount());
+
+  CHECK_EQUAL(1002, filter.Filter(1002));
+  CHECK_EQUAL(2, filter.GetOutlierCount());
+}
+
+int main()
+{
+  TestInit();
+  TestSpike();
+  TestSteadyReadings();
+  TestStep();
+
+  return 0;
+}
@@ -0,0 +1,42 @@
+///
+/// @file HostTest.h
+///
+/// @brief The checks used by the host tests
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+#pragma once
+
+#if !defined(_HOSTTEST_H_)
+#define _HOSTTEST_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/// Fails the test when the condition is false, the checks stay enabled in the release builds
+#define CHECK(condition)                                                              \
+  do                                                                                  \
+  {                                                                                   \
+    if (!(condition))                                                                 \
+    {                                                                                 \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition);   \
+      exit(1);                                                                        \
+    }                                                                                 \
+  } while(0)
+
+/// Fails the test when the values differ, and prints both values
+#define CHECK_EQUAL(expected, actual)                                                 \
+  do                                                                                  \
+  {                                                                                   \
+    long long expectedValue = (long long)(expected);                                  \
+    long long actualValue   = (long long)(actual);                                    \
+    if (expectedValue != actualValue)                                                 \
+    {                                                                                 \
+      fprintf(stderr, "%s:%d: CHECK_EQUAL(%s, %s) failed: %lld != %lld\n",            \
+              __FILE__, __LINE__, #expected, #actual, expectedValue, actualValue);    \
+      exit(1);                                                                        \
+    }                                                                                 \
+  } while(0)
+
+#endif // _HOSTTEST_H_
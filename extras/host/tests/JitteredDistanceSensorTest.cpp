@@ -0,0 +1,267 @@
+///
+/// @file JitteredDistanceSensorTest.cpp
+///
+/// @brief Simulates two neighbouring bays hearing each other's pings
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include <Arduino.h>
+#include <deque>
+#include "JitteredDistanceSensor.h"
+#include "DebugUtils.h"
+#include "HostTest.h"
+
+using namespace CNEGR;
+
+#define SIMULATION_STEP_US      50          ///< The resolution of the simulated time
+#define SIMULATION_DURATION_S   600         ///< The simulated time
+#define CROSSTALK_DELAY_US      5800        ///< The flight time of a ping to the other bay's sensor, 2 m
+#define PING_BLANKING_US        400         ///< The sensor doesn't listen right after its own burst
+#define CORRECT_TOLERANCE_MM    100         ///< A reading closer than this to the car is correct
+
+/// @brief The sensor of a bay, hearing the pings of the other bay
+///
+/// The reading is the first of the bay's own echo and the burst of the other sensor,
+/// like the HC-SR04 which reports the first pulse it receives.
+///
+class CrosstalkSensor: public IDistanceSensor
+{
+public:
+  CrosstalkSensor(uint32_t distanceMm)
+    :_initDone(false),
+     _busy(false),
+     _pingUs(0),
+     _distanceMm(distanceMm),
+     _other(nullptr)
+  {
+  }
+
+  void SetOther(const CrosstalkSensor *other)
+  {
+    _other = other;
+  }
+
+  uint32_t GetDistance() const
+  {
+    return _distanceMm;
+  }
+
+  virtual Result Init(const Config& configuration)
+  {
+    (void)configuration;
+    _initDone = true;
+    return RESULT_OK;
+  }
+
+  virtual bool IsInitialized() const
+  {
+    return _initDone;
+  }
+
+  virtual void Deinit()
+  {
+    _initDone = false;
+  }
+
+  virtual Result MeasureDistance(uint32_t& distance)
+  {
+    (void)distance;
+    return RESULT_NOT_SUP;
+  }
+
+  virtual Result MeasureDistance(uint32_t ambientTemperature, uint32_t& distance)
+  {
+    (void)ambientTemperature;
+    (void)distance;
+    return RESULT_NOT_SUP;
+  }
+
+  virtual Result MeasureDistance(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance)
+  {
+    (void)ambientTemperature;
+    (void)relativeHumidity;
+    (void)distance;
+    return RESULT_NOT_SUP;
+  }
+
+  virtual Result MeasureDistanceAsync(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance)
+  {
+    (void)ambientTemperature;
+    (void)relativeHumidity;
+
+    uint32_t now = micros();
+
+    if (!_busy)
+    {
+      _busy   = true;
+      _pingUs = now;
+      _pings.push_back(now);
+
+      if (_pings.size() > 8)
+        _pings.pop_front();
+
+      return RESULT_BUSY;
+    }
+
+    uint32_t echoUs = (uint32_t)((uint64_t)_distanceMm * 2000000 / 343000);
+    if (now - _pingUs < echoUs)
+      return RESULT_BUSY;
+
+    _busy = false;
+
+    for (size_t i = 0; i < _other->_pings.size(); i++)
+    {
+      uint32_t arrivalUs = _other->_pings[i] + CROSSTALK_DELAY_US - _pingUs;
+      if ((arrivalUs > PING_BLANKING_US) && (arrivalUs < echoUs))
+        echoUs = arrivalUs;
+    }
+
+    distance = (uint32_t)((uint64_t)echoUs * 343000 / 2000000);
+    return RESULT_OK;
+  }
+
+  virtual Result SetRangeLimit(uint32_t rangeLimitMm)
+  {
+    (void)rangeLimitMm;
+    return RESULT_OK;
+  }
+
+private:
+  bool                    _initDone;      ///< A flag to indicate whether the sensor was initialized
+  bool                    _busy;          ///< A flag to indicate that a ping is in flight
+  uint32_t                _pingUs;        ///< The time of the current ping
+  uint32_t                _distanceMm;    ///< The distance of the parked car
+  const CrosstalkSensor   *_other;        ///< The sensor of the other bay
+  std::deque<uint32_t>    _pings;         ///< The times of the last pings
+};
+
+/// @brief The readings of a bay
+///
+struct BayResults
+{
+  uint32_t  correct;                      ///< The readings of the bay's own car
+  uint32_t  wrong;                        ///< The readings of the other sensor's burst
+  uint32_t  rejected;                     ///< The readings reported as timeouts
+};
+
+/// @brief Runs the two bays, the boards having slightly different ping periods
+///
+/// @param jitterMs           The longest random delay before a ping, or 0 for the bare sensors
+/// @param results            Contains the readings of the two bays
+///
+static void Simulate(uint32_t jitterMs, BayResults results[2])
+{
+  HostSetMicros(0);
+
+  IDistanceSensor::Config config;
+  config.name = "Bay";
+
+  CrosstalkSensor sensors[2] = { CrosstalkSensor(1500), CrosstalkSensor(1000) };
+  sensors[0].SetOther(&sensors[1]);
+  sensors[1].SetOther(&sensors[0]);
+
+  JitteredDistanceSensor jittered0(&sensors[0], jitterMs, 150, 12345, nullptr);
+  JitteredDistanceSensor jittered1(&sensors[1], jitterMs, 150, 777, nullptr);
+  IDistanceSensor *measured[2] = { &sensors[0], &sensors[1] };
+
+  for (int i = 0; i < 2; i++)
+    CHECK_EQUAL(RESULT_OK, sensors[i].Init(config));
+
+  if (jitterMs != 0)
+  {
+    CHECK_EQUAL(RESULT_OK, jittered0.Init(config));
+    CHECK_EQUAL(RESULT_OK, jittered1.Init(config));
+    measured[0] = &jittered0;
+    measured[1] = &jittered1;
+  }
+
+  const uint32_t periodUs[2] = { 100000, 100020 };
+  uint32_t nextUs[2]         = { 0, 37000 };
+  bool     pending[2]        = { false, false };
+
+  memset(results, 0, 2 * sizeof(BayResults));
+
+  for (uint64_t now = 0; now < (uint64_t)SIMULATION_DURATION_S * 1000000; now += SIMULATION_STEP_US)
+  {
+    HostSetMicros((uint32_t)now);
+
+    for (int i = 0; i < 2; i++)
+    {
+      if (!pending[i] && (now >= nextUs[i]))
+      {
+        pending[i] = true;
+        nextUs[i] += periodUs[i];
+      }
+
+      if (!pending[i])
+        continue;
+
+      uint32_t distance = 0;
+      Result result = measured[i]->MeasureDistanceAsync(200, 50, distance);
+      if (result == RESULT_BUSY)
+        continue;
+
+      pending[i] = false;
+
+      if (result != RESULT_OK)
+      {
+        CHECK_EQUAL(RESULT_TIMEOUT, result);
+        results[i].rejected++;
+      }
+      else if (abs((int32_t)distance - (int32_t)sensors[i].GetDistance()) <= CORRECT_TOLERANCE_MM)
+      {
+        results[i].correct++;
+      }
+      else
+      {
+        results[i].wrong++;
+      }
+    }
+  }
+
+  if (jitterMs != 0)
+  {
+    JitteredDistanceSensor::Statistics statistics;
+    jittered0.GetStatistics(statistics);
+    CHECK_EQUAL(results[0].rejected, statistics.rejected);
+    CHECK_EQUAL(results[0].correct + results[0].wrong + results[0].rejected, statistics.readings);
+  }
+}
+
+int main()
+{
+  Logger::SetLogLevel(Logger::Level::OFF);
+
+  BayResults bare[2];
+  BayResults jittered[2];
+
+  Simulate(0, bare);
+  Simulate(20, jittered);
+
+  for (int i = 0; i < 2; i++)
+  {
+    uint32_t bareCount     = bare[i].correct + bare[i].wrong + bare[i].rejected;
+    uint32_t jitteredCount = jittered[i].correct + jittered[i].wrong + jittered[i].rejected;
+
+    printf("bay %d: bare %u correct, %u wrong; jittered %u correct, %u wrong, %u rejected\n", i,
+           bare[i].correct, bare[i].wrong, jittered[i].correct, jittered[i].wrong, jittered[i].rejected);
+
+    // Every ping gets an answer, the jitter only delays some of them
+    CHECK(bareCount >= SIMULATION_DURATION_S * 9);
+    CHECK(jitteredCount >= SIMULATION_DURATION_S * 8);
+
+    // The overlapping pings of the bare sensors last for seconds and give
+    // a few percent of wrong readings
+    CHECK(bare[i].wrong * 50 > bareCount);
+
+    // With the jitter, the wrong readings are at least ten times rarer and
+    // most of the overlaps are rejected instead
+    CHECK(jittered[i].wrong * 100 < jitteredCount);
+    CHECK(jittered[i].wrong * 10 < bare[i].wrong);
+    CHECK(jittered[i].correct * 10 > jitteredCount * 9);
+  }
+
+  return 0;
+}
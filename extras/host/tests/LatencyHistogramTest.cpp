@@ -0,0 +1,189 @@
+///
+/// @file LatencyHistogramTest.cpp
+///
+/// @brief Checks the buckets and percentiles of the LatencyHistogram
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include <Arduino.h>
+#include <string>
+#include "LatencyHistogram.h"
+#include "HostTest.h"
+
+using namespace CNEGR;
+
+#define LONGEST_LATENCY_US    5000000   ///< Beyond the last bucket with an upper bound
+
+/// @brief Keeps the characters printed
+///
+class RecordingOutput: public Print
+{
+public:
+  virtual size_t write(uint8_t c)
+  {
+    text.push_back((char)c);
+    return 1;
+  }
+
+  using Print::write;
+
+  std::string text;                 ///< The characters printed
+};
+
+/// @brief Gets the upper bound of the bucket holding a latency
+///
+/// @param latencyUs          The latency
+///
+/// @retval The median of the latency and a longer one, the largest latency if the bucket has no upper bound
+///
+static uint32_t GetUpperBound(uint32_t latencyUs)
+{
+  LatencyHistogram histogram;
+  histogram.Record(latencyUs);
+  histogram.Record(LONGEST_LATENCY_US);
+
+  uint32_t upperBoundUs = 0;
+  CHECK_EQUAL(RESULT_OK, histogram.GetPercentile(50, upperBoundUs));
+  return upperBoundUs;
+}
+
+static void TestEmpty()
+{
+  LatencyHistogram histogram;
+  uint32_t latencyUs = 0;
+
+  CHECK_EQUAL(0, histogram.GetCount());
+  CHECK_EQUAL(0, histogram.GetMax());
+  CHECK_EQUAL(RESULT_NO_DATA, histogram.GetPercentile(50, latencyUs));
+
+  histogram.Record(100);
+  CHECK_EQUAL(RESULT_BAD_PARAM, histogram.GetPercentile(0, latencyUs));
+  CHECK_EQUAL(RESULT_BAD_PARAM, histogram.GetPercentile(101, latencyUs));
+}
+
+static void TestBucketEdges()
+{
+  // Below the first power of two
+  CHECK_EQUAL(64, GetUpperBound(0));
+  CHECK_EQUAL(64, GetUpperBound(63));
+
+  // Two buckets per power of two, split at one and a half times
+  CHECK_EQUAL(96, GetUpperBound(64));
+  CHECK_EQUAL(96, GetUpperBound(95));
+  CHECK_EQUAL(128, GetUpperBound(96));
+  CHECK_EQUAL(128, GetUpperBound(127));
+  CHECK_EQUAL(192, GetUpperBound(128));
+  CHECK_EQUAL(1024, GetUpperBound(1000));
+
+  // The last buckets with an upper bound
+  CHECK_EQUAL(1572864, GetUpperBound(1048576));
+  CHECK_EQUAL(2097152, GetUpperBound(1572864));
+  CHECK_EQUAL(2097152, GetUpperBound(2097151));
+
+  // The last bucket has none, the largest latency is reported instead
+  CHECK_EQUAL(LONGEST_LATENCY_US, GetUpperBound(2097152));
+
+  // An upper bound is never more than the largest latency
+  LatencyHistogram histogram;
+  uint32_t latencyUs = 0;
+  histogram.Record(70);
+  CHECK_EQUAL(RESULT_OK, histogram.GetPercentile(100, latencyUs));
+  CHECK_EQUAL(70, latencyUs);
+}
+
+static void TestPercentiles()
+{
+  LatencyHistogram histogram;
+  uint32_t latencyUs = 0;
+
+  for (uint32_t i = 0; i < 90; i++)
+    histogram.Record(50);
+
+  for (uint32_t i = 0; i < 9; i++)
+    histogram.Record(1000);
+
+  histogram.Record(20000);
+
+  CHECK_EQUAL(100, histogram.GetCount());
+  CHECK_EQUAL(20000, histogram.GetMax());
+
+  CHECK_EQUAL(RESULT_OK, histogram.GetPercentile(50, latencyUs));
+  CHECK_EQUAL(64, latencyUs);
+  CHECK_EQUAL(RESULT_OK, histogram.GetPercentile(90, latencyUs));
+  CHECK_EQUAL(64, latencyUs);
+
+  // The rank is rounded up
+  CHECK_EQUAL(RESULT_OK, histogram.GetPercentile(91, latencyUs));
+  CHECK_EQUAL(1024, latencyUs);
+  CHECK_EQUAL(RESULT_OK, histogram.GetPercentile(99, latencyUs));
+  CHECK_EQUAL(1024, latencyUs);
+  CHECK_EQUAL(RESULT_OK, histogram.GetPercentile(100, latencyUs));
+  CHECK_EQUAL(20000, latencyUs);
+
+  RecordingOutput output;
+  histogram.Print(output);
+  CHECK(output.text == "count=100\r\np50Us=64\r\np99Us=1024\r\nmaxUs=20000\r\nle64=90\r\nle1024=9\r\nle24576=1\r\n");
+}
+
+static void TestSaturation()
+{
+  LatencyHistogram histogram;
+  uint32_t latencyUs = 0;
+
+  for (uint32_t i = 0; i < 70000; i++)
+    histogram.Record(50);
+
+  for (uint32_t i = 0; i < 10; i++)
+    histogram.Record(1000);
+
+  // The count goes on, the bucket stops at its maximum
+  CHECK_EQUAL(70010, histogram.GetCount());
+
+  RecordingOutput output;
+  histogram.Print(output);
+  CHECK(output.text.find("le64=65535\r\n") != std::string::npos);
+
+  // The percentiles come from the saturated counts
+  CHECK_EQUAL(RESULT_OK, histogram.GetPercentile(99, latencyUs));
+  CHECK_EQUAL(64, latencyUs);
+  CHECK_EQUAL(RESULT_OK, histogram.GetPercentile(100, latencyUs));
+  CHECK_EQUAL(1000, latencyUs);
+}
+
+static void TestClear()
+{
+  LatencyHistogram histogram;
+  uint32_t latencyUs = 0;
+
+  histogram.Record(3000000);
+  histogram.Record(100);
+  histogram.Clear();
+
+  CHECK_EQUAL(0, histogram.GetCount());
+  CHECK_EQUAL(0, histogram.GetMax());
+  CHECK_EQUAL(RESULT_NO_DATA, histogram.GetPercentile(99, latencyUs));
+
+  RecordingOutput output;
+  histogram.Print(output);
+  CHECK(output.text == "count=0\r\np50Us=0\r\np99Us=0\r\nmaxUs=0\r\n");
+
+  // The latencies recorded before don't count anymore
+  histogram.Record(200);
+  CHECK_EQUAL(1, histogram.GetCount());
+  CHECK_EQUAL(200, histogram.GetMax());
+  CHECK_EQUAL(RESULT_OK, histogram.GetPercentile(99, latencyUs));
+  CHECK_EQUAL(200, latencyUs);
+}
+
+int main()
+{
+  TestEmpty();
+  TestBucketEdges();
+  TestPercentiles();
+  TestSaturation();
+  TestClear();
+
+  return 0;
+}
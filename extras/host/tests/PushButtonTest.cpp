@@ -0,0 +1,224 @@
+///
+/// @file PushButtonTest.cpp
+///
+/// @brief Checks the debouncing of the PushButton and the MockButton queue
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include <Arduino.h>
+#include "PushButton.h"
+#include "MockButton.h"
+#include "HostTest.h"
+
+using namespace CNEGR;
+
+#define BUTTON_PIN          2       ///< An external interrupt pin of the host stub
+#define OTHER_BUTTON_PIN    3       ///< The other external interrupt pin
+#define DEBOUNCE_TIME_MS    30
+#define LONG_PRESS_TIME_MS  1500
+
+/// @brief Lets the time pass, with the timer tick every millisecond like the board
+///
+/// @param ms                 The number of milliseconds
+///
+static void Wait(uint32_t ms)
+{
+  while (ms-- != 0)
+  {
+    HostAdvanceMicros(1000);
+    PushButton::OnTimerTick();
+  }
+}
+
+/// @brief Changes the pin level, with the edge interrupt
+///
+static void SetPressed(uint8_t pin, bool pressed)
+{
+  HostSetPin(pin, pressed ? LOW : HIGH);
+}
+
+/// @brief Bounces the contact, one edge per millisecond, and ends at the given level
+///
+static void Bounce(uint8_t pin, bool pressed, uint8_t edges)
+{
+  for (uint8_t i = 0; i < edges; i++)
+  {
+    SetPressed(pin, ((edges - i) % 2) != 0 ? pressed : !pressed);
+    Wait(1);
+  }
+}
+
+/// @brief Counts the queued events
+///
+static uint8_t CountEvents(IButton& button, IButton::Event expected)
+{
+  uint8_t count = 0;
+  IButton::Event event;
+
+  while (button.GetEvent(event) == RESULT_OK)
+  {
+    CHECK_EQUAL(expected, event);
+    count++;
+  }
+
+  return count;
+}
+
+/// @brief Presses and releases the button without bounces
+///
+static void Press(uint8_t pin, uint32_t durationMs)
+{
+  SetPressed(pin, true);
+  Wait(durationMs);
+  SetPressed(pin, false);
+  Wait(DEBOUNCE_TIME_MS + 1);
+}
+
+static void TestPushButton()
+{
+  HostSetMicros(1000000);
+  HostSetPin(BUTTON_PIN, HIGH);
+  HostSetPin(OTHER_BUTTON_PIN, HIGH);
+
+  IButton::Config config = { "Button", BUTTON_PIN, SignalPolarity::ActiveLow, DEBOUNCE_TIME_MS, LONG_PRESS_TIME_MS };
+  PushButton button;
+  IButton::Event event;
+
+  CHECK_EQUAL(RESULT_NOT_READY, button.GetEvent(event));
+
+  IButton::Config bad = config;
+  bad.debounceTimeMs = 0;
+  CHECK_EQUAL(RESULT_BAD_PARAM, button.Init(bad));
+  bad = config;
+  bad.longPressTimeMs = DEBOUNCE_TIME_MS;
+  CHECK_EQUAL(RESULT_BAD_PARAM, button.Init(bad));
+
+  // The host has no pin change interrupts, only the external interrupt pins work
+  bad = config;
+  bad.pin = 9;
+  CHECK_EQUAL(RESULT_NOT_SUP, button.Init(bad));
+
+  CHECK_EQUAL(RESULT_OK, button.Init(config));
+  CHECK_EQUAL(RESULT_BUSY, button.Init(config));
+  CHECK_EQUAL(INPUT_PULLUP, HostGetPinMode(BUTTON_PIN));
+  CHECK_EQUAL(RESULT_NO_DATA, button.GetEvent(event));
+
+  // Bounces on the press and on the release give a single press
+  Bounce(BUTTON_PIN, true, 7);
+  Wait(200);
+  Bounce(BUTTON_PIN, false, 5);
+  CHECK_EQUAL(RESULT_NO_DATA, button.GetEvent(event));
+  Wait(DEBOUNCE_TIME_MS);
+  CHECK_EQUAL(1, CountEvents(button, IButton::Press));
+
+  // A glitch or a tap shorter than the debounce time is ignored, and doesn't
+  // leave the button pressed
+  Press(BUTTON_PIN, 1);
+  Press(BUTTON_PIN, DEBOUNCE_TIME_MS - 5);
+  CHECK_EQUAL(0, CountEvents(button, IButton::Press));
+
+  // The next press is reported normally
+  Press(BUTTON_PIN, 100);
+  CHECK_EQUAL(1, CountEvents(button, IButton::Press));
+
+  // A release bouncing back to pressed within the debounce time doesn't end the press
+  SetPressed(BUTTON_PIN, true);
+  Wait(100);
+  SetPressed(BUTTON_PIN, false);
+  Wait(DEBOUNCE_TIME_MS / 2);
+  SetPressed(BUTTON_PIN, true);
+  Wait(100);
+  CHECK_EQUAL(RESULT_NO_DATA, button.GetEvent(event));
+  SetPressed(BUTTON_PIN, false);
+  Wait(DEBOUNCE_TIME_MS + 1);
+  CHECK_EQUAL(1, CountEvents(button, IButton::Press));
+
+  // A level change whose interrupt was missed is caught by the timer tick
+  digitalWrite(BUTTON_PIN, LOW);
+  Wait(100);
+  digitalWrite(BUTTON_PIN, HIGH);
+  Wait(DEBOUNCE_TIME_MS + 1);
+  CHECK_EQUAL(1, CountEvents(button, IButton::Press));
+
+  // The press duration decides between a press and a long press
+  Press(BUTTON_PIN, LONG_PRESS_TIME_MS - 10);
+  CHECK_EQUAL(1, CountEvents(button, IButton::Press));
+  Press(BUTTON_PIN, LONG_PRESS_TIME_MS + 10);
+  CHECK_EQUAL(1, CountEvents(button, IButton::LongPress));
+
+  // The events the main loop doesn't retrieve are counted once the queue is full
+  uint8_t capacity = SpscQueue<uint8_t, PUSHBUTTON_QUEUE_SIZE>::GetCapacity();
+  for (uint8_t i = 0; i < capacity + 2; i++)
+    Press(BUTTON_PIN, 100);
+
+  CHECK_EQUAL(2, button.GetLostEventCount());
+  CHECK_EQUAL(capacity, CountEvents(button, IButton::Press));
+
+  // A second button works independently, a third one has no slot
+  IButton::Config otherConfig = config;
+  otherConfig.pin = OTHER_BUTTON_PIN;
+  PushButton other;
+  PushButton third;
+  CHECK_EQUAL(RESULT_OK, other.Init(otherConfig));
+  CHECK_EQUAL(RESULT_NO_RESOURCE, third.Init(otherConfig));
+
+  SetPressed(BUTTON_PIN, true);
+  Wait(50);
+  Press(OTHER_BUTTON_PIN, LONG_PRESS_TIME_MS + 10);
+  SetPressed(BUTTON_PIN, false);
+  Wait(DEBOUNCE_TIME_MS + 1);
+  CHECK_EQUAL(1, CountEvents(other, IButton::LongPress));
+  CHECK_EQUAL(1, CountEvents(button, IButton::LongPress));
+
+  // A deinitialized button ignores the pin and frees its slot
+  button.Deinit();
+  CHECK(!button.IsInitialized());
+  Press(BUTTON_PIN, 100);
+  CHECK_EQUAL(RESULT_NOT_READY, button.GetEvent(event));
+  CHECK_EQUAL(RESULT_OK, third.Init(config));
+  third.Deinit();
+  other.Deinit();
+}
+
+static void TestMockButton()
+{
+  IButton::Config config = { "Mock", 0, SignalPolarity::ActiveLow, DEBOUNCE_TIME_MS, LONG_PRESS_TIME_MS };
+  MockButton button;
+  IButton::Event event;
+
+  CHECK_EQUAL(RESULT_NOT_READY, button.InjectEvent(IButton::Press));
+  CHECK_EQUAL(RESULT_NOT_READY, button.GetEvent(event));
+  CHECK_EQUAL(RESULT_OK, button.Init(config));
+  CHECK_EQUAL(RESULT_BUSY, button.Init(config));
+  CHECK_EQUAL(RESULT_NO_DATA, button.GetEvent(event));
+
+  // The events come out in order
+  CHECK_EQUAL(RESULT_OK, button.InjectEvent(IButton::LongPress));
+  CHECK_EQUAL(RESULT_OK, button.InjectEvent(IButton::Press));
+  CHECK_EQUAL(RESULT_OK, button.GetEvent(event));
+  CHECK_EQUAL(IButton::LongPress, event);
+  CHECK_EQUAL(RESULT_OK, button.GetEvent(event));
+  CHECK_EQUAL(IButton::Press, event);
+  CHECK_EQUAL(RESULT_NO_DATA, button.GetEvent(event));
+
+  // The queue wraps around and counts the overflows
+  for (uint8_t i = 0; i < MOCKBUTTON_QUEUE_SIZE; i++)
+    CHECK_EQUAL(RESULT_OK, button.InjectEvent(IButton::Press));
+
+  CHECK_EQUAL(RESULT_OVERFLOW, button.InjectEvent(IButton::Press));
+  CHECK_EQUAL(1, button.GetLostEventCount());
+  CHECK_EQUAL(MOCKBUTTON_QUEUE_SIZE, CountEvents(button, IButton::Press));
+
+  button.Deinit();
+  CHECK(!button.IsInitialized());
+}
+
+int main()
+{
+  TestPushButton();
+  TestMockButton();
+
+  return 0;
+}
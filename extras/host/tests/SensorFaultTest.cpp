@@ -0,0 +1,324 @@
+///
+/// @file SensorFaultTest.cpp
+///
+/// @brief Checks that a sensor unplugged and plugged back in is detected, and that an empty bay isn't a fault
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+/// The HCSR04 driver runs unchanged on the host, its pins are connected to a SimulatedEchoLine
+/// and the time only advances when the test says so.
+///
+
+#include <Arduino.h>
+#include <string.h>
+#include "HCSR04.h"
+#include "SpeedOfSound.h"
+#include "DualDistanceSensor.h"
+#include "StateMachine.h"
+#include "MockTrafficLight.h"
+#include "SimulatedEchoLine.h"
+#include "HostTest.h"
+
+using namespace CNEGR;
+
+#define LEFT_TRIGGER_PIN      12
+#define LEFT_ECHO_PIN         2
+#define RIGHT_TRIGGER_PIN     7
+#define RIGHT_ECHO_PIN        3
+#define PERIOD_MS             100     ///< The time between two measurements
+#define BUSY_POLL_US          1000    ///< The time between two calls returning RESULT_BUSY
+#define HOLDING_TIME_MS       2000
+
+/// @brief Initializes an HC-SR04 connected to a simulated module
+///
+static void Init(HCSR04& sensor, SimulatedEchoLine& line, const char *name, uint8_t triggerPin, uint8_t echoPin)
+{
+  CHECK_EQUAL(RESULT_OK, line.Attach(triggerPin, echoPin));
+
+  IDistanceSensor::Config config;
+  config.name       = name;
+  config.triggerPin = triggerPin;
+  config.echoPin    = echoPin;
+  CHECK_EQUAL(RESULT_OK, sensor.Init(config));
+}
+
+/// @brief Completes one measurement, polling it like the loop does
+///
+static Result Measure(IDistanceSensor& sensor, uint32_t& distance)
+{
+  Result result;
+
+  while ((result = sensor.MeasureDistanceAsync(STATEMACHINE_DEFAULT_TEMPERATURE, DEFAULT_RELATIVE_HUMIDITY, distance)) == RESULT_BUSY)
+    HostAdvanceMicros(BUSY_POLL_US);
+
+  HostAdvanceMicros(PERIOD_MS * 1000);
+  return result;
+}
+
+/// @brief A state machine with its lights, on the given sensor
+///
+struct Bay
+{
+  MockTrafficLight        trafficLight;
+  StateMachine            stateMachine;
+
+  explicit Bay(IDistanceSensor *sensor)
+  {
+    ITrafficLight::Config trafficLightConfig;
+    trafficLightConfig.name           = "Bay";
+    trafficLightConfig.redLightPin    = 0;
+    trafficLightConfig.yellowLightPin = 0;
+    trafficLightConfig.greenLightPin  = 0;
+    trafficLightConfig.pinsPolarity   = SignalPolarity::ActiveHigh;
+    CHECK_EQUAL(RESULT_OK, trafficLight.Init(trafficLightConfig));
+
+    StateMachine::Config config;
+    memset(&config, 0, sizeof(config));
+    config.distanceSensor                     = sensor;
+    config.trafficLight                       = &trafficLight;
+    config.maxDistanceThresholdMm             = 3000;
+    config.farThresholdMm                     = 1500;
+    config.nearThresholdMm                    = 250;
+    config.movingDistanceDetectionThresholdMm = 50;
+    config.movingTimeThresholdMs              = 100;
+    config.holdingTimeThresholdMs             = HOLDING_TIME_MS;
+    config.outlierFilter.thresholdX16         = 71;
+    config.outlierFilter.minDeviationMm       = 40;
+    config.classifier.persistenceSamples      = 5;
+    config.classifier.maxStepMm               = 150;
+    config.classifier.maxMissedSamples        = 2;
+    config.tracker.alpha                      = Q16_FROM_RATIO(1, 2);
+    config.tracker.beta                       = Q16_FROM_RATIO(1, 8);
+    config.tracker.maxPredictedSamples        = 5;
+    stateMachine.Init(config);
+  }
+
+  /// @brief Completes one update, the lights test included
+  ///
+  void Update()
+  {
+    while (stateMachine.Update() == RESULT_BUSY)
+      HostAdvanceMicros(BUSY_POLL_US);
+
+    HostAdvanceMicros(PERIOD_MS * 1000);
+  }
+
+  /// @brief Gets whether the state machine is in the given state
+  ///
+  bool IsIn(const char *state)
+  {
+    return strcmp(StateMachine::GetStateName(stateMachine.GetState()), state) == 0;
+  }
+
+  /// @brief Gets the number of times the sensor stopped answering
+  ///
+  uint32_t GetSensorFaults()
+  {
+    StateMachine::Statistics statistics;
+    stateMachine.GetStatistics(statistics);
+    return statistics.sensorFaults;
+  }
+
+  /// @brief Gets whether all the lights are off
+  ///
+  bool AreLightsOff()
+  {
+    ITrafficLight::LightState state = ITrafficLight::Off;
+    ITrafficLight::LightSelector lights[] = { ITrafficLight::RedLight, ITrafficLight::YellowLight, ITrafficLight::GreenLight };
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+      trafficLight.GetState(lights[i], state);
+      if (state != ITrafficLight::Off)
+        return false;
+    }
+
+    return true;
+  }
+};
+
+static void TestSensor()
+{
+  HostSetMicros(0);
+
+  SimulatedEchoLine line;
+  HCSR04 sensor;
+  Init(sensor, line, "Sensor", LEFT_TRIGGER_PIN, LEFT_ECHO_PIN);
+
+  uint32_t distance = 0;
+  line.SetTarget(1200);
+  CHECK_EQUAL(RESULT_OK, Measure(sensor, distance));
+  CHECK((distance >= 1199) && (distance <= 1201));
+
+  // An empty bay is a long echo pulse, never a missing one
+  line.SetState(SimulatedEchoLine::Empty);
+  for (uint8_t i = 0; i < 3 * DISTANCESENSOR_MAX_MISSING_RESPONSES; i++)
+    CHECK_EQUAL(RESULT_TIMEOUT, Measure(sensor, distance));
+
+  CHECK_EQUAL(0, sensor.GetReconnectAttempts());
+
+  // Unplugged, the echo pin stays low. The last ping of the series reports the sensor lost
+  // and configures the pins again, and so does every following one.
+  line.SetState(SimulatedEchoLine::Unplugged);
+  for (uint8_t i = 1; i < DISTANCESENSOR_MAX_MISSING_RESPONSES; i++)
+    CHECK_EQUAL(RESULT_TIMEOUT, Measure(sensor, distance));
+
+  CHECK_EQUAL(0, sensor.GetReconnectAttempts());
+  CHECK_EQUAL(RESULT_DEV_ERR, Measure(sensor, distance));
+  CHECK_EQUAL(1, sensor.GetReconnectAttempts());
+  CHECK_EQUAL(RESULT_DEV_ERR, Measure(sensor, distance));
+  CHECK_EQUAL(2, sensor.GetReconnectAttempts());
+
+  // Plugged back in, the first echo is measured and the count of missing pings starts over
+  line.SetTarget(1500);
+  CHECK_EQUAL(RESULT_OK, Measure(sensor, distance));
+  CHECK((distance >= 1499) && (distance <= 1501));
+
+  line.SetState(SimulatedEchoLine::Unplugged);
+  for (uint8_t i = 1; i < DISTANCESENSOR_MAX_MISSING_RESPONSES; i++)
+    CHECK_EQUAL(RESULT_TIMEOUT, Measure(sensor, distance));
+
+  CHECK_EQUAL(2, sensor.GetReconnectAttempts());
+  CHECK(line.GetPingCount() > 0);
+}
+
+static void TestStateMachine()
+{
+  HostSetMicros(0);
+
+  SimulatedEchoLine line;
+  HCSR04 sensor;
+  Init(sensor, line, "Sensor", LEFT_TRIGGER_PIN, LEFT_ECHO_PIN);
+
+  Bay bay(&sensor);
+
+  // An empty bay for a while, the lights test runs first
+  line.SetState(SimulatedEchoLine::Empty);
+  for (uint8_t i = 0; i < 50; i++)
+  {
+    bay.Update();
+    CHECK(bay.IsIn("Idle"));
+  }
+
+  CHECK_EQUAL(RESULT_OK, bay.stateMachine.GetLightsTestResult());
+  CHECK_EQUAL(0, bay.GetSensorFaults());
+
+  // Unplugged, the fault is raised by the last of the missing responses
+  line.SetState(SimulatedEchoLine::Unplugged);
+  for (uint8_t i = 1; i < DISTANCESENSOR_MAX_MISSING_RESPONSES; i++)
+  {
+    bay.Update();
+    CHECK(bay.IsIn("Idle"));
+  }
+
+  bay.Update();
+  CHECK(bay.IsIn("SensorFault"));
+  CHECK(bay.AreLightsOff());
+  CHECK_EQUAL(1, bay.GetSensorFaults());
+
+  // It is counted once, however long the sensor stays unplugged
+  for (uint8_t i = 0; i < 20; i++)
+  {
+    bay.Update();
+    CHECK(bay.IsIn("SensorFault"));
+  }
+
+  CHECK_EQUAL(1, bay.GetSensorFaults());
+
+  // Plugged back in, without restarting the application
+  line.SetState(SimulatedEchoLine::Empty);
+  bay.Update();
+  CHECK(bay.IsIn("Idle"));
+
+  for (uint8_t i = 0; i < 20; i++)
+  {
+    bay.Update();
+    CHECK(bay.IsIn("Idle"));
+  }
+
+  CHECK_EQUAL(1, bay.GetSensorFaults());
+}
+
+static void TestDualSensors()
+{
+  HostSetMicros(0);
+
+  SimulatedEchoLine leftLine;
+  SimulatedEchoLine rightLine;
+  HCSR04 left;
+  HCSR04 right;
+  Init(left, leftLine, "Left", LEFT_TRIGGER_PIN, LEFT_ECHO_PIN);
+  Init(right, rightLine, "Right", RIGHT_TRIGGER_PIN, RIGHT_ECHO_PIN);
+
+  // The configuration of DistanceMeasurement.ino
+  DualDistanceSensor sensor(&left, &right, 1200, 30, 150);
+  IDistanceSensor::Config config;
+  config.name = "Dual";
+  CHECK_EQUAL(RESULT_OK, sensor.Init(config));
+
+  Bay bay(&sensor);
+
+  // The right sensor is dead from the start, the left one keeps the bay running
+  leftLine.SetState(SimulatedEchoLine::Empty);
+  rightLine.SetState(SimulatedEchoLine::Unplugged);
+
+  for (uint8_t i = 0; i < 60; i++)
+  {
+    bay.Update();
+    CHECK(bay.IsIn("Idle"));
+  }
+
+  CHECK(right.GetReconnectAttempts() > 0);
+  CHECK_EQUAL(0, bay.GetSensorFaults());
+
+  // A car still turns the lights on
+  uint32_t distance = 2900;
+  for (uint8_t i = 0; (i < 40) && !bay.IsIn("SubjectApproaching"); i++)
+  {
+    leftLine.SetTarget(distance);
+    bay.Update();
+    distance -= 40;
+  }
+
+  CHECK(bay.IsIn("SubjectApproaching"));
+
+  // The lights show the distance from the next update
+  leftLine.SetTarget(distance);
+  bay.Update();
+  CHECK(bay.IsIn("SubjectApproaching"));
+  CHECK(!bay.AreLightsOff());
+  CHECK_EQUAL(0, bay.GetSensorFaults());
+
+  // Once both sensors are lost the fault is raised
+  leftLine.SetState(SimulatedEchoLine::Unplugged);
+  for (uint8_t i = 0; (i < 4 * DISTANCESENSOR_MAX_MISSING_RESPONSES) && !bay.IsIn("SensorFault"); i++)
+    bay.Update();
+
+  CHECK(bay.IsIn("SensorFault"));
+  CHECK_EQUAL(1, bay.GetSensorFaults());
+
+  // One of them plugged back in is enough
+  rightLine.SetState(SimulatedEchoLine::Empty);
+  for (uint8_t i = 0; (i < 4) && !bay.IsIn("Idle"); i++)
+    bay.Update();
+
+  CHECK(bay.IsIn("Idle"));
+
+  for (uint8_t i = 0; i < 20; i++)
+  {
+    bay.Update();
+    CHECK(!bay.IsIn("SensorFault"));
+  }
+
+  CHECK_EQUAL(1, bay.GetSensorFaults());
+}
+
+int main()
+{
+  TestSensor();
+  TestStateMachine();
+  TestDualSensors();
+
+  return 0;
+}
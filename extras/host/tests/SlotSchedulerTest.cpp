@@ -0,0 +1,331 @@
+///
+/// @file SlotSchedulerTest.cpp
+///
+/// @brief Simulates four boards sharing the air with time slots, and the loss of the board sending the sync
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include <Arduino.h>
+#include <vector>
+#include "SlotScheduler.h"
+#include "SlottedDistanceSensor.h"
+#include "DebugUtils.h"
+#include "HostTest.h"
+
+using namespace CNEGR;
+
+#define BOARD_COUNT             4           ///< The number of boards sharing the sync wire
+#define SIMULATION_STEP_US      100         ///< The resolution of the simulated time
+#define PHASE_DURATION_US       60000000    ///< All up, board 0 down, board 0 back
+#define ECHO_TIME_US            17442       ///< The echo time of a target at 3 m
+#define PING_PERIOD_MS          100         ///< The ping period of the boards without slots
+
+/// The clock errors and the boot times of the boards
+static const int32_t  clockErrorPpm[BOARD_COUNT] = { 0, 80, -60, 120 };
+static const uint32_t clockOffsetUs[BOARD_COUNT] = { 0, 12345000, 777000, 4242000 };
+
+/// @brief Gets the time of a board
+///
+/// @retval The time in milliseconds on the clock of the board
+///
+static uint32_t GetBoardTime(int board)
+{
+  uint64_t now = micros();
+  return (uint32_t)((clockOffsetUs[board] + now + (int64_t)now * clockErrorPpm[board] / 1000000) / 1000);
+}
+
+template <int BOARD>
+static uint32_t BoardClock()
+{
+  return GetBoardTime(BOARD);
+}
+
+static const ClockProc boardClocks[BOARD_COUNT] = { BoardClock<0>, BoardClock<1>, BoardClock<2>, BoardClock<3> };
+
+/// @brief A ping sent by a board
+///
+struct Ping
+{
+  uint32_t  timeUs;                       ///< The time of the ping
+  int       board;                        ///< The board pinging
+};
+
+static std::vector<Ping> pings;           ///< Every ping of the simulation
+
+/// @brief A sensor recording the time of its pings, the target is at 3 m
+///
+class RecordingSensor: public IDistanceSensor
+{
+public:
+  RecordingSensor()
+    :_board(0),
+     _initDone(false),
+     _busy(false),
+     _pingUs(0)
+  {
+  }
+
+  void SetBoard(int board)
+  {
+    _board = board;
+  }
+
+  void Abort()
+  {
+    _busy = false;
+  }
+
+  virtual Result Init(const Config& configuration)
+  {
+    (void)configuration;
+    _initDone = true;
+    return RESULT_OK;
+  }
+
+  virtual bool IsInitialized() const
+  {
+    return _initDone;
+  }
+
+  virtual void Deinit()
+  {
+    _initDone = false;
+  }
+
+  virtual Result MeasureDistance(uint32_t& distance)
+  {
+    (void)distance;
+    return RESULT_NOT_SUP;
+  }
+
+  virtual Result MeasureDistance(uint32_t ambientTemperature, uint32_t& distance)
+  {
+    (void)ambientTemperature;
+    (void)distance;
+    return RESULT_NOT_SUP;
+  }
+
+  virtual Result MeasureDistance(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance)
+  {
+    (void)ambientTemperature;
+    (void)relativeHumidity;
+    (void)distance;
+    return RESULT_NOT_SUP;
+  }
+
+  virtual Result MeasureDistanceAsync(uint32_t ambientTemperature, uint32_t relativeHumidity, uint32_t& distance)
+  {
+    (void)ambientTemperature;
+    (void)relativeHumidity;
+
+    uint32_t now = micros();
+
+    if (!_busy)
+    {
+      Ping ping = { now, _board };
+      pings.push_back(ping);
+      _busy   = true;
+      _pingUs = now;
+      return RESULT_BUSY;
+    }
+
+    if (now - _pingUs < ECHO_TIME_US)
+      return RESULT_BUSY;
+
+    _busy    = false;
+    distance = 3000;
+    return RESULT_OK;
+  }
+
+  virtual Result SetRangeLimit(uint32_t rangeLimitMm)
+  {
+    (void)rangeLimitMm;
+    return RESULT_OK;
+  }
+
+private:
+  int       _board;                       ///< The board of the sensor
+  bool      _initDone;                    ///< A flag to indicate whether the sensor was initialized
+  bool      _busy;                        ///< A flag to indicate that a ping is in flight
+  uint32_t  _pingUs;                      ///< The time of the current ping
+};
+
+/// @brief The pings of a phase of the simulation
+///
+struct PhaseResults
+{
+  uint32_t  collisions;                   ///< The pings heard by another board before their echo returned
+  uint32_t  pings[BOARD_COUNT];           ///< The number of pings of every board
+};
+
+/// @brief Runs the boards for the three phases
+///
+/// @param slotted            true to ping in the slots, false for free running boards
+/// @param results            Contains the pings of every phase
+/// @param schedulers         Contains the schedulers at the end of the simulation
+///
+static void Simulate(bool slotted, PhaseResults results[3], SlotScheduler schedulers[BOARD_COUNT])
+{
+  HostSetMicros(0);
+  pings.clear();
+
+  IDistanceSensor::Config sensorConfig;
+  sensorConfig.name = "Bay";
+
+  RecordingSensor       sensors[BOARD_COUNT];
+  SlottedDistanceSensor *slottedSensors[BOARD_COUNT];
+  IDistanceSensor       *measured[BOARD_COUNT];
+  bool                  pending[BOARD_COUNT];
+  uint32_t              lastPingMs[BOARD_COUNT];
+
+  // Boots a board, with the scheduler state lost like on a reset
+  auto boot = [&](int board)
+  {
+    SlotScheduler::Config config;
+    config.slotCount         = BOARD_COUNT;
+    config.slot              = (uint8_t)board;
+    config.slotTimeMs        = 25;
+    config.pingWindowMs      = 5;
+    config.syncTimeoutFrames = 3;
+    config.clock             = boardClocks[board];
+
+    schedulers[board].Deinit();
+    CHECK_EQUAL(RESULT_OK, schedulers[board].Init(config));
+    slottedSensors[board]->Deinit();
+    CHECK_EQUAL(RESULT_OK, slottedSensors[board]->Init(sensorConfig));
+    sensors[board].Abort();
+    pending[board]    = false;
+    lastPingMs[board] = 0;
+  };
+
+  for (int i = 0; i < BOARD_COUNT; i++)
+  {
+    sensors[i].SetBoard(i);
+    CHECK_EQUAL(RESULT_OK, sensors[i].Init(sensorConfig));
+    slottedSensors[i] = new SlottedDistanceSensor(&sensors[i], &schedulers[i]);
+    measured[i] = slotted ? (IDistanceSensor *)slottedSensors[i] : &sensors[i];
+    boot(i);
+  }
+
+  const uint32_t downUs = PHASE_DURATION_US;
+  const uint32_t upUs   = 2 * PHASE_DURATION_US;
+  const uint32_t endUs  = 3 * PHASE_DURATION_US;
+
+  for (uint32_t now = 0; now < endUs; now += SIMULATION_STEP_US)
+  {
+    HostSetMicros(now);
+
+    bool board0Up = (now < downUs) || (now >= upUs);
+    if (now == upUs)
+      boot(0);
+
+    for (int i = 0; i < BOARD_COUNT; i++)
+    {
+      if ((i == 0) && !board0Up)
+        continue;
+
+      // The pulse reaches the other boards, which notice it within a millisecond
+      if (slotted && schedulers[i].Update())
+      {
+        for (int j = 0; j < BOARD_COUNT; j++)
+        {
+          if ((j != i) && ((j != 0) || board0Up))
+            schedulers[j].OnSync(GetBoardTime(j) - (uint32_t)random(2));
+        }
+      }
+
+      // The free running boards ping every PING_PERIOD_MS, the slotted ones
+      // whenever their slot allows it
+      uint32_t time = GetBoardTime(i);
+      if (!slotted && !pending[i] && (time - lastPingMs[i] < PING_PERIOD_MS))
+        continue;
+
+      if (!pending[i])
+        lastPingMs[i] = time;
+
+      uint32_t distance = 0;
+      pending[i] = (measured[i]->MeasureDistanceAsync(200, 50, distance) == RESULT_BUSY);
+    }
+  }
+
+  // A ping collides when another board pings before its echo returned
+  memset(results, 0, 3 * sizeof(PhaseResults));
+
+  for (size_t a = 0; a < pings.size(); a++)
+  {
+    int phase = (pings[a].timeUs < downUs) ? 0 : ((pings[a].timeUs < upUs) ? 1 : 2);
+    results[phase].pings[pings[a].board]++;
+
+    for (size_t b = a + 1; (b < pings.size()) && (pings[b].timeUs - pings[a].timeUs < ECHO_TIME_US); b++)
+    {
+      if (pings[b].board != pings[a].board)
+      {
+        results[phase].collisions++;
+        break;
+      }
+    }
+  }
+
+  for (int i = 0; i < BOARD_COUNT; i++)
+    delete slottedSensors[i];
+}
+
+int main()
+{
+  Logger::SetLogLevel(Logger::Level::OFF);
+
+  PhaseResults  freeRunning[3];
+  PhaseResults  slotted[3];
+  SlotScheduler freeSchedulers[BOARD_COUNT];
+  SlotScheduler schedulers[BOARD_COUNT];
+
+  Simulate(false, freeRunning, freeSchedulers);
+  Simulate(true, slotted, schedulers);
+
+  const uint32_t minPings = PHASE_DURATION_US / 1000 / (4 * 25) * 95 / 100;
+
+  for (int phase = 0; phase < 3; phase++)
+  {
+    printf("phase %d: collisions free running %u, slotted %u\n", phase, freeRunning[phase].collisions, slotted[phase].collisions);
+
+    // The boards running on their own clocks drift through each other
+    CHECK(freeRunning[phase].collisions > 1000);
+
+    // Every live board keeps a ping per frame
+    for (int i = 0; i < BOARD_COUNT; i++)
+    {
+      if ((i == 0) && (phase == 1))
+        CHECK_EQUAL(0, slotted[phase].pings[i]);
+      else
+        CHECK(slotted[phase].pings[i] >= minPings);
+    }
+  }
+
+  // The slots never overlap while the sync is held, and at most one ping of the
+  // rebooted board lands before it hears the new sync
+  CHECK_EQUAL(0, slotted[0].collisions);
+  CHECK_EQUAL(0, slotted[1].collisions);
+  CHECK(slotted[2].collisions <= 2);
+
+  // Board 1 took over the sync when board 0 went down and kept it, the
+  // rebooted board 0 follows it instead of sending a second pulse
+  SlotScheduler::Statistics statistics;
+  schedulers[1].GetStatistics(statistics);
+  CHECK(schedulers[1].IsSending());
+  CHECK_EQUAL(1, statistics.takeovers);
+
+  for (int i = 0; i < BOARD_COUNT; i++)
+  {
+    if (i == 1)
+      continue;
+
+    schedulers[i].GetStatistics(statistics);
+    CHECK(!schedulers[i].IsSending());
+    CHECK_EQUAL(0, statistics.syncsSent);
+    CHECK(statistics.syncsReceived > 0);
+  }
+
+  return 0;
+}
@@ -0,0 +1,146 @@
+///
+/// @file SpscQueueTest.cpp
+///
+/// @brief Checks the SpscQueue alone and between a producer and a consumer thread
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "SpscQueue.h"
+#include "HostTest.h"
+#include <thread>
+
+using namespace CNEGR;
+
+/// @brief An item bigger than the indices, a torn copy breaks its check value
+///
+struct Item
+{
+  uint32_t  sequence;                 ///< The number of items pushed before this one
+  uint32_t  check;                    ///< The complement of the sequence
+  uint64_t  payload;                  ///< The sequence spread over 64 bits
+};
+
+/// @brief Makes the item with the given sequence
+///
+static Item MakeItem(uint32_t sequence)
+{
+  Item item;
+  item.sequence = sequence;
+  item.check    = ~sequence;
+  item.payload  = (uint64_t)sequence * 0x9E3779B97F4A7C15ULL;
+  return item;
+}
+
+/// @brief Get whether an item was copied whole
+///
+static bool IsValid(const Item& item)
+{
+  return (item.check == ~item.sequence) && (item.payload == (uint64_t)item.sequence * 0x9E3779B97F4A7C15ULL);
+}
+
+/// @brief Checks the queue from a single thread
+///
+static void TestSingleThread()
+{
+  SpscQueue<uint8_t, 8> queue;
+  uint8_t value = 0;
+
+  CHECK_EQUAL(7, queue.GetCapacity());
+  CHECK(queue.IsEmpty());
+  CHECK(!queue.Pop(value));
+
+  // Fill it, the last slot stays free to tell a full queue from an empty one
+  for (uint8_t i = 0; i < 7; i++)
+    CHECK(queue.Push(i));
+
+  CHECK(!queue.Push(7));
+  CHECK_EQUAL(7, queue.GetCount());
+
+  // Wrap around the end of the buffer several times, in order
+  uint8_t expected = 0;
+  for (uint8_t i = 7; i < 100; i++)
+  {
+    CHECK(queue.Pop(value));
+    CHECK_EQUAL(expected++, value);
+    CHECK(queue.Push(i));
+    CHECK_EQUAL(7, queue.GetCount());
+  }
+
+  queue.Clear();
+  CHECK(queue.IsEmpty());
+  CHECK_EQUAL(0, queue.GetCount());
+  CHECK(!queue.Pop(value));
+
+  CHECK(queue.Push(42));
+  CHECK(queue.Pop(value));
+  CHECK_EQUAL(42, value);
+}
+
+/// @brief Moves items from a producer thread to the calling thread
+///
+/// @tparam SIZE              The queue size
+///
+/// @param count              The number of items
+/// @param clearEvery         The consumer clears the queue every clearEvery items, 0 never
+///
+template <uint8_t SIZE>
+static void TestTwoThreads(uint32_t count, uint32_t clearEvery)
+{
+  SpscQueue<Item, SIZE> queue;
+
+  std::thread producer([&queue, count]()
+  {
+    for (uint32_t sequence = 0; sequence < count; )
+    {
+      if (queue.Push(MakeItem(sequence)))
+        sequence++;
+      else
+        std::this_thread::yield();
+    }
+  });
+
+  // The items arrive whole and in order, a Clear() only drops items
+  uint32_t received = 0;
+  uint32_t next     = 0;
+  Item     item;
+
+  while (next < count)
+  {
+    if (!queue.Pop(item))
+    {
+      std::this_thread::yield();
+      continue;
+    }
+
+    CHECK(IsValid(item));
+    CHECK(item.sequence >= next);
+    if (clearEvery == 0)
+      CHECK_EQUAL(next, item.sequence);
+
+    next = item.sequence + 1;
+    received++;
+
+    if ((clearEvery != 0) && (received % clearEvery == 0))
+      queue.Clear();
+  }
+
+  producer.join();
+
+  CHECK(queue.IsEmpty());
+  if (clearEvery == 0)
+    CHECK_EQUAL(count, received);
+}
+
+int main()
+{
+  TestSingleThread();
+
+  TestTwoThreads<2>(200000, 0);
+  TestTwoThreads<16>(1000000, 0);
+  TestTwoThreads<128>(2000000, 0);
+  TestTwoThreads<16>(1000000, 1000);
+
+  return 0;
+}
@@ -0,0 +1,272 @@
+///
+/// @file StateMachineTest.cpp
+///
+/// @brief Checks the time to the first light after a reset and when the deferred lights test runs
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include <Arduino.h>
+#include <string.h>
+#include "StateMachine.h"
+#include "MockTrafficLight.h"
+#include "ScriptedDistanceSensor.h"
+#include "SimulatedEchoLine.h"
+#include "HCSR04.h"
+#include "DebugUtils.h"
+#include "HostTest.h"
+
+using namespace CNEGR;
+
+#define PERIOD_MS             110     ///< The time between two measurements
+#define BUSY_POLL_MS          10      ///< The time between two calls returning RESULT_BUSY
+#define HOLDING_TIME_MS       2000
+#define LIGHTS_TEST_TIME_MS   1500    ///< The duration of the lights test of the MockTrafficLight
+#define FIRST_LIGHT_TARGET_MS 100     ///< The time from the reset to the first light on a fast start
+#define TRIGGER_PIN           3       ///< The pins of DistanceMeasurement.ino
+#define ECHO_PIN              2
+#define LOOP_ITERATION_US     100     ///< The time between two iterations of the loop
+
+static uint32_t simulatedTimeMs;      ///< The clock of the state machine and the lights
+
+static uint32_t GetTime()
+{
+  return simulatedTimeMs;
+}
+
+/// @brief Initializes a state machine with the configuration of DistanceMeasurement.ino
+///
+static void InitStateMachine(StateMachine& stateMachine, IDistanceSensor *sensor, ITrafficLight *trafficLight,
+                             ClockProc clock, bool deferLightsTest)
+{
+  StateMachine::Config config;
+  memset(&config, 0, sizeof(config));
+  config.distanceSensor                     = sensor;
+  config.trafficLight                       = trafficLight;
+  config.clock                              = clock;
+  config.deferLightsTest                    = deferLightsTest;
+  config.maxDistanceThresholdMm             = 3000;
+  config.farThresholdMm                     = 1500;
+  config.nearThresholdMm                    = 250;
+  config.movingDistanceDetectionThresholdMm = 50;
+  config.movingTimeThresholdMs              = 100;
+  config.holdingTimeThresholdMs             = HOLDING_TIME_MS;
+  config.outlierFilter.thresholdX16         = 71;
+  config.outlierFilter.minDeviationMm       = 40;
+  config.classifier.persistenceSamples      = 5;
+  config.classifier.maxStepMm               = 150;
+  config.classifier.maxMissedSamples        = 2;
+  config.tracker.alpha                      = Q16_FROM_RATIO(1, 2);
+  config.tracker.beta                       = Q16_FROM_RATIO(1, 8);
+  config.tracker.maxPredictedSamples        = 5;
+  stateMachine.Init(config);
+}
+
+/// @brief Gets whether the lights show a distance, outside of the lights test
+///
+static bool IsShowingDistance(StateMachine& stateMachine, MockTrafficLight& trafficLight)
+{
+  if (strcmp(StateMachine::GetStateName(stateMachine.GetState()), "SubjectApproaching") != 0)
+    return false;
+
+  ITrafficLight::LightState state = ITrafficLight::Off;
+  ITrafficLight::LightSelector lights[] = { ITrafficLight::RedLight, ITrafficLight::YellowLight, ITrafficLight::GreenLight };
+
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    trafficLight.GetState(lights[i], state);
+    if (state == ITrafficLight::On)
+      return true;
+  }
+
+  return false;
+}
+
+/// @brief A state machine with its sensor and lights
+///
+struct Bay
+{
+  ScriptedDistanceSensor  sensor;
+  MockTrafficLight        trafficLight;
+  StateMachine            stateMachine;
+
+  Bay(bool deferLightsTest)
+    :trafficLight(GetTime)
+  {
+    simulatedTimeMs = 0;
+
+    IDistanceSensor::Config sensorConfig;
+    sensorConfig.name = "Bay";
+    CHECK_EQUAL(RESULT_OK, sensor.Init(sensorConfig));
+    sensor.SetMeasurement(RESULT_TIMEOUT, 0);
+
+    ITrafficLight::Config trafficLightConfig;
+    trafficLightConfig.name           = "Bay";
+    trafficLightConfig.redLightPin    = 0;
+    trafficLightConfig.yellowLightPin = 0;
+    trafficLightConfig.greenLightPin  = 0;
+    trafficLightConfig.pinsPolarity   = SignalPolarity::ActiveHigh;
+    CHECK_EQUAL(RESULT_OK, trafficLight.Init(trafficLightConfig));
+
+    InitStateMachine(stateMachine, &sensor, &trafficLight, GetTime, deferLightsTest);
+  }
+
+  /// @brief Completes one measurement of a car at the given distance, UINT32_MAX for an empty bay
+  ///
+  void Measure(uint32_t distance)
+  {
+    if (distance == UINT32_MAX)
+      sensor.SetMeasurement(RESULT_TIMEOUT, 0);
+    else
+      sensor.SetMeasurement(RESULT_OK, distance);
+
+    while (stateMachine.Update() == RESULT_BUSY)
+      simulatedTimeMs += BUSY_POLL_MS;
+
+    simulatedTimeMs += PERIOD_MS;
+  }
+
+  /// @brief Gets whether the lights show a distance, outside of the lights test
+  ///
+  bool IsShowingDistance()
+  {
+    return ::IsShowingDistance(stateMachine, trafficLight);
+  }
+};
+
+/// @brief Drives a car in from the edge of the range right after the reset
+///
+/// @param deferLightsTest    The configuration of the state machine
+///
+/// @retval The time from the reset to the first light showing the distance, in milliseconds
+///
+static uint32_t GetTimeToFirstLight(bool deferLightsTest)
+{
+  Bay bay(deferLightsTest);
+  uint32_t distance = 2900;
+
+  while (true)
+  {
+    CHECK(simulatedTimeMs < 10000);
+    bay.Measure(distance);
+    distance -= 100;
+
+    // A car arriving doesn't start the deferred test
+    if (deferLightsTest)
+      CHECK_EQUAL(RESULT_NOT_EXECUTED, bay.stateMachine.GetLightsTestResult());
+
+    // The light came on at the end of the update, before the wait for the next one
+    if (bay.IsShowingDistance())
+      return simulatedTimeMs - PERIOD_MS;
+  }
+}
+
+/// @brief Measures the time to the first light with an HC-SR04 and a car already in range at the reset
+///
+/// @param distanceMm         The distance of the car
+///
+/// @retval The time from the reset to the first light showing the distance, in microseconds
+///
+static uint32_t GetTimeToFirstLightOnSensor(uint32_t distanceMm)
+{
+  HostSetMicros(0);
+
+  SimulatedEchoLine line;
+  CHECK_EQUAL(RESULT_OK, line.Attach(TRIGGER_PIN, ECHO_PIN));
+  line.SetTarget(distanceMm);
+
+  HCSR04 sensor;
+  IDistanceSensor::Config sensorConfig;
+  sensorConfig.name       = "Bay";
+  sensorConfig.triggerPin = TRIGGER_PIN;
+  sensorConfig.echoPin    = ECHO_PIN;
+  CHECK_EQUAL(RESULT_OK, sensor.Init(sensorConfig));
+
+  MockTrafficLight trafficLight;
+  ITrafficLight::Config trafficLightConfig;
+  trafficLightConfig.name           = "Bay";
+  trafficLightConfig.redLightPin    = 0;
+  trafficLightConfig.yellowLightPin = 0;
+  trafficLightConfig.greenLightPin  = 0;
+  trafficLightConfig.pinsPolarity   = SignalPolarity::ActiveHigh;
+  CHECK_EQUAL(RESULT_OK, trafficLight.Init(trafficLightConfig));
+
+  // The loop starts the first update as soon as setup() returns, and polls it
+  StateMachine stateMachine;
+  InitStateMachine(stateMachine, &sensor, &trafficLight, nullptr, true);
+
+  while (!IsShowingDistance(stateMachine, trafficLight))
+  {
+    CHECK(micros() < 1000000);
+
+    if (stateMachine.Update() == RESULT_BUSY)
+      HostAdvanceMicros(LOOP_ITERATION_US);
+  }
+
+  return micros();
+}
+
+static void TestTimeToFirstLight()
+{
+  uint32_t deferredMs = GetTimeToFirstLight(true);
+  uint32_t testedMs   = GetTimeToFirstLight(false);
+
+  printf("time to the first light: deferred lights test %u ms, lights test first %u ms\n", deferredMs, testedMs);
+
+  // On a fast start the first reading in range turns the light on. With the lights test
+  // first the car has to be confirmed by the classifier and seen moving after the test.
+  CHECK(deferredMs < FIRST_LIGHT_TARGET_MS);
+  CHECK(testedMs >= deferredMs + LIGHTS_TEST_TIME_MS);
+
+  // The echo of the first ping is the longest wait, up to the range limit
+  uint32_t nearUs = GetTimeToFirstLightOnSensor(300);
+  uint32_t farUs  = GetTimeToFirstLightOnSensor(2900);
+
+  printf("time to the first light on an HC-SR04: car at 300 mm %u us, at 2900 mm %u us\n", nearUs, farUs);
+
+  CHECK(nearUs < farUs);
+  CHECK(farUs < FIRST_LIGHT_TARGET_MS * 1000);
+}
+
+static void TestDeferredLightsTest()
+{
+  Bay bay(true);
+
+  // A car parked at the reset, the bay is idle but never empty
+  for (uint32_t i = 0; i < 100; i++)
+    bay.Measure(1000);
+
+  CHECK_EQUAL(RESULT_NOT_EXECUTED, bay.stateMachine.GetLightsTestResult());
+
+  // The car leaves, the test waits for the bay to stay empty for the holding time
+  uint32_t emptyTimeMs = simulatedTimeMs;
+
+  while (bay.stateMachine.GetLightsTestResult() == RESULT_NOT_EXECUTED)
+  {
+    CHECK(simulatedTimeMs - emptyTimeMs < 10000);
+    bay.Measure(UINT32_MAX);
+  }
+
+  CHECK_EQUAL(RESULT_OK, bay.stateMachine.GetLightsTestResult());
+  CHECK(simulatedTimeMs - emptyTimeMs >= HOLDING_TIME_MS + LIGHTS_TEST_TIME_MS);
+  CHECK(simulatedTimeMs - emptyTimeMs <= HOLDING_TIME_MS + LIGHTS_TEST_TIME_MS + 4 * PERIOD_MS);
+
+  // Something in range in the meantime restarts the wait
+  Bay other(true);
+
+  for (uint32_t i = 0; i < 30; i++)
+    other.Measure((i == 15) ? 2000 : UINT32_MAX);
+
+  CHECK_EQUAL(RESULT_NOT_EXECUTED, other.stateMachine.GetLightsTestResult());
+}
+
+int main()
+{
+  Logger::SetLogLevel(Logger::Level::OFF);
+
+  TestTimeToFirstLight();
+  TestDeferredLightsTest();
+
+  return 0;
+}
@@ -0,0 +1,189 @@
+///
+/// @file TargetClassifierTest.cpp
+///
+/// @brief Checks that the TargetClassifier rejects the pedestrians and confirms the cars
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include "TargetClassifier.h"
+#include "HostTest.h"
+
+using namespace CNEGR;
+
+#define PERSISTENCE_SAMPLES   5
+#define MAX_STEP_MM           150
+#define MAX_MISSED_SAMPLES    2
+#define PERIOD_MS             100     ///< The time between two readings
+#define WALL_MM               2800    ///< The back wall of the bay
+
+/// @brief Initializes a classifier with the configuration of DistanceMeasurement.ino
+///
+static void Init(TargetClassifier& classifier)
+{
+  TargetClassifier::Config config = { PERSISTENCE_SAMPLES, MAX_STEP_MM, MAX_MISSED_SAMPLES };
+  CHECK_EQUAL(RESULT_OK, classifier.Init(config));
+}
+
+/// @brief Drives a car in from the edge of the range
+///
+/// @param speedMmPerS        The speed of the car
+///
+/// @retval The number of the reading confirming the car, 0 if it is never confirmed
+///
+static uint32_t GetConfirmingSample(uint32_t speedMmPerS)
+{
+  TargetClassifier classifier;
+  Init(classifier);
+
+  uint32_t distance = 3000;
+
+  for (uint32_t sample = 1; sample <= 20; sample++)
+  {
+    classifier.Update(distance);
+    if (classifier.IsConfirmed())
+      return sample;
+
+    distance -= speedMmPerS * PERIOD_MS / 1000;
+  }
+
+  return 0;
+}
+
+static void TestInit()
+{
+  TargetClassifier classifier;
+
+  TargetClassifier::Config config = { 0, MAX_STEP_MM, MAX_MISSED_SAMPLES };
+  CHECK_EQUAL(RESULT_BAD_PARAM, classifier.Init(config));
+
+  config.persistenceSamples = UINT8_MAX;
+  CHECK_EQUAL(RESULT_BAD_PARAM, classifier.Init(config));
+
+  Init(classifier);
+  CHECK(!classifier.IsConfirmed());
+  CHECK_EQUAL(0, classifier.GetRejectedCount());
+}
+
+static void TestPedestrians()
+{
+  // Walking through the beam of an empty bay, the sensor times out before and after
+  for (uint8_t length = 1; length < PERSISTENCE_SAMPLES; length++)
+  {
+    TargetClassifier classifier;
+    Init(classifier);
+
+    for (uint8_t i = 0; i < 3; i++)
+      classifier.Miss();
+
+    for (uint8_t i = 0; i < length; i++)
+    {
+      classifier.Update(1500 + i * 40);
+      CHECK(!classifier.IsConfirmed());
+    }
+
+    for (uint8_t i = 0; i <= MAX_MISSED_SAMPLES; i++)
+    {
+      classifier.Miss();
+      CHECK(!classifier.IsConfirmed());
+    }
+
+    // A single reading isn't counted as a target
+    CHECK_EQUAL((length > 1) ? 1 : 0, classifier.GetRejectedCount());
+  }
+
+  // Walking in front of the back wall, the wall is a target too but it doesn't move
+  for (uint8_t length = 1; length < PERSISTENCE_SAMPLES; length++)
+  {
+    TargetClassifier classifier;
+    Init(classifier);
+
+    for (uint8_t i = 0; i < 10; i++)
+      classifier.Update(WALL_MM);
+
+    CHECK(classifier.IsConfirmed());
+
+    for (uint8_t i = 0; i < length; i++)
+    {
+      classifier.Update(1200 + i * 30);
+      CHECK(!classifier.IsConfirmed());
+    }
+
+    // The wall comes back as a new target
+    for (uint8_t i = 1; i < PERSISTENCE_SAMPLES; i++)
+    {
+      classifier.Update(WALL_MM);
+      CHECK(!classifier.IsConfirmed());
+    }
+
+    classifier.Update(WALL_MM);
+    CHECK(classifier.IsConfirmed());
+    CHECK_EQUAL((length > 1) ? 1 : 0, classifier.GetRejectedCount());
+  }
+}
+
+static void TestCar()
+{
+  // 25 mm per reading, confirmed on the 5th in range reading
+  CHECK_EQUAL(PERSISTENCE_SAMPLES, GetConfirmingSample(250));
+
+  // A car stays confirmed through the tolerated dropouts
+  TargetClassifier classifier;
+  Init(classifier);
+
+  for (uint8_t i = 0; i < PERSISTENCE_SAMPLES; i++)
+    classifier.Update(2000 - i * 25);
+
+  for (uint8_t i = 0; i < MAX_MISSED_SAMPLES; i++)
+  {
+    classifier.Miss();
+    CHECK(classifier.IsConfirmed());
+  }
+
+  classifier.Update(1850);
+  CHECK(classifier.IsConfirmed());
+
+  // One dropout too many drops it
+  for (uint8_t i = 0; i <= MAX_MISSED_SAMPLES; i++)
+    classifier.Miss();
+
+  CHECK(!classifier.IsConfirmed());
+  CHECK_EQUAL(0, classifier.GetRejectedCount());
+}
+
+static void TestSpeedLimit()
+{
+  // maxStepMm per 100 ms reading is 1.5 m/s, anything faster is never confirmed
+  CHECK_EQUAL(PERSISTENCE_SAMPLES, GetConfirmingSample(MAX_STEP_MM * 1000 / PERIOD_MS));
+  CHECK_EQUAL(0, GetConfirmingSample(MAX_STEP_MM * 1000 / PERIOD_MS + 10));
+}
+
+static void TestSeed()
+{
+  // A car already in range at the reset is confirmed from its first reading
+  TargetClassifier classifier;
+  Init(classifier);
+
+  classifier.Seed(1500);
+  CHECK(classifier.IsConfirmed());
+
+  classifier.Update(1500 - MAX_STEP_MM);
+  CHECK(classifier.IsConfirmed());
+
+  // The seeded target is dropped like any other
+  classifier.Update(2900);
+  CHECK(!classifier.IsConfirmed());
+  CHECK_EQUAL(0, classifier.GetRejectedCount());
+}
+
+int main()
+{
+  TestInit();
+  TestPedestrians();
+  TestCar();
+  TestSpeedLimit();
+  TestSeed();
+
+  return 0;
+}
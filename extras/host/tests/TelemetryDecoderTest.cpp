@@ -0,0 +1,119 @@
+///
+/// @file TelemetryDecoderTest.cpp
+///
+/// @brief Checks that the host decoder reads back the frames sent by the Telemetry
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include <Arduino.h>
+#include <vector>
+#include "Telemetry.h"
+#include "TelemetryDecoder.h"
+#include "HostTest.h"
+
+using namespace CNEGR;
+
+/// @brief Records the bytes sent by the telemetry
+///
+class RecordingOutput: public Print
+{
+public:
+  virtual size_t write(uint8_t c)
+  {
+    bytes.push_back(c);
+    return 1;
+  }
+
+  using Print::write;
+
+  std::vector<uint8_t> bytes;       ///< The bytes sent
+};
+
+/// @brief Pushes bytes to the decoder
+///
+/// @retval The number of valid frames completed
+///
+static uint32_t Receive(TelemetryDecoder& decoder, const std::vector<uint8_t>& bytes)
+{
+  uint32_t frames = 0;
+
+  for (size_t i = 0; i < bytes.size(); i++)
+    frames += (decoder.Push(bytes[i]) == RESULT_OK);
+
+  return frames;
+}
+
+int main()
+{
+  RecordingOutput output;
+  Telemetry telemetry;
+  TelemetryDecoder decoder;
+
+  CHECK_EQUAL(RESULT_BAD_PARAM, telemetry.Init(nullptr));
+  CHECK_EQUAL(RESULT_OK, telemetry.Init(&output));
+
+  TelemetrySample sample = { 123456, 1500, 1490, -320, 2 };
+  CHECK_EQUAL(RESULT_NOT_READY, telemetry.Send(sample));
+  CHECK(output.bytes.empty());
+
+  telemetry.SetEnabled(true);
+
+  // A sample goes through unchanged
+  CHECK_EQUAL(RESULT_OK, telemetry.Send(sample));
+  CHECK_EQUAL(1, Receive(decoder, output.bytes));
+  CHECK_EQUAL(TelemetrySampleMessage, decoder.GetType());
+
+  TelemetrySample decodedSample;
+  CHECK_EQUAL(RESULT_OK, DecodeTelemetryPayload(decoder.GetPayload(), decoder.GetPayloadLength(), decodedSample));
+  CHECK_EQUAL(sample.timeMs, decodedSample.timeMs);
+  CHECK_EQUAL(sample.rawDistanceMm, decodedSample.rawDistanceMm);
+  CHECK_EQUAL(sample.trackedDistanceMm, decodedSample.trackedDistanceMm);
+  CHECK_EQUAL(sample.velocityMmPerS, decodedSample.velocityMmPerS);
+  CHECK_EQUAL(sample.state, decodedSample.state);
+
+  // Console text before a frame is dropped, the frame after it is received
+  const char *text = "OK\r\n";
+  output.bytes.assign(text, text + 4);
+  TelemetryTransition transition = { 200000, 2, 3 };
+  CHECK_EQUAL(RESULT_OK, telemetry.Send(transition));
+  CHECK_EQUAL(1, Receive(decoder, output.bytes));
+  CHECK_EQUAL(TelemetryTransitionMessage, decoder.GetType());
+
+  TelemetryTransition decodedTransition;
+  CHECK_EQUAL(RESULT_OK, DecodeTelemetryPayload(decoder.GetPayload(), decoder.GetPayloadLength(), decodedTransition));
+  CHECK_EQUAL(transition.timeMs, decodedTransition.timeMs);
+  CHECK_EQUAL(transition.toState, decodedTransition.toState);
+  CHECK_EQUAL(0, decoder.GetLostFrameCount());
+
+  // A corrupted frame is dropped and counted, and the next one is lost from the sequence
+  uint32_t errors = decoder.GetErrorCount();
+  output.bytes.clear();
+  CHECK_EQUAL(RESULT_OK, telemetry.Send(sample));
+  output.bytes[output.bytes.size() / 2] ^= 0x10;
+  CHECK_EQUAL(0, Receive(decoder, output.bytes));
+  CHECK(decoder.GetErrorCount() > errors);
+
+  output.bytes.clear();
+  CHECK_EQUAL(RESULT_OK, telemetry.Send(sample));
+  CHECK_EQUAL(1, Receive(decoder, output.bytes));
+  CHECK_EQUAL(1, decoder.GetLostFrameCount());
+
+  // A long stream of frames, every one received in order
+  output.bytes.clear();
+  for (uint32_t i = 0; i < 1000; i++)
+  {
+    sample.timeMs = i;
+    CHECK_EQUAL(RESULT_OK, telemetry.Send(sample));
+  }
+
+  uint32_t frames = decoder.GetFrameCount();
+  CHECK_EQUAL(1000, Receive(decoder, output.bytes));
+  CHECK_EQUAL(frames + 1000, decoder.GetFrameCount());
+  CHECK_EQUAL(1, decoder.GetLostFrameCount());
+  CHECK_EQUAL(RESULT_OK, DecodeTelemetryPayload(decoder.GetPayload(), decoder.GetPayloadLength(), decodedSample));
+  CHECK_EQUAL(999, decodedSample.timeMs);
+
+  return 0;
+}
@@ -0,0 +1,106 @@
+///
+/// @file TraceAnalyticsTest.cpp
+///
+/// @brief Checks the vectorized trace analysis against the scalar reference
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include <vector>
+#include "TraceAnalytics.h"
+#include "TraceReference.h"
+#include "HostTest.h"
+
+using namespace CNEGR;
+
+/// @brief Checks that two statistics are the same
+///
+static void CheckStatistics(const TraceStatistics& expected, const TraceStatistics& actual)
+{
+  CHECK_EQUAL(expected.sampleCount, actual.sampleCount);
+  CHECK_EQUAL(expected.validCount, actual.validCount);
+  CHECK_EQUAL(expected.minDistanceMm, actual.minDistanceMm);
+  CHECK_EQUAL(expected.maxDistanceMm, actual.maxDistanceMm);
+  CHECK_EQUAL(expected.meanDistanceMm, actual.meanDistanceMm);
+  CHECK_EQUAL(expected.noiseMm, actual.noiseMm);
+  CHECK_EQUAL(expected.minVelocityMmPerS, actual.minVelocityMmPerS);
+  CHECK_EQUAL(expected.maxVelocityMmPerS, actual.maxVelocityMmPerS);
+
+  for (int zone = 0; zone < TraceZoneCount; zone++)
+    CHECK_EQUAL(expected.dwellTimeMs[zone], actual.dwellTimeMs[zone]);
+}
+
+/// @brief Analyzes a trace with both versions and compares the results
+///
+static void CheckTrace(const uint32_t *timesMs, const uint32_t *distancesMm, size_t count, const TraceZones& zones)
+{
+  TraceStatistics expected;
+  TraceStatistics actual;
+
+  ReferenceAnalyzeTrace(timesMs, distancesMm, count, zones, expected);
+  CHECK_EQUAL(RESULT_OK, AnalyzeTrace(timesMs, distancesMm, count, zones, actual));
+  CheckStatistics(expected, actual);
+}
+
+int main()
+{
+  const TraceZones zones = { 500, 1500, 3000 };
+  TraceStatistics statistics;
+  uint32_t times[3]     = { 0, 100, 200 };
+  uint32_t distances[3] = { 1000, 900, 800 };
+
+  // Arguments
+  CHECK_EQUAL(RESULT_BAD_PARAM, AnalyzeTrace(nullptr, distances, 3, zones, statistics));
+  CHECK_EQUAL(RESULT_BAD_PARAM, AnalyzeTrace(times, nullptr, 3, zones, statistics));
+  const TraceZones unordered = { 1500, 500, 3000 };
+  CHECK_EQUAL(RESULT_BAD_PARAM, AnalyzeTrace(times, distances, 3, unordered, statistics));
+  CHECK_EQUAL(RESULT_NO_DATA, AnalyzeTrace(times, distances, 0, zones, statistics));
+
+  // A steady approach, 1 m/s without noise, all in the yellow zone
+  CHECK_EQUAL(RESULT_OK, AnalyzeTrace(times, distances, 3, zones, statistics));
+  CHECK_EQUAL(3, statistics.validCount);
+  CHECK_EQUAL(800, statistics.minDistanceMm);
+  CHECK_EQUAL(1000, statistics.maxDistanceMm);
+  CHECK_EQUAL(900, statistics.meanDistanceMm);
+  CHECK_EQUAL(0, statistics.noiseMm);
+  CHECK_EQUAL(-1000, statistics.minVelocityMmPerS);
+  CHECK_EQUAL(0, statistics.maxVelocityMmPerS);
+  CHECK_EQUAL(200, statistics.dwellTimeMs[TraceYellowZone]);
+  CheckTrace(times, distances, 3, zones);
+
+  // Without any echo
+  uint32_t lost[3] = { TRACE_NO_DISTANCE, TRACE_NO_DISTANCE, TRACE_NO_DISTANCE };
+  CHECK_EQUAL(RESULT_OK, AnalyzeTrace(times, lost, 3, zones, statistics));
+  CHECK_EQUAL(0, statistics.validCount);
+  CHECK_EQUAL(TRACE_NO_DISTANCE, statistics.minDistanceMm);
+  CHECK_EQUAL(0, statistics.maxDistanceMm);
+  CHECK_EQUAL(200, statistics.dwellTimeMs[TraceOutOfRangeZone]);
+  CheckTrace(times, lost, 3, zones);
+
+  // A single sample, and samples at the same time
+  CheckTrace(times, distances, 1, zones);
+  uint32_t sameTimes[3] = { 50, 50, 50 };
+  CheckTrace(sameTimes, distances, 3, zones);
+
+  // Recorded parkings of every length, so that the vector loops end on every remainder
+  for (size_t count = 2; count < 300; count += 7)
+  {
+    std::vector<uint32_t> traceTimes(count);
+    std::vector<uint32_t> echoTimes(count);
+    std::vector<uint32_t> expectedDistances(count);
+    std::vector<uint32_t> actualDistances(count);
+
+    MakeTrace(&traceTimes[0], &echoTimes[0], count, (uint32_t)count);
+
+    ReferenceEchoTimesToDistances(34300, &echoTimes[0], &expectedDistances[0], count);
+    EchoTimesToDistances(34300, &echoTimes[0], &actualDistances[0], count);
+
+    for (size_t i = 0; i < count; i++)
+      CHECK_EQUAL(expectedDistances[i], actualDistances[i]);
+
+    CheckTrace(&traceTimes[0], &actualDistances[0], count, zones);
+  }
+
+  return 0;
+}
@@ -0,0 +1,146 @@
+///
+/// @file TraceReference.h
+///
+/// @brief A plain scalar version of the trace analysis, the reference of the checks
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+/// Written the obvious way, one sample at a time with branches, and with the firmware's
+/// EchoTimeToDistance() for the conversion.
+///
+#pragma once
+
+#if !defined(_TRACEREFERENCE_H_)
+#define _TRACEREFERENCE_H_
+
+#include <math.h>
+#include <string.h>
+#include "SpeedOfSound.h"
+#include "TraceAnalytics.h"
+
+namespace CNEGR
+{
+  /// @brief Converts echo durations to distances, one EchoTimeToDistance() call per sample
+  ///
+  inline void ReferenceEchoTimesToDistances(uint16_t speedOfSound, const uint32_t *echoTimesUs, uint32_t *distancesMm, size_t count)
+  {
+    for (size_t i = 0; i < count; i++)
+    {
+      if (echoTimesUs[i] == 0)
+        distancesMm[i] = TRACE_NO_DISTANCE;
+      else
+        distancesMm[i] = EchoTimeToDistance(speedOfSound, echoTimesUs[i]);
+    }
+  }
+
+  /// @brief Gets the zone of a distance
+  ///
+  inline TraceZone GetReferenceZone(uint32_t distanceMm, const TraceZones& zones)
+  {
+    if (distanceMm <= zones.nearThresholdMm)
+      return TraceRedZone;
+
+    if (distanceMm <= zones.farThresholdMm)
+      return TraceYellowZone;
+
+    if (distanceMm <= zones.maxDistanceThresholdMm)
+      return TraceGreenZone;
+
+    return TraceOutOfRangeZone;
+  }
+
+  /// @brief Computes the statistics of a trace in a single pass with branches
+  ///
+  /// @note The arguments are not checked, the trace must not be empty
+  ///
+  inline void ReferenceAnalyzeTrace(const uint32_t *timesMs, const uint32_t *distancesMm, size_t count,
+                                    const TraceZones& zones, TraceStatistics& statistics)
+  {
+    memset(&statistics, 0, sizeof(statistics));
+    statistics.sampleCount   = count;
+    statistics.minDistanceMm = TRACE_NO_DISTANCE;
+
+    uint64_t sum          = 0;
+    uint64_t sumOfSquares = 0;
+    uint32_t noiseCount   = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+      uint32_t distance = distancesMm[i];
+      bool     valid    = (distance != TRACE_NO_DISTANCE);
+
+      if (valid)
+      {
+        statistics.validCount++;
+        sum += distance;
+
+        if (distance < statistics.minDistanceMm)
+          statistics.minDistanceMm = distance;
+
+        if (distance > statistics.maxDistanceMm)
+          statistics.maxDistanceMm = distance;
+      }
+
+      if (i + 1 == count)
+        break;
+
+      uint32_t next     = distancesMm[i + 1];
+      uint32_t duration = timesMs[i + 1] - timesMs[i];
+
+      statistics.dwellTimeMs[GetReferenceZone(distance, zones)] += duration;
+
+      if (valid && (next != TRACE_NO_DISTANCE) && (duration != 0))
+      {
+        int32_t velocity = (int32_t)((int64_t)((int32_t)next - (int32_t)distance) * 1000 / duration);
+
+        if (velocity < statistics.minVelocityMmPerS)
+          statistics.minVelocityMmPerS = velocity;
+
+        if (velocity > statistics.maxVelocityMmPerS)
+          statistics.maxVelocityMmPerS = velocity;
+      }
+
+      if ((i != 0) && valid && (next != TRACE_NO_DISTANCE) && (distancesMm[i - 1] != TRACE_NO_DISTANCE))
+      {
+        int64_t error = 2 * (int64_t)distance - distancesMm[i - 1] - next;
+        sumOfSquares += (uint64_t)(error * error);
+        noiseCount++;
+      }
+    }
+
+    if (statistics.validCount != 0)
+      statistics.meanDistanceMm = (uint32_t)(sum / statistics.validCount);
+
+    if (noiseCount != 0)
+      statistics.noiseMm = (uint32_t)sqrt((double)(sumOfSquares / (6 * (uint64_t)noiseCount)));
+  }
+
+  /// @brief Records a car parking: approach, stop with noise, and a few lost echoes
+  ///
+  /// @param timesMs            Contains the sample times
+  /// @param echoTimesUs        Contains the echo times, 0 for a lost echo
+  /// @param count              The number of samples
+  /// @param seed               The seed of the noise
+  ///
+  inline void MakeTrace(uint32_t *timesMs, uint32_t *echoTimesUs, size_t count, uint32_t seed)
+  {
+    uint32_t state = seed;
+    uint32_t timeMs = 1000;
+
+    for (size_t i = 0; i < count; i++)
+    {
+      state = state * 1103515245UL + 12345UL;
+      uint32_t noise = (state >> 16) & 0x3F;
+
+      // 60 ms pings with some jitter, from 4 m down to 0.3 m then parked
+      timeMs += 55 + (noise & 0x0F);
+      uint32_t position = (i < count / 2) ? 4000 - (uint32_t)((uint64_t)3700 * i / (count / 2)) : 300;
+      uint32_t distance = position + noise - 32;
+
+      timesMs[i]     = timeMs;
+      echoTimesUs[i] = ((state >> 8) % 37 == 0) ? 0 : DistanceToEchoTime(34300, distance);
+    }
+  }
+}
+#endif // _TRACEREFERENCE_H_
@@ -0,0 +1,135 @@
+///
+/// @file UpdateProfilerTest.cpp
+///
+/// @brief Checks the paths and cycle counts recorded by the UpdateProfiler
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+/// On the host the cycles follow the simulated clock, 16 cycles per microsecond.
+///
+
+#include <Arduino.h>
+#include <string>
+#include "UpdateProfiler.h"
+#include "DebugUtils.h"
+#include "HostTest.h"
+
+using namespace CNEGR;
+
+/// @brief Keeps the characters printed
+///
+class RecordingOutput: public Print
+{
+public:
+  virtual size_t write(uint8_t c)
+  {
+    text.push_back((char)c);
+    return 1;
+  }
+
+  using Print::write;
+
+  std::string text;                 ///< The characters printed
+};
+
+/// @brief Profiles an update lasting a given time
+///
+static void Profile(UpdateProfiler& profiler, uint8_t state, uint8_t nextState, Result result, uint32_t timeUs)
+{
+  profiler.Begin(state);
+  HostAdvanceMicros(timeUs);
+  profiler.End(nextState, result);
+}
+
+static void TestPaths()
+{
+  UpdateProfiler profiler;
+  UpdateProfiler::Path path;
+
+  // Nothing is recorded while stopped
+  Profile(profiler, 0, 1, RESULT_OK, 100);
+  CHECK(!profiler.IsRunning());
+  CHECK_EQUAL(0, profiler.GetPathCount());
+
+  CHECK_EQUAL(RESULT_OK, profiler.Start());
+  CHECK_EQUAL(RESULT_BUSY, profiler.Start());
+  CHECK(profiler.IsRunning());
+
+  // The largest count of a path is kept
+  Profile(profiler, 0, 0, RESULT_BUSY, 100);
+  Profile(profiler, 0, 0, RESULT_BUSY, 50);
+  Profile(profiler, 0, 0, RESULT_BUSY, 20);
+
+  CHECK_EQUAL(1, profiler.GetPathCount());
+  CHECK_EQUAL(RESULT_OK, profiler.GetPath(0, path));
+  CHECK_EQUAL(Logger::Level::OFF, path.logLevel);
+  CHECK_EQUAL(0, path.state);
+  CHECK_EQUAL(0, path.nextState);
+  CHECK_EQUAL(RESULT_BUSY, path.result);
+  CHECK_EQUAL(3, path.count);
+  CHECK_EQUAL(1600, path.maxCycles);
+
+  // The next state, the result and the log level make new paths
+  Profile(profiler, 0, 1, RESULT_BUSY, 10);
+  Profile(profiler, 0, 0, RESULT_OK, 200);
+  Logger::SetLogLevel(Logger::Level::INFO);
+  Profile(profiler, 0, 0, RESULT_OK, 300);
+  Logger::SetLogLevel(Logger::Level::OFF);
+
+  CHECK_EQUAL(4, profiler.GetPathCount());
+  CHECK_EQUAL(RESULT_OK, profiler.GetPath(3, path));
+  CHECK_EQUAL(Logger::Level::INFO, path.logLevel);
+  CHECK_EQUAL(4800, path.maxCycles);
+  CHECK_EQUAL(RESULT_BAD_PARAM, profiler.GetPath(4, path));
+
+  // An End() without Begin() is ignored
+  HostAdvanceMicros(1000);
+  profiler.End(0, RESULT_OK);
+  CHECK_EQUAL(RESULT_OK, profiler.GetPath(2, path));
+  CHECK_EQUAL(1, path.count);
+  CHECK_EQUAL(3200, path.maxCycles);
+
+  RecordingOutput output;
+  profiler.Print(output);
+  CHECK(output.text.find("maxCycles=4800\r\n") != std::string::npos);
+  CHECK(output.text.find("overflow") == std::string::npos);
+
+  // Stopping releases the paths, starting again clears them
+  profiler.Stop();
+  CHECK(!profiler.IsRunning());
+  CHECK_EQUAL(0, profiler.GetPathCount());
+
+  CHECK_EQUAL(RESULT_OK, profiler.Start());
+  CHECK_EQUAL(0, profiler.GetPathCount());
+}
+
+static void TestOverflow()
+{
+  UpdateProfiler profiler;
+  CHECK_EQUAL(RESULT_OK, profiler.Start());
+
+  for (uint8_t i = 0; i < UPDATEPROFILER_MAX_PATHS + 4; i++)
+    Profile(profiler, 0, i, RESULT_OK, 10 + i);
+
+  // The paths recorded first are kept
+  UpdateProfiler::Path path;
+  CHECK_EQUAL(UPDATEPROFILER_MAX_PATHS, profiler.GetPathCount());
+  CHECK_EQUAL(RESULT_OK, profiler.GetPath(UPDATEPROFILER_MAX_PATHS - 1, path));
+  CHECK_EQUAL(UPDATEPROFILER_MAX_PATHS - 1, path.nextState);
+
+  RecordingOutput output;
+  profiler.Print(output);
+  CHECK(output.text.find("overflow=1\r\n") != std::string::npos);
+}
+
+int main()
+{
+  Logger::SetLogLevel(Logger::Level::OFF);
+  HostSetMicros(0);
+
+  TestPaths();
+  TestOverflow();
+
+  return 0;
+}
@@ -0,0 +1,217 @@
+///
+/// @file UpdateTimingHarnessTest.cpp
+///
+/// @brief Checks that the UpdateTimingHarness drives the StateMachine through every path
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+
+#include <Arduino.h>
+#include <string.h>
+#include "UpdateTimingHarness.h"
+#include "HostTest.h"
+
+using namespace CNEGR;
+
+#define SERIAL_BAUD   19200       ///< The baud rate of the sketch
+
+/// @brief Gets the simulated time of the Arduino core stub
+///
+/// @retval The time in nanoseconds
+///
+static uint32_t GetSimulatedNs()
+{
+  return (uint32_t)micros() * 1000;
+}
+
+/// @brief Fills the configuration of DistanceMeasurement.ino
+///
+static void GetConfig(UpdateTimingHarness::Config& config)
+{
+  memset(&config, 0, sizeof(config));
+
+  config.periodMs  = 110;
+  config.runs      = 3;
+  config.nsCounter = nullptr;
+
+  StateMachine::Config& stateMachine = config.stateMachine;
+  stateMachine.maxDistanceThresholdMm             = 3000;
+  stateMachine.farThresholdMm                     = 1500;
+  stateMachine.nearThresholdMm                    = 250;
+  stateMachine.movingDistanceDetectionThresholdMm = 50;
+  stateMachine.movingTimeThresholdMs              = 100;
+  stateMachine.holdingTimeThresholdMs             = 2000;
+  stateMachine.deferLightsTest                    = true;
+  stateMachine.outlierFilter.thresholdX16         = 71;
+  stateMachine.outlierFilter.minDeviationMm       = 40;
+  stateMachine.classifier.persistenceSamples      = 5;
+  stateMachine.classifier.maxStepMm               = 150;
+  stateMachine.classifier.maxMissedSamples        = 2;
+  stateMachine.tracker.alpha                      = Q16_FROM_RATIO(1, 2);
+  stateMachine.tracker.beta                       = Q16_FROM_RATIO(1, 8);
+  stateMachine.tracker.maxPredictedSamples        = 5;
+}
+
+/// @brief Counts the updates of the paths matching a filter
+///
+/// @param harness            The harness, after a run
+/// @param state              The state the paths start from, nullptr for any
+/// @param nextState          The state the paths end in, nullptr for any
+/// @param lights             The lights after the update, -1 for any
+///
+/// @retval The number of updates
+///
+static uint32_t CountUpdates(const UpdateTimingHarness& harness, const char *state, const char *nextState, int lights)
+{
+  uint32_t count = 0;
+
+  for (uint8_t i = 0; i < harness.GetPathCount(); i++)
+  {
+    UpdateTimingHarness::Path path;
+    CHECK_EQUAL(RESULT_OK, harness.GetPath(i, path));
+
+    if (((state == nullptr) || (strcmp(state, StateMachine::GetStateName(path.state)) == 0)) &&
+        ((nextState == nullptr) || (strcmp(nextState, StateMachine::GetStateName(path.nextState)) == 0)) &&
+        ((lights < 0) || (lights == path.lights)))
+    {
+      count += path.count;
+    }
+  }
+
+  return count;
+}
+
+static void TestInit()
+{
+  UpdateTimingHarness::Config config;
+  UpdateTimingHarness harness;
+
+  CHECK_EQUAL(RESULT_NOT_READY, harness.Run(Logger::Level::OFF));
+
+  // The car must be seen moving between two updates
+  GetConfig(config);
+  config.periodMs = config.stateMachine.movingTimeThresholdMs;
+  CHECK_EQUAL(RESULT_BAD_PARAM, harness.Init(config));
+
+  GetConfig(config);
+  config.runs = 0;
+  CHECK_EQUAL(RESULT_BAD_PARAM, harness.Init(config));
+
+  GetConfig(config);
+  config.stateMachine.nearThresholdMm = config.stateMachine.farThresholdMm;
+  CHECK_EQUAL(RESULT_BAD_PARAM, harness.Init(config));
+
+  GetConfig(config);
+  config.stateMachine.classifier.maxStepMm = config.stateMachine.movingDistanceDetectionThresholdMm;
+  CHECK_EQUAL(RESULT_BAD_PARAM, harness.Init(config));
+
+  // The harnesses share the simulated clock
+  GetConfig(config);
+  UpdateTimingHarness other;
+  CHECK_EQUAL(RESULT_OK, harness.Init(config));
+  CHECK(harness.IsInitialized());
+  CHECK_EQUAL(RESULT_BUSY, other.Init(config));
+
+  harness.Deinit();
+  CHECK(!harness.IsInitialized());
+  CHECK_EQUAL(RESULT_OK, other.Init(config));
+}
+
+static void TestPaths()
+{
+  UpdateTimingHarness::Config config;
+  GetConfig(config);
+
+  UpdateTimingHarness harness;
+  CHECK_EQUAL(RESULT_OK, harness.Init(config));
+  CHECK_EQUAL(RESULT_OK, harness.Run(Logger::Level::OFF));
+
+  uint8_t pathCount = harness.GetPathCount();
+  UpdateTimingHarness::Path path;
+  CHECK(pathCount >= 20);
+  CHECK_EQUAL(RESULT_BAD_PARAM, harness.GetPath(pathCount, path));
+
+  // Every state of a parking manoeuvre is entered and left
+  static const char *states[] = { "Idle", "SubjectApproaching", "SubjectRetreating", "SensorFault" };
+
+  for (size_t i = 0; i < sizeof(states) / sizeof(states[0]); i++)
+  {
+    CHECK(CountUpdates(harness, states[i], nullptr, -1) > 0);
+    CHECK(CountUpdates(harness, nullptr, states[i], -1) > 0);
+  }
+
+  CHECK(CountUpdates(harness, "Idle", "SubjectApproaching", -1) > 0);
+  CHECK(CountUpdates(harness, "SubjectApproaching", "SubjectRetreating", -1) > 0);
+  CHECK(CountUpdates(harness, "SubjectRetreating", "SubjectApproaching", -1) > 0);
+  CHECK(CountUpdates(harness, "SubjectApproaching", "Idle", -1) > 0);
+  CHECK(CountUpdates(harness, "SensorFault", "Idle", -1) > 0);
+  CHECK_EQUAL(0, CountUpdates(harness, "Error", nullptr, -1));
+
+  // The car is seen in every range
+  CHECK(CountUpdates(harness, nullptr, nullptr, UpdateTimingHarness::Green) > 0);
+  CHECK(CountUpdates(harness, nullptr, nullptr, UpdateTimingHarness::Yellow) > 0);
+  CHECK(CountUpdates(harness, nullptr, nullptr, UpdateTimingHarness::Red) > 0);
+  CHECK(CountUpdates(harness, nullptr, nullptr, UpdateTimingHarness::AllOff) > 0);
+
+  // The manoeuvre is scripted, every run takes the same paths
+  uint16_t counts[UPDATETIMINGHARNESS_MAX_PATHS];
+  for (uint8_t i = 0; i < pathCount; i++)
+  {
+    CHECK_EQUAL(RESULT_OK, harness.GetPath(i, path));
+    counts[i] = path.count;
+    CHECK_EQUAL(0, path.count % config.runs);
+  }
+
+  CHECK_EQUAL(RESULT_OK, harness.Run(Logger::Level::OFF));
+  CHECK_EQUAL(pathCount, harness.GetPathCount());
+
+  for (uint8_t i = 0; i < pathCount; i++)
+  {
+    CHECK_EQUAL(RESULT_OK, harness.GetPath(i, path));
+    CHECK_EQUAL(counts[i], path.count);
+  }
+}
+
+static void TestSerialBlocking()
+{
+  UpdateTimingHarness::Config config;
+  GetConfig(config);
+  config.runs      = 1;
+  config.nsCounter = GetSimulatedNs;
+
+  HostSetMicros(0);
+  HostSetSerialBaud(SERIAL_BAUD);
+  HostSetSerialEcho(false);
+
+  UpdateTimingHarness harness;
+  CHECK_EQUAL(RESULT_OK, harness.Init(config));
+
+  // Without logs the simulated clock doesn't move
+  CHECK_EQUAL(RESULT_OK, harness.Run(Logger::Level::OFF));
+  CHECK_EQUAL(0, harness.GetMaxNs());
+
+  // The logs of a state change fill the 64 bytes transmit buffer and block for
+  // the time to send the rest, more than a ping cycle at 19200 bauds
+  CHECK_EQUAL(RESULT_OK, harness.Run(Logger::Level::INFO));
+  uint32_t infoNs = harness.GetMaxNs();
+  printf("longest update at %u bauds: INFO %u us\n", SERIAL_BAUD, infoNs / 1000);
+  CHECK(infoNs > 60000000UL);
+
+  CHECK_EQUAL(RESULT_OK, harness.Run(Logger::Level::DEBUG));
+  CHECK(harness.GetMaxNs() >= infoNs);
+
+  HostSetSerialBaud(0);
+  HostSetSerialEcho(true);
+}
+
+int main()
+{
+  HostSetSerialEcho(false);
+
+  TestInit();
+  TestPaths();
+  TestSerialBlocking();
+
+  return 0;
+}
@@ -0,0 +1,103 @@
+///
+/// @file EchoEdgesMain.cpp
+///
+/// @brief Decodes the echo edge captures of the telemetry and prints the pulses of each ping
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+/// Usage: echo-edges [file]
+///
+/// Reads the bytes received from the board's serial port, from the file or from the
+/// standard input, e.g. after 'telemetry on', 'edges 8' and 'edges' on the console.
+/// The console text and the other telemetry frames are skipped. Each complete capture
+/// is printed as one line per ping, the distance is the one the measurement would
+/// report for the first pulse at 20 degrees celsius.
+///
+
+#include <stdio.h>
+#include "EchoEdgeAnalysis.h"
+#include "SpeedOfSound.h"
+#include "TelemetryDecoder.h"
+
+using namespace CNEGR;
+
+/// @brief Prints the pulses of every ping of a capture
+///
+static void PrintCapture(const EchoEdgeCapture& capture)
+{
+  uint16_t speedOfSound = GetSpeedOfSound(200, DEFAULT_RELATIVE_HUMIDITY);
+
+  printf("capture: %u edges, %u lost\n", capture.GetEdgeCount(), capture.GetLostEdgeCount());
+  printf("ping edges pulses  rise_us width_us distance_mm last_fall_us shortest_us unterminated\n");
+
+  for (uint8_t ping = 0; ping < capture.GetPingCount(); ping++)
+  {
+    EchoPulseStatistics statistics;
+    if (AnalyzeEchoEdges(capture.GetEdges(), capture.GetEdgeCount(), ping, statistics) != RESULT_OK)
+    {
+      printf("%4u     0      0        -        -           -            -           -            -\n", ping);
+      continue;
+    }
+
+    uint32_t distanceMm = (statistics.pulseCount != 0) ? EchoTimeToDistance(speedOfSound, statistics.firstWidthUs) : 0;
+
+    printf("%4u %5u %6u %8u %8u %11u %12u %11u %12s\n",
+           ping, statistics.edgeCount, statistics.pulseCount, statistics.firstRiseUs, statistics.firstWidthUs,
+           distanceMm, statistics.lastFallUs, statistics.shortestWidthUs, statistics.unterminated ? "yes" : "no");
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  FILE *input = stdin;
+
+  if (argc > 1)
+  {
+    input = fopen(argv[1], "rb");
+    if (input == nullptr)
+    {
+      perror(argv[1]);
+      return 1;
+    }
+  }
+
+  TelemetryDecoder decoder;
+  EchoEdgeCapture capture;
+  uint32_t captures = 0;
+  int c;
+
+  while ((c = fgetc(input)) != EOF)
+  {
+    if ((decoder.Push((uint8_t)c) != RESULT_OK) || (decoder.GetType() != TelemetryEchoEdgesMessage))
+      continue;
+
+    TelemetryEchoEdges message;
+    Result result = DecodeTelemetryPayload(decoder.GetPayload(), decoder.GetPayloadLength(), message);
+    if (result == RESULT_OK)
+      result = capture.Add(message);
+
+    if (result != RESULT_OK)
+    {
+      // A missing part, wait for the next capture
+      fprintf(stderr, "edges frame %u dropped: %s\n", decoder.GetSequence(), ResultToStr(result));
+      capture.Reset();
+      continue;
+    }
+
+    if (capture.IsComplete())
+    {
+      PrintCapture(capture);
+      capture.Reset();
+      captures++;
+    }
+  }
+
+  if (input != stdin)
+    fclose(input);
+
+  if (decoder.GetErrorCount() + decoder.GetLostFrameCount() != 0)
+    fprintf(stderr, "%u frames or console lines dropped, %u frames lost\n", decoder.GetErrorCount(), decoder.GetLostFrameCount());
+
+  return (captures != 0) ? 0 : 1;
+}
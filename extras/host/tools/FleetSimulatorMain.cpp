@@ -0,0 +1,96 @@
+///
+/// @file FleetSimulatorMain.cpp
+///
+/// @brief Runs the fleet simulator and prints its results
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+/// Usage: fleet-simulator [bays [threads [periodMs [durationS]]]]
+///
+/// The thresholds and filters are the defaults of DistanceMeasurement.ino. 0 threads
+/// runs one worker per core.
+///
+
+#include <Arduino.h>
+#include "FleetSimulator.h"
+
+using namespace CNEGR;
+
+/// @brief Prints to the standard output
+///
+class StandardOutput: public Print
+{
+public:
+  virtual size_t write(uint8_t c)
+  {
+    return (putchar(c) != EOF) ? 1 : 0;
+  }
+};
+
+int main(int argc, char *argv[])
+{
+  FleetSimulator::Config config;
+  memset(&config, 0, sizeof(config));
+
+  config.bayCount     = (argc > 1) ? (uint16_t)atoi(argv[1]) : 2000;
+  config.threadCount  = (argc > 2) ? (uint16_t)atoi(argv[2]) : 0;
+  config.periodMs     = (argc > 3) ? (uint32_t)atoi(argv[3]) : 120;
+  config.durationMs   = (argc > 4) ? (uint32_t)atoi(argv[4]) * 1000 : 3600000;
+  config.seed         = 1;
+
+  config.scenario.startDistanceMm = 3500;
+  config.scenario.stopDistanceMm  = 500;
+  config.scenario.speedMmPerS     = 800;
+  config.scenario.emptyTimeMs     = 60000;
+  config.scenario.parkedTimeMs    = 120000;
+  config.scenario.noiseMm         = 15;
+  config.scenario.dropoutPercent  = 5;
+  config.scenario.spikePercent    = 2;
+
+  StateMachine::Config& stateMachine = config.stateMachine;
+  stateMachine.maxDistanceThresholdMm             = 3000;
+  stateMachine.farThresholdMm                     = 1500;
+  stateMachine.nearThresholdMm                    = 600;
+  stateMachine.movingDistanceDetectionThresholdMm = 50;
+  stateMachine.movingTimeThresholdMs              = 100;
+  stateMachine.holdingTimeThresholdMs             = 2000;
+  stateMachine.deferLightsTest                    = true;
+  stateMachine.outlierFilter.thresholdX16         = 71;
+  stateMachine.outlierFilter.minDeviationMm       = 40;
+  stateMachine.classifier.persistenceSamples      = 5;
+  stateMachine.classifier.maxStepMm               = 150;
+  stateMachine.classifier.maxMissedSamples        = 2;
+  stateMachine.tracker.alpha                      = Q16_FROM_RATIO(1, 2);
+  stateMachine.tracker.beta                       = Q16_FROM_RATIO(1, 8);
+  stateMachine.tracker.maxPredictedSamples        = 5;
+
+  config.energy.mcuActiveUa     = 9000;
+  config.energy.mcuSleepUa      = 2700;
+  config.energy.sensorIdleUa    = 2000;
+  config.energy.sensorPingUa    = 15000;
+  config.energy.sensorTimeoutUs = 38000;
+  config.energy.lightUa         = 10000;
+  config.updateActiveTimeUs     = 2000;
+  config.sleepWhenIdle          = true;
+
+  FleetSimulator simulator;
+  Result result = simulator.Init(config);
+  if (result != RESULT_OK)
+  {
+    fprintf(stderr, "Init returned %s\n", ResultToStr(result));
+    return 1;
+  }
+
+  FleetSimulator::Results results;
+  result = simulator.Run(results);
+  if (result != RESULT_OK)
+  {
+    fprintf(stderr, "Run returned %s\n", ResultToStr(result));
+    return 1;
+  }
+
+  StandardOutput output;
+  FleetSimulator::PrintResults(output, results);
+  return 0;
+}
@@ -0,0 +1,208 @@
+///
+/// @file SampleLatencyMain.cpp
+///
+/// @brief Measures the latency from the capture of a sample to the light it causes at every log level
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+/// Usage: sample-latency [baud]
+///
+/// Runs the loop of DistanceMeasurement.ino on the simulated clock of the Arduino core
+/// stub: an HCSR04 on a SimulatedEchoLine, the light wrapped by an InstrumentedTrafficLight
+/// like the sketch does, and the serial port sending the logs at the baud rate, 19200 by
+/// default, behind its transmit buffer. A car arrives, parks and leaves every 40 seconds
+/// for 2 minutes, at each log level, and the latencies are printed like the 'latency'
+/// console command does.
+///
+/// The time of the code itself isn't simulated, only the echo, the loop polling and the
+/// logs waiting for the serial port. The processing cost must be read on the board with
+/// the 'latency' command.
+///
+
+#include <Arduino.h>
+#include <string.h>
+#include "HCSR04.h"
+#include "StateMachine.h"
+#include "DebugUtils.h"
+#include "InstrumentedTrafficLight.h"
+#include "LatencyHistogram.h"
+#include "MockTrafficLight.h"
+#include "SimulatedEchoLine.h"
+
+using namespace CNEGR;
+
+#define TRIGGER_PIN           3       ///< The pins of DistanceMeasurement.ino
+#define ECHO_PIN              2
+#define PERIOD_MS             100     ///< The waitTimeBetweenMeasurementsMs of DistanceMeasurement.ino
+#define LOOP_ITERATION_US     100     ///< The time between two iterations of the loop
+#define CYCLE_TIME_MS         40000   ///< The time for a car to arrive, park and leave
+#define DURATION_MS           120000  ///< The simulated time at every log level
+
+static HCSR04 *sensor = nullptr;      ///< The sensor whose captures are timed
+
+/// @brief Prints to the standard output
+///
+class StandardOutput: public Print
+{
+public:
+  virtual size_t write(uint8_t c)
+  {
+    return (putchar(c) != EOF) ? 1 : 0;
+  }
+};
+
+/// @brief Gets the time of the last capture of the sensor
+///
+/// @retval The time in microseconds
+///
+static uint32_t GetCaptureTime()
+{
+  return sensor->GetLastCaptureTime();
+}
+
+/// @brief Moves the car of the parking cycle
+///
+/// The bay is empty for 5 seconds, the car drives in from the edge of the range in
+/// 10 seconds, stays parked 15 seconds, backs out in 5 seconds and the bay is empty again.
+///
+/// @param line               The line of the sensor
+/// @param timeMs             The time since the start of the cycle
+///
+static void MoveCar(SimulatedEchoLine& line, uint32_t timeMs)
+{
+  if ((timeMs < 5000) || (timeMs >= 35000))
+  {
+    line.SetState(SimulatedEchoLine::Empty);
+    return;
+  }
+
+  if (timeMs < 15000)
+    line.SetTarget(2900 - (timeMs - 5000) * 2500 / 10000);
+  else if (timeMs < 30000)
+    line.SetTarget(400);
+  else
+    line.SetTarget(400 + (timeMs - 30000) * 2500 / 5000);
+
+  line.SetState(SimulatedEchoLine::Target);
+}
+
+/// @brief Runs the loop of DistanceMeasurement.ino for a while
+///
+/// @param stateMachine       The state machine to update
+/// @param line               The line of the sensor
+/// @param durationMs         The simulated time
+///
+static void RunLoop(StateMachine& stateMachine, SimulatedEchoLine& line, uint32_t durationMs)
+{
+  uint32_t startTimeMs      = millis();
+  uint32_t lastUpdateTimeMs = startTimeMs - PERIOD_MS;
+  bool     updatePending    = false;
+
+  while (millis() - startTimeMs < durationMs)
+  {
+    MoveCar(line, (millis() - startTimeMs) % CYCLE_TIME_MS);
+
+    if (updatePending || (millis() - lastUpdateTimeMs >= PERIOD_MS))
+    {
+      if (!updatePending)
+        lastUpdateTimeMs = millis();
+
+      updatePending = (stateMachine.Update() == RESULT_BUSY);
+    }
+
+    HostAdvanceMicros(LOOP_ITERATION_US);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  uint32_t baud = (argc > 1) ? (uint32_t)atol(argv[1]) : 19200;
+
+  // The logs only advance the simulated clock, they are not printed
+  HostSetMicros(0);
+  HostSetSerialBaud(baud);
+  HostSetSerialEcho(false);
+  Logger::SetLogLevel(Logger::Level::OFF);
+
+  SimulatedEchoLine line;
+  Result result = line.Attach(TRIGGER_PIN, ECHO_PIN);
+  if (result != RESULT_OK)
+  {
+    fprintf(stderr, "Attach returned %s\n", ResultToStr(result));
+    return 1;
+  }
+
+  HCSR04 echoSensor;
+  sensor = &echoSensor;
+
+  IDistanceSensor::Config sensorConfig;
+  sensorConfig.name       = "DistanceSensor";
+  sensorConfig.triggerPin = TRIGGER_PIN;
+  sensorConfig.echoPin    = ECHO_PIN;
+
+  MockTrafficLight trafficLight;
+  ITrafficLight::Config trafficLightConfig;
+  trafficLightConfig.name           = "TrafficLight";
+  trafficLightConfig.redLightPin    = 0;
+  trafficLightConfig.yellowLightPin = 0;
+  trafficLightConfig.greenLightPin  = 0;
+  trafficLightConfig.pinsPolarity   = SignalPolarity::ActiveHigh;
+
+  LatencyHistogram histogram;
+  InstrumentedTrafficLight instrumentedLight(&trafficLight, GetCaptureTime, &histogram, nullptr);
+
+  if (((result = echoSensor.Init(sensorConfig)) != RESULT_OK) ||
+      ((result = trafficLight.Init(trafficLightConfig)) != RESULT_OK) ||
+      ((result = instrumentedLight.Init(trafficLightConfig)) != RESULT_OK))
+  {
+    fprintf(stderr, "Init returned %s\n", ResultToStr(result));
+    return 1;
+  }
+
+  // The configuration of DistanceMeasurement.ino
+  StateMachine::Config config;
+  memset(&config, 0, sizeof(config));
+  config.distanceSensor                     = &echoSensor;
+  config.trafficLight                       = &instrumentedLight;
+  config.maxDistanceThresholdMm             = 3000;
+  config.farThresholdMm                     = 1500;
+  config.nearThresholdMm                    = 250;
+  config.movingDistanceDetectionThresholdMm = 50;
+  config.movingTimeThresholdMs              = 100;
+  config.holdingTimeThresholdMs             = 2000;
+  config.deferLightsTest                    = true;
+  config.outlierFilter.thresholdX16         = 71;
+  config.outlierFilter.minDeviationMm       = 40;
+  config.classifier.persistenceSamples      = 5;
+  config.classifier.maxStepMm               = 150;
+  config.classifier.maxMissedSamples        = 2;
+  config.tracker.alpha                      = Q16_FROM_RATIO(1, 2);
+  config.tracker.beta                       = Q16_FROM_RATIO(1, 8);
+  config.tracker.maxPredictedSamples        = 5;
+
+  static const Logger::Level levels[] = { Logger::Level::INFO, Logger::Level::WARNING, Logger::Level::OFF };
+  static const char *levelNames[]     = { "INFO", "WARNING", "OFF" };
+
+  StandardOutput output;
+  printf("baud=%u\n", baud);
+
+  for (size_t i = 0; i < sizeof(levels) / sizeof(levels[0]); i++)
+  {
+    StateMachine stateMachine;
+    stateMachine.Init(config);
+
+    histogram.Clear();
+    Logger::SetLogLevel(levels[i]);
+    RunLoop(stateMachine, line, DURATION_MS);
+    Logger::SetLogLevel(Logger::Level::OFF);
+
+    // Let the logs drain before the next level
+    Serial.flush();
+
+    printf("logLevel=%s\n", levelNames[i]);
+    histogram.Print(output);
+  }
+
+  return 0;
+}
@@ -0,0 +1,109 @@
+///
+/// @file UpdateTimingMain.cpp
+///
+/// @brief Measures StateMachine::Update() on every path at every log level
+///
+/// @author Carl Negrescu
+/// @date October 18, 2026
+///
+/// Usage: update-timing [baud]
+///
+/// Without a baud rate the times are measured on the host steady clock, they show the
+/// relative cost of the paths and of the log levels. With a baud rate the times follow
+/// the simulated clock of the Arduino core stub, which only advances while the logs wait
+/// for room in the serial transmit buffer: they show how long Update() blocks on the
+/// serial port at that baud rate. The thresholds and filters are the defaults of
+/// DistanceMeasurement.ino.
+///
+
+#include <Arduino.h>
+#include "UpdateTimingHarness.h"
+
+using namespace CNEGR;
+
+/// @brief Prints to the standard output
+///
+class StandardOutput: public Print
+{
+public:
+  virtual size_t write(uint8_t c)
+  {
+    return (putchar(c) != EOF) ? 1 : 0;
+  }
+};
+
+/// @brief Gets the simulated time of the Arduino core stub
+///
+/// @retval The time in nanoseconds
+///
+static uint32_t GetSimulatedNs()
+{
+  return (uint32_t)micros() * 1000;
+}
+
+int main(int argc, char *argv[])
+{
+  uint32_t baud = (argc > 1) ? (uint32_t)atol(argv[1]) : 0;
+
+  UpdateTimingHarness::Config config;
+  memset(&config, 0, sizeof(config));
+
+  config.periodMs  = 110;
+  config.runs      = 3;
+  config.nsCounter = nullptr;
+
+  StateMachine::Config& stateMachine = config.stateMachine;
+  stateMachine.maxDistanceThresholdMm             = 3000;
+  stateMachine.farThresholdMm                     = 1500;
+  stateMachine.nearThresholdMm                    = 250;
+  stateMachine.movingDistanceDetectionThresholdMm = 50;
+  stateMachine.movingTimeThresholdMs              = 100;
+  stateMachine.holdingTimeThresholdMs             = 2000;
+  stateMachine.deferLightsTest                    = true;
+  stateMachine.outlierFilter.thresholdX16         = 71;
+  stateMachine.outlierFilter.minDeviationMm       = 40;
+  stateMachine.classifier.persistenceSamples      = 5;
+  stateMachine.classifier.maxStepMm               = 150;
+  stateMachine.classifier.maxMissedSamples        = 2;
+  stateMachine.tracker.alpha                      = Q16_FROM_RATIO(1, 2);
+  stateMachine.tracker.beta                       = Q16_FROM_RATIO(1, 8);
+  stateMachine.tracker.maxPredictedSamples        = 5;
+
+  if (baud != 0)
+  {
+    // The logs only advance the simulated clock, they are not printed
+    HostSetMicros(0);
+    HostSetSerialBaud(baud);
+    config.nsCounter = GetSimulatedNs;
+  }
+
+  HostSetSerialEcho(false);
+
+  UpdateTimingHarness harness;
+  Result result = harness.Init(config);
+  if (result != RESULT_OK)
+  {
+    fprintf(stderr, "Init returned %s\n", ResultToStr(result));
+    return 1;
+  }
+
+  static const Logger::Level levels[] = { Logger::Level::DEBUG, Logger::Level::INFO, Logger::Level::OFF };
+  static const char *levelNames[]     = { "DEBUG", "INFO", "OFF" };
+
+  StandardOutput output;
+
+  for (size_t i = 0; i < sizeof(levels) / sizeof(levels[0]); i++)
+  {
+    result = harness.Run(levels[i]);
+    if ((result != RESULT_OK) && (result != RESULT_OVERFLOW))
+    {
+      fprintf(stderr, "Run returned %s\n", ResultToStr(result));
+      return 1;
+    }
+
+    printf("logLevel=%s\n", levelNames[i]);
+    harness.Print(output);
+  }
+
+  return 0;
+}